@@ -39,6 +39,9 @@ android {
     buildFeatures {
         compose = true
     }
+    testOptions {
+        unitTests.isReturnDefaultValues = true   // android.util.Log in parsers under JVM tests
+    }
 }
 
 dependencies {
@@ -0,0 +1,152 @@
+package com.tnvsai.yatramate.ble
+
+import android.content.Context
+import android.util.Log
+import com.google.gson.Gson
+
+/**
+ * Frequent callers, pushed to the display once per connection (firmware caller_directory.h)
+ *
+ * Callers are learned from the calls the app forwards and ranked by how often
+ * they call. The top [MAX_SYNCED] go to the display as
+ * {"type":"contacts","reset":true,"c":[[id,"name",numberHash],...]}; call frames
+ * for them then carry {"contact":id} instead of caller_name and caller_number.
+ * IDs are stable across connections (stored with the entries).
+ */
+class CallerDirectory(context: Context) {
+
+    companion object {
+        private const val TAG = "CallerDirectory"
+        private const val PREFS_NAME = "yatramate_caller_directory"
+        private const val KEY_ENTRIES = "entries"
+        const val MAX_SYNCED = 48             // Firmware CALLER_DIRECTORY_MAX_ENTRIES
+        private const val MAX_STORED = 128    // Least called entries are forgotten beyond this
+        private const val ENTRIES_PER_MESSAGE = 8
+        private const val NAME_MAX = 31       // UTF-8 bytes; firmware CALLER_DIRECTORY_NAME_LEN - 1
+        private const val HASH_DIGITS = 10    // Firmware CALLER_DIRECTORY_HASH_DIGITS
+
+        /**
+         * FNV-1a over the last [HASH_DIGITS] digits, as computed by the firmware (0 = no digits)
+         */
+        fun numberHash(number: String): Long {
+            val digits = number.filter { it in '0'..'9' }.takeLast(HASH_DIGITS)
+            if (digits.isEmpty()) return 0
+            var hash = 2166136261L
+            for (c in digits) {
+                hash = hash xor c.code.toLong()
+                hash = (hash * 16777619L) and 0xFFFFFFFFL
+            }
+            return hash
+        }
+    }
+
+    data class Entry(
+        val id: Int,
+        val name: String,
+        val numberKey: String,     // Last HASH_DIGITS digits
+        val calls: Int,
+        val lastCallMs: Long
+    )
+
+    private val prefs = context.getSharedPreferences(PREFS_NAME, Context.MODE_PRIVATE)
+    private val gson = Gson()
+    private val entries = mutableMapOf<String, Entry>()
+
+    init {
+        try {
+            prefs.getString(KEY_ENTRIES, null)?.let { json ->
+                gson.fromJson(json, Array<Entry>::class.java).forEach { entries[it.numberKey] = it }
+            }
+            Log.d(TAG, "Loaded ${entries.size} callers")
+        } catch (e: Exception) {
+            Log.e(TAG, "Error loading callers: ${e.message}", e)
+        }
+    }
+
+    /**
+     * Find a known caller by number
+     */
+    @Synchronized
+    fun find(number: String): Entry? = entries[numberKey(number)]
+
+    /**
+     * Count a call from this caller (learns new callers)
+     * @return The caller's entry, or null for a number without digits
+     */
+    @Synchronized
+    fun recordCall(name: String?, number: String): Entry? {
+        val key = numberKey(number)
+        if (key.isEmpty()) return null
+        val old = entries[key]
+        val displayName = fitName(name?.takeIf { it.isNotBlank() } ?: old?.name ?: number)
+        val entry = Entry(
+            id = old?.id ?: nextId(),
+            name = displayName,
+            numberKey = key,
+            calls = (old?.calls ?: 0) + 1,
+            lastCallMs = System.currentTimeMillis()
+        )
+        entries[key] = entry
+        if (entries.size > MAX_STORED) {
+            ranked().lastOrNull()?.let { entries.remove(it.numberKey) }
+        }
+        save()
+        return entry
+    }
+
+    /**
+     * True if the entry is among the callers synced to the display
+     */
+    @Synchronized
+    fun isSyncable(entry: Entry): Boolean = ranked().take(MAX_SYNCED).any { it.id == entry.id }
+
+    /**
+     * Messages carrying the whole synced list (the first one resets the display's table)
+     * @return Messages and the IDs they carry
+     */
+    @Synchronized
+    fun syncMessages(): Pair<List<String>, Set<Int>> {
+        val synced = ranked().take(MAX_SYNCED)
+        if (synced.isEmpty()) return Pair(listOf(contactsMessage(emptyList(), reset = true)), emptySet())
+        val messages = synced.chunked(ENTRIES_PER_MESSAGE).mapIndexed { i, chunk -> contactsMessage(chunk, reset = i == 0) }
+        return Pair(messages, synced.map { it.id }.toSet())
+    }
+
+    /**
+     * Message adding one caller to the display's table
+     */
+    fun addMessage(entry: Entry): String = contactsMessage(listOf(entry), reset = false)
+
+    private fun contactsMessage(chunk: List<Entry>, reset: Boolean): String {
+        val message = HashMap<String, Any>()
+        message["type"] = "contacts"
+        if (reset) message["reset"] = true
+        message["c"] = chunk.map { listOf(it.id, it.name, numberHash(it.numberKey)) }
+        return gson.toJson(message)
+    }
+
+    private fun ranked(): List<Entry> =
+        entries.values.sortedWith(compareByDescending<Entry> { it.calls }.thenByDescending { it.lastCallMs })
+
+    private fun nextId(): Int {
+        val used = entries.values.map { it.id }.toSet()
+        return (1..0xFFFF).first { it !in used }
+    }
+
+    // Whole characters only: the display truncates by bytes
+    private fun fitName(name: String): String {
+        var fitted = name
+        while (fitted.toByteArray(Charsets.UTF_8).size > NAME_MAX) fitted = fitted.dropLast(1)
+        return fitted
+    }
+
+    private fun numberKey(number: String): String = number.filter { it in '0'..'9' }.takeLast(HASH_DIGITS)
+
+    private fun save() {
+        try {
+            prefs.edit().putString(KEY_ENTRIES, gson.toJson(entries.values.toList())).apply()
+        } catch (e: Exception) {
+            Log.e(TAG, "Error saving callers: ${e.message}", e)
+        }
+    }
+}
@@ -0,0 +1,131 @@
+package com.tnvsai.yatramate.ble
+
+import java.io.ByteArrayOutputStream
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Flight recorder log pulled from the display (firmware flight_recorder.h)
+ *
+ * The display records every raw BLE write it receives. A dump arrives as numbered
+ * notifications carrying the record stream; [Assembler] puts it back together and
+ * the stream is saved unchanged to flightrec-<time>.bin in the app's external
+ * files directory (adb pull /sdcard/Android/data/<package>/files/).
+ *
+ * Record: [length:2] [source] [flags] [index:4] [time ms:4] [crc:2] [reserved:2] [frame...]
+ */
+object FlightRecorderLog {
+    const val HEADER_LEN = 16
+    const val MAX_FRAME = 512
+    const val FLAG_BOOT = 0x01
+    const val FLAG_CONNECT = 0x02
+    private const val CHUNK_END = 0xFFFF
+
+    val COMMAND_DUMP = byteArrayOf('D'.code.toByte())
+    val COMMAND_CLEAR = byteArrayOf('C'.code.toByte())
+    val COMMAND_STOP = byteArrayOf('S'.code.toByte())
+
+    /**
+     * Replay the log on the display
+     * @param speed 1 = real time, N = N times faster, 0 = as fast as possible
+     */
+    fun replayCommand(speed: Int): ByteArray = byteArrayOf('P'.code.toByte(), speed.coerceIn(0, 255).toByte())
+
+    /**
+     * One logged write (or a boot/connect marker with an empty frame)
+     * @param source Stream of the characteristic written (0 = main characteristic)
+     */
+    class Record(
+        val index: Long,
+        val timeMs: Long,
+        val source: Int,
+        val flags: Int,
+        val frame: ByteArray,
+        val crcOk: Boolean
+    ) {
+        val isMarker: Boolean get() = (flags and (FLAG_BOOT or FLAG_CONNECT)) != 0
+    }
+
+    /**
+     * Collects dump notifications in order
+     */
+    class Assembler {
+        private val bytes = ByteArrayOutputStream()
+        private var nextChunk = 0
+
+        /** Chunks lost in transit (the saved stream has holes) */
+        var missingChunks = 0
+            private set
+        /** Records the display sent, from the end-of-dump notification */
+        var recordsReported = 0L
+            private set
+        /** Records the display could not stage (flash writer fell behind) */
+        var droppedReported = 0L
+            private set
+
+        /**
+         * @return true once the end-of-dump notification has arrived
+         */
+        fun add(value: ByteArray): Boolean {
+            if (value.size < 2) return false
+            val chunk = (value[0].toInt() and 0xFF) or ((value[1].toInt() and 0xFF) shl 8)
+            if (chunk == CHUNK_END) {
+                if (value.size >= 10) {
+                    val buf = ByteBuffer.wrap(value, 2, 8).order(ByteOrder.LITTLE_ENDIAN)
+                    recordsReported = buf.int.toLong() and 0xFFFFFFFFL
+                    droppedReported = buf.int.toLong() and 0xFFFFFFFFL
+                }
+                return true
+            }
+            if (chunk != nextChunk) missingChunks += (chunk - nextChunk + CHUNK_END) % CHUNK_END
+            nextChunk = (chunk + 1) % CHUNK_END
+            bytes.write(value, 2, value.size - 2)
+            return false
+        }
+
+        fun bytes(): ByteArray = bytes.toByteArray()
+    }
+
+    /**
+     * Split a dumped record stream into records (stops at the first malformed header)
+     */
+    fun parse(stream: ByteArray): List<Record> {
+        val records = mutableListOf<Record>()
+        val buf = ByteBuffer.wrap(stream).order(ByteOrder.LITTLE_ENDIAN)
+        while (buf.remaining() >= HEADER_LEN) {
+            val start = buf.position()
+            val length = buf.short.toInt() and 0xFFFF
+            if (length > MAX_FRAME || buf.remaining() < HEADER_LEN - 2 + length) break
+            val source = buf.get().toInt() and 0xFF
+            val flags = buf.get().toInt() and 0xFF
+            val index = buf.int.toLong() and 0xFFFFFFFFL
+            val timeMs = buf.int.toLong() and 0xFFFFFFFFL
+            val crc = buf.short.toInt() and 0xFFFF
+            buf.short   // Reserved
+            val frame = ByteArray(length).also { buf.get(it) }
+
+            // CRC over the header with its crc field zeroed, then the frame
+            val header = stream.copyOfRange(start, start + HEADER_LEN)
+            header[12] = 0
+            header[13] = 0
+            val crcOk = crc16(crc16(0xFFFF, header), frame) == crc
+            records.add(Record(index, timeMs, source, flags, frame, crcOk))
+        }
+        return records
+    }
+
+    /**
+     * CRC-16/CCITT-FALSE (poly 0x1021), as computed by the firmware
+     */
+    private fun crc16(initial: Int, data: ByteArray): Int {
+        var crc = initial
+        for (b in data) {
+            crc = crc xor ((b.toInt() and 0xFF) shl 8)
+            repeat(8) {
+                crc = if ((crc and 0x8000) != 0) (crc shl 1) xor 0x1021 else crc shl 1
+                crc = crc and 0xFFFF
+            }
+        }
+        return crc
+    }
+}
@@ -0,0 +1,178 @@
+package com.tnvsai.yatramate.ble
+
+/**
+ * Binary framing shared with the ESP32 firmware (ble_frame.h)
+ *
+ * Frame: [0xA5] [flags:4 | stream:4] [seq lo] [seq hi] [payload...]
+ * Ack:   [0xA5] ['A'] [n] then n x [stream] [last seq lo] [last seq hi] [received] [dropped]
+ *
+ * A bare JSON payload (no header) is still accepted by the firmware as a legacy frame.
+ * Payloads that don't fit one write are split into START / CONT... / END
+ * fragments with consecutive sequence numbers.
+ *
+ * Batch (stream 4): one message carrying several others, each sequenced on its own stream:
+ *   n x [stream] [seq lo] [seq hi] [len lo] [len hi] [payload...]
+ * The display applies them in order and renders once.
+ */
+object FrameProtocol {
+    const val MAGIC: Byte = 0xA5.toByte()
+    const val HEADER_LEN = 4
+    private const val ACK_TYPE: Byte = 'A'.code.toByte()
+    private const val ACK_ENTRY_LEN = 5
+
+    // Streams (one sequence space each)
+    const val STREAM_LEGACY = 0     // Unframed JSON (manual sends)
+    const val STREAM_NAV = 1
+    const val STREAM_CALL = 2
+    const val STREAM_NOTIFY = 3
+    const val STREAM_BATCH = 4
+    const val STREAM_COUNT = 5
+    const val SUB_HEADER_LEN = 5
+
+    // Fragment flags
+    const val FLAG_START = 0x1
+    const val FLAG_CONT = 0x2
+    const val FLAG_END = 0x4
+
+    const val DEFAULT_MTU = 23
+    const val PREFERRED_MTU = 247
+    private const val ATT_WRITE_OVERHEAD = 3      // Opcode + handle
+    private const val L2CAP_OVERHEAD = 4
+    const val REASSEMBLY_MAX = 1024               // Firmware BLE_FRAME_REASSEMBLY_MAX
+
+    /**
+     * Acknowledgement for one stream
+     * @param lastSeq Newest frame the display accepted
+     * @param received Frames accepted since the previous ack
+     * @param dropped Frames rejected as stale or duplicate since the previous ack
+     */
+    data class Ack(val stream: Int, val lastSeq: Int, val received: Int, val dropped: Int)
+    
+    /**
+     * One message inside a batch (its sequence number belongs to its own stream)
+     */
+    class SubMessage(val stream: Int, val seq: Int, val payload: ByteArray)
+
+    /**
+     * Prefix a payload with the frame header
+     */
+    fun encode(stream: Int, seq: Int, payload: ByteArray, flags: Int = 0): ByteArray {
+        val frame = ByteArray(HEADER_LEN + payload.size)
+        frame[0] = MAGIC
+        frame[1] = (((flags and 0x0F) shl 4) or (stream and 0x0F)).toByte()
+        frame[2] = (seq and 0xFF).toByte()
+        frame[3] = ((seq shr 8) and 0xFF).toByte()
+        System.arraycopy(payload, 0, frame, HEADER_LEN, payload.size)
+        return frame
+    }
+
+    /**
+     * Sequence number from a frame header
+     */
+    fun seqOf(frame: ByteArray): Int = (frame[2].toInt() and 0xFF) or ((frame[3].toInt() and 0xFF) shl 8)
+
+    /**
+     * Fragment flags from a frame header (0 for an unfragmented frame)
+     */
+    fun flagsOf(frame: ByteArray): Int = (frame[1].toInt() and 0xFF) shr 4
+
+    /**
+     * Pack messages into batch payloads, in order, each within the display's reassembly limit
+     * Every message must fit a batch on its own (payload + SUB_HEADER_LEN <= REASSEMBLY_MAX).
+     */
+    fun packBatches(messages: List<SubMessage>): List<ByteArray> {
+        val batches = mutableListOf<ByteArray>()
+        var current = java.io.ByteArrayOutputStream()
+        for (message in messages) {
+            if (current.size() + SUB_HEADER_LEN + message.payload.size > REASSEMBLY_MAX) {
+                batches.add(current.toByteArray())
+                current = java.io.ByteArrayOutputStream()
+            }
+            current.write(message.stream and 0x0F)
+            current.write(message.seq and 0xFF)
+            current.write((message.seq shr 8) and 0xFF)
+            current.write(message.payload.size and 0xFF)
+            current.write((message.payload.size shr 8) and 0xFF)
+            current.write(message.payload)
+        }
+        if (current.size() > 0) batches.add(current.toByteArray())
+        return batches
+    }
+    
+    /**
+     * Payload bytes one write can carry after the ATT and frame headers
+     */
+    fun chunkSize(mtu: Int): Int = mtu - ATT_WRITE_OVERHEAD - HEADER_LEN
+
+    /**
+     * Number of writes (sequence numbers) a payload needs at this MTU
+     */
+    fun fragmentCount(payloadSize: Int, mtu: Int): Int {
+        val chunk = chunkSize(mtu)
+        return if (payloadSize <= chunk) 1 else (payloadSize + chunk - 1) / chunk
+    }
+
+    /**
+     * Split a payload into frames; a payload that fits is sent as one unflagged frame
+     * @param firstSeq Sequence number of the first fragment (the rest follow consecutively)
+     */
+    fun fragment(stream: Int, firstSeq: Int, payload: ByteArray, mtu: Int): List<ByteArray> {
+        val chunk = chunkSize(mtu)
+        if (payload.size <= chunk) return listOf(encode(stream, firstSeq, payload))
+
+        val count = fragmentCount(payload.size, mtu)
+        return (0 until count).map { i ->
+            val from = i * chunk
+            val to = minOf(from + chunk, payload.size)
+            val flags = when (i) {
+                0 -> FLAG_START
+                count - 1 -> FLAG_END
+                else -> FLAG_CONT
+            }
+            encode(stream, (firstSeq + i) and 0xFFFF, payload.copyOfRange(from, to), flags)
+        }
+    }
+
+    /**
+     * Effective throughput of one payload at the common MTUs
+     * One acknowledged write per connection interval (write with response
+     * completes in the next event), so time = writes x interval.
+     * @return One line per MTU: writes, bytes on air, efficiency and bytes/s
+     */
+    fun throughputReport(payloadSize: Int, connectionIntervalMs: Int = 30): List<String> {
+        return listOf(DEFAULT_MTU, 185, PREFERRED_MTU).map { mtu ->
+            val writes = fragmentCount(payloadSize, mtu)
+            val onAir = payloadSize + writes * (HEADER_LEN + ATT_WRITE_OVERHEAD + L2CAP_OVERHEAD)
+            val efficiency = payloadSize * 100 / onAir
+            val bytesPerSecond = payloadSize * 1000L / (writes * connectionIntervalMs)
+            "MTU $mtu: $writes write(s), $onAir B on air, $efficiency% payload, ~$bytesPerSecond B/s"
+        }
+    }
+
+    /**
+     * Decode an acknowledgement notification
+     * @return The per-stream acks, or null if the value is not an ack
+     */
+    fun decodeAcks(value: ByteArray?): List<Ack>? {
+        if (value == null || value.size < 3 || value[0] != MAGIC || value[1] != ACK_TYPE) return null
+        val count = value[2].toInt() and 0xFF
+        if (value.size < 3 + count * ACK_ENTRY_LEN) return null
+
+        return (0 until count).map { i ->
+            val at = 3 + i * ACK_ENTRY_LEN
+            Ack(
+                stream = value[at].toInt() and 0xFF,
+                lastSeq = (value[at + 1].toInt() and 0xFF) or ((value[at + 2].toInt() and 0xFF) shl 8),
+                received = value[at + 3].toInt() and 0xFF,
+                dropped = value[at + 4].toInt() and 0xFF
+            )
+        }
+    }
+
+    /**
+     * Wrap-safe "a is at or before b" for 16-bit sequence numbers
+     */
+    fun seqAtOrBefore(a: Int, b: Int): Boolean {
+        return ((b - a) and 0xFFFF) < 0x8000
+    }
+}
@@ -0,0 +1,77 @@
+package com.tnvsai.yatramate.ble
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Performance record notified by the display (firmware telemetry.h)
+ *
+ * Counters cover one reporting period; memory and RSSI are sampled at its end.
+ * Records are appended to telemetry.csv in the app's external files directory
+ * (adb pull /sdcard/Android/data/<package>/files/telemetry.csv).
+ */
+data class TelemetryRecord(
+    val flags: Int,
+    val periodMs: Int,
+    val uptimeMs: Long,
+    val frames: Int,
+    val handlerAvgUs: Int,
+    val handlerMaxUs: Int,
+    val flushBytes: Long,
+    val ackBacklog: Int,
+    val droppedFrames: Int,
+    val lvglUsed: Long,
+    val lvglLargestFree: Long,
+    val heapInternalFree: Long,
+    val rssi: Int
+) {
+    val navScreen: Boolean get() = (flags and FLAG_NAV_SCREEN) != 0
+    val callScreen: Boolean get() = (flags and FLAG_CALL) != 0
+
+    /**
+     * Frames per second over the period
+     */
+    val fps: Float get() = if (periodMs > 0) frames * 1000f / periodMs else 0f
+
+    fun toCsvRow(receivedAtMs: Long): String = listOf(
+        receivedAtMs, uptimeMs, periodMs, flags, frames, handlerAvgUs, handlerMaxUs, flushBytes,
+        ackBacklog, droppedFrames, lvglUsed, lvglLargestFree, heapInternalFree, rssi
+    ).joinToString(",")
+
+    companion object {
+        const val VERSION = 1
+        const val LENGTH = 34
+        const val FLAG_NAV_SCREEN = 0x01
+        const val FLAG_CALL = 0x02
+
+        const val CSV_HEADER = "received_ms,uptime_ms,period_ms,flags,frames,handler_avg_us,handler_max_us," +
+            "flush_bytes,ack_backlog,dropped_frames,lvgl_used,lvgl_largest_free,heap_internal_free,rssi"
+
+        /**
+         * Decode a telemetry notification
+         * @return The record, or null for a short value or an unknown version
+         */
+        fun decode(value: ByteArray?): TelemetryRecord? {
+            if (value == null || value.size < LENGTH || value[0].toInt() != VERSION) return null
+            val buf = ByteBuffer.wrap(value).order(ByteOrder.LITTLE_ENDIAN)
+            buf.get()   // Version
+            val flags = buf.get().toInt() and 0xFF
+            val periodMs = buf.short.toInt() and 0xFFFF
+            val uptimeMs = buf.int.toLong() and 0xFFFFFFFFL
+            val frames = buf.short.toInt() and 0xFFFF
+            val handlerAvgUs = buf.short.toInt() and 0xFFFF
+            val handlerMaxUs = buf.short.toInt() and 0xFFFF
+            val flushBytes = buf.int.toLong() and 0xFFFFFFFFL
+            val ackBacklog = buf.get().toInt() and 0xFF
+            val droppedFrames = buf.get().toInt() and 0xFF
+            val lvglUsed = buf.int.toLong() and 0xFFFFFFFFL
+            val lvglLargestFree = buf.int.toLong() and 0xFFFFFFFFL
+            val heapInternalFree = buf.int.toLong() and 0xFFFFFFFFL
+            val rssi = buf.get().toInt()   // Signed dBm, 0 = not read yet
+            return TelemetryRecord(
+                flags, periodMs, uptimeMs, frames, handlerAvgUs, handlerMaxUs, flushBytes,
+                ackBacklog, droppedFrames, lvglUsed, lvglLargestFree, heapInternalFree, rssi
+            )
+        }
+    }
+}
@@ -7,6 +7,7 @@ import android.bluetooth.BluetoothDevice
 import android.bluetooth.BluetoothGatt
 import android.bluetooth.BluetoothGattCallback
 import android.bluetooth.BluetoothGattCharacteristic
+import android.bluetooth.BluetoothGattDescriptor
 import android.bluetooth.BluetoothGattService
 import android.bluetooth.BluetoothManager
 import android.bluetooth.BluetoothProfile
@@ -25,20 +26,27 @@ import com.tnvsai.yatramate.model.Direction
 import com.tnvsai.yatramate.model.NavigationData
 import com.tnvsai.yatramate.model.PhoneCallData
 import com.tnvsai.yatramate.model.CallState
+import com.tnvsai.yatramate.notification.NavigationNotificationEntry
+import com.tnvsai.yatramate.notification.NotificationHistoryManager
 import com.tnvsai.yatramate.notification.NotificationListenerService
 import com.google.gson.Gson
 import com.tnvsai.yatramate.config.ConfigManager
 import com.tnvsai.yatramate.mcu.DataTransformer
+import com.tnvsai.yatramate.mcu.PhraseDictionary
+import com.tnvsai.yatramate.utils.ETACalculator
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.flow.MutableStateFlow
 import kotlinx.coroutines.flow.StateFlow
 import kotlinx.coroutines.flow.asStateFlow
 import kotlinx.coroutines.launch
+import java.io.File
 import java.text.SimpleDateFormat
 import java.util.Date
 import java.util.Locale
 import java.util.UUID
+import java.util.concurrent.Executors
+import kotlin.math.abs
 
 /**
  * Working BLE Service based on proven SimpleBLEService
@@ -54,7 +62,48 @@ class WorkingBLEService(
         private const val ESP32_DEVICE_NAME = "ESP32_BLE"
         private const val SERVICE_UUID = "12345678-1234-1234-1234-1234567890ab"
         private const val CHARACTERISTIC_UUID = "abcd1234-5678-90ab-cdef-1234567890ab"
+        // Per-stream write characteristics (firmware routes by handle)
+        private const val NAV_CHARACTERISTIC_UUID = "abcd1235-5678-90ab-cdef-1234567890ab"
+        private const val CALL_CHARACTERISTIC_UUID = "abcd1236-5678-90ab-cdef-1234567890ab"
+        private const val NOTIFY_CHARACTERISTIC_UUID = "abcd1237-5678-90ab-cdef-1234567890ab"
+        private const val TELEMETRY_CHARACTERISTIC_UUID = "abcd1238-5678-90ab-cdef-1234567890ab"
+        private const val TELEMETRY_CSV_FILE = "telemetry.csv"
+        private const val FLIGHTREC_CHARACTERISTIC_UUID = "abcd1239-5678-90ab-cdef-1234567890ab"
+        // Read on connect: [phrase dictionary version] (absent on older firmware)
+        private const val CAPABILITIES_CHARACTERISTIC_UUID = "abcd123a-5678-90ab-cdef-1234567890ab"
         private const val SCAN_TIMEOUT = 10000L
+        // The display counts distance down on its own between updates, so a
+        // distance-only decrease is sent at most this often...
+        private const val DISTANCE_ONLY_MIN_INTERVAL_MS = 5000L
+        // ...unless the maneuver is this close (keeps the < 100 m alert accurate)
+        private const val DISTANCE_ALWAYS_SEND_M = 100
+        // The display also counts the ETA down; a new ETA within this much of
+        // that countdown is not worth a message
+        private const val ETA_RESYNC_TOLERANCE_S = 90
+        // Navigation frames the display may have outstanding before we hold back
+        // (calls are never held back)
+        private const val MAX_NAV_IN_FLIGHT = 8
+        // Unacked frames older than this are treated as lost (or the firmware doesn't ack)
+        private const val IN_FLIGHT_TIMEOUT_MS = 2000L
+        private const val CCCD_UUID = "00002902-0000-1000-8000-00805f9b34fb"
+        // Notification frames allowed to wait for the link; more notifications are dropped
+        private const val MAX_NOTIFY_QUEUED_FRAMES = 16
+        // A call or batch write that could not be started is retried after this
+        private const val WRITE_RETRY_DELAY_MS = 100L
+        // Write queues are drained in this order
+        private val WRITE_PRIORITY = intArrayOf(
+            FrameProtocol.STREAM_CALL,
+            FrameProtocol.STREAM_BATCH,
+            FrameProtocol.STREAM_NAV,
+            FrameProtocol.STREAM_LEGACY,
+            FrameProtocol.STREAM_NOTIFY
+        )
+        // Streams whose queued frames hold back the pending batch
+        private val BATCH_ORDERED_STREAMS = intArrayOf(
+            FrameProtocol.STREAM_CALL,
+            FrameProtocol.STREAM_BATCH,
+            FrameProtocol.STREAM_NAV
+        )
     }
     
     private val bluetoothManager = context.getSystemService(Context.BLUETOOTH_SERVICE) as BluetoothManager
@@ -63,6 +112,9 @@ class WorkingBLEService(
     
     private var bluetoothGatt: BluetoothGatt? = null
     private var navigationCharacteristic: BluetoothGattCharacteristic? = null
+    private var telemetryCharacteristic: BluetoothGattCharacteristic? = null
+    private var flightRecorderCharacteristic: BluetoothGattCharacteristic? = null
+    private var capabilitiesCharacteristic: BluetoothGattCharacteristic? = null
     private var isScanning = false
     private var isConnected = false
     
@@ -72,6 +124,7 @@ class WorkingBLEService(
     // Track what was last successfully sent to MCU (for change detection)
     private var lastSentNavigationData: NavigationData? = null
     private var lastSentPhoneCallData: PhoneCallData? = null
+    private var lastNavigationSendMs = 0L
     private val handler = Handler(Looper.getMainLooper())
     private val gson = Gson()
     
@@ -96,6 +149,64 @@ class WorkingBLEService(
     private var lastMessageTimestamp: Long? = null
     private var messagesSentSuccess = 0
     private var messagesSentFailed = 0
+    private var navigationUpdatesReceived = 0
+    private var distanceOnlySkipped = 0
+    private var etaOnlySkipped = 0
+    private var navigationMessagesSent = 0
+    private var navigationRateStartMs = 0L
+    
+    // Frame sequencing and acknowledgements (see FrameProtocol)
+    private data class InFlight(val seq: Int, val sentAtMs: Long)
+    private val nextSeq = IntArray(FrameProtocol.STREAM_COUNT)
+    private val inFlight = Array(FrameProtocol.STREAM_COUNT) { ArrayDeque<InFlight>() }
+    private var smoothedRttMs = 0L
+    private var framesDroppedByDisplay = 0
+    private var navigationHeldBack = false
+    // Releases held-back navigation once the oldest unacked frame times out (acks may never come)
+    private val navigationRelease = Runnable { releaseHeldNavigation() }
+    
+    // GATT allows one outstanding write: frames (and fragments) go out one per onCharacteristicWrite.
+    // Each stream queues separately and WRITE_PRIORITY picks the next one, so a call
+    // waits for at most one write however many notifications are queued.
+    private val writeLock = Any()
+    private val writeQueues = Array(FrameProtocol.STREAM_COUNT) { ArrayDeque<ByteArray>() }
+    private var writeInProgress = false
+    // Write characteristic per stream (the legacy one where the firmware has no dedicated one)
+    private val streamCharacteristics = arrayOfNulls<BluetoothGattCharacteristic>(FrameProtocol.STREAM_COUNT)
+    // Nav/call messages sent while a write is outstanding go out together as one batch (guarded by writeLock)
+    private val pendingBatch = mutableListOf<FrameProtocol.SubMessage>()
+    private var notificationsDropped = 0
+    private var bleWrites = 0
+    private var batchesSent = 0
+    private var messagesBatched = 0
+    private var writeStartedAtMs = 0L
+    private var radioBusyMs = 0L           // Sum of write-to-callback times (link busy with our data)
+    private var mtu = FrameProtocol.DEFAULT_MTU
+    
+    /**
+     * Subscribe to the display's telemetry on the next connection and log it to telemetry.csv
+     * (the display samples nothing while nobody is subscribed)
+     */
+    var telemetryLoggingEnabled = false
+    private val _telemetry = MutableStateFlow<TelemetryRecord?>(null)
+    val telemetry: StateFlow<TelemetryRecord?> = _telemetry.asStateFlow()
+    private val telemetryWriter = Executors.newSingleThreadExecutor()
+    
+    // Flight recorder: a command waits for the link like any write (guarded by writeLock)
+    private var recorderCommand: ByteArray? = null
+    private var flightRecorderDump: FlightRecorderLog.Assembler? = null
+    private val _flightRecorderFile = MutableStateFlow<File?>(null)
+    /** Latest dump saved from the display's flight recorder */
+    val flightRecorderFile: StateFlow<File?> = _flightRecorderFile.asStateFlow()
+    
+    // Caller directory: IDs the display has acknowledged on this connection, and IDs
+    // waiting for the ack of the call frame that carries them (both guarded by syncedContactIds)
+    private val callerDirectory = CallerDirectory(context)
+    private val syncedContactIds = mutableSetOf<Int>()
+    private val pendingContactIds = mutableMapOf<Int, Set<Int>>()   // Last seq of a directory send -> IDs
+    private var callFramesSent = 0
+    private var callFrameBytes = 0L
+    private var callFrameBytesWithoutIds = 0L   // What the same frames cost with name and number
     
     private val _transmissionStats = MutableStateFlow(TransmissionStats())
     val transmissionStats: StateFlow<TransmissionStats> = _transmissionStats.asStateFlow()
@@ -116,7 +227,16 @@ class WorkingBLEService(
         val totalSent: Int = 0,
         val sessionSent: Int = 0,
         val successRate: Float = 0f,
-        val lastMessageTime: String? = null
+        val lastMessageTime: String? = null,
+        val distanceOnlySkipped: Int = 0,
+        val etaOnlySkipped: Int = 0,
+        val navigationMessagesPerMinute: Float = 0f,
+        val ackRttMs: Long = 0,
+        val framesDroppedByDisplay: Int = 0,
+        val bleWrites: Int = 0,
+        val messagesBatched: Int = 0,
+        val radioBusyMs: Long = 0,
+        val notificationsDropped: Int = 0
     )
     
     data class ConnectionHistoryEntry(
@@ -162,6 +282,7 @@ class WorkingBLEService(
                     if (status == BluetoothGatt.GATT_SUCCESS) {
                         Log.i(TAG, "✅ GATT CONNECTION SUCCESSFUL!")
                         isConnected = true
+                        resetFrameState()
                         bluetoothGatt = gatt
                         
                         val deviceName = gatt.device.name ?: "ESP32_BLE"
@@ -176,9 +297,12 @@ class WorkingBLEService(
                         // Add to connection history
                         addConnectionHistory(deviceName, deviceAddress, true)
                         
-                        Log.i(TAG, "Starting service discovery...")
-                        val discoveryStarted = gatt.discoverServices()
-                        Log.i(TAG, "Service discovery started: $discoveryStarted")
+                        // Larger MTU first (service discovery follows in onMtuChanged)
+                        mtu = FrameProtocol.DEFAULT_MTU
+                        if (!gatt.requestMtu(FrameProtocol.PREFERRED_MTU)) {
+                            Log.w(TAG, "MTU request failed - staying at $mtu")
+                            startServiceDiscovery(gatt)
+                        }
                     } else {
                         Log.e(TAG, "❌ GATT connection failed with status: $status")
                         isConnected = false
@@ -196,6 +320,11 @@ class WorkingBLEService(
                     isConnected = false
                     bluetoothGatt = null
                     navigationCharacteristic = null
+                    telemetryCharacteristic = null
+                    flightRecorderCharacteristic = null
+                    capabilitiesCharacteristic = null
+                    flightRecorderDump = null
+                    streamCharacteristics.fill(null)
                     _connectionStatus.value = BLEConnectionStatus(
                         isConnected = false,
                         deviceName = null,
@@ -230,8 +359,31 @@ class WorkingBLEService(
                         Log.i(TAG, "Supports WRITE: ${(properties and BluetoothGattCharacteristic.PROPERTY_WRITE) != 0}")
                         Log.i(TAG, "🎉 READY TO SEND DATA!")
                         
-                        // Send latest data if available
-                        sendLatestDataIfConnected()
+                        // Dedicated stream characteristics (older firmware: everything on this one)
+                        streamCharacteristics.fill(navigationCharacteristic)
+                        listOf(
+                            FrameProtocol.STREAM_NAV to NAV_CHARACTERISTIC_UUID,
+                            FrameProtocol.STREAM_CALL to CALL_CHARACTERISTIC_UUID,
+                            FrameProtocol.STREAM_NOTIFY to NOTIFY_CHARACTERISTIC_UUID
+                        ).forEach { (stream, uuid) ->
+                            service.getCharacteristic(UUID.fromString(uuid))?.let {
+                                it.writeType = BluetoothGattCharacteristic.WRITE_TYPE_NO_RESPONSE
+                                streamCharacteristics[stream] = it
+                            }
+                        }
+                        Log.i(TAG, "Stream characteristics: ${streamCharacteristics.count { it != null && it != navigationCharacteristic }} dedicated")
+                        
+                        telemetryCharacteristic = service.getCharacteristic(UUID.fromString(TELEMETRY_CHARACTERISTIC_UUID))
+                        flightRecorderCharacteristic = service.getCharacteristic(UUID.fromString(FLIGHTREC_CHARACTERISTIC_UUID))
+                        capabilitiesCharacteristic = service.getCharacteristic(UUID.fromString(CAPABILITIES_CHARACTERISTIC_UUID))
+                        
+                        // Plain maneuver text until the display reports the same phrase dictionary
+                        PhraseDictionary.enabled = false
+                        val capabilities = capabilitiesCharacteristic
+                        if (capabilities == null || !gatt.readCharacteristic(capabilities)) {
+                            Log.i(TAG, "No display capabilities - phrase dictionary off")
+                            subscribeToAcks(gatt)
+                        }
                     } else {
                         Log.e(TAG, "❌ Target characteristic not found")
                     }
@@ -247,12 +399,74 @@ class WorkingBLEService(
             }
         }
         
+        override fun onMtuChanged(gatt: BluetoothGatt, mtu: Int, status: Int) {
+            if (status == BluetoothGatt.GATT_SUCCESS) {
+                this@WorkingBLEService.mtu = mtu
+            }
+            val resolvedMtu = this@WorkingBLEService.mtu
+            Log.i(TAG, "MTU negotiated: $resolvedMtu (status $status), " +
+                    "${FrameProtocol.chunkSize(resolvedMtu)} payload bytes per write")
+            FrameProtocol.throughputReport(transformer.getMaxPayloadSize()).forEach { Log.i(TAG, "Throughput: $it") }
+            startServiceDiscovery(gatt)
+        }
+        
+        override fun onDescriptorWrite(gatt: BluetoothGatt, descriptor: BluetoothGattDescriptor, status: Int) {
+            val telemetry = telemetryCharacteristic
+            val recorder = flightRecorderCharacteristic
+            // One GATT operation at a time: acks, then telemetry, then the flight recorder
+            when (descriptor.characteristic) {
+                recorder -> Log.i(TAG, "Flight recorder notifications enabled: ${status == BluetoothGatt.GATT_SUCCESS}")
+                telemetry -> {
+                    Log.i(TAG, "Telemetry notifications enabled: ${status == BluetoothGatt.GATT_SUCCESS}")
+                    if (recorder != null && enableNotifications(gatt, recorder)) return
+                }
+                else -> {
+                    Log.i(TAG, "Ack notifications enabled: ${status == BluetoothGatt.GATT_SUCCESS}")
+                    if (telemetryLoggingEnabled && telemetry != null && enableNotifications(gatt, telemetry)) return
+                    if (recorder != null && enableNotifications(gatt, recorder)) return
+                }
+            }
+            sendLatestDataIfConnected()
+        }
+        
+        @Deprecated("Deprecated in Android 13; kept for older API levels")
+        override fun onCharacteristicRead(gatt: BluetoothGatt, characteristic: BluetoothGattCharacteristic, status: Int) {
+            if (characteristic != capabilitiesCharacteristic) return
+            val version = characteristic.value?.firstOrNull()?.toInt()?.and(0xFF) ?: 0
+            PhraseDictionary.enabled = status == BluetoothGatt.GATT_SUCCESS && version == PhraseDictionary.VERSION
+            Log.i(TAG, "Display phrase dictionary v$version (app v${PhraseDictionary.VERSION}) - " +
+                       "maneuver tokens ${if (PhraseDictionary.enabled) "on" else "off"}")
+            subscribeToAcks(gatt)
+        }
+        
+        @Deprecated("Deprecated in Android 13; kept for older API levels")
+        override fun onCharacteristicChanged(gatt: BluetoothGatt, characteristic: BluetoothGattCharacteristic) {
+            if (characteristic == telemetryCharacteristic) {
+                val record = TelemetryRecord.decode(characteristic.value) ?: return
+                handler.post { handleTelemetry(record) }
+                return
+            }
+            if (characteristic == flightRecorderCharacteristic) {
+                val chunk = characteristic.value?.copyOf() ?: return   // The next notification reuses the value
+                handler.post { handleFlightRecorderChunk(chunk) }
+                return
+            }
+            val acks = FrameProtocol.decodeAcks(characteristic.value) ?: return
+            handler.post { handleAcks(acks) }
+        }
+        
         override fun onCharacteristicWrite(gatt: BluetoothGatt, characteristic: BluetoothGattCharacteristic, status: Int) {
             if (status == BluetoothGatt.GATT_SUCCESS) {
                 Log.i(TAG, "✅ Data written successfully to ESP32!")
             } else {
                 Log.e(TAG, "❌ Failed to write data: $status")
             }
+            synchronized(writeLock) {
+                writeInProgress = false
+                radioBusyMs += System.currentTimeMillis() - writeStartedAtMs
+            }
+            flushPendingBatch()
+            writeNextQueued()
         }
     }
     
@@ -357,11 +571,33 @@ class WorkingBLEService(
             return
         }
         
+        navigationUpdatesReceived++
+        if (!forceSend && lastSentNavigationData != null && isEtaOnlyOnTrack(lastSentNavigationData!!, navigationData)) {
+            etaOnlySkipped++
+            Log.d(TAG, "⏭ Skipped ETA-only update (display counts down) - " +
+                    "$etaOnlySkipped/$navigationUpdatesReceived suppressed")
+            return
+        }
+        if (!forceSend && lastSentNavigationData != null && isDistanceOnlyCountdown(lastSentNavigationData!!, navigationData)) {
+            distanceOnlySkipped++
+            Log.d(TAG, "⏭ Skipped distance-only update (display extrapolates) - " +
+                    "$distanceOnlySkipped/$navigationUpdatesReceived suppressed")
+            return
+        }
+        
         if (!isConnected || navigationCharacteristic == null) {
             Log.w(TAG, "Not connected - storing for later send")
             return
         }
         
+        // Display is behind: keep only the latest data and send it when acks arrive
+        if (!forceSend && isNavigationBacklogged()) {
+            navigationHeldBack = true
+            scheduleNavigationRelease()
+            Log.w(TAG, "⏸ Holding navigation data - ${inFlight[FrameProtocol.STREAM_NAV].size} frames unacked")
+            return
+        }
+        
         // Add transmission log
         val timestamp = SimpleDateFormat("HH:mm:ss.SSS", Locale.getDefault()).format(Date())
         val logMessage = "[$timestamp] TX: dir=${navigationData.direction?.name}, dist=${navigationData.distance}, man=${navigationData.maneuver}"
@@ -375,26 +611,32 @@ class WorkingBLEService(
         try {
             // Use transformer to convert data to MCU-specific format
             val dataString = transformer.transformNavigation(navigationData)
-            val data = dataString.toByteArray()
+            val payload = dataString.toByteArray()
             
             // Validate payload size
-            if (data.size > transformer.getMaxPayloadSize()) {
-                Log.w(TAG, "Payload size ${data.size} exceeds max ${transformer.getMaxPayloadSize()}")
+            if (payload.size > transformer.getMaxPayloadSize()) {
+                Log.w(TAG, "Payload size ${payload.size} exceeds max ${transformer.getMaxPayloadSize()}")
             }
             
             Log.i(TAG, "=== BLE JSON DATA TRANSMISSION DEBUG ===")
             Log.i(TAG, "Original NavigationData: $navigationData")
             Log.i(TAG, "JSON data: $dataString")
-            Log.i(TAG, "Data bytes: ${data.contentToString()}")
-            Log.i(TAG, "Data length: ${data.size}")
+            Log.i(TAG, "Data length: ${payload.size}")
             
-            navigationCharacteristic?.value = data
-            val writeResult = bluetoothGatt?.writeCharacteristic(navigationCharacteristic)
+            val seq = sendFrame(FrameProtocol.STREAM_NAV, payload)
+            val writeResult = seq != null
             Log.i(TAG, "Write result: $writeResult")
             
-            if (writeResult == true) {
+            if (seq != null) {
                 Log.i(TAG, "✅ Data sent successfully!")
                 lastSentNavigationData = navigationData // Mark as sent
+                lastNavigationSendMs = System.currentTimeMillis()
+                trackInFlight(FrameProtocol.STREAM_NAV, seq)
+                if (navigationMessagesSent++ == 0) navigationRateStartMs = lastNavigationSendMs
+                Log.i(TAG, "Navigation rate: ${"%.1f".format(navigationMessagesPerMinute())} msg/min " +
+                        "($navigationMessagesSent sent, $distanceOnlySkipped distance-only and " +
+                        "$etaOnlySkipped ETA-only skipped of $navigationUpdatesReceived)")
+                Log.i(TAG, "Phrase dictionary: ${PhraseDictionary.recordSent(navigationData.maneuver ?: "")}")
                 updateStats(true)
                 
                 // Log to debug console (only after successful send)
@@ -454,33 +696,55 @@ class WorkingBLEService(
         }
         
         try {
+            // A caller the display already knows goes out as a contact ID
+            val contact = learnCaller(phoneCallData)
+            val contactId = contact?.id?.takeIf { synchronized(syncedContactIds) { it in syncedContactIds } } ?: 0
+            
             // Use transformer to convert data to MCU-specific format
-            val dataString = transformer.transformPhoneCall(phoneCallData)
-            val data = dataString.toByteArray()
+            val dataString = transformer.transformPhoneCall(phoneCallData.copy(contactId = contactId))
+            val payload = dataString.toByteArray()
             
             // Validate payload size
-            if (data.size > transformer.getMaxPayloadSize()) {
-                Log.w(TAG, "Payload size ${data.size} exceeds max ${transformer.getMaxPayloadSize()}")
+            if (payload.size > transformer.getMaxPayloadSize()) {
+                Log.w(TAG, "Payload size ${payload.size} exceeds max ${transformer.getMaxPayloadSize()}")
             }
             
+            // Frame size with and without the directory
+            val fullSize = if (contactId != 0) transformer.transformPhoneCall(phoneCallData).toByteArray().size else payload.size
+            callFramesSent++
+            callFrameBytes += payload.size
+            callFrameBytesWithoutIds += fullSize
+            Log.i(TAG, "Call frame: ${payload.size} B" + (if (contactId != 0) " by contact $contactId ($fullSize B with name and number)" else "") +
+                       "; $callFramesSent frames, $callFrameBytes B ($callFrameBytesWithoutIds B without the caller directory)")
+            
             Log.i(TAG, "✅ Sending changed phone call data")
             Log.i(TAG, "=== BLE PHONE CALL DATA TRANSMISSION DEBUG ===")
             Log.i(TAG, "Original PhoneCallData: $phoneCallData")
             Log.i(TAG, "JSON data: $dataString")
-            Log.i(TAG, "Data bytes: ${data.contentToString()}")
-            Log.i(TAG, "Data length: ${data.size}")
+            Log.i(TAG, "Data length: ${payload.size}")
             
-            navigationCharacteristic?.value = data
-            Log.i(TAG, "📡 PHONE CALL: About to write characteristic, value size: ${data.size} bytes")
             Log.i(TAG, "📡 PHONE CALL: JSON string being sent: $dataString")
-            val writeResult = bluetoothGatt?.writeCharacteristic(navigationCharacteristic)
+            val seq = sendFrame(FrameProtocol.STREAM_CALL, payload)
+            val writeResult = seq != null
             Log.i(TAG, "Write result: $writeResult")
             
-            if (writeResult == true) {
+            if (seq != null) {
                 Log.i(TAG, "✅ Phone call data sent successfully!")
                 lastSentPhoneCallData = phoneCallData // Mark as sent
+                trackInFlight(FrameProtocol.STREAM_CALL, seq)
                 updateStats(true)
                 
+                // A new frequent caller: the display learns it for the rest of this call
+                if (contact != null && contactId == 0 && callerDirectory.isSyncable(contact) && !isContactPending(contact.id)) {
+                    if (displayContactCount() < CallerDirectory.MAX_SYNCED) {
+                        sendCallerDirectory(listOf(callerDirectory.addMessage(contact)), setOf(contact.id), reset = false)
+                    } else {
+                        // The display's table is full (it never evicts): replace it with the current top callers
+                        val (messages, ids) = callerDirectory.syncMessages()
+                        sendCallerDirectory(messages, ids, reset = true)
+                    }
+                }
+                
                 // Log to debug console (only after successful send)
                 val debugMessage = "Phone: ${phoneCallData.callerName} - ${phoneCallData.callState.displayName}"
                 NotificationListenerService.debugLogCallback?.invoke(debugMessage)
@@ -512,11 +776,10 @@ class WorkingBLEService(
             Log.i(TAG, "Sending raw JSON to ESP32...")
             Log.i(TAG, "Data length: ${data.size} bytes")
             
-            navigationCharacteristic?.value = data
-            val writeResult = bluetoothGatt?.writeCharacteristic(navigationCharacteristic)
+            val writeResult = enqueueWrites(FrameProtocol.STREAM_LEGACY, listOf(data))
             Log.i(TAG, "Write result: $writeResult")
             
-            if (writeResult == true) {
+            if (writeResult) {
                 Log.i(TAG, "✅ Raw JSON data sent successfully!")
                 updateStats(true)
             } else {
@@ -529,6 +792,21 @@ class WorkingBLEService(
         }
     }
     
+    /**
+     * Send a generic notification (messages, banking, ...) on the notification stream
+     * Queued behind calls and navigation; dropped when the notification queue is full.
+     */
+    fun sendNotificationData(jsonString: String) {
+        if (!isConnected || navigationCharacteristic == null) {
+            Log.w(TAG, "Not connected - cannot send notification")
+            return
+        }
+        
+        val seq = sendFrame(FrameProtocol.STREAM_NOTIFY, jsonString.toByteArray())
+        Log.i(TAG, "Notification queued: seq=$seq (${jsonString.length} B)")
+        updateStats(seq != null)
+    }
+    
     private fun updateStats(success: Boolean) {
         totalMessagesSent++
         sessionMessagesSent++
@@ -539,7 +817,16 @@ class WorkingBLEService(
             totalSent = totalMessagesSent,
             sessionSent = sessionMessagesSent,
             successRate = if (totalMessagesSent > 0) (messagesSentSuccess.toFloat() / totalMessagesSent * 100) else 0f,
-            lastMessageTime = SimpleDateFormat("HH:mm:ss", Locale.getDefault()).format(Date(lastMessageTimestamp!!))
+            lastMessageTime = SimpleDateFormat("HH:mm:ss", Locale.getDefault()).format(Date(lastMessageTimestamp!!)),
+            distanceOnlySkipped = distanceOnlySkipped,
+            etaOnlySkipped = etaOnlySkipped,
+            navigationMessagesPerMinute = navigationMessagesPerMinute(),
+            ackRttMs = smoothedRttMs,
+            framesDroppedByDisplay = framesDroppedByDisplay,
+            bleWrites = bleWrites,
+            messagesBatched = messagesBatched,
+            radioBusyMs = radioBusyMs,
+            notificationsDropped = notificationsDropped
         )
     }
     
@@ -592,6 +879,15 @@ class WorkingBLEService(
             lastSentNavigationData = null
             lastSentPhoneCallData = null
             
+            // How the phrase dictionary does on the maneuvers seen so far
+            val maneuvers = NotificationHistoryManager.getHistoryByType("navigation")
+                .mapNotNull { (it as? NavigationNotificationEntry)?.maneuver }
+            PhraseDictionary.corpusReport(maneuvers).forEach { Log.i(TAG, it) }
+            
+            // Frequent callers first, so call frames can refer to them
+            val (messages, ids) = callerDirectory.syncMessages()
+            sendCallerDirectory(messages, ids, reset = true)
+            
             lastNavigationData?.let {
                 Log.i(TAG, "Sending latest navigation data")
                 sendNavigationData(it)
@@ -618,6 +914,12 @@ class WorkingBLEService(
         
         isConnected = false
         navigationCharacteristic = null
+        telemetryCharacteristic = null
+        flightRecorderCharacteristic = null
+        capabilitiesCharacteristic = null
+        flightRecorderDump = null
+        streamCharacteristics.fill(null)
+        resetFrameState()
         
         // CRITICAL FIX: Clear sent data so it will be re-sent on reconnection
         lastSentNavigationData = null
@@ -702,7 +1004,465 @@ class WorkingBLEService(
         return old.direction == new.direction &&
                old.distance == new.distance &&
                old.maneuver == new.maneuver &&
-               old.eta == new.eta
+               old.eta == new.eta &&
+               old.upcoming == new.upcoming
+    }
+    
+    /**
+     * Check if only the distance moved closer (same step, ETA unchanged) and the
+     * display can keep counting down on its own. Resends once the interval has
+     * passed or the maneuver is near.
+     */
+    private fun isDistanceOnlyCountdown(old: NavigationData, new: NavigationData): Boolean {
+        if (old.direction != new.direction || old.maneuver != new.maneuver || old.upcoming != new.upcoming ||
+            !isEtaOnTrack(old, new)) {
+            return false
+        }
+        val oldMeters = extractDistanceInMeters(old.distance)
+        val newMeters = extractDistanceInMeters(new.distance)
+        if (newMeters <= DISTANCE_ALWAYS_SEND_M || newMeters >= oldMeters) {
+            return false
+        }
+        return System.currentTimeMillis() - lastNavigationSendMs < DISTANCE_ONLY_MIN_INTERVAL_MS
+    }
+    
+    /**
+     * Check if only the ETA changed and it still matches the display's local countdown
+     */
+    private fun isEtaOnlyOnTrack(old: NavigationData, new: NavigationData): Boolean {
+        return old.direction == new.direction &&
+               old.distance == new.distance &&
+               old.maneuver == new.maneuver &&
+               old.upcoming == new.upcoming &&
+               isEtaOnTrack(old, new)
+    }
+    
+    /**
+     * Check if the new ETA agrees with what the display shows by counting down
+     * the last structured ETA it received
+     */
+    private fun isEtaOnTrack(old: NavigationData, new: NavigationData): Boolean {
+        if (old.eta == new.eta) return true
+        val sentSeconds = ETACalculator.parseETAToSeconds(old.eta) ?: return false
+        val newSeconds = ETACalculator.parseETAToSeconds(new.eta) ?: return false
+        val elapsedSeconds = ((System.currentTimeMillis() - lastNavigationSendMs) / 1000).toInt()
+        val projected = (sentSeconds - elapsedSeconds).coerceAtLeast(0)
+        return abs(newSeconds - projected) <= ETA_RESYNC_TOLERANCE_S
+    }
+    
+    /**
+     * Enable notifications on a characteristic (frame acks, telemetry)
+     * @return true if the CCCD write was started (onDescriptorWrite follows)
+     */
+    @SuppressLint("MissingPermission")
+    private fun enableNotifications(gatt: BluetoothGatt, characteristic: BluetoothGattCharacteristic): Boolean {
+        if ((characteristic.properties and BluetoothGattCharacteristic.PROPERTY_NOTIFY) == 0) return false
+        val descriptor = characteristic.getDescriptor(UUID.fromString(CCCD_UUID)) ?: return false
+        gatt.setCharacteristicNotification(characteristic, true)
+        descriptor.value = BluetoothGattDescriptor.ENABLE_NOTIFICATION_VALUE
+        return gatt.writeDescriptor(descriptor)
+    }
+    
+    /**
+     * Subscribe to frame acks; latest data goes out once that (and the rest of the subscriptions) completes
+     */
+    private fun subscribeToAcks(gatt: BluetoothGatt) {
+        val characteristic = navigationCharacteristic ?: return
+        if (!enableNotifications(gatt, characteristic)) {
+            sendLatestDataIfConnected()
+        }
+    }
+    
+    @SuppressLint("MissingPermission")
+    private fun startServiceDiscovery(gatt: BluetoothGatt) {
+        Log.i(TAG, "Starting service discovery...")
+        val discoveryStarted = gatt.discoverServices()
+        Log.i(TAG, "Service discovery started: $discoveryStarted")
+    }
+    
+    /**
+     * Frame a payload (fragmenting it to the MTU) and queue it for writing
+     * While a write is outstanding the payload is held for the next batch instead.
+     * @return Sequence number of the last frame, or null if nothing could be sent
+     */
+    private fun sendFrame(stream: Int, payload: ByteArray): Int? {
+        if (payload.size > FrameProtocol.REASSEMBLY_MAX) {
+            Log.e(TAG, "❌ Payload ${payload.size} B exceeds display reassembly limit ${FrameProtocol.REASSEMBLY_MAX} B")
+            return null
+        }
+        val batchable = stream == FrameProtocol.STREAM_NAV || stream == FrameProtocol.STREAM_CALL
+        if (batchable && payload.size + FrameProtocol.SUB_HEADER_LEN <= FrameProtocol.REASSEMBLY_MAX) {
+            synchronized(writeLock) {
+                if (writeInProgress || hasQueuedWrites(BATCH_ORDERED_STREAMS)) {
+                    val seq = reserveFrameSeqs(stream, 1)
+                    // Navigation is latest-state: a newer update replaces one still waiting
+                    if (stream == FrameProtocol.STREAM_NAV) pendingBatch.removeAll { it.stream == stream }
+                    pendingBatch.add(FrameProtocol.SubMessage(stream, seq, payload))
+                    return seq
+                }
+            }
+        }
+        val count = FrameProtocol.fragmentCount(payload.size, mtu)
+        val firstSeq = reserveFrameSeqs(stream, count)
+        val frames = FrameProtocol.fragment(stream, firstSeq, payload, mtu)
+        if (frames.size > 1) Log.i(TAG, "Fragmenting ${payload.size} B into ${frames.size} writes (MTU $mtu)")
+        return if (enqueueWrites(stream, frames)) (firstSeq + frames.size - 1) and 0xFFFF else null
+    }
+    
+    private fun hasQueuedWrites(streams: IntArray): Boolean = streams.any { writeQueues[it].isNotEmpty() }
+    
+    /**
+     * Queue writes on a stream and start the first one if the link is idle
+     * @return false if the write could not be started (or a notification was dropped)
+     */
+    private fun enqueueWrites(stream: Int, frames: List<ByteArray>): Boolean {
+        synchronized(writeLock) {
+            val queue = writeQueues[stream]
+            if (stream == FrameProtocol.STREAM_NOTIFY && queue.size + frames.size > MAX_NOTIFY_QUEUED_FRAMES) {
+                notificationsDropped++
+                Log.w(TAG, "Notification queue full (${queue.size} frames) - dropped ($notificationsDropped total)")
+                return false
+            }
+            queue.addAll(frames)
+            if (writeInProgress) return true
+        }
+        return writeNextQueued()
+    }
+    
+    /**
+     * Once the queued nav/call frames are written, send the held messages as batch frames
+     */
+    private fun flushPendingBatch() {
+        val messages = synchronized(writeLock) {
+            if (hasQueuedWrites(BATCH_ORDERED_STREAMS) || pendingBatch.isEmpty()) return
+            pendingBatch.toList().also { pendingBatch.clear() }
+        }
+        
+        val frames = mutableListOf<ByteArray>()
+        for (batch in FrameProtocol.packBatches(messages)) {
+            val count = FrameProtocol.fragmentCount(batch.size, mtu)
+            val firstSeq = reserveFrameSeqs(FrameProtocol.STREAM_BATCH, count)
+            frames.addAll(FrameProtocol.fragment(FrameProtocol.STREAM_BATCH, firstSeq, batch, mtu))
+            batchesSent++
+        }
+        messagesBatched += messages.size
+        synchronized(writeLock) { writeQueues[FrameProtocol.STREAM_BATCH].addAll(frames) }
+        Log.i(TAG, "Batched ${messages.size} message(s) into ${frames.size} write(s) " +
+                   "(writes=$bleWrites batches=$batchesSent batched=$messagesBatched radio busy=${radioBusyMs}ms)")
+    }
+    
+    @SuppressLint("MissingPermission")
+    private fun writeNextQueued(): Boolean {
+        val (characteristic, frame, stream) = synchronized(writeLock) {
+            if (writeInProgress) return true
+            // A flight recorder command goes first (rare, and on its own characteristic)
+            val command = recorderCommand
+            val next = if (command != null) {
+                recorderCommand = null
+                Triple(flightRecorderCharacteristic, command, -1)
+            } else {
+                val stream = WRITE_PRIORITY.firstOrNull { writeQueues[it].isNotEmpty() } ?: return true
+                Triple(streamCharacteristics[stream] ?: navigationCharacteristic, writeQueues[stream].removeFirst(), stream)
+            }
+            writeInProgress = true
+            bleWrites++
+            writeStartedAtMs = System.currentTimeMillis()
+            next
+        }
+        characteristic?.value = frame
+        val started = characteristic != null && bluetoothGatt?.writeCharacteristic(characteristic) == true
+        if (!started) {
+            synchronized(writeLock) { writeInProgress = false }
+            if (stream >= 0) handleFailedWrite(stream, frame)
+        }
+        return started
+    }
+    
+    /**
+     * Recover from a write that could not be started (the frame never reached the display)
+     * Call and batch frames go back to the head of their queue and are retried, so a call
+     * state change is not lost. Any other message is dropped whole: its remaining fragments
+     * are discarded and its sequence number no longer counts as in flight.
+     */
+    private fun handleFailedWrite(stream: Int, frame: ByteArray) {
+        if (stream == FrameProtocol.STREAM_CALL || stream == FrameProtocol.STREAM_BATCH) {
+            synchronized(writeLock) { writeQueues[stream].addFirst(frame) }
+            Log.w(TAG, "Write not started - retrying stream $stream in ${WRITE_RETRY_DELAY_MS}ms")
+            if (isConnected) handler.postDelayed({ writeNextQueued() }, WRITE_RETRY_DELAY_MS)
+            return
+        }
+        if (stream == FrameProtocol.STREAM_LEGACY) {
+            Log.w(TAG, "Write not started - raw frame dropped")
+            return
+        }
+        
+        var lastSeq = FrameProtocol.seqOf(frame)
+        var flags = FrameProtocol.flagsOf(frame)
+        var dropped = 1
+        synchronized(writeLock) {
+            val queue = writeQueues[stream]
+            while ((flags == FrameProtocol.FLAG_START || flags == FrameProtocol.FLAG_CONT) && queue.isNotEmpty()) {
+                val next = queue.removeFirst()
+                lastSeq = FrameProtocol.seqOf(next)
+                flags = FrameProtocol.flagsOf(next)
+                dropped++
+            }
+        }
+        synchronized(inFlight) { inFlight[stream].removeAll { it.seq == lastSeq } }
+        // The display never got it, so the next update must not be skipped as unchanged
+        if (stream == FrameProtocol.STREAM_NAV) lastSentNavigationData = null
+        Log.w(TAG, "Write not started - dropped stream $stream seq $lastSeq ($dropped write(s))")
+    }
+    
+    private fun reserveFrameSeqs(stream: Int, count: Int): Int = synchronized(inFlight) {
+        val seq = nextSeq[stream]
+        nextSeq[stream] = (seq + count) and 0xFFFF
+        seq
+    }
+    
+    private fun trackInFlight(stream: Int, seq: Int) = synchronized(inFlight) {
+        inFlight[stream].addLast(InFlight(seq, System.currentTimeMillis()))
+    }
+    
+    /**
+     * Count a new call in the caller directory (a call's later frames are not counted again)
+     * @return The caller's directory entry, if it has one
+     */
+    private fun learnCaller(data: PhoneCallData): CallerDirectory.Entry? {
+        val last = lastSentPhoneCallData
+        val newCall = data.callState == CallState.INCOMING ||
+                      (data.callState == CallState.ONGOING &&
+                       (last == null || last.callState != CallState.ONGOING || last.callerNumber != data.callerNumber))
+        return if (newCall) callerDirectory.recordCall(data.callerName, data.callerNumber) else callerDirectory.find(data.callerNumber)
+    }
+    
+    /**
+     * Send caller directory messages on the call stream (ordered with call frames)
+     * Call frames keep name and number for these IDs until the display acks the last message.
+     * @param ids Contact IDs the messages carry
+     * @param reset The first message replaces the display's table (IDs synced so far are dropped)
+     */
+    private fun sendCallerDirectory(messages: List<String>, ids: Set<Int>, reset: Boolean) {
+        if (reset) {
+            synchronized(syncedContactIds) {
+                syncedContactIds.clear()
+                pendingContactIds.clear()
+            }
+        }
+        var bytes = 0
+        var lastSeq = 0
+        for (message in messages) {
+            val payload = message.toByteArray()
+            val seq = sendFrame(FrameProtocol.STREAM_CALL, payload) ?: run {
+                Log.w(TAG, "Caller directory not sent - call frames keep name and number")
+                return
+            }
+            trackInFlight(FrameProtocol.STREAM_CALL, seq)
+            lastSeq = seq
+            bytes += payload.size
+        }
+        synchronized(syncedContactIds) { pendingContactIds[lastSeq] = ids }
+        Log.i(TAG, "Caller directory: ${ids.size} caller(s) in ${messages.size} message(s), $bytes B" +
+                   (if (reset) " (table reset)" else ""))
+    }
+    
+    private fun isContactPending(id: Int): Boolean = synchronized(syncedContactIds) {
+        pendingContactIds.values.any { id in it }
+    }
+    
+    /**
+     * Entries the display's table holds once everything sent so far is applied
+     */
+    private fun displayContactCount(): Int = synchronized(syncedContactIds) {
+        (syncedContactIds + pendingContactIds.values.flatten()).size
+    }
+    
+    /**
+     * Contact IDs carried by call frames up to an acked sequence number are now known to the display
+     */
+    private fun confirmContactIds(ackedSeq: Int) = synchronized(syncedContactIds) {
+        val iterator = pendingContactIds.entries.iterator()
+        while (iterator.hasNext()) {
+            val (seq, ids) = iterator.next()
+            if (FrameProtocol.seqAtOrBefore(seq, ackedSeq)) {
+                syncedContactIds.addAll(ids)
+                iterator.remove()
+            }
+        }
+    }
+    
+    private fun resetFrameState() {
+        synchronized(syncedContactIds) {
+            syncedContactIds.clear()
+            pendingContactIds.clear()
+        }
+        synchronized(inFlight) {
+            nextSeq.fill(0)
+            inFlight.forEach { it.clear() }
+            navigationHeldBack = false
+        }
+        handler.removeCallbacks(navigationRelease)
+        synchronized(writeLock) {
+            writeQueues.forEach { it.clear() }
+            pendingBatch.clear()
+            recorderCommand = null
+            writeInProgress = false
+        }
+    }
+    
+    /**
+     * True if too many navigation frames are still waiting for an ack
+     * (entries past the timeout are dropped so a silent display can't stall us)
+     */
+    private fun isNavigationBacklogged(): Boolean = synchronized(inFlight) {
+        val queue = inFlight[FrameProtocol.STREAM_NAV]
+        val now = System.currentTimeMillis()
+        while (queue.isNotEmpty() && now - queue.first().sentAtMs > IN_FLIGHT_TIMEOUT_MS) {
+            queue.removeFirst()
+        }
+        queue.size >= MAX_NAV_IN_FLIGHT
+    }
+    
+    /**
+     * Retire acknowledged frames, update the round-trip estimate and release held-back data
+     */
+    private fun handleAcks(acks: List<FrameProtocol.Ack>) {
+        val now = System.currentTimeMillis()
+        synchronized(inFlight) {
+            for (ack in acks) {
+                if (ack.stream !in 1 until FrameProtocol.STREAM_COUNT) continue
+                framesDroppedByDisplay += ack.dropped
+                if (ack.stream == FrameProtocol.STREAM_CALL) confirmContactIds(ack.lastSeq)
+                val queue = inFlight[ack.stream]
+                while (queue.isNotEmpty() && FrameProtocol.seqAtOrBefore(queue.first().seq, ack.lastSeq)) {
+                    val rtt = now - queue.removeFirst().sentAtMs
+                    // EWMA with 1/8 weight, like TCP's SRTT
+                    smoothedRttMs = if (smoothedRttMs == 0L) rtt else smoothedRttMs + (rtt - smoothedRttMs) / 8
+                }
+            }
+        }
+        Log.d(TAG, "Ack: $acks rtt=${smoothedRttMs}ms dropped=$framesDroppedByDisplay")
+        _transmissionStats.value = _transmissionStats.value.copy(
+            ackRttMs = smoothedRttMs,
+            framesDroppedByDisplay = framesDroppedByDisplay
+        )
+        
+        if (navigationHeldBack) releaseHeldNavigation()
+    }
+    
+    /**
+     * Send the newest held-back navigation data if the backlog has cleared, else wait for the next timeout
+     */
+    private fun releaseHeldNavigation() {
+        handler.removeCallbacks(navigationRelease)
+        if (!navigationHeldBack) return
+        if (isNavigationBacklogged()) {
+            scheduleNavigationRelease()
+            return
+        }
+        navigationHeldBack = false
+        lastNavigationData?.let { sendNavigationData(it) }
+    }
+    
+    /**
+     * Check the backlog again just after the oldest unacked navigation frame times out
+     */
+    private fun scheduleNavigationRelease() {
+        val now = System.currentTimeMillis()
+        val oldest = synchronized(inFlight) { inFlight[FrameProtocol.STREAM_NAV].firstOrNull()?.sentAtMs } ?: now
+        handler.removeCallbacks(navigationRelease)
+        handler.postDelayed(navigationRelease, (oldest + IN_FLIGHT_TIMEOUT_MS + 1 - now).coerceAtLeast(1))
+    }
+    
+    /**
+     * Publish a telemetry record and append it to the CSV log
+     */
+    private fun handleTelemetry(record: TelemetryRecord) {
+        _telemetry.value = record
+        Log.d(TAG, "Telemetry: ${record.frames} frames (${"%.1f".format(record.fps)} fps), " +
+                   "handler avg=${record.handlerAvgUs}us max=${record.handlerMaxUs}us, rssi=${record.rssi}dBm")
+        
+        val row = record.toCsvRow(System.currentTimeMillis())
+        telemetryWriter.execute {
+            try {
+                val file = File(context.getExternalFilesDir(null), TELEMETRY_CSV_FILE)
+                if (!file.exists()) file.writeText(TelemetryRecord.CSV_HEADER + "\n")
+                file.appendText(row + "\n")
+            } catch (e: Exception) {
+                Log.e(TAG, "❌ Failed to write telemetry CSV: ${e.message}")
+            }
+        }
+    }
+    
+    /**
+     * Pull the display's flight recorder log; saved to flightrec-<time>.bin when complete
+     * @return false if the display has no flight recorder (or isn't connected)
+     */
+    fun dumpFlightRecorder(): Boolean {
+        flightRecorderDump = FlightRecorderLog.Assembler()
+        return sendRecorderCommand(FlightRecorderLog.COMMAND_DUMP)
+    }
+    
+    /**
+     * Erase the display's flight recorder log
+     */
+    fun clearFlightRecorder(): Boolean = sendRecorderCommand(FlightRecorderLog.COMMAND_CLEAR)
+    
+    /**
+     * Replay the recorded writes on the display (it ignores live data until done)
+     * @param speed 1 = real time, N = N times faster, 0 = as fast as possible
+     */
+    fun replayFlightRecorder(speed: Int = 1): Boolean = sendRecorderCommand(FlightRecorderLog.replayCommand(speed))
+    
+    /**
+     * Stop a running dump or replay
+     */
+    fun stopFlightRecorder(): Boolean {
+        flightRecorderDump = null
+        return sendRecorderCommand(FlightRecorderLog.COMMAND_STOP)
+    }
+    
+    private fun sendRecorderCommand(command: ByteArray): Boolean {
+        if (flightRecorderCharacteristic == null) {
+            Log.w(TAG, "Display has no flight recorder characteristic")
+            return false
+        }
+        synchronized(writeLock) {
+            recorderCommand = command
+            if (writeInProgress) return true
+        }
+        return writeNextQueued()
+    }
+    
+    /**
+     * Collect a dump notification; save the log once the end marker arrives
+     */
+    private fun handleFlightRecorderChunk(value: ByteArray) {
+        val dump = flightRecorderDump ?: return
+        if (!dump.add(value)) return
+        flightRecorderDump = null
+        
+        val data = dump.bytes()
+        val records = FlightRecorderLog.parse(data)
+        Log.i(TAG, "Flight recorder dump: ${records.size}/${dump.recordsReported} records " +
+                   "(${records.count { !it.crcOk }} bad CRC), ${data.size} B, ${dump.missingChunks} chunks missing, " +
+                   "${dump.droppedReported} dropped on the display")
+        telemetryWriter.execute {
+            try {
+                val file = File(context.getExternalFilesDir(null), "flightrec-${System.currentTimeMillis()}.bin")
+                file.writeBytes(data)
+                _flightRecorderFile.value = file
+                Log.i(TAG, "Flight recorder log saved to ${file.absolutePath}")
+            } catch (e: Exception) {
+                Log.e(TAG, "❌ Failed to save flight recorder log: ${e.message}")
+            }
+        }
+    }
+    
+    private fun navigationMessagesPerMinute(): Float {
+        val elapsedMs = System.currentTimeMillis() - navigationRateStartMs
+        if (navigationMessagesSent == 0 || elapsedMs < 60000L) return navigationMessagesSent.toFloat()
+        return navigationMessagesSent * 60000f / elapsedMs
     }
     
     /**
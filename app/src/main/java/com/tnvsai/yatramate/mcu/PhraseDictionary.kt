@@ -0,0 +1,256 @@
+package com.tnvsai.yatramate.mcu
+
+import com.google.gson.Gson
+
+/**
+ * Maneuver phrase dictionary shared with the firmware (phrase_dict.h)
+ *
+ * Maneuver text goes out as "mt": phrase IDs (Int) and literal strings, joined
+ * by single spaces on the display, plus "mv": [VERSION]. Text is only sent this
+ * way when it comes out shorter than the plain "maneuver" string.
+ * IDs are list index + 1 and must match the firmware table; never reuse one,
+ * change a phrase only together with a version bump on both sides.
+ */
+object PhraseDictionary {
+    
+    const val VERSION = 1
+    
+    /**
+     * Set per connection from the display's capabilities characteristic: on only when it
+     * expands this VERSION (other firmware would show no maneuver text)
+     */
+    @Volatile var enabled = false
+    
+    private val PHRASES = listOf(
+        "Turn left",
+        "Turn right",
+        "Turn left onto",
+        "Turn right onto",
+        "Slight left",
+        "Slight right",
+        "Slight left onto",
+        "Slight right onto",
+        "Sharp left",
+        "Sharp right",
+        "Sharp left onto",
+        "Sharp right onto",
+        "Keep left",
+        "Keep right",
+        "Keep left at the fork",
+        "Keep right at the fork",
+        "Keep left to continue on",
+        "Keep right to continue on",
+        "Keep left to stay on",
+        "Keep right to stay on",
+        "Make a U-turn",
+        "Make a U-turn at",
+        "Head north",
+        "Head south",
+        "Head east",
+        "Head west",
+        "Head northeast",
+        "Head northwest",
+        "Head southeast",
+        "Head southwest",
+        "Head north on",
+        "Head south on",
+        "Head east on",
+        "Head west on",
+        "Continue",
+        "Continue onto",
+        "Continue on",
+        "Continue straight",
+        "Continue straight onto",
+        "Continue straight to stay on",
+        "At the roundabout,",
+        "take the 1st exit",
+        "take the 2nd exit",
+        "take the 3rd exit",
+        "take the 4th exit",
+        "take the 5th exit",
+        "At the roundabout, take the 1st exit",
+        "At the roundabout, take the 2nd exit",
+        "At the roundabout, take the 3rd exit",
+        "At the roundabout, take the 4th exit",
+        "At the roundabout, take the 5th exit",
+        "Go through 1 roundabout",
+        "Go through 2 roundabouts",
+        "Exit the roundabout",
+        "onto",
+        "Take the exit",
+        "Take exit",
+        "Take the exit toward",
+        "Take the ramp",
+        "Take the ramp onto",
+        "Take the ramp to",
+        "Take the",
+        "exit",
+        "exit onto",
+        "Merge onto",
+        "Merge with",
+        "Use the left lane",
+        "Use the right lane",
+        "Use the left 2 lanes",
+        "Use the right 2 lanes",
+        "Use any lane",
+        "to turn left",
+        "to turn right",
+        "to take the",
+        "to stay on",
+        "to continue on",
+        "then turn left",
+        "then turn right",
+        "then",
+        "toward",
+        "on",
+        "at",
+        "and",
+        "for",
+        "the",
+        "Destination reached",
+        "Your destination is on the left",
+        "Your destination is on the right",
+        "Arrive at",
+        "Pass by",
+        "Road",
+        "Rd",
+        "Street",
+        "St",
+        "Main Road",
+        "Highway",
+        "Expressway",
+        "Flyover",
+        "Bridge",
+        "Service Road",
+        "Ring Road",
+        "Cross",
+        "Marg",
+        "Nagar",
+        "Avenue",
+        "Lane",
+        "Circle",
+        "Junction",
+        "Nagar Main Road",
+        "Layout",
+        "Bypass",
+        "km",
+        "m"
+    )
+    
+    private val gson = Gson()
+    
+    // Phrases by first word, longest first, for greedy matching
+    private val candidates: Map<String, List<Pair<Int, List<String>>>> =
+        PHRASES.mapIndexed { i, phrase -> Pair(i + 1, phrase.split(' ')) }
+            .groupBy { it.second.first() }
+            .mapValues { (_, list) -> list.sortedByDescending { it.second.size } }
+    
+    // Sent maneuvers this session
+    private var sentFrames = 0
+    private var sentTokenized = 0
+    private var sentPlainBytes = 0L
+    private var sentBytes = 0L
+    
+    /**
+     * Tokens for a maneuver text
+     * @return Phrase IDs and literal strings, or null if disabled or not smaller than the plain text
+     */
+    fun encode(text: String): List<Any>? {
+        if (!enabled) return null
+        val tokens = tokenize(text)
+        if (tokens.none { it is Int }) return null
+        return if (tokenizedSize(tokens) < plainSize(text)) tokens else null
+    }
+    
+    /**
+     * Text the display shows for a token list
+     */
+    fun expand(tokens: List<Any>): String =
+        tokens.joinToString(" ") { token -> if (token is Int) PHRASES[token - 1] else token.toString() }
+    
+    /**
+     * Count a sent maneuver
+     * @return Session summary for the log
+     */
+    @Synchronized
+    fun recordSent(text: String): String {
+        val plain = plainSize(text)
+        val tokens = encode(text)
+        sentFrames++
+        sentPlainBytes += plain
+        if (tokens != null) {
+            sentTokenized++
+            sentBytes += tokenizedSize(tokens)
+        } else {
+            sentBytes += plain
+        }
+        return "maneuver text $sentBytes B for $sentPlainBytes B plain (${ratio(sentBytes, sentPlainBytes)}), " +
+               "$sentTokenized of $sentFrames frames tokenized"
+    }
+    
+    /**
+     * Compression over a set of maneuver texts (e.g. the notification history)
+     * @return Report lines: totals and the most common words not in the dictionary
+     */
+    fun corpusReport(texts: List<String>): List<String> {
+        var plainBytes = 0L
+        var bytes = 0L
+        var tokenized = 0
+        val literalWords = mutableMapOf<String, Int>()
+        for (text in texts.filter { it.isNotBlank() }) {
+            val plain = plainSize(text)
+            val tokens = encode(text)
+            plainBytes += plain
+            if (tokens != null) {
+                tokenized++
+                bytes += tokenizedSize(tokens)
+            } else {
+                bytes += plain
+            }
+            tokenize(text).filterIsInstance<String>().flatMap { it.split(' ') }
+                .forEach { literalWords[it] = (literalWords[it] ?: 0) + 1 }
+        }
+        val missing = literalWords.entries.sortedByDescending { it.value }.take(8)
+            .joinToString(", ") { "\"${it.key}\" x${it.value}" }
+        return listOf(
+            "Phrase dictionary v$VERSION: ${texts.size} texts, $tokenized tokenized, " +
+                "$bytes B for $plainBytes B plain (${ratio(bytes, plainBytes)})",
+            "Most common literal words: ${missing.ifEmpty { "none" }}"
+        )
+    }
+    
+    // Greedy longest match on whole words; words between phrases merge into one literal
+    private fun tokenize(text: String): List<Any> {
+        val words = text.trim().split(Regex("\\s+")).filter { it.isNotEmpty() }
+        val tokens = mutableListOf<Any>()
+        val literal = StringBuilder()
+        var i = 0
+        while (i < words.size) {
+            val match = candidates[words[i]]?.firstOrNull { (_, phrase) ->
+                i + phrase.size <= words.size && phrase.indices.all { words[i + it] == phrase[it] }
+            }
+            if (match != null) {
+                if (literal.isNotEmpty()) tokens.add(literal.toString())
+                literal.clear()
+                tokens.add(match.first)
+                i += match.second.size
+            } else {
+                if (literal.isNotEmpty()) literal.append(' ')
+                literal.append(words[i])
+                i++
+            }
+        }
+        if (literal.isNotEmpty()) tokens.add(literal.toString())
+        return tokens
+    }
+    
+    // Field bytes as the transformer writes them: "mt":[...],"mv":N vs "maneuver":"..."
+    private fun tokenizedSize(tokens: List<Any>): Int =
+        "\"mt\":".length + gson.toJson(tokens).toByteArray().size + ",\"mv\":$VERSION".length
+    
+    private fun plainSize(text: String): Int =
+        "\"maneuver\":".length + gson.toJson(text).toByteArray().size
+    
+    private fun ratio(bytes: Long, plainBytes: Long): String =
+        if (plainBytes > 0) "%.0f%%".format(bytes * 100.0 / plainBytes) else "n/a"
+}
@@ -4,10 +4,12 @@ import com.google.gson.Gson
 import com.tnvsai.yatramate.config.ConfigManager
 import com.tnvsai.yatramate.config.models.MCUFormat
 import com.tnvsai.yatramate.mcu.DataTransformer
+import com.tnvsai.yatramate.mcu.PhraseDictionary
 import com.tnvsai.yatramate.model.CallState
 import com.tnvsai.yatramate.model.Direction
 import com.tnvsai.yatramate.model.NavigationData
 import com.tnvsai.yatramate.model.PhoneCallData
+import com.tnvsai.yatramate.utils.ETACalculator
 import android.util.Log
 import java.util.HashMap
 
@@ -42,11 +44,33 @@ class ESP32Transformer(private val format: MCUFormat) : DataTransformer {
             jsonData["type"] = "NAVIGATION"
             jsonData["direction"] = directionStr
             jsonData["distance"] = distance
-            jsonData["maneuver"] = data.maneuver ?: ""
+            val maneuverTokens = data.maneuver?.let { PhraseDictionary.encode(it) }
+            if (maneuverTokens != null) {
+                // Phrase IDs plus literal street names (firmware phrase_dict.h)
+                jsonData["mt"] = maneuverTokens
+                jsonData["mv"] = PhraseDictionary.VERSION
+            } else {
+                jsonData["maneuver"] = data.maneuver ?: ""
+            }
+            
+            // Lookahead: [direction, meters from the previous maneuver, text or phrase tokens]
+            if (data.upcoming.isNotEmpty()) {
+                jsonData["next"] = data.upcoming.take(2).map { next ->
+                    val entry = mutableListOf<Any>(mapDirection(next.direction), extractDistanceInMeters(next.distance))
+                    next.maneuver?.let { text ->
+                        val tokens = PhraseDictionary.encode(text)
+                        if (tokens != null) jsonData["mv"] = PhraseDictionary.VERSION
+                        entry.add(tokens ?: text)
+                    }
+                    entry
+                }
+            }
             
             // Add ETA if available
             if (data.eta != null) {
                 jsonData["eta"] = data.eta
+                // Structured ETA lets the display count down on its own
+                ETACalculator.parseETAToSeconds(data.eta)?.let { jsonData["eta_s"] = it }
             }
             
             Log.d(TAG, "JSON data map: $jsonData")
@@ -75,8 +99,13 @@ class ESP32Transformer(private val format: MCUFormat) : DataTransformer {
             // Create JSON data using HashMap to avoid type inference issues
             val jsonData = HashMap<String, Any>()
             jsonData["type"] = "phone_call"
-            jsonData["caller_name"] = data.callerName ?: ""
-            jsonData["caller_number"] = data.callerNumber
+            if (data.contactId != 0) {
+                // The display already has this caller's name (caller directory)
+                jsonData["contact"] = data.contactId
+            } else {
+                jsonData["caller_name"] = data.callerName ?: ""
+                jsonData["caller_number"] = data.callerNumber
+            }
             jsonData["call_state"] = callStateStr
             jsonData["duration"] = data.duration
             
@@ -10,7 +10,17 @@ data class NavigationData(
     val maneuver: String? = null,
     val icon: String? = null,  // Icon identifier for ESP32
     val eta: String? = null,   // Estimated time of arrival
-    val timestamp: Long = System.currentTimeMillis()
+    val timestamp: Long = System.currentTimeMillis(),
+    val upcoming: List<UpcomingManeuver> = emptyList()  // Maneuvers after this one, nearest first
+)
+
+/**
+ * A maneuver after the current one ("..., then turn left"), sent as display lookahead
+ */
+data class UpcomingManeuver(
+    val direction: Direction,
+    val distance: String? = null,   // From the previous maneuver; null if the notification doesn't say
+    val maneuver: String? = null
 )
 
 /**
@@ -9,7 +9,8 @@ data class PhoneCallData(
     val callerNumber: String,
     val callState: CallState,
     val timestamp: Long = System.currentTimeMillis(),
-    val duration: Int = 0 // Duration in seconds for ongoing calls
+    val duration: Int = 0, // Duration in seconds for ongoing calls
+    val contactId: Int = 0 // Display's caller directory ID (CallerDirectory); 0 = send name and number
 )
 
 /**
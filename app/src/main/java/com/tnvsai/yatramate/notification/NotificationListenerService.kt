@@ -766,9 +766,9 @@ class NotificationListenerService : NotificationListenerService() {
                             service.sendPhoneCallData(phoneCallData)
                         }
                         else -> {
-                            // For other notification types, send raw JSON via BLE
+                            // Other notification types go on their own stream (never ahead of calls)
                             Log.i(TAG, "Sending generic notification type ${type.id} to MCU")
-                            service.sendRawData(payload)
+                            service.sendNotificationData(payload)
                         }
                     }
                 }
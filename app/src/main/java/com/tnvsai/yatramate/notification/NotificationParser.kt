@@ -3,6 +3,7 @@ package com.tnvsai.yatramate.notification
 import com.tnvsai.yatramate.config.ConfigManager
 import com.tnvsai.yatramate.model.Direction
 import com.tnvsai.yatramate.model.NavigationData
+import com.tnvsai.yatramate.model.UpcomingManeuver
 import com.tnvsai.yatramate.utils.ETACalculator
 import android.util.Log
 import java.util.regex.Pattern
@@ -14,6 +15,8 @@ import java.util.regex.Pattern
 object NotificationParser {
     
     private const val TAG = "NotificationParser"
+    private const val MAX_UPCOMING = 2    // Firmware NAV_LOOKAHEAD_MAX
+    private val THEN_CLAUSE = Regex(",?\\s+then\\s+", RegexOption.IGNORE_CASE)
     
     // Patterns loaded dynamically from config
     private var directionPatterns: Map<Direction, List<String>> = emptyMap()
@@ -76,6 +79,17 @@ object NotificationParser {
         
         Log.d(TAG, "Parsing notification: $notificationText")
         
+        // "Turn right onto X, then turn left": the "then" clauses are the upcoming maneuvers
+        val clauses = notificationText.split(THEN_CLAUSE)
+        val upcoming = if (clauses.size > 1 && clauses[0].isNotBlank()) {
+            clauses.drop(1).take(MAX_UPCOMING).mapNotNull { parseUpcoming(it) }
+        } else {
+            emptyList()
+        }
+        if (upcoming.isNotEmpty()) {
+            return parseNotification(clauses[0])?.copy(upcoming = upcoming)
+        }
+        
         // Check for special cases first
         val roundaboutResult = detectRoundabout(notificationText)
         val isDestination = detectDestination(notificationText)
@@ -116,6 +130,18 @@ object NotificationParser {
         return null
     }
     
+    /**
+     * Parse a "then ..." clause
+     */
+    private fun parseUpcoming(text: String): UpcomingManeuver? {
+        val direction = detectRoundabout(text)?.first
+            ?: (if (detectDestination(text)) Direction.DESTINATION_REACHED else null)
+            ?: extractDirection(text)
+            ?: return null
+        val maneuver = cleanManeuverText(text.trim()).replaceFirstChar { it.uppercase() }
+        return UpcomingManeuver(direction, extractDistance(text), maneuver.ifBlank { null })
+    }
+    
     /**
      * Extract direction from notification text
      */
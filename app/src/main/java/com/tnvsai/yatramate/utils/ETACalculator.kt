@@ -44,6 +44,25 @@ object ETACalculator {
         }
     }
     
+    /**
+     * Convert an ETA string produced by calculateETA back to remaining seconds
+     * Whole minutes are mapped to the middle of the minute so a local countdown
+     * shows the same text for about as long as the phone would.
+     * @param eta ETA string (e.g., "< 1 min", "12 min", "1h", "1h 15m")
+     * @return Remaining seconds, or null if the text has no duration ("Arrived", "Calculating...")
+     */
+    fun parseETAToSeconds(eta: String?): Int? {
+        if (eta.isNullOrBlank()) return null
+        val text = eta.trim().lowercase()
+        if (text == "< 1 min") return 30
+        
+        val hours = Regex("(\\d+)\\s*h").find(text)?.groupValues?.get(1)?.toIntOrNull()
+        val minutes = Regex("(\\d+)\\s*(min|m)\\b").find(text)?.groupValues?.get(1)?.toIntOrNull()
+        if (hours == null && minutes == null) return null
+        
+        return ((hours ?: 0) * 60 + (minutes ?: 0)) * 60 + 30
+    }
+    
     /**
      * Parse distance string to meters
      * @param distance Distance string (e.g., "200m", "1.2km")
@@ -0,0 +1,29 @@
+package com.tnvsai.yatramate.ble
+
+import org.junit.Assert.*
+import org.junit.Test
+
+/**
+ * numberHash must match the firmware's caller_directory_hash_number
+ */
+class CallerDirectoryTest {
+
+    @Test
+    fun numberHash_isFnv1aOfDigits() {
+        assertEquals(0x52158234L, CallerDirectory.numberHash("9876543210"))
+    }
+
+    @Test
+    fun numberHash_ignoresFormattingAndCountryCode() {
+        val hash = CallerDirectory.numberHash("9876543210")
+        assertEquals(hash, CallerDirectory.numberHash("+91 98765-43210"))
+        assertEquals(hash, CallerDirectory.numberHash("0091 (987) 654 3210"))
+        assertNotEquals(hash, CallerDirectory.numberHash("9876543211"))
+    }
+
+    @Test
+    fun numberHash_isZeroWithoutDigits() {
+        assertEquals(0L, CallerDirectory.numberHash(""))
+        assertEquals(0L, CallerDirectory.numberHash("Private"))
+    }
+}
@@ -0,0 +1,96 @@
+package com.tnvsai.yatramate.ble
+
+import org.junit.Assert.*
+import org.junit.Test
+
+/**
+ * Frame, batch and ack layouts must match the firmware (ble_frame.h, test/host/test_ble_frame.cpp)
+ */
+class FrameProtocolTest {
+
+    private fun bytes(vararg values: Int) = ByteArray(values.size) { values[it].toByte() }
+
+    @Test
+    fun encode_writesHeader() {
+        val frame = FrameProtocol.encode(FrameProtocol.STREAM_CALL, 0x1234, "ab".toByteArray(), FrameProtocol.FLAG_END)
+        assertArrayEquals(bytes(0xA5, 0x42, 0x34, 0x12, 'a'.code, 'b'.code), frame)
+        assertEquals(0x1234, FrameProtocol.seqOf(frame))
+        assertEquals(FrameProtocol.FLAG_END, FrameProtocol.flagsOf(frame))
+    }
+
+    @Test
+    fun fragment_smallPayloadIsOneUnflaggedFrame() {
+        val frames = FrameProtocol.fragment(FrameProtocol.STREAM_NAV, 7, "{}".toByteArray(), FrameProtocol.DEFAULT_MTU)
+        assertEquals(1, frames.size)
+        assertArrayEquals(bytes(0xA5, 0x01, 7, 0, '{'.code, '}'.code), frames[0])
+    }
+
+    @Test
+    fun fragment_splitsAcrossSequenceWrap() {
+        val payload = ByteArray(40) { it.toByte() }
+        val chunk = FrameProtocol.chunkSize(FrameProtocol.DEFAULT_MTU)
+        val frames = FrameProtocol.fragment(FrameProtocol.STREAM_NAV, 0xFFFF, payload, FrameProtocol.DEFAULT_MTU)
+
+        assertEquals(FrameProtocol.fragmentCount(payload.size, FrameProtocol.DEFAULT_MTU), frames.size)
+        assertEquals(3, frames.size)
+        assertEquals(listOf(FrameProtocol.FLAG_START, FrameProtocol.FLAG_CONT, FrameProtocol.FLAG_END),
+            frames.map { FrameProtocol.flagsOf(it) })
+        assertEquals(listOf(0xFFFF, 0x0000, 0x0001), frames.map { FrameProtocol.seqOf(it) })
+        assertTrue(frames.all { it.size <= FrameProtocol.HEADER_LEN + chunk })
+
+        val reassembled = frames.flatMap { it.drop(FrameProtocol.HEADER_LEN) }.toByteArray()
+        assertArrayEquals(payload, reassembled)
+    }
+
+    @Test
+    fun packBatches_layoutMatchesFirmware() {
+        val batches = FrameProtocol.packBatches(listOf(
+            FrameProtocol.SubMessage(FrameProtocol.STREAM_NAV, 7, "{}".toByteArray()),
+            FrameProtocol.SubMessage(FrameProtocol.STREAM_CALL, 9, "[1]".toByteArray())
+        ))
+        assertEquals(1, batches.size)
+        assertArrayEquals(bytes(
+            1, 7, 0, 2, 0, '{'.code, '}'.code,
+            2, 9, 0, 3, 0, '['.code, '1'.code, ']'.code
+        ), batches[0])
+    }
+
+    @Test
+    fun packBatches_staysWithinReassemblyLimit() {
+        val messages = (0 until 5).map { FrameProtocol.SubMessage(FrameProtocol.STREAM_NOTIFY, it, ByteArray(300)) }
+        val batches = FrameProtocol.packBatches(messages)
+        assertEquals(2, batches.size)
+        assertTrue(batches.all { it.size <= FrameProtocol.REASSEMBLY_MAX })
+        assertEquals(5 * (FrameProtocol.SUB_HEADER_LEN + 300), batches.sumOf { it.size })
+    }
+
+    @Test
+    fun decodeAcks_readsEveryStream() {
+        val acks = FrameProtocol.decodeAcks(bytes(0xA5, 'A'.code, 2, 1, 2, 0, 2, 1, 2, 0x34, 0x12, 1, 0))
+        assertEquals(listOf(
+            FrameProtocol.Ack(FrameProtocol.STREAM_NAV, 2, 2, 1),
+            FrameProtocol.Ack(FrameProtocol.STREAM_CALL, 0x1234, 1, 0)
+        ), acks)
+    }
+
+    @Test
+    fun decodeAcks_rejectsOtherValues() {
+        assertNull(FrameProtocol.decodeAcks(null))
+        assertNull(FrameProtocol.decodeAcks(bytes(0xA5, 'A'.code)))
+        assertNull(FrameProtocol.decodeAcks(bytes(0x5A, 'A'.code, 0)))
+        assertNull(FrameProtocol.decodeAcks("{\"a\":1}".toByteArray()))
+        assertNull(FrameProtocol.decodeAcks(bytes(0xA5, 'A'.code, 2, 1, 2, 0, 2, 1)))  // Truncated
+        assertEquals(emptyList<FrameProtocol.Ack>(), FrameProtocol.decodeAcks(bytes(0xA5, 'A'.code, 0)))
+    }
+
+    @Test
+    fun seqAtOrBefore_handlesWrap() {
+        assertTrue(FrameProtocol.seqAtOrBefore(5, 5))
+        assertTrue(FrameProtocol.seqAtOrBefore(5, 6))
+        assertFalse(FrameProtocol.seqAtOrBefore(6, 5))
+        assertTrue(FrameProtocol.seqAtOrBefore(0xFFFF, 0x0000))
+        assertFalse(FrameProtocol.seqAtOrBefore(0x0000, 0xFFFF))
+        assertTrue(FrameProtocol.seqAtOrBefore(0xFFF0, 0x0010))
+        assertFalse(FrameProtocol.seqAtOrBefore(0x0010, 0xFFF0))
+    }
+}
@@ -0,0 +1,60 @@
+package com.tnvsai.yatramate.mcu
+
+import org.junit.After
+import org.junit.Assert.*
+import org.junit.Before
+import org.junit.Test
+
+/**
+ * Phrase IDs here must match the firmware table (phrase_dict.h)
+ */
+class PhraseDictionaryTest {
+
+    @Before
+    fun enable() {
+        PhraseDictionary.enabled = true   // As after a display reports this version
+    }
+
+    @After
+    fun disable() {
+        PhraseDictionary.enabled = false
+    }
+
+    @Test
+    fun encode_matchesLongestPhrases() {
+        assertEquals(listOf(3, "MG", 91), PhraseDictionary.encode("Turn left onto MG Road"))
+        assertEquals(listOf(109), PhraseDictionary.encode("Nagar Main Road"))
+        assertEquals(listOf(48), PhraseDictionary.encode("At the roundabout, take the 2nd exit"))
+    }
+
+    @Test
+    fun encode_mergesLiteralWords() {
+        assertEquals(listOf(16, "Indira Gandhi", 91), PhraseDictionary.encode("Keep right at the fork Indira Gandhi Road"))
+    }
+
+    @Test
+    fun encode_matchesWholeWordsOnly() {
+        assertNull(PhraseDictionary.encode("Turnleft"))
+        assertEquals(listOf(1), PhraseDictionary.encode("  Turn   left "))
+    }
+
+    @Test
+    fun encode_skipsTextThatWouldNotShrink() {
+        assertNull(PhraseDictionary.encode("Xyz Abc"))   // No phrase
+        assertNull(PhraseDictionary.encode("m"))         // Tokens longer than the text
+    }
+
+    @Test
+    fun expand_restoresText() {
+        val text = "Turn right onto Outer Ring Road then turn left"
+        val tokens = PhraseDictionary.encode(text)
+        assertNotNull(tokens)
+        assertEquals(text, PhraseDictionary.expand(tokens!!))
+    }
+
+    @Test
+    fun encode_isOffWhenDisabled() {
+        PhraseDictionary.enabled = false
+        assertNull(PhraseDictionary.encode("Turn left onto MG Road"))
+    }
+}
@@ -0,0 +1,43 @@
+package com.tnvsai.yatramate.notification
+
+import com.tnvsai.yatramate.model.Direction
+import org.junit.Assert.*
+import org.junit.Test
+
+/**
+ * "then" clause split (runs without config keywords: directions come from
+ * distance, roundabout and destination detection only)
+ */
+class NotificationParserTest {
+
+    @Test
+    fun thenClauses_becomeUpcomingManeuvers() {
+        val data = NotificationParser.parseNotification(
+            "Turn right onto MG Road in 200 m, then at the roundabout, take the 2nd exit, " +
+                "then your destination is on the left, then keep left"
+        )
+        assertNotNull(data)
+        assertEquals("200m", data!!.distance)
+        assertEquals(2, data.upcoming.size)   // Firmware NAV_LOOKAHEAD_MAX
+        assertEquals(Direction.ROUNDABOUT_STRAIGHT, data.upcoming[0].direction)
+        assertEquals("At the roundabout, take the 2nd exit", data.upcoming[0].maneuver)
+        assertNull(data.upcoming[0].distance)
+        assertEquals(Direction.DESTINATION_REACHED, data.upcoming[1].direction)
+    }
+
+    @Test
+    fun unrecognisedThenClause_keepsWholeText() {
+        val data = NotificationParser.parseNotification("In 300 m, then xyz")
+        assertNotNull(data)
+        assertTrue(data!!.upcoming.isEmpty())
+        assertEquals("300m", data.distance)
+    }
+
+    @Test
+    fun thenInsideWord_isNotSplit() {
+        val data = NotificationParser.parseNotification("Continue on Athens Street for 2 km")
+        assertNotNull(data)
+        assertTrue(data!!.upcoming.isEmpty())
+        assertEquals("2km", data.distance)
+    }
+}
@@ -0,0 +1,34 @@
+package com.tnvsai.yatramate.utils
+
+import org.junit.Assert.*
+import org.junit.Test
+
+class ETACalculatorTest {
+
+    @Test
+    fun parseETAToSeconds_readsCalculatedFormats() {
+        assertEquals(30, ETACalculator.parseETAToSeconds("< 1 min"))
+        assertEquals(12 * 60 + 30, ETACalculator.parseETAToSeconds("12 min"))
+        assertEquals(3600 + 30, ETACalculator.parseETAToSeconds("1h"))
+        assertEquals(3600 + 15 * 60 + 30, ETACalculator.parseETAToSeconds("1h 15m"))
+    }
+
+    @Test
+    fun parseETAToSeconds_roundTripsCalculateETA() {
+        // Every duration calculateETA produces parses, and more distance never means less time
+        val seconds = listOf("100m", "900m", "5km", "12km", "45km", "90km").map {
+            ETACalculator.parseETAToSeconds(ETACalculator.calculateETA(it))
+        }
+        assertTrue(seconds.all { it != null })
+        assertEquals(seconds.map { it!! }.sorted(), seconds.map { it!! })
+        assertTrue(seconds.last()!! > 3600)
+    }
+
+    @Test
+    fun parseETAToSeconds_isNullWithoutDuration() {
+        assertNull(ETACalculator.parseETAToSeconds(null))
+        assertNull(ETACalculator.parseETAToSeconds(""))
+        assertNull(ETACalculator.parseETAToSeconds("Arrived"))
+        assertNull(ETACalculator.parseETAToSeconds("Calculating..."))
+    }
+}
@@ -0,0 +1,190 @@
+#include <Arduino.h>
+#include <new>
+#include <stdarg.h>
+#include "alloc_guard.h"
+#include "lv_mem_pool.h"
+
+static volatile bool boot_complete = false;
+
+// Post-boot counters per source (new_allocs are also counted in heap_allocs
+// when the heap wrappers are linked)
+static volatile uint32_t heap_allocs = 0;
+static volatile uint32_t heap_frees = 0;
+static volatile uint32_t new_allocs = 0;
+static volatile uint32_t lvgl_allocs = 0;
+
+// Set by the first wrapped heap call (the link has the --wrap flags)
+static volatile bool heap_wrapped = false;
+
+// Active message scope (one at a time, owned by one task)
+static volatile TaskHandle_t scope_task = nullptr;
+static volatile uint32_t scope_allocs = 0;
+
+// Per message kind results
+typedef struct {
+    const char *kind;
+    uint32_t messages;
+    uint32_t violations;
+    uint32_t allocs;
+    uint32_t max_allocs;
+} alloc_guard_kind_t;
+
+static alloc_guard_kind_t kinds[ALLOC_GUARD_MAX_KINDS];
+static uint32_t total_violations = 0;
+
+static inline void count(volatile uint32_t *counter) {
+    if (!boot_complete) return;
+    __atomic_add_fetch(counter, 1, __ATOMIC_RELAXED);
+    if (scope_task != nullptr && xTaskGetCurrentTaskHandle() == scope_task) {
+        __atomic_add_fetch(&scope_allocs, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void lvgl_alloc_hook(size_t size) {
+    (void)size;
+    count(&lvgl_allocs);
+}
+
+// Link-time heap wrappers (-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free).
+// Arduino String, ArduinoJson's dynamic documents, Print::printf and operator
+// new all end in malloc/realloc, so this is the one place that sees them.
+// Without the flags these are never called and the weak __real_ references
+// stay unresolved (null) instead of failing the link. newlib's own _malloc_r
+// calls go straight to the heap and are not seen either way.
+extern "C" {
+void *__real_malloc(size_t size) __attribute__((weak));
+void *__real_calloc(size_t n, size_t size) __attribute__((weak));
+void *__real_realloc(void *ptr, size_t size) __attribute__((weak));
+void __real_free(void *ptr) __attribute__((weak));
+
+IRAM_ATTR void *__wrap_malloc(size_t size) {
+    heap_wrapped = true;
+    void *p = __real_malloc(size);
+    if (p != nullptr) count(&heap_allocs);
+    return p;
+}
+
+IRAM_ATTR void *__wrap_calloc(size_t n, size_t size) {
+    heap_wrapped = true;
+    void *p = __real_calloc(n, size);
+    if (p != nullptr) count(&heap_allocs);
+    return p;
+}
+
+IRAM_ATTR void *__wrap_realloc(void *ptr, size_t size) {
+    heap_wrapped = true;
+    void *p = __real_realloc(ptr, size);
+    // realloc(ptr, 0) frees; anything else may move or grow a block
+    if (p != nullptr && size > 0) count(&heap_allocs);
+    return p;
+}
+
+void IRAM_ATTR __wrap_free(void *ptr) {
+    heap_wrapped = true;
+    __real_free(ptr);
+    if (ptr != nullptr && boot_complete) __atomic_add_fetch(&heap_frees, 1, __ATOMIC_RELAXED);
+}
+}
+
+// Global operator new (BLE objects, std containers); its malloc is counted by
+// the heap wrapper when linked, so it is only charged to the scope without it
+static void *guarded_new(size_t size) {
+    void *p = malloc(size ? size : 1);
+    if (p == nullptr) {
+#if __cpp_exceptions
+        throw std::bad_alloc();
+#else
+        abort();
+#endif
+    }
+    if (boot_complete) {
+        __atomic_add_fetch(&new_allocs, 1, __ATOMIC_RELAXED);
+        if (!heap_wrapped && scope_task != nullptr && xTaskGetCurrentTaskHandle() == scope_task) {
+            __atomic_add_fetch(&scope_allocs, 1, __ATOMIC_RELAXED);
+        }
+    }
+    return p;
+}
+
+void *operator new(size_t size) { return guarded_new(size); }
+void *operator new[](size_t size) { return guarded_new(size); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+static alloc_guard_kind_t *find_kind(const char *kind) {
+    for (int i = 0; i < ALLOC_GUARD_MAX_KINDS; i++) {
+        if (kinds[i].kind == nullptr) {
+            kinds[i].kind = kind;
+            return &kinds[i];
+        }
+        if (strcmp(kinds[i].kind, kind) == 0) return &kinds[i];
+    }
+    return nullptr;
+}
+
+void alloc_guard_init(void) {
+    lv_mem_pool_set_alloc_hook(lvgl_alloc_hook);
+}
+
+void alloc_guard_mark_boot_complete(void) {
+    if (boot_complete) return;
+    boot_complete = true;
+    Serial.printf("[ALLOC] Boot complete - counting allocations (heap wrappers: %s)\n",
+                  heap_wrapped ? "yes" : "no - link with -Wl,--wrap=malloc,... to see malloc/realloc");
+}
+
+bool alloc_guard_boot_complete(void) {
+    return boot_complete;
+}
+
+void alloc_guard_scope_begin(void) {
+    scope_allocs = 0;
+    scope_task = xTaskGetCurrentTaskHandle();
+}
+
+uint32_t alloc_guard_scope_end(const char *kind) {
+    scope_task = nullptr;
+    uint32_t allocs = scope_allocs;
+    if (!boot_complete) return allocs;
+
+    alloc_guard_kind_t *k = find_kind(kind ? kind : "other");
+    if (k) {
+        k->messages++;
+        k->allocs += allocs;
+        if (allocs > k->max_allocs) k->max_allocs = allocs;
+        if (allocs > 0) k->violations++;
+    }
+    if (allocs > 0) {
+        total_violations++;
+        Serial.printf("[ALLOC] VIOLATION: %s message made %lu allocation(s)\n", kind, allocs);
+    }
+    return allocs;
+}
+
+uint32_t alloc_guard_violations(void) {
+    return total_violations;
+}
+
+void alloc_guard_log_stats(void) {
+    if (!boot_complete) return;
+    Serial.printf("[ALLOC] since boot: heap=%lu frees=%lu new=%lu lvgl=%lu violations=%lu\n",
+                  heap_allocs, heap_frees, new_allocs, lvgl_allocs, total_violations);
+    for (int i = 0; i < ALLOC_GUARD_MAX_KINDS && kinds[i].kind != nullptr; i++) {
+        const alloc_guard_kind_t *k = &kinds[i];
+        Serial.printf("[ALLOC] %s: messages=%lu violations=%lu allocs=%lu max=%lu\n",
+                      k->kind, k->messages, k->violations, k->allocs, k->max_allocs);
+    }
+}
+
+void alloc_guard_printf(const char *fmt, ...) {
+    char buf[ALLOC_GUARD_PRINTF_MAX];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (len <= 0) return;
+    if (len >= (int)sizeof(buf)) len = sizeof(buf) - 1;
+    Serial.write((const uint8_t *)buf, len);
+}
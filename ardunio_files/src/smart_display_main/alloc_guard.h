@@ -0,0 +1,84 @@
+#ifndef ALLOC_GUARD_H
+#define ALLOC_GUARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Allocation Guard
+// Counts heap allocations once boot is complete and checks that handling a
+// BLE message (navigation or call) does not allocate at all.
+// Sources: malloc/calloc/realloc/free through link-time wrappers, global
+// operator new and the LVGL pool.
+//
+// The wrappers need these linker flags (PlatformIO build_flags, or
+// compiler.c.elf.extra_flags with arduino-cli --build-property):
+//   -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=free
+// Without them String, ArduinoJson and Print::printf allocations are not
+// seen (only operator new and LVGL are); the boot log says which applies.
+// ============================================================================
+
+#define ALLOC_GUARD_MAX_KINDS     4     // Message kinds tracked separately
+#define ALLOC_GUARD_PRINTF_MAX    192   // alloc_guard_printf() line limit
+
+/**
+ * Install the LVGL pool hook
+ * Call once from setup() after lvgl_init()
+ */
+void alloc_guard_init(void);
+
+/**
+ * Mark boot as complete
+ * Allocations from here on are counted, and message scopes are checked.
+ */
+void alloc_guard_mark_boot_complete(void);
+
+/**
+ * Check if boot has been marked complete
+ */
+bool alloc_guard_boot_complete(void);
+
+/**
+ * Start counting allocations made by the calling task
+ * Scopes do not nest; one BLE message at a time.
+ */
+void alloc_guard_scope_begin(void);
+
+/**
+ * Stop counting and charge the result to a message kind
+ * Prints a violation if the scope allocated after boot.
+ * @param kind Message kind (string literal, e.g. "nav", "call")
+ * @return Allocations made inside the scope
+ */
+uint32_t alloc_guard_scope_end(const char *kind);
+
+/**
+ * Violations since boot complete (scopes that allocated)
+ */
+uint32_t alloc_guard_violations(void);
+
+/**
+ * Print allocation counters over serial
+ */
+void alloc_guard_log_stats(void);
+
+/**
+ * printf to Serial through a stack buffer
+ * Print::printf() mallocs for lines over 64 bytes; use this on message paths.
+ * Output is truncated to ALLOC_GUARD_PRINTF_MAX bytes.
+ */
+void alloc_guard_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * Scope helper for functions with several return paths
+ */
+class AllocGuardScope {
+public:
+    AllocGuardScope() : kind("other") { alloc_guard_scope_begin(); }
+    ~AllocGuardScope() { alloc_guard_scope_end(kind); }
+    void set_kind(const char *k) { kind = k; }
+private:
+    const char *kind;
+};
+
+#endif // ALLOC_GUARD_H
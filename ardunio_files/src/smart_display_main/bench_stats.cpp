@@ -0,0 +1,43 @@
+#include <string.h>
+#include "bench_stats.h"
+
+void bench_stats_percentiles(const uint32_t *samples, uint16_t count, uint32_t *scratch, uint32_t out[4]) {
+    if (count == 0) {
+        out[0] = out[1] = out[2] = out[3] = 0;
+        return;
+    }
+    memcpy(scratch, samples, count * sizeof(scratch[0]));
+    for (uint16_t i = 1; i < count; i++) {
+        uint32_t v = scratch[i];
+        int j = i - 1;
+        while (j >= 0 && scratch[j] > v) {
+            scratch[j + 1] = scratch[j];
+            j--;
+        }
+        scratch[j + 1] = v;
+    }
+    // Rank ceil(n * p / 100), 1-based
+    out[0] = scratch[((uint32_t)count * 50 + 99) / 100 - 1];
+    out[1] = scratch[((uint32_t)count * 95 + 99) / 100 - 1];
+    out[2] = scratch[((uint32_t)count * 99 + 99) / 100 - 1];
+    out[3] = scratch[count - 1];
+}
+
+const render_bench_baseline_t *bench_stats_find_baseline(const render_bench_baseline_t *table, const char *scenario) {
+    for (const render_bench_baseline_t *b = table; b->scenario != nullptr; b++) {
+        if (strcmp(b->scenario, scenario) == 0) return b;
+    }
+    return nullptr;
+}
+
+bool bench_stats_regressed(const render_bench_baseline_t *result, const render_bench_baseline_t *base,
+                           uint32_t time_tolerance_pct) {
+    uint64_t time_limit = (uint64_t)base->render_us * (100 + time_tolerance_pct) / 100;
+    return result->render_us > time_limit || result->inv_px > base->inv_px ||
+           result->flushes > base->flushes || result->heap > base->heap;
+}
+
+int32_t bench_stats_pct_change(uint32_t value, uint32_t base) {
+    if (base == 0) return value == 0 ? 0 : 100;
+    return (int32_t)(((int64_t)value - (int64_t)base) * 100 / (int64_t)base);
+}
@@ -0,0 +1,44 @@
+#ifndef BENCH_STATS_H
+#define BENCH_STATS_H
+
+#include <stdint.h>
+#include "render_bench.h"
+
+// ============================================================================
+// Benchmark statistics
+// Pure math shared by the benchmarks (no LVGL, no tasks), so it runs in the
+// host tests as well as on the device.
+// ============================================================================
+
+/**
+ * p50/p95/p99/max of a set of samples (nearest rank)
+ * Insertion sort: meant for a few hundred samples, once per run.
+ * @param samples Samples in any order (not modified)
+ * @param count Number of samples (0 gives all zeros)
+ * @param scratch Buffer of at least count entries for the sorted copy
+ * @param out p50, p95, p99 and max
+ */
+void bench_stats_percentiles(const uint32_t *samples, uint16_t count, uint32_t *scratch, uint32_t out[4]);
+
+/**
+ * Find a scenario's baseline
+ * @param table Baseline entries, ended by one with a nullptr scenario
+ * @return The entry, or nullptr if the scenario has none
+ */
+const render_bench_baseline_t *bench_stats_find_baseline(const render_bench_baseline_t *table, const char *scenario);
+
+/**
+ * Check a render result against its baseline
+ * Render time may be up to time_tolerance_pct percent slower; invalidated
+ * area, flush calls and heap change may not grow at all.
+ */
+bool bench_stats_regressed(const render_bench_baseline_t *result, const render_bench_baseline_t *base,
+                           uint32_t time_tolerance_pct);
+
+/**
+ * Change from a baseline value in percent (rounded toward zero)
+ * A zero baseline gives 0 if the value is still zero, else +100.
+ */
+int32_t bench_stats_pct_change(uint32_t value, uint32_t base);
+
+#endif // BENCH_STATS_H
@@ -0,0 +1,325 @@
+#include <Arduino.h>
+#include <string.h>
+#include "ble_frame.h"
+
+// Per stream sequence state
+typedef struct {
+    bool synced;             // Seen a frame since the last reset
+    uint16_t last_seq;       // Newest accepted sequence number
+    uint8_t ack_received;    // Frames since the last ack
+    uint8_t ack_dropped;
+    // Totals
+    uint32_t accepted;
+    uint32_t duplicates;
+    uint32_t stale;
+    uint32_t resyncs;
+} stream_state_t;
+
+static stream_state_t streams[BLE_STREAM_COUNT];
+
+// Partial message per stream (BLE task only)
+typedef struct {
+    bool active;
+    uint16_t last_seq;
+    uint32_t start_ms;
+    size_t len;
+    uint8_t buf[BLE_FRAME_REASSEMBLY_MAX];
+} reassembly_t;
+
+static reassembly_t partial[BLE_STREAM_COUNT];
+
+// Reassembly statistics
+static uint32_t fragments_received = 0;
+static uint32_t messages_reassembled = 0;
+static uint32_t reassembly_aborts = 0;
+static uint32_t reassembled_bytes = 0;
+static uint32_t reassembly_ms_total = 0;
+static uint32_t ack_pending = 0;            // Frames not yet covered by an ack
+static uint32_t ack_first_pending_ms = 0;
+static uint32_t acks_sent = 0;
+static uint32_t invalid_frames = 0;
+
+// Live sequence state set aside during a replay (ble_frame_save/ble_frame_restore)
+typedef struct {
+    bool synced;
+    uint16_t last_seq;
+    uint8_t ack_received;
+    uint8_t ack_dropped;
+} saved_stream_t;
+
+static saved_stream_t saved_streams[BLE_STREAM_COUNT];
+static uint32_t saved_ack_pending = 0;
+static uint32_t saved_ack_first_pending_ms = 0;
+static bool saved = false;
+
+// Frames are checked on the BLE task, acks are built in loop()
+static portMUX_TYPE frame_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *stream_names[BLE_STREAM_COUNT] = { "legacy", "nav", "call", "notify", "batch" };
+
+bool ble_frame_parse(const uint8_t *data, size_t len, ble_frame_t *out) {
+    out->has_header = false;
+    out->stream = BLE_STREAM_LEGACY;
+    out->flags = 0;
+    out->seq = 0;
+    out->payload = data;
+    out->payload_len = len;
+
+    if (len == 0 || data[0] != BLE_FRAME_MAGIC) return true;   // Legacy JSON
+    uint8_t stream = len >= BLE_FRAME_HEADER_LEN ? (data[1] & 0x0F) : BLE_STREAM_LEGACY;
+    if (stream == BLE_STREAM_LEGACY || stream >= BLE_STREAM_COUNT) {
+        invalid_frames++;
+        return false;
+    }
+
+    out->has_header = true;
+    out->stream = stream;
+    out->flags = data[1] >> 4;
+    out->seq = (uint16_t)(data[2] | (data[3] << 8));
+    out->payload = data + BLE_FRAME_HEADER_LEN;
+    out->payload_len = len - BLE_FRAME_HEADER_LEN;
+    return true;
+}
+
+BleFrameVerdict ble_frame_check(const ble_frame_t *frame) {
+    if (!frame->has_header) return BLE_FRAME_ACCEPT;
+
+    BleFrameVerdict verdict = BLE_FRAME_ACCEPT;
+    portENTER_CRITICAL(&frame_mux);
+    stream_state_t *s = &streams[frame->stream];
+
+    if (s->synced) {
+        // Wrap-safe distance from the last accepted frame
+        int16_t delta = (int16_t)(frame->seq - s->last_seq);
+        if (delta == 0) {
+            verdict = BLE_FRAME_DUPLICATE;
+        } else if (delta < 0 && delta > -BLE_FRAME_RESYNC_GAP) {
+            verdict = BLE_FRAME_STALE;
+        } else if (delta < 0) {
+            s->resyncs++;   // Far behind: the phone restarted its counter
+        }
+    }
+
+    if (verdict == BLE_FRAME_ACCEPT) {
+        s->synced = true;
+        s->last_seq = frame->seq;
+        s->accepted++;
+        if (s->ack_received < 0xFF) s->ack_received++;
+    } else {
+        if (verdict == BLE_FRAME_DUPLICATE) s->duplicates++;
+        else s->stale++;
+        if (s->ack_dropped < 0xFF) s->ack_dropped++;
+    }
+
+    if (ack_pending++ == 0) ack_first_pending_ms = millis();
+    portEXIT_CRITICAL(&frame_mux);
+    return verdict;
+}
+
+static void reassembly_abort(reassembly_t *r, const char *reason) {
+    if (r->active) {
+        reassembly_aborts++;
+        Serial.printf("[FRAME] Reassembly aborted (%s) after %u bytes\n", reason, (unsigned)r->len);
+    }
+    r->active = false;
+    r->len = 0;
+}
+
+bool ble_frame_reassemble(const ble_frame_t *frame, uint32_t now_ms,
+                          const uint8_t **out_payload, size_t *out_len) {
+    uint8_t frag = frame->flags & (BLE_FRAME_FLAG_START | BLE_FRAME_FLAG_CONT | BLE_FRAME_FLAG_END);
+    if (!frame->has_header || frag == 0 || frag == (BLE_FRAME_FLAG_START | BLE_FRAME_FLAG_END)) {
+        *out_payload = frame->payload;
+        *out_len = frame->payload_len;
+        return true;
+    }
+
+    reassembly_t *r = &partial[frame->stream];
+    fragments_received++;
+
+    if (frag & BLE_FRAME_FLAG_START) {
+        reassembly_abort(r, "restarted");
+        r->active = true;
+        r->start_ms = now_ms;
+    } else if (!r->active) {
+        reassembly_aborts++;    // Continuation without a START (its START was lost)
+        return false;
+    } else if (frame->seq != (uint16_t)(r->last_seq + 1)) {
+        reassembly_abort(r, "gap");
+        return false;
+    } else if (now_ms - r->start_ms > BLE_FRAME_REASSEMBLY_TIMEOUT) {
+        reassembly_abort(r, "timeout");
+        return false;
+    }
+
+    if (r->len + frame->payload_len > sizeof(r->buf)) {
+        reassembly_abort(r, "overflow");
+        return false;
+    }
+    memcpy(r->buf + r->len, frame->payload, frame->payload_len);
+    r->len += frame->payload_len;
+    r->last_seq = frame->seq;
+
+    if (!(frag & BLE_FRAME_FLAG_END)) return false;
+
+    r->active = false;
+    messages_reassembled++;
+    reassembled_bytes += r->len;
+    reassembly_ms_total += now_ms - r->start_ms;
+    *out_payload = r->buf;
+    *out_len = r->len;
+    return true;
+}
+
+bool ble_frame_next_sub(const uint8_t **cursor, const uint8_t *end, ble_frame_t *sub) {
+    const uint8_t *p = *cursor;
+    if (end - p < BLE_FRAME_SUB_HEADER_LEN) return false;
+
+    uint8_t stream = p[0];
+    size_t len = (size_t)(p[3] | (p[4] << 8));
+    if (stream == BLE_STREAM_LEGACY || stream >= BLE_STREAM_BATCH ||
+        (size_t)(end - p) - BLE_FRAME_SUB_HEADER_LEN < len) {
+        invalid_frames++;
+        return false;
+    }
+
+    sub->has_header = true;
+    sub->stream = stream;
+    sub->flags = 0;
+    sub->seq = (uint16_t)(p[1] | (p[2] << 8));
+    sub->payload = p + BLE_FRAME_SUB_HEADER_LEN;
+    sub->payload_len = len;
+    *cursor = p + BLE_FRAME_SUB_HEADER_LEN + len;
+    return true;
+}
+
+void ble_frame_reset(void) {
+    for (int i = 0; i < BLE_STREAM_COUNT; i++) {
+        partial[i].active = false;
+        partial[i].len = 0;
+    }
+    portENTER_CRITICAL(&frame_mux);
+    for (int i = 0; i < BLE_STREAM_COUNT; i++) {
+        streams[i].synced = false;
+        streams[i].ack_received = 0;
+        streams[i].ack_dropped = 0;
+    }
+    ack_pending = 0;
+    portEXIT_CRITICAL(&frame_mux);
+}
+
+void ble_frame_reset_live(void) {
+    portENTER_CRITICAL(&frame_mux);
+    bool replaying = saved;
+    if (replaying) {
+        memset(saved_streams, 0, sizeof(saved_streams));
+        saved_ack_pending = 0;
+    }
+    portEXIT_CRITICAL(&frame_mux);
+    if (!replaying) ble_frame_reset();
+}
+
+void ble_frame_save(void) {
+    portENTER_CRITICAL(&frame_mux);
+    for (int i = 0; i < BLE_STREAM_COUNT; i++) {
+        saved_streams[i].synced = streams[i].synced;
+        saved_streams[i].last_seq = streams[i].last_seq;
+        saved_streams[i].ack_received = streams[i].ack_received;
+        saved_streams[i].ack_dropped = streams[i].ack_dropped;
+    }
+    saved_ack_pending = ack_pending;
+    saved_ack_first_pending_ms = ack_first_pending_ms;
+    saved = true;
+    portEXIT_CRITICAL(&frame_mux);
+}
+
+void ble_frame_restore(void) {
+    for (int i = 0; i < BLE_STREAM_COUNT; i++) {
+        partial[i].active = false;
+        partial[i].len = 0;
+    }
+    portENTER_CRITICAL(&frame_mux);
+    if (saved) {
+        for (int i = 0; i < BLE_STREAM_COUNT; i++) {
+            streams[i].synced = saved_streams[i].synced;
+            streams[i].last_seq = saved_streams[i].last_seq;
+            streams[i].ack_received = saved_streams[i].ack_received;
+            streams[i].ack_dropped = saved_streams[i].ack_dropped;
+        }
+        ack_pending = saved_ack_pending;
+        ack_first_pending_ms = saved_ack_first_pending_ms;
+        saved = false;
+    }
+    portEXIT_CRITICAL(&frame_mux);
+}
+
+bool ble_frame_ack_due(uint32_t now_ms) {
+    portENTER_CRITICAL(&frame_mux);
+    bool due = ack_pending >= BLE_FRAME_ACK_EVERY ||
+               (ack_pending > 0 && now_ms - ack_first_pending_ms >= BLE_FRAME_ACK_MAX_DELAY);
+    portEXIT_CRITICAL(&frame_mux);
+    return due;
+}
+
+size_t ble_frame_build_ack(uint8_t *buf, size_t size) {
+    if (size < BLE_FRAME_ACK_MAX_LEN) return 0;
+
+    size_t len = 3;
+    uint8_t count = 0;
+    portENTER_CRITICAL(&frame_mux);
+    for (int i = BLE_STREAM_NAV; i < BLE_STREAM_COUNT; i++) {
+        stream_state_t *s = &streams[i];
+        if (s->ack_received == 0 && s->ack_dropped == 0) continue;
+        buf[len++] = (uint8_t)i;
+        buf[len++] = (uint8_t)(s->last_seq & 0xFF);
+        buf[len++] = (uint8_t)(s->last_seq >> 8);
+        buf[len++] = s->ack_received;
+        buf[len++] = s->ack_dropped;
+        s->ack_received = 0;
+        s->ack_dropped = 0;
+        count++;
+    }
+    ack_pending = 0;
+    portEXIT_CRITICAL(&frame_mux);
+
+    if (count == 0) return 0;
+    buf[0] = BLE_FRAME_MAGIC;
+    buf[1] = BLE_FRAME_ACK_TYPE;
+    buf[2] = count;
+    acks_sent++;
+    return len;
+}
+
+uint32_t ble_frame_dropped_total(void) {
+    uint32_t total = invalid_frames + reassembly_aborts;
+    portENTER_CRITICAL(&frame_mux);
+    for (int i = BLE_STREAM_NAV; i < BLE_STREAM_COUNT; i++) {
+        total += streams[i].duplicates + streams[i].stale;
+    }
+    portEXIT_CRITICAL(&frame_mux);
+    return total;
+}
+
+uint32_t ble_frame_ack_backlog(void) {
+    portENTER_CRITICAL(&frame_mux);
+    uint32_t pending = ack_pending;
+    portEXIT_CRITICAL(&frame_mux);
+    return pending;
+}
+
+void ble_frame_log_stats(void) {
+    for (int i = BLE_STREAM_NAV; i < BLE_STREAM_COUNT; i++) {
+        const stream_state_t *s = &streams[i];
+        if (s->accepted == 0 && s->duplicates == 0 && s->stale == 0) continue;
+        Serial.printf("[FRAME] %s: accepted=%lu duplicate=%lu stale=%lu resyncs=%lu last_seq=%u\n",
+                      stream_names[i], s->accepted, s->duplicates, s->stale, s->resyncs, s->last_seq);
+    }
+    Serial.printf("[FRAME] acks sent=%lu invalid=%lu\n", acks_sent, invalid_frames);
+    if (fragments_received > 0) {
+        // Effective rate from START to END of fragmented messages
+        Serial.printf("[FRAME] fragments=%lu reassembled=%lu (%lu bytes, %lu B/s) aborted=%lu\n",
+                      fragments_received, messages_reassembled, reassembled_bytes,
+                      reassembly_ms_total ? (uint32_t)((uint64_t)reassembled_bytes * 1000 / reassembly_ms_total) : 0,
+                      reassembly_aborts);
+    }
+}
@@ -0,0 +1,165 @@
+#ifndef BLE_FRAME_H
+#define BLE_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// BLE frame header, per-stream sequence checking and batched acknowledgements
+//
+// Frame:  [0xA5] [flags:4 | stream:4] [seq lo] [seq hi] [payload...]
+// Legacy: a bare JSON document (first byte '{') - no ordering, never acked
+//
+// Payloads larger than one write are split into fragments with consecutive
+// sequence numbers: START, CONT..., END. A frame without fragment flags is a
+// complete message.
+//
+// Batch (stream 4): the message is a list of sub-messages, each sequenced on
+// its own stream:  n x { [stream] [seq lo] [seq hi] [len lo] [len hi] [payload...] }
+//
+// Ack (NOTIFY on the same characteristic):
+//   [0xA5] ['A'] [n] then n x { [stream] [last seq lo] [last seq hi] [received] [dropped] }
+//   'last seq' is the newest frame accepted on that stream; 'received' and
+//   'dropped' count frames since the previous ack (dropped = stale or duplicate)
+// ============================================================================
+
+#define BLE_FRAME_MAGIC           0xA5
+#define BLE_FRAME_HEADER_LEN      4
+#define BLE_FRAME_ACK_TYPE        'A'
+
+#define BLE_FRAME_ACK_EVERY       4       // Ack after this many frames...
+#define BLE_FRAME_ACK_MAX_DELAY   200     // ...or this long after the first unacked one (ms)
+#define BLE_FRAME_RESYNC_GAP      1024    // A jump back this far means the sender restarted
+#define BLE_FRAME_ACK_MAX_LEN     (3 + 5 * BLE_STREAM_COUNT)
+
+// Fragment flags (header high nibble)
+#define BLE_FRAME_FLAG_START      0x1
+#define BLE_FRAME_FLAG_CONT       0x2
+#define BLE_FRAME_FLAG_END        0x4
+
+#define BLE_FRAME_SUB_HEADER_LEN  5
+
+#define BLE_FRAME_REASSEMBLY_MAX      1024   // Largest reassembled payload (per stream)
+#define BLE_FRAME_REASSEMBLY_TIMEOUT  1000   // A message must complete this soon after its START (ms)
+
+/**
+ * Logical streams (one sequence space each)
+ */
+enum BleStream {
+    BLE_STREAM_LEGACY = 0,      // Headerless JSON
+    BLE_STREAM_NAV = 1,
+    BLE_STREAM_CALL = 2,
+    BLE_STREAM_NOTIFY = 3,
+    BLE_STREAM_BATCH = 4,       // Container for messages of the other streams
+    BLE_STREAM_COUNT
+};
+
+/**
+ * Result of the sequence check
+ */
+enum BleFrameVerdict {
+    BLE_FRAME_ACCEPT = 0,
+    BLE_FRAME_DUPLICATE,        // Same sequence number as the last accepted frame
+    BLE_FRAME_STALE             // Older than the last accepted frame (arrived out of order)
+};
+
+/**
+ * Parsed frame (payload points into the caller's buffer)
+ */
+typedef struct {
+    bool has_header;
+    uint8_t stream;
+    uint8_t flags;
+    uint16_t seq;
+    const uint8_t *payload;
+    size_t payload_len;
+} ble_frame_t;
+
+/**
+ * Split a received write into header and payload
+ * Headerless JSON is returned as a legacy frame with the whole buffer as payload.
+ * @return false if the header is malformed
+ */
+bool ble_frame_parse(const uint8_t *data, size_t len, ble_frame_t *out);
+
+/**
+ * Check a frame's sequence number against its stream and record it for the next ack
+ * Legacy frames are always accepted. Safe to call from the BLE task.
+ */
+BleFrameVerdict ble_frame_check(const ble_frame_t *frame);
+
+/**
+ * Feed an accepted frame through fragment reassembly
+ * Unfragmented and legacy frames pass straight through. A gap in the
+ * sequence, an overflow or a timeout discards the partial message.
+ * BLE task only; the returned payload stays valid until the stream's next START.
+ * @param now_ms Current time (millis())
+ * @param out_payload Set to the complete message
+ * @param out_len Set to the message length
+ * @return true when a complete message is ready
+ */
+bool ble_frame_reassemble(const ble_frame_t *frame, uint32_t now_ms,
+                          const uint8_t **out_payload, size_t *out_len);
+
+/**
+ * Read the next sub-message of a batch
+ * The result is a headered frame (check it with ble_frame_check() like any other).
+ * @param cursor Read position inside the batch payload (advanced past the sub-message)
+ * @param end End of the batch payload
+ * @return false at the end of the batch or on a malformed entry
+ */
+bool ble_frame_next_sub(const uint8_t **cursor, const uint8_t *end, ble_frame_t *sub);
+
+/**
+ * Forget all sequence state (a new sender, or a replay's connect marker)
+ */
+void ble_frame_reset(void);
+
+/**
+ * Reset for a connect or disconnect
+ * While a replay runs the live state is the saved one, so that is reset instead
+ * and the replay keeps its own.
+ */
+void ble_frame_reset_live(void);
+
+/**
+ * Set the live sequence and ack state aside before a replay feeds its own frames
+ * (live writes are ignored meanwhile; a partial live message is not kept)
+ */
+void ble_frame_save(void);
+
+/**
+ * Put the state saved by ble_frame_save() back once the replay ends
+ * The replay's partial messages are discarded. No-op if nothing was saved.
+ */
+void ble_frame_restore(void);
+
+/**
+ * Check if an acknowledgement should be sent now
+ * @param now_ms Current time (millis())
+ */
+bool ble_frame_ack_due(uint32_t now_ms);
+
+/**
+ * Build the pending acknowledgement and clear the per-ack counters
+ * @param buf Output buffer (at least BLE_FRAME_ACK_MAX_LEN bytes)
+ * @return Bytes written (0 if nothing is pending)
+ */
+size_t ble_frame_build_ack(uint8_t *buf, size_t size);
+
+/**
+ * Frames dropped since boot (stale, duplicate, malformed or lost to an aborted reassembly)
+ */
+uint32_t ble_frame_dropped_total(void);
+
+/**
+ * Frames received but not yet covered by an acknowledgement
+ */
+uint32_t ble_frame_ack_backlog(void);
+
+/**
+ * Print accepted/duplicate/stale counts per stream and reassembly stats over serial
+ */
+void ble_frame_log_stats(void);
+
+#endif // BLE_FRAME_H
@@ -0,0 +1,161 @@
+#include <Arduino.h>
+#include <string.h>
+#include "caller_directory.h"
+
+// Table writes and lookups happen on the BLE task (and on replays), the
+// flush hook on the UI task
+typedef struct {
+    uint16_t id;                                // 0 = empty slot
+    uint32_t number_hash;
+    char name[CALLER_DIRECTORY_NAME_LEN];
+} caller_entry_t;
+
+// Per frame form (by contact ID / by name and number)
+typedef struct {
+    uint32_t frames;
+    uint32_t bytes;
+    uint32_t incoming;                          // Incoming-call screens timed
+    uint32_t latency_sum_us;
+    uint32_t latency_max_us;
+} caller_form_stats_t;
+
+static caller_entry_t table[CALLER_DIRECTORY_SLOTS];
+static uint8_t entry_count = 0;
+static portMUX_TYPE table_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static caller_form_stats_t form_stats[2];       // [by_id]
+static uint32_t stat_lookups = 0;
+static uint32_t stat_misses = 0;
+static uint32_t stat_probes = 0;
+static uint32_t stat_rejected = 0;
+
+static portMUX_TYPE latency_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool incoming_pending = false;
+static bool incoming_by_id = false;
+static uint32_t incoming_write_us = 0;
+
+// Fibonacci hashing: consecutive IDs spread over the table
+static inline uint32_t home_slot(uint16_t id) {
+    return ((uint32_t)id * 40503u) >> 10 & (CALLER_DIRECTORY_SLOTS - 1);
+}
+
+// Slot holding id, or the empty slot where it would go (table_mux held)
+static int find_slot(uint16_t id, uint32_t *probes) {
+    uint32_t slot = home_slot(id);
+    for (uint32_t probe = 0; probe < CALLER_DIRECTORY_SLOTS; probe++) {
+        (*probes)++;
+        if (table[slot].id == id || table[slot].id == 0) return (int)slot;
+        slot = (slot + 1) & (CALLER_DIRECTORY_SLOTS - 1);
+    }
+    return -1;
+}
+
+uint32_t caller_directory_hash_number(const char *number) {
+    if (number == nullptr) return 0;
+
+    // Only the trailing digits count (country code and formatting vary)
+    size_t digits = 0;
+    for (const char *p = number; *p; p++) {
+        if (*p >= '0' && *p <= '9') digits++;
+    }
+    if (digits == 0) return 0;
+
+    size_t skip = digits > CALLER_DIRECTORY_HASH_DIGITS ? digits - CALLER_DIRECTORY_HASH_DIGITS : 0;
+    uint32_t hash = 2166136261u;
+    for (const char *p = number; *p; p++) {
+        if (*p < '0' || *p > '9') continue;
+        if (skip > 0) {
+            skip--;
+            continue;
+        }
+        hash ^= (uint8_t)*p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void caller_directory_clear(void) {
+    portENTER_CRITICAL(&table_mux);
+    memset(table, 0, sizeof(table));
+    entry_count = 0;
+    portEXIT_CRITICAL(&table_mux);
+}
+
+bool caller_directory_put(uint16_t id, uint32_t number_hash, const char *name) {
+    if (id == 0) return false;
+    bool stored = false;
+    uint32_t probes = 0;
+    portENTER_CRITICAL(&table_mux);
+    int slot = find_slot(id, &probes);
+    if (slot >= 0 && (table[slot].id == id || entry_count < CALLER_DIRECTORY_MAX_ENTRIES)) {
+        if (table[slot].id == 0) entry_count++;
+        table[slot].id = id;
+        table[slot].number_hash = number_hash;
+        strlcpy(table[slot].name, name ? name : "", sizeof(table[slot].name));
+        stored = true;
+    } else {
+        stat_rejected++;
+    }
+    portEXIT_CRITICAL(&table_mux);
+    return stored;
+}
+
+bool caller_directory_lookup(uint16_t id, char *name, size_t name_size, uint32_t *number_hash) {
+    if (id == 0) return false;
+    bool found = false;
+    portENTER_CRITICAL(&table_mux);
+    stat_lookups++;
+    int slot = find_slot(id, &stat_probes);
+    if (slot >= 0 && table[slot].id == id) {
+        strlcpy(name, table[slot].name, name_size);
+        if (number_hash) *number_hash = table[slot].number_hash;
+        found = true;
+    } else {
+        stat_misses++;
+    }
+    portEXIT_CRITICAL(&table_mux);
+    return found;
+}
+
+void caller_directory_record_call_frame(size_t len, bool by_id) {
+    caller_form_stats_t *s = &form_stats[by_id ? 1 : 0];
+    s->frames++;
+    s->bytes += len;
+}
+
+void caller_directory_mark_incoming(uint32_t write_us, bool by_id) {
+    portENTER_CRITICAL(&latency_mux);
+    incoming_pending = true;
+    incoming_by_id = by_id;
+    incoming_write_us = write_us;
+    portEXIT_CRITICAL(&latency_mux);
+}
+
+void caller_directory_record_flush(bool last) {
+    if (!last || !incoming_pending) return;
+    uint32_t now_us = micros();
+    portENTER_CRITICAL(&latency_mux);
+    if (incoming_pending) {
+        caller_form_stats_t *s = &form_stats[incoming_by_id ? 1 : 0];
+        uint32_t latency_us = now_us - incoming_write_us;
+        s->incoming++;
+        s->latency_sum_us += latency_us;
+        if (latency_us > s->latency_max_us) s->latency_max_us = latency_us;
+        incoming_pending = false;
+    }
+    portEXIT_CRITICAL(&latency_mux);
+}
+
+void caller_directory_log_stats(void) {
+    Serial.printf("[CALLERS] entries=%u/%d lookups=%lu misses=%lu probes/lookup=%lu.%02lu rejected=%lu\n",
+                  entry_count, CALLER_DIRECTORY_MAX_ENTRIES, stat_lookups, stat_misses,
+                  stat_lookups ? stat_probes / stat_lookups : 0,
+                  stat_lookups ? (stat_probes * 100 / stat_lookups) % 100 : 0, stat_rejected);
+    static const char *const form_names[2] = { "by name", "by id" };
+    for (int i = 0; i < 2; i++) {
+        const caller_form_stats_t *s = &form_stats[i];
+        Serial.printf("[CALLERS] %-7s frames=%lu avg=%luB incoming=%lu write->glass avg=%luus max=%luus\n",
+                      form_names[i], s->frames, s->frames ? s->bytes / s->frames : 0,
+                      s->incoming, s->incoming ? s->latency_sum_us / s->incoming : 0, s->latency_max_us);
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef CALLER_DIRECTORY_H
+#define CALLER_DIRECTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Caller directory
+// The phone pushes its most frequent callers once per connection:
+//   {"type":"contacts","reset":true,"c":[[id,"name",number_hash],...]}
+// (several messages for a long list; "reset" only on the first). Call frames
+// for a listed caller then carry {"contact":id} instead of caller_name and
+// caller_number.
+//
+// Entries live in a fixed open-addressing table keyed by the 16-bit ID
+// (linear probing, cleared as a whole on disconnect, never deleted singly).
+//
+// Number hash: FNV-1a (32-bit) over the last CALLER_DIRECTORY_HASH_DIGITS
+// digits of the number, so "+91 98765 43210" and "9876543210" match; the
+// phone computes the same hash (CallerDirectory.kt).
+// ============================================================================
+
+#define CALLER_DIRECTORY_SLOTS        64   // Power of two
+#define CALLER_DIRECTORY_MAX_ENTRIES  48   // Keeps the table at most 75% full
+#define CALLER_DIRECTORY_NAME_LEN     32
+#define CALLER_DIRECTORY_HASH_DIGITS  10
+
+/**
+ * Hash a phone number the way the phone does (0 for a number without digits)
+ */
+uint32_t caller_directory_hash_number(const char *number);
+
+/**
+ * Drop every entry (new connection, or a "reset" contacts message)
+ */
+void caller_directory_clear(void);
+
+/**
+ * Add or replace an entry
+ * @param id Contact ID (1-65535)
+ * @return false for ID 0 or a full table
+ */
+bool caller_directory_put(uint16_t id, uint32_t number_hash, const char *name);
+
+/**
+ * Look up a contact ID
+ * @param name Output buffer for the display name
+ * @param number_hash Output (may be nullptr)
+ * @return false if the ID is not in the table
+ */
+bool caller_directory_lookup(uint16_t id, char *name, size_t name_size, uint32_t *number_hash);
+
+/**
+ * Count a received call frame (BLE task)
+ * @param by_id True if it carried a contact ID instead of name and number
+ */
+void caller_directory_record_call_frame(size_t len, bool by_id);
+
+/**
+ * Start timing an incoming-call screen: from its write to the end of the next flushed frame
+ * @param write_us micros() when the write was received
+ */
+void caller_directory_mark_incoming(uint32_t write_us, bool by_id);
+
+/**
+ * Record one flushed area (display flush callback)
+ * @param last True for the last area of a frame
+ */
+void caller_directory_record_flush(bool last);
+
+/**
+ * Print table, frame size and incoming latency statistics over serial
+ */
+void caller_directory_log_stats(void);
+
+#endif // CALLER_DIRECTORY_H
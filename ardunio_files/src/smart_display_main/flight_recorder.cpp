@@ -0,0 +1,495 @@
+#include <Arduino.h>
+#include <string.h>
+#include "esp_partition.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "flight_recorder.h"
+
+static_assert(FLIGHT_RECORD_HEADER_LEN == 16, "flight record layout changed - update the phone's decoder");
+
+#define WRITER_STACK_SIZE  6144   // Replay runs the whole message path on this task
+#define WRITER_PRIORITY    1      // Same as loop(): flash work never preempts rendering
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint32_t seq;                    // Increments with every sector started
+    uint32_t first_seq;              // Oldest sector that belongs to the log
+    uint32_t first_index;            // Index of the sector's first record
+} sector_header_t;
+
+static const esp_partition_t *partition = nullptr;
+static uint32_t sector_count = 0;
+static bool ready = false;
+static flight_recorder_sink_t replay_sink = nullptr;
+static TaskHandle_t writer_task = nullptr;
+static SemaphoreHandle_t flash_lock = nullptr;   // Writer task vs dump reads
+
+// Write position (writer task; read by the dump while holding flash_lock)
+static uint32_t cur_sector = 0;
+static uint32_t cur_seq = 0;
+static uint32_t first_seq = 1;
+static uint32_t write_offset = 0;
+static uint32_t next_index = 0;
+
+// Staged records (BLE task -> writer task)
+static portMUX_TYPE staging_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t staging[FLIGHT_RECORDER_STAGING_SIZE];
+static size_t staging_len = 0;
+static uint8_t flush_buf[FLIGHT_RECORDER_STAGING_SIZE];   // Writer task only
+
+// Requests from commands (BLE task), handled by the writer task
+static volatile bool clear_requested = false;
+static volatile bool replay_requested = false;
+static volatile bool stop_requested = false;
+static volatile uint8_t replay_speed = 1;
+static volatile bool replaying = false;
+static volatile bool dump_active = false;
+
+// Dump cursor (UI task)
+static bool dump_started = false;
+static uint32_t dump_seq = 0;
+static uint32_t dump_offset = 0;     // 0: sector header not read yet
+static uint32_t dump_remaining = 0;  // Bytes of the current record still to send
+static uint16_t dump_chunk = 0;
+static uint32_t dump_records = 0;
+
+// Statistics
+static uint32_t records_written = 0;
+static uint32_t staged_dropped = 0;
+static uint32_t flushes = 0;
+static uint32_t flash_writes = 0;
+static uint32_t sector_erases = 0;
+static uint32_t flash_errors = 0;
+static uint32_t last_flush_ms = 0;
+
+static uint32_t sector_addr(uint32_t sector) {
+    return sector * FLIGHT_RECORDER_SECTOR_SIZE;
+}
+
+// Ring position of a sector sequence number (within the last sector_count sectors)
+static uint32_t sector_of(uint32_t seq) {
+    return (cur_sector + sector_count - (cur_seq - seq) % sector_count) % sector_count;
+}
+
+static uint32_t oldest_seq(void) {
+    uint32_t oldest = (cur_seq >= sector_count) ? cur_seq - sector_count + 1 : 1;
+    return (oldest > first_seq) ? oldest : first_seq;
+}
+
+static bool read_sector_header(uint32_t sector, sector_header_t *hdr) {
+    return esp_partition_read(partition, sector_addr(sector), hdr, sizeof(*hdr)) == ESP_OK &&
+           hdr->magic == FLIGHT_RECORDER_SECTOR_MAGIC;
+}
+
+// Read the record header at a sector offset; false at the end of the sector's records
+static bool read_record_header(uint32_t sector, uint32_t offset, flight_record_header_t *rec) {
+    if (offset + FLIGHT_RECORD_HEADER_LEN > FLIGHT_RECORDER_SECTOR_SIZE) return false;
+    if (esp_partition_read(partition, sector_addr(sector) + offset, rec, sizeof(*rec)) != ESP_OK) return false;
+    // Erased flash reads as length 0xFFFF
+    return rec->length <= FLIGHT_RECORDER_MAX_FRAME &&
+           offset + FLIGHT_RECORD_HEADER_LEN + rec->length <= FLIGHT_RECORDER_SECTOR_SIZE;
+}
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+static uint16_t crc16(uint16_t crc, const uint8_t *data, size_t len) {
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t record_crc(const flight_record_header_t *rec, const uint8_t *data) {
+    flight_record_header_t copy = *rec;
+    copy.crc = 0;
+    uint16_t crc = crc16(0xFFFF, (const uint8_t *)&copy, sizeof(copy));
+    return crc16(crc, data, rec->length);
+}
+
+// Erase a sector and make it the write position
+static void start_sector(uint32_t sector, uint32_t seq) {
+    cur_sector = sector;
+    cur_seq = seq;
+    write_offset = FLIGHT_RECORDER_SECTOR_SIZE;   // Full until the header is down
+
+    if (esp_partition_erase_range(partition, sector_addr(sector), FLIGHT_RECORDER_SECTOR_SIZE) != ESP_OK) {
+        flash_errors++;
+        return;
+    }
+    sector_erases++;
+    sector_header_t hdr = { FLIGHT_RECORDER_SECTOR_MAGIC, seq, first_seq, next_index };
+    if (esp_partition_write(partition, sector_addr(sector), &hdr, sizeof(hdr)) != ESP_OK) {
+        flash_errors++;
+        return;
+    }
+    write_offset = sizeof(hdr);
+}
+
+static void advance_sector(void) {
+    start_sector((cur_sector + 1) % sector_count, cur_seq + 1);
+}
+
+// Continue after the newest record in flash (or start a new log)
+static void resume(void) {
+    bool found = false;
+    sector_header_t newest;
+    for (uint32_t sector = 0; sector < sector_count; sector++) {
+        sector_header_t hdr;
+        if (!read_sector_header(sector, &hdr)) continue;
+        if (!found || hdr.seq > newest.seq) {
+            newest = hdr;
+            cur_sector = sector;
+            found = true;
+        }
+    }
+    if (!found) {
+        first_seq = 1;
+        next_index = 0;
+        start_sector(0, 1);
+        Serial.printf("[FLIGHTREC] New log: %lu sectors of %u bytes\n", sector_count, FLIGHT_RECORDER_SECTOR_SIZE);
+        return;
+    }
+
+    cur_seq = newest.seq;
+    first_seq = newest.first_seq;
+    next_index = newest.first_index;
+    uint32_t offset = sizeof(sector_header_t);
+    flight_record_header_t rec;
+    memset(&rec, 0xFF, sizeof(rec));
+    while (read_record_header(cur_sector, offset, &rec)) {
+        offset += FLIGHT_RECORD_HEADER_LEN + rec.length;
+        next_index = rec.index + 1;
+    }
+    write_offset = offset;
+    // Anything but erased flash after the last record is a torn write: leave the rest of this sector alone
+    if (offset + FLIGHT_RECORD_HEADER_LEN <= FLIGHT_RECORDER_SECTOR_SIZE && rec.length != 0xFFFF) {
+        write_offset = FLIGHT_RECORDER_SECTOR_SIZE;
+    }
+    Serial.printf("[FLIGHTREC] Resumed at record %lu (sector %lu, seq %lu, %lu/%u bytes used)\n",
+                  next_index, cur_sector, cur_seq, write_offset, FLIGHT_RECORDER_SECTOR_SIZE);
+}
+
+static void stage(const uint8_t *data, size_t len, uint8_t source, uint8_t flags) {
+    if (!ready || replaying) return;
+    if (len > FLIGHT_RECORDER_MAX_FRAME) len = FLIGHT_RECORDER_MAX_FRAME;
+
+    // Index and CRC are filled in by the writer
+    flight_record_header_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.length = (uint16_t)len;
+    rec.source = source;
+    rec.flags = flags;
+    rec.time_ms = millis();
+
+    bool wake = false;
+    portENTER_CRITICAL(&staging_mux);
+    if (staging_len + FLIGHT_RECORD_HEADER_LEN + len <= sizeof(staging)) {
+        memcpy(staging + staging_len, &rec, FLIGHT_RECORD_HEADER_LEN);
+        if (len > 0) memcpy(staging + staging_len + FLIGHT_RECORD_HEADER_LEN, data, len);
+        staging_len += FLIGHT_RECORD_HEADER_LEN + len;
+        wake = staging_len >= sizeof(staging) / 2;
+    } else {
+        staged_dropped++;
+    }
+    portEXIT_CRITICAL(&staging_mux);
+
+    if (wake) xTaskNotifyGive(writer_task);
+}
+
+static void write_run(const uint8_t *data, size_t len) {
+    if (len == 0) return;
+    if (esp_partition_write(partition, sector_addr(cur_sector) + write_offset, data, len) != ESP_OK) {
+        flash_errors++;
+    } else {
+        flash_writes++;
+    }
+    write_offset += len;
+}
+
+// Move staged records to flash: one write per sector touched (writer task, flash_lock held)
+static void flush_staging(void) {
+    portENTER_CRITICAL(&staging_mux);
+    size_t len = staging_len;
+    memcpy(flush_buf, staging, len);
+    staging_len = 0;
+    portEXIT_CRITICAL(&staging_mux);
+    if (len == 0) return;
+
+    uint32_t started_ms = millis();
+    size_t pos = 0;
+    size_t run_start = 0;
+    size_t run_len = 0;
+    while (pos < len) {
+        flight_record_header_t *rec = (flight_record_header_t *)(flush_buf + pos);
+        size_t total = FLIGHT_RECORD_HEADER_LEN + rec->length;
+        // Records never span sectors
+        if (write_offset + run_len + total > FLIGHT_RECORDER_SECTOR_SIZE) {
+            write_run(flush_buf + run_start, run_len);
+            advance_sector();
+            run_start = pos;
+            run_len = 0;
+        }
+        rec->index = next_index++;
+        rec->crc = record_crc(rec, flush_buf + pos + FLIGHT_RECORD_HEADER_LEN);
+        run_len += total;
+        pos += total;
+        records_written++;
+    }
+    write_run(flush_buf + run_start, run_len);
+    flushes++;
+    last_flush_ms = millis() - started_ms;
+}
+
+static void clear_log(void) {
+    portENTER_CRITICAL(&staging_mux);
+    staging_len = 0;
+    portEXIT_CRITICAL(&staging_mux);
+    first_seq = cur_seq + 1;   // Older sectors stop counting; they are erased as the ring reaches them
+    advance_sector();
+    Serial.println("[FLIGHTREC] Log cleared");
+}
+
+// Feed every record to the sink at the recorded pace (writer task)
+static void replay(void) {
+    static uint8_t data[FLIGHT_RECORDER_MAX_FRAME];
+    flush_staging();   // Everything received so far is part of the replay
+
+    uint8_t speed = replay_speed;
+    uint32_t started_ms = millis();
+    uint32_t count = 0;
+    uint32_t bad = 0;
+    uint32_t prev_time_ms = 0;
+    bool have_prev = false;
+    if (speed == 0) {
+        Serial.println("[FLIGHTREC] Replay started (as fast as possible)");
+    } else {
+        Serial.printf("[FLIGHTREC] Replay started (%ux)\n", speed);
+    }
+
+    for (uint32_t seq = oldest_seq(); seq <= cur_seq && !stop_requested; seq++) {
+        uint32_t sector = sector_of(seq);
+        sector_header_t hdr;
+        if (!read_sector_header(sector, &hdr) || hdr.seq != seq) continue;
+
+        uint32_t offset = sizeof(hdr);
+        flight_record_header_t rec;
+        while (!stop_requested && read_record_header(sector, offset, &rec)) {
+            esp_partition_read(partition, sector_addr(sector) + offset + FLIGHT_RECORD_HEADER_LEN, data, rec.length);
+            offset += FLIGHT_RECORD_HEADER_LEN + rec.length;
+            if (record_crc(&rec, data) != rec.crc) {
+                bad++;
+                continue;
+            }
+
+            if (rec.flags & FLIGHT_RECORD_FLAG_BOOT) have_prev = false;   // millis() restarted
+            if (speed > 0 && have_prev && rec.time_ms > prev_time_ms) {
+                uint32_t gap_ms = rec.time_ms - prev_time_ms;
+                if (gap_ms > FLIGHT_RECORDER_REPLAY_MAX_GAP_MS) gap_ms = FLIGHT_RECORDER_REPLAY_MAX_GAP_MS;
+                vTaskDelay(pdMS_TO_TICKS(gap_ms / speed));
+            } else {
+                taskYIELD();
+            }
+            prev_time_ms = rec.time_ms;
+            have_prev = true;
+
+            replay_sink(&rec, data);
+            count++;
+        }
+    }
+
+    replay_sink(nullptr, nullptr);
+    Serial.printf("[FLIGHTREC] Replay %s: %lu records (%lu failed CRC) in %lu ms\n",
+                  stop_requested ? "stopped" : "done", count, bad, millis() - started_ms);
+    replaying = false;
+}
+
+static void writer_task_fn(void *arg) {
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(FLIGHT_RECORDER_FLUSH_MS));
+        xSemaphoreTake(flash_lock, portMAX_DELAY);
+        // A dump reads a stable log: records stay staged until it ends
+        if (!dump_active) {
+            if (clear_requested) {
+                clear_requested = false;
+                clear_log();
+            } else if (replay_requested) {
+                replay_requested = false;
+                replay();
+            } else {
+                flush_staging();
+            }
+        }
+        xSemaphoreGive(flash_lock);
+    }
+}
+
+bool flight_recorder_init(flight_recorder_sink_t sink) {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                         FLIGHT_RECORDER_PARTITION_LABEL);
+    if (partition == nullptr) {
+        Serial.println("[FLIGHTREC] No '" FLIGHT_RECORDER_PARTITION_LABEL "' partition (see partitions.csv) - recorder disabled");
+        return false;
+    }
+    sector_count = partition->size / FLIGHT_RECORDER_SECTOR_SIZE;
+    if (sector_count < 2) {
+        Serial.println("[FLIGHTREC] Partition smaller than two sectors - recorder disabled");
+        return false;
+    }
+
+    replay_sink = sink;
+    flash_lock = xSemaphoreCreateMutex();
+    resume();
+    if (xTaskCreate(writer_task_fn, "flightrec", WRITER_STACK_SIZE, nullptr, WRITER_PRIORITY, &writer_task) != pdPASS) {
+        Serial.println("[FLIGHTREC] Writer task not created - recorder disabled");
+        return false;
+    }
+    ready = true;
+    stage(nullptr, 0, 0, FLIGHT_RECORD_FLAG_BOOT);
+    return true;
+}
+
+void flight_recorder_record(const uint8_t *data, size_t len, uint8_t source) {
+    stage(data, len, source, 0);
+}
+
+void flight_recorder_mark_connect(void) {
+    stage(nullptr, 0, 0, FLIGHT_RECORD_FLAG_CONNECT);
+}
+
+bool flight_recorder_command(const uint8_t *data, size_t len) {
+    if (!ready || len == 0) return false;
+
+    switch (data[0]) {
+        case 'D':
+            if (replaying || dump_active) return false;
+            dump_active = true;   // loop() starts sending
+            Serial.println("[FLIGHTREC] Dump requested");
+            return true;
+
+        case 'C':
+            if (replaying || dump_active) return false;
+            clear_requested = true;
+            break;
+
+        case 'P':
+            if (replaying || dump_active) return false;
+            replay_speed = (len > 1) ? data[1] : 1;
+            stop_requested = false;
+            replaying = true;   // Live writes are ignored from here on
+            replay_requested = true;
+            break;
+
+        case 'S':
+            stop_requested = true;
+            dump_active = false;
+            return true;
+
+        default:
+            return false;
+    }
+    xTaskNotifyGive(writer_task);
+    return true;
+}
+
+bool flight_recorder_dumping(void) {
+    return dump_active;
+}
+
+// Position the dump cursor on the next record (UI task, flash_lock held)
+static bool dump_seek_record(void) {
+    while (dump_seq <= cur_seq) {
+        uint32_t sector = sector_of(dump_seq);
+        if (dump_offset == 0) {
+            sector_header_t hdr;
+            if (!read_sector_header(sector, &hdr) || hdr.seq != dump_seq) {
+                dump_seq++;
+                continue;
+            }
+            dump_offset = sizeof(hdr);
+        }
+        flight_record_header_t rec;
+        if (read_record_header(sector, dump_offset, &rec)) {
+            dump_remaining = FLIGHT_RECORD_HEADER_LEN + rec.length;
+            dump_records++;
+            return true;
+        }
+        dump_seq++;
+        dump_offset = 0;
+    }
+    return false;
+}
+
+size_t flight_recorder_dump_next(uint8_t *buf, size_t size) {
+    if (!dump_active) {
+        dump_started = false;
+        return 0;
+    }
+    if (size < 10) return 0;
+    if (xSemaphoreTake(flash_lock, 0) != pdTRUE) return 0;   // Writer busy: try again next loop
+
+    if (!dump_started) {
+        dump_started = true;
+        dump_seq = oldest_seq();
+        dump_offset = 0;
+        dump_remaining = 0;
+        dump_chunk = 0;
+        dump_records = 0;
+    }
+
+    // Records are sent back to back, split wherever the chunk ends
+    size_t len = 2;
+    while (len < size) {
+        if (dump_remaining == 0 && !dump_seek_record()) break;
+        size_t n = size - len;
+        if (n > dump_remaining) n = dump_remaining;
+        esp_partition_read(partition, sector_addr(sector_of(dump_seq)) + dump_offset, buf + len, n);
+        dump_offset += n;
+        dump_remaining -= n;
+        len += n;
+    }
+    xSemaphoreGive(flash_lock);
+
+    if (len == 2) {
+        uint32_t dropped = staged_dropped;
+        buf[0] = 0xFF;
+        buf[1] = 0xFF;
+        memcpy(buf + 2, &dump_records, 4);
+        memcpy(buf + 6, &dropped, 4);
+        Serial.printf("[FLIGHTREC] Dump done: %lu records in %u chunks\n", dump_records, dump_chunk);
+        dump_active = false;
+        dump_started = false;
+        xTaskNotifyGive(writer_task);   // Write what was held back meanwhile
+        return 10;
+    }
+
+    buf[0] = dump_chunk & 0xFF;
+    buf[1] = dump_chunk >> 8;
+    dump_chunk = (dump_chunk + 1) % FLIGHT_RECORDER_DUMP_END;
+    return len;
+}
+
+void flight_recorder_stop_dump(void) {
+    if (dump_active) Serial.println("[FLIGHTREC] Dump abandoned");
+    dump_active = false;
+}
+
+bool flight_recorder_replaying(void) {
+    return replaying;
+}
+
+uint8_t flight_recorder_replay_speed(void) {
+    return replay_speed;
+}
+
+void flight_recorder_log_stats(void) {
+    if (!ready) return;
+    Serial.printf("[FLIGHTREC] records=%lu next=%lu dropped=%lu flushes=%lu writes=%lu erases=%lu errors=%lu last_flush=%lums\n",
+                  records_written, next_index, staged_dropped, flushes, flash_writes, sector_erases,
+                  flash_errors, last_flush_ms);
+    Serial.printf("[FLIGHTREC] sector %lu/%lu seq=%lu (log from seq %lu), %lu/%u bytes used\n",
+                  cur_sector, sector_count, cur_seq, oldest_seq(), write_offset, FLIGHT_RECORDER_SECTOR_SIZE);
+}
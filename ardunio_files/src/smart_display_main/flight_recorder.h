@@ -0,0 +1,129 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Flight recorder
+// Every raw BLE write is logged, exactly as received, to a dedicated flash
+// partition ("flightrec", see partitions.csv) so a field problem can be
+// pulled off the display and replayed.
+//
+// Receiving a write only copies it into a RAM staging buffer. A low-priority
+// task writes staged records to flash every FLIGHT_RECORDER_FLUSH_MS, or
+// sooner once the buffer is half full.
+//
+// Flash layout: the partition is a ring of 4 KB sectors, each starting with
+//   [magic:4] [sector seq:4] [first seq:4] [first record index:4]
+// and holding whole records. Sectors are erased one at a time, just before
+// reuse, so every sector sees the same number of erase cycles. A clear only
+// raises 'first seq' in the next sector header (no bulk erase).
+//
+// Record (little-endian, FLIGHT_RECORD_HEADER_LEN + length bytes):
+//   [length:2] [source] [flags] [index:4] [time ms:4] [crc:2] [reserved:2] [frame...]
+//   source: stream of the characteristic written (0 = main characteristic)
+//   index:  consecutive record number across sectors
+//   crc:    CRC-16/CCITT-FALSE over the header (crc = 0) and the frame bytes
+// Marker records (no frame bytes) flag a boot or a new connection.
+//
+// Commands (written to the recorder characteristic):
+//   'D'          dump the log, oldest first, as notifications on the same characteristic
+//   'C'          clear the log
+//   'P' [speed]  replay the log into the firmware: 1 = real time, N = N times
+//                faster, 0 = as fast as possible (live writes are ignored meanwhile)
+//   'S'          stop a dump or replay
+// Dump notification: [chunk lo] [chunk hi] [record stream bytes...]
+// End of dump:       [0xFF] [0xFF] [records:4] [dropped:4]
+// ============================================================================
+
+#define FLIGHT_RECORDER_PARTITION_LABEL  "flightrec"
+#define FLIGHT_RECORDER_SECTOR_SIZE      4096
+#define FLIGHT_RECORDER_SECTOR_MAGIC     0x43455246   // "FREC"
+#define FLIGHT_RECORDER_MAX_FRAME        512     // Largest frame recorded (one BLE write)
+#define FLIGHT_RECORDER_STAGING_SIZE     4096    // Records waiting for the flash writer
+#define FLIGHT_RECORDER_FLUSH_MS         2000    // Staged records reach flash at least this often
+#define FLIGHT_RECORDER_REPLAY_MAX_GAP_MS 5000   // Longer silences are shortened on replay
+
+// Record flags
+#define FLIGHT_RECORD_FLAG_BOOT      0x01   // Marker: firmware started
+#define FLIGHT_RECORD_FLAG_CONNECT   0x02   // Marker: phone connected (sequence numbers restart)
+
+#define FLIGHT_RECORDER_DUMP_END     0xFFFF  // Chunk number of the end-of-dump notification
+
+typedef struct __attribute__((packed)) {
+    uint16_t length;                 // Frame bytes that follow (0xFFFF: erased, end of sector)
+    uint8_t source;
+    uint8_t flags;                   // FLIGHT_RECORD_FLAG_*
+    uint32_t index;
+    uint32_t time_ms;                // millis() when received
+    uint16_t crc;
+    uint16_t reserved;
+} flight_record_header_t;
+
+#define FLIGHT_RECORD_HEADER_LEN sizeof(flight_record_header_t)
+
+/**
+ * Replay target: called from the recorder task for every record, in order
+ * @param data Frame bytes (record->length of them; none for markers)
+ */
+typedef void (*flight_recorder_sink_t)(const flight_record_header_t *record, const uint8_t *data);
+
+/**
+ * Find the partition, resume after the newest record and start the writer task
+ * Without the partition the recorder stays disabled and every call is a no-op.
+ * @param sink Replay target
+ * @return false if the recorder is disabled
+ */
+bool flight_recorder_init(flight_recorder_sink_t sink);
+
+/**
+ * Stage a received write (BLE task; copies only, never allocates)
+ * @param source Stream of the characteristic written
+ */
+void flight_recorder_record(const uint8_t *data, size_t len, uint8_t source);
+
+/**
+ * Stage a connection marker (replay restarts sequence checking there)
+ */
+void flight_recorder_mark_connect(void);
+
+/**
+ * Handle a command written to the recorder characteristic (BLE task)
+ * @return false for an unknown command or one that can't run now
+ */
+bool flight_recorder_command(const uint8_t *data, size_t len);
+
+/**
+ * Check if a dump is in progress
+ */
+bool flight_recorder_dumping(void);
+
+/**
+ * Read the next dump notification (UI task)
+ * @param buf Output buffer (at least 10 bytes)
+ * @return Bytes written; 0 if no dump is running or the flash is busy
+ */
+size_t flight_recorder_dump_next(uint8_t *buf, size_t size);
+
+/**
+ * Abandon a dump (the phone disconnected)
+ */
+void flight_recorder_stop_dump(void);
+
+/**
+ * Check if a replay is running (live writes are ignored and not recorded)
+ */
+bool flight_recorder_replaying(void);
+
+/**
+ * Speed of the running (or last) replay (see the 'P' command)
+ */
+uint8_t flight_recorder_replay_speed(void);
+
+/**
+ * Print record, flash and drop counters over serial
+ */
+void flight_recorder_log_stats(void);
+
+#endif // FLIGHT_RECORDER_H
@@ -0,0 +1,166 @@
+#include <Arduino.h>
+#include <string.h>
+#include "frame_dedup.h"
+#include "sys_clock.h"
+
+// Everything except log_stats runs on the BLE task (onWrite/onDisconnect)
+
+static const uint32_t PRIME1 = 2654435761U;
+static const uint32_t PRIME2 = 2246822519U;
+static const uint32_t PRIME3 = 3266489917U;
+static const uint32_t PRIME4 = 668265263U;
+static const uint32_t PRIME5 = 374761393U;
+
+// Last decoded frame per type
+typedef struct {
+    bool valid;
+    uint32_t hash;
+    size_t len;
+    uint32_t seen_ms;        // Last time this frame arrived (decoded or duplicate)
+} frame_slot_t;
+
+// Per type statistics
+typedef struct {
+    uint32_t frames;         // Decoded frames
+    uint32_t duplicates;
+    uint64_t decode_us;      // Total time spent decoding frames
+} frame_stats_t;
+
+static frame_slot_t slots[FRAME_KIND_COUNT];
+static frame_stats_t stats[FRAME_KIND_COUNT];
+static const uint32_t window_ms[FRAME_KIND_COUNT] = {
+    0,                           // Navigation: a repeat is always a repeat
+    FRAME_DEDUP_CALL_WINDOW_MS
+};
+static const char *kind_names[FRAME_KIND_COUNT] = { "nav", "call" };
+
+static uint32_t hash_us_total = 0;
+static uint32_t first_frame_ms = 0;
+
+static inline uint32_t rotl32(uint32_t x, int r) {
+    return (x << r) | (x >> (32 - r));
+}
+
+static inline uint32_t read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));   // Unaligned-safe; ESP32 is little-endian like the reference
+    return v;
+}
+
+static inline uint32_t round32(uint32_t acc, uint32_t input) {
+    acc += input * PRIME2;
+    acc = rotl32(acc, 13);
+    return acc * PRIME1;
+}
+
+uint32_t frame_dedup_hash(const uint8_t *data, size_t len) {
+    uint32_t start_us = micros();
+    const uint8_t *p = data;
+    const uint8_t *end = data + len;
+    uint32_t h;
+
+    if (len >= 16) {
+        const uint8_t *limit = end - 16;
+        uint32_t v1 = PRIME1 + PRIME2;
+        uint32_t v2 = PRIME2;
+        uint32_t v3 = 0;
+        uint32_t v4 = 0 - PRIME1;
+        do {
+            v1 = round32(v1, read32(p)); p += 4;
+            v2 = round32(v2, read32(p)); p += 4;
+            v3 = round32(v3, read32(p)); p += 4;
+            v4 = round32(v4, read32(p)); p += 4;
+        } while (p <= limit);
+        h = rotl32(v1, 1) + rotl32(v2, 7) + rotl32(v3, 12) + rotl32(v4, 18);
+    } else {
+        h = PRIME5;
+    }
+
+    h += (uint32_t)len;
+
+    while (p + 4 <= end) {
+        h += read32(p) * PRIME3;
+        h = rotl32(h, 17) * PRIME4;
+        p += 4;
+    }
+    while (p < end) {
+        h += (*p++) * PRIME5;
+        h = rotl32(h, 11) * PRIME1;
+    }
+
+    h ^= h >> 15;
+    h *= PRIME2;
+    h ^= h >> 13;
+    h *= PRIME3;
+    h ^= h >> 16;
+
+    hash_us_total += micros() - start_us;
+    return h;
+}
+
+FrameKind frame_dedup_match(uint32_t hash, size_t len, uint32_t now_ms) {
+    if (first_frame_ms == 0) first_frame_ms = now_ms ? now_ms : 1;
+
+    for (int k = 0; k < FRAME_KIND_COUNT; k++) {
+        frame_slot_t *slot = &slots[k];
+        if (!slot->valid || slot->hash != hash || slot->len != len) continue;
+        if (window_ms[k] != 0 && now_ms - slot->seen_ms > window_ms[k]) {
+            slot->valid = false;
+            continue;
+        }
+        slot->seen_ms = now_ms;
+        stats[k].duplicates++;
+        return (FrameKind)k;
+    }
+    return FRAME_KIND_NONE;
+}
+
+void frame_dedup_reset(void) {
+    for (int k = 0; k < FRAME_KIND_COUNT; k++) {
+        slots[k].valid = false;
+    }
+}
+
+void frame_dedup_forget(FrameKind kind) {
+    if (kind >= 0 && kind < FRAME_KIND_COUNT) slots[kind].valid = false;
+}
+
+FrameDedupDecode::FrameDedupDecode(uint32_t hash, size_t len)
+    : hash_(hash), len_(len), start_us_(micros()), kind_(FRAME_KIND_NONE) {
+}
+
+FrameDedupDecode::~FrameDedupDecode() {
+    if (kind_ == FRAME_KIND_NONE) return;
+    stats[kind_].frames++;
+    stats[kind_].decode_us += micros() - start_us_;
+    slots[kind_].valid = true;
+    slots[kind_].hash = hash_;
+    slots[kind_].len = len_;
+    slots[kind_].seen_ms = sys_clock_ms();
+}
+
+void frame_dedup_log_stats(void) {
+    uint32_t elapsed_ms = first_frame_ms ? sys_clock_ms() - first_frame_ms : 0;
+    uint32_t total_frames = 0;
+    uint32_t total_dups = 0;
+    uint64_t saved_us = 0;
+
+    for (int k = 0; k < FRAME_KIND_COUNT; k++) {
+        const frame_stats_t *s = &stats[k];
+        uint32_t avg_us = s->frames ? (uint32_t)(s->decode_us / s->frames) : 0;
+        uint64_t kind_saved_us = (uint64_t)avg_us * s->duplicates;
+        total_frames += s->frames + s->duplicates;
+        total_dups += s->duplicates;
+        saved_us += kind_saved_us;
+        Serial.printf("[DEDUP] %s: decoded=%lu duplicates=%lu avg_decode=%luus saved=%lums\n",
+                      kind_names[k], s->frames, s->duplicates, avg_us,
+                      (uint32_t)(kind_saved_us / 1000));
+    }
+
+    // Net of the hashing cost, scaled to an hour since the first frame
+    uint64_t net_us = saved_us > hash_us_total ? saved_us - hash_us_total : 0;
+    uint32_t per_hour_ms = elapsed_ms ? (uint32_t)(net_us * 3600ULL / elapsed_ms) : 0;
+    Serial.printf("[DEDUP] duplicates %lu/%lu frames, hashing=%lums, net saved=%lums (~%lums/h)\n",
+                  total_dups, total_frames, hash_us_total / 1000,
+                  (uint32_t)(net_us / 1000), per_hour_ms);
+}
@@ -0,0 +1,76 @@
+#ifndef FRAME_DEDUP_H
+#define FRAME_DEDUP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Duplicate BLE frame detection
+// The phone often resends an identical payload when a Maps notification
+// refreshes. Each raw payload is hashed (xxHash32) and compared against the
+// last decoded frame of every message type, so repeats can skip JSON decode
+// and the UI updates entirely.
+// ============================================================================
+
+/**
+ * Message types tracked separately
+ */
+enum FrameKind {
+    FRAME_KIND_NAV = 0,
+    FRAME_KIND_CALL,
+    FRAME_KIND_COUNT,
+    FRAME_KIND_NONE = -1
+};
+
+// A repeated call frame older than this is treated as a new event (a second
+// missed call from the same number must not be swallowed)
+#define FRAME_DEDUP_CALL_WINDOW_MS 5000
+
+/**
+ * xxHash32 of a buffer (seed 0)
+ */
+uint32_t frame_dedup_hash(const uint8_t *data, size_t len);
+
+/**
+ * Check a payload against the last frame of each type
+ * Counts the duplicate (and the decode time it saves) when it matches.
+ * @param hash frame_dedup_hash() of the payload
+ * @param len Payload length
+ * @param now_ms Current time (sys_clock_ms())
+ * @return Type of the identical previous frame, or FRAME_KIND_NONE
+ */
+FrameKind frame_dedup_match(uint32_t hash, size_t len, uint32_t now_ms);
+
+/**
+ * Forget all remembered frames (e.g. on disconnect, so a reconnect re-applies state)
+ */
+void frame_dedup_reset(void);
+
+/**
+ * Forget the last frame of one type (its content is no longer what the UI shows)
+ */
+void frame_dedup_forget(FrameKind kind);
+
+/**
+ * Print duplicate counts and decode time saved over serial
+ */
+void frame_dedup_log_stats(void);
+
+/**
+ * Times the decode of a new frame and remembers its hash when it goes out of scope
+ * (only if set_kind() was called - invalid or unknown frames are not remembered)
+ */
+class FrameDedupDecode {
+public:
+    FrameDedupDecode(uint32_t hash, size_t len);
+    ~FrameDedupDecode();
+    void set_kind(FrameKind kind) { kind_ = kind; }
+
+private:
+    uint32_t hash_;
+    size_t len_;
+    uint32_t start_us_;
+    FrameKind kind_;
+};
+
+#endif // FRAME_DEDUP_H
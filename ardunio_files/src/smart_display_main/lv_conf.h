@@ -46,10 +46,16 @@
  *=========================*/
 
 /*1: use custom malloc/free, 0: use the built-in `lv_mem_alloc()` and `lv_mem_free()`*/
-#define LV_MEM_CUSTOM 0
+/*Custom: TLSF pool sized at boot from free internal RAM, see lv_mem_pool.h.
+ *lv_mem_pool.c sets both to build LVGL's TLSF for its pool, hence the #ifndef*/
+#ifndef LV_MEM_CUSTOM
+#define LV_MEM_CUSTOM 1
+#endif
 #if LV_MEM_CUSTOM == 0
     /*Size of the memory available for `lv_mem_alloc()` in bytes (>= 2kB)*/
+    #ifndef LV_MEM_SIZE
     #define LV_MEM_SIZE (48U * 1024U)          /*[bytes]*/
+    #endif
 
     /*Set an address for the memory pool instead of allocating it as a normal array. Can be in external SRAM too.*/
     #define LV_MEM_ADR 0     /*0: unused*/
@@ -60,10 +66,10 @@
     #endif
 
 #else       /*LV_MEM_CUSTOM*/
-    #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
-    #define LV_MEM_CUSTOM_ALLOC   malloc
-    #define LV_MEM_CUSTOM_FREE    free
-    #define LV_MEM_CUSTOM_REALLOC realloc
+    #define LV_MEM_CUSTOM_INCLUDE "lv_mem_pool.h"   /*Header for the dynamic memory function*/
+    #define LV_MEM_CUSTOM_ALLOC   lv_mem_pool_alloc
+    #define LV_MEM_CUSTOM_FREE    lv_mem_pool_free
+    #define LV_MEM_CUSTOM_REALLOC lv_mem_pool_realloc
 #endif     /*LV_MEM_CUSTOM*/
 
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
@@ -87,8 +93,8 @@
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
 #define LV_TICK_CUSTOM 1
 #if LV_TICK_CUSTOM
-    #define LV_TICK_CUSTOM_INCLUDE "Arduino.h"         /*Header for the system time function*/
-    #define LV_TICK_CUSTOM_SYS_TIME_EXPR (millis())    /*Expression evaluating to current system time in ms*/
+    #define LV_TICK_CUSTOM_INCLUDE "sys_clock.h"       /*Header for the system time function*/
+    #define LV_TICK_CUSTOM_SYS_TIME_EXPR (sys_clock_ms())  /*Firmware clock, follows fast-forward jumps*/
     /*If using lvgl as ESP32 component*/
     // #define LV_TICK_CUSTOM_INCLUDE "esp_timer.h"
     // #define LV_TICK_CUSTOM_SYS_TIME_EXPR ((esp_timer_get_time() / 1000LL))
@@ -702,7 +708,7 @@
  *----------*/
 
 /*1: Enable API to take snapshot for object*/
-#define LV_USE_SNAPSHOT 0
+#define LV_USE_SNAPSHOT 1
 
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
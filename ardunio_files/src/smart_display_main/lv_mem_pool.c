@@ -0,0 +1,274 @@
+// LVGL only builds its bundled TLSF (misc/lv_tlsf.c) for the built-in
+// allocator (LV_MEM_CUSTOM 0), which this pool replaces. Build the same
+// source here, sized for the largest pool, so the pool is TLSF whatever
+// the IDF's multi_heap uses. lv_conf.h only sets both when not yet defined.
+#include "lv_mem_pool.h"
+#define LV_MEM_CUSTOM 0
+#define LV_MEM_SIZE LV_MEM_POOL_MAX_SIZE
+#include <misc/lv_tlsf.c>
+
+#include <string.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_heap_caps.h"
+
+// Every block carries a small header so frees can be charged to the
+// allocating tag (8 bytes keeps LVGL's 4/8-byte alignment)
+typedef struct {
+    uint32_t size;   // Requested size
+    uint8_t tag;
+    uint8_t reserved[3];
+} block_hdr_t;
+
+static uint8_t *pool_mem = NULL;
+static uint32_t pool_size = 0;
+static lv_tlsf_t pool_tlsf = NULL;
+static uint32_t pool_capacity = 0;     // Free bytes in the empty pool
+static uint32_t pool_used = 0;         // Pool bytes in use, block overhead included
+static uint32_t pool_min_free = 0;
+static bool pool_init_tried = false;
+static uint32_t reserved_bytes = 0;    // Buffers allocated after the pool
+static uint32_t pool_shortfall = 0;
+
+// Guards the pool and the counters (LVGL is also touched from the BLE task).
+// The system heap has its own lock and is called outside this one.
+static portMUX_TYPE pool_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint8_t current_tag = 0;
+
+static uint32_t live_bytes = 0;
+static uint32_t peak_bytes = 0;
+static uint32_t live_blocks = 0;
+static uint32_t alloc_count = 0;
+static uint32_t free_count = 0;
+static uint32_t failed_count = 0;
+
+static lv_mem_pool_tag_stats_t tag_stats[LV_MEM_POOL_MAX_TAGS];
+
+static volatile lv_mem_pool_alloc_hook_t alloc_hook = NULL;
+
+static bool in_pool(const void *p) {
+    return pool_mem && (const uint8_t *)p >= pool_mem && (const uint8_t *)p < pool_mem + pool_size;
+}
+
+// Pool accounting, called with the lock held around each pool alloc/free
+static void pool_take(void *p) {
+    pool_used += lv_tlsf_block_size(p);
+    uint32_t free_now = pool_capacity - pool_used;
+    if (free_now < pool_min_free) pool_min_free = free_now;
+}
+
+static void pool_give(void *p) {
+    pool_used -= lv_tlsf_block_size(p);
+}
+
+typedef struct {
+    uint32_t free_bytes;
+    uint32_t largest_free;
+} pool_walk_t;
+
+static void pool_walker(void *ptr, size_t size, int used, void *user) {
+    (void)ptr;
+    pool_walk_t *w = (pool_walk_t *)user;
+    if (used) return;
+    w->free_bytes += size;
+    if (size > w->largest_free) w->largest_free = size;
+}
+
+static void charge(uint8_t tag, uint32_t size) {
+    lv_mem_pool_tag_stats_t *t = &tag_stats[tag];
+    t->live_bytes += size;
+    t->alloc_count++;
+    if (t->live_bytes > t->peak_bytes) t->peak_bytes = t->live_bytes;
+
+    live_bytes += size;
+    live_blocks++;
+    alloc_count++;
+    if (live_bytes > peak_bytes) peak_bytes = live_bytes;
+}
+
+static void refund(uint8_t tag, uint32_t size) {
+    lv_mem_pool_tag_stats_t *t = &tag_stats[tag];
+    t->live_bytes -= size;
+    t->free_count++;
+
+    live_bytes -= size;
+    live_blocks--;
+    free_count++;
+}
+
+void lv_mem_pool_reserve(uint32_t bytes) {
+    if (!pool_init_tried) reserved_bytes += bytes;
+}
+
+bool lv_mem_pool_init(void) {
+    if (pool_init_tried) return pool_tlsf != NULL;
+    pool_init_tried = true;
+
+    tag_stats[0].name = "lvgl";
+
+    // Size from what is free now, minus the registered buffers and the system reserve
+    uint32_t reserve = reserved_bytes + LV_MEM_POOL_RESERVE_SYSTEM;
+    uint32_t free_internal = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    uint32_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    uint32_t size = free_internal > reserve ? free_internal - reserve : 0;
+    if (size < LV_MEM_POOL_MIN_SIZE) size = LV_MEM_POOL_MIN_SIZE;
+    if (size > LV_MEM_POOL_MAX_SIZE) size = LV_MEM_POOL_MAX_SIZE;
+    if (size > largest) size = largest & ~7U;
+    pool_shortfall = size + reserve > free_internal ? size + reserve - free_internal : 0;
+
+    pool_mem = (uint8_t *)heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (pool_mem == NULL) return false;
+
+    pool_tlsf = lv_tlsf_create_with_pool(pool_mem, size);
+    if (pool_tlsf == NULL) {
+        heap_caps_free(pool_mem);
+        pool_mem = NULL;
+        return false;
+    }
+    pool_size = size;
+
+    pool_walk_t w = { 0, 0 };
+    lv_tlsf_walk_pool(lv_tlsf_get_pool(pool_tlsf), pool_walker, &w);
+    pool_capacity = w.free_bytes;
+    pool_min_free = w.free_bytes;
+    return true;
+}
+
+void *lv_mem_pool_alloc(size_t size) {
+    if (!pool_init_tried) lv_mem_pool_init();
+
+    block_hdr_t *hdr;
+    if (pool_tlsf) {
+        portENTER_CRITICAL(&pool_mux);
+        hdr = (block_hdr_t *)lv_tlsf_malloc(pool_tlsf, size + sizeof(block_hdr_t));
+        if (hdr) pool_take(hdr);
+    } else {
+        // No pool: the system heap, which locks for itself
+        hdr = (block_hdr_t *)malloc(size + sizeof(block_hdr_t));
+        portENTER_CRITICAL(&pool_mux);
+    }
+    if (hdr == NULL) {
+        failed_count++;
+        portEXIT_CRITICAL(&pool_mux);
+        return NULL;
+    }
+    hdr->size = size;
+    hdr->tag = current_tag;
+    charge(hdr->tag, size);
+    portEXIT_CRITICAL(&pool_mux);
+
+    if (alloc_hook) alloc_hook(size);
+    return hdr + 1;
+}
+
+void lv_mem_pool_free(void *ptr) {
+    if (ptr == NULL) return;
+
+    block_hdr_t *hdr = (block_hdr_t *)ptr - 1;
+    bool pooled = in_pool(hdr);
+    portENTER_CRITICAL(&pool_mux);
+    refund(hdr->tag, hdr->size);
+    if (pooled) {
+        pool_give(hdr);
+        lv_tlsf_free(pool_tlsf, hdr);
+    }
+    portEXIT_CRITICAL(&pool_mux);
+
+    if (!pooled) free(hdr);
+}
+
+void *lv_mem_pool_realloc(void *ptr, size_t new_size) {
+    if (ptr == NULL) return lv_mem_pool_alloc(new_size);
+    if (new_size == 0) {
+        lv_mem_pool_free(ptr);
+        return NULL;
+    }
+
+    block_hdr_t *hdr = (block_hdr_t *)ptr - 1;
+    uint8_t tag = hdr->tag;   // Keep charging the original owner
+    uint32_t old_size = hdr->size;
+
+    block_hdr_t *new_hdr;
+    if (in_pool(hdr)) {
+        portENTER_CRITICAL(&pool_mux);
+        pool_give(hdr);
+        new_hdr = (block_hdr_t *)lv_tlsf_realloc(pool_tlsf, hdr, new_size + sizeof(block_hdr_t));
+        // On failure the old block is still there
+        pool_take(new_hdr ? new_hdr : hdr);
+    } else {
+        new_hdr = (block_hdr_t *)realloc(hdr, new_size + sizeof(block_hdr_t));
+        portENTER_CRITICAL(&pool_mux);
+    }
+    if (new_hdr == NULL) {
+        failed_count++;
+        portEXIT_CRITICAL(&pool_mux);
+        return NULL;
+    }
+
+    refund(tag, old_size);
+    new_hdr->size = new_size;
+    new_hdr->tag = tag;
+    charge(tag, new_size);
+    // A realloc is one allocation, not a free plus an alloc
+    alloc_count--;
+    free_count--;
+    tag_stats[tag].alloc_count--;
+    tag_stats[tag].free_count--;
+    portEXIT_CRITICAL(&pool_mux);
+
+    if (alloc_hook) alloc_hook(new_size);
+    return new_hdr + 1;
+}
+
+uint8_t lv_mem_pool_set_tag(uint8_t tag) {
+    uint8_t prev = current_tag;
+    current_tag = tag < LV_MEM_POOL_MAX_TAGS ? tag : 0;
+    return prev;
+}
+
+void lv_mem_pool_set_tag_name(uint8_t tag, const char *name) {
+    if (tag < LV_MEM_POOL_MAX_TAGS) {
+        tag_stats[tag].name = name;
+    }
+}
+
+void lv_mem_pool_set_alloc_hook(lv_mem_pool_alloc_hook_t hook) {
+    alloc_hook = hook;
+}
+
+void lv_mem_pool_get_stats(lv_mem_pool_stats_t *stats) {
+    if (stats == NULL) return;
+    memset(stats, 0, sizeof(*stats));
+
+    portENTER_CRITICAL(&pool_mux);
+    stats->total_size = pool_size;
+    stats->live_bytes = live_bytes;
+    stats->peak_bytes = peak_bytes;
+    stats->alloc_count = alloc_count;
+    stats->free_count = free_count;
+    stats->failed_count = failed_count;
+    stats->live_blocks = live_blocks;
+    stats->reserved_bytes = reserved_bytes + LV_MEM_POOL_RESERVE_SYSTEM;
+    stats->shortfall = pool_shortfall;
+    if (pool_tlsf) {
+        pool_walk_t w = { 0, 0 };
+        lv_tlsf_walk_pool(lv_tlsf_get_pool(pool_tlsf), pool_walker, &w);
+        stats->free_bytes = w.free_bytes;
+        stats->largest_free = w.largest_free;
+        stats->min_free = pool_min_free;
+    }
+    portEXIT_CRITICAL(&pool_mux);
+
+    if (stats->free_bytes > 0) {
+        stats->frag_pct = 100 - (uint8_t)((uint64_t)stats->largest_free * 100 / stats->free_bytes);
+    }
+}
+
+bool lv_mem_pool_get_tag_stats(uint8_t tag, lv_mem_pool_tag_stats_t *stats) {
+    if (tag >= LV_MEM_POOL_MAX_TAGS || stats == NULL) return false;
+    portENTER_CRITICAL(&pool_mux);
+    *stats = tag_stats[tag];
+    portEXIT_CRITICAL(&pool_mux);
+    return true;
+}
@@ -0,0 +1,119 @@
+#ifndef LV_MEM_POOL_H
+#define LV_MEM_POOL_H
+
+// LVGL heap backend (LV_MEM_CUSTOM) on a dedicated pool run by LVGL's TLSF (lv_tlsf).
+// Included by LVGL's C sources through LV_MEM_CUSTOM_INCLUDE - keep it C.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Pool Sizing (decided once at boot from free internal RAM)
+// The pool is created before lv_init(), ahead of the draw buffers, the
+// transition snapshot buffer and the BLE stack. Buffers allocated after it
+// are registered with lv_mem_pool_reserve() so their share is left free;
+// the BLE stack and the rest of the firmware get LV_MEM_POOL_RESERVE_SYSTEM.
+// ============================================================================
+
+#define LV_MEM_POOL_MIN_SIZE        (48U * 1024U)   // Never smaller than the old LV_MEM_SIZE
+#define LV_MEM_POOL_MAX_SIZE        (96U * 1024U)   // Upper bound
+#define LV_MEM_POOL_RESERVE_SYSTEM  (80U * 1024U)   // BLE stack (initialized later), tasks, app buffers
+
+#define LV_MEM_POOL_MAX_TAGS   8               // Allocation sites tracked separately
+
+/**
+ * Pool statistics
+ */
+typedef struct {
+    uint32_t total_size;       // Pool size in bytes
+    uint32_t live_bytes;       // Bytes currently allocated (requested sizes)
+    uint32_t peak_bytes;       // Highest live_bytes seen
+    uint32_t free_bytes;       // Free bytes in the pool
+    uint32_t largest_free;     // Largest free block
+    uint32_t min_free;         // Lowest free_bytes seen
+    uint32_t alloc_count;      // Successful allocations
+    uint32_t free_count;       // Frees
+    uint32_t failed_count;     // Failed allocations
+    uint32_t live_blocks;      // Blocks currently allocated
+    uint8_t frag_pct;          // 100 - largest_free * 100 / free_bytes
+    uint32_t reserved_bytes;   // Left outside the pool at creation (buffers + system)
+    uint32_t shortfall;        // Bytes the pool and its reserve were short of at creation (0 = fits)
+} lv_mem_pool_stats_t;
+
+/**
+ * Per-tag (allocation site) statistics
+ */
+typedef struct {
+    const char *name;
+    uint32_t live_bytes;
+    uint32_t peak_bytes;
+    uint32_t alloc_count;
+    uint32_t free_count;
+} lv_mem_pool_tag_stats_t;
+
+/**
+ * Allocation hook (called after each successful alloc/realloc, outside the pool lock)
+ */
+typedef void (*lv_mem_pool_alloc_hook_t)(size_t size);
+
+/**
+ * Leave internal RAM outside the pool for a buffer allocated after it
+ * Call before lv_mem_pool_init(); later calls have no effect.
+ * @param bytes Buffer size
+ */
+void lv_mem_pool_reserve(uint32_t bytes);
+
+/**
+ * Create the pool (called automatically on first allocation)
+ * The pool never grows into the reserve: if free RAM can't hold both, the
+ * pool gets LV_MEM_POOL_MIN_SIZE and the shortfall is reported in the stats.
+ * @return True if the pool is available
+ */
+bool lv_mem_pool_init(void);
+
+/**
+ * LVGL allocator hooks (LV_MEM_CUSTOM_ALLOC / FREE / REALLOC)
+ */
+void *lv_mem_pool_alloc(size_t size);
+void lv_mem_pool_free(void *ptr);
+void *lv_mem_pool_realloc(void *ptr, size_t new_size);
+
+/**
+ * Set the tag charged for following allocations
+ * Frees and reallocs are charged to the tag that made the allocation.
+ * @param tag Tag index (0 = default "lvgl")
+ * @return Previous tag (restore it when done)
+ */
+uint8_t lv_mem_pool_set_tag(uint8_t tag);
+
+/**
+ * Name a tag for reports (name must outlive the pool)
+ */
+void lv_mem_pool_set_tag_name(uint8_t tag, const char *name);
+
+/**
+ * Install an allocation hook (NULL to remove)
+ */
+void lv_mem_pool_set_alloc_hook(lv_mem_pool_alloc_hook_t hook);
+
+/**
+ * Read pool statistics
+ */
+void lv_mem_pool_get_stats(lv_mem_pool_stats_t *stats);
+
+/**
+ * Read statistics for one tag
+ * @return False if the tag is out of range
+ */
+bool lv_mem_pool_get_tag_stats(uint8_t tag, lv_mem_pool_tag_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LV_MEM_POOL_H
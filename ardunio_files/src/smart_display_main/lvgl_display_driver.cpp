@@ -1,6 +1,15 @@
 #include <Arduino.h>
 #include "lvgl_display_driver.h"
 #include "esp_lcd_touch_axs5106l.h"  // For touch_data_t, bsp_touch_read, bsp_touch_get_coordinates
+#include "ui_screens.h"               // For ui_screens_on_flush (switch latency)
+#include "telemetry.h"
+#include "perf_hud.h"
+#include "replay_bench.h"
+#include "render_bench.h"
+#include "caller_directory.h"
+#include "nav_lookahead.h"
+#include "lv_mem_pool.h"
+#include "ui_transition.h"
 
 #ifdef ESP32
 #include "esp_heap_caps.h"
@@ -48,6 +57,15 @@ void lvgl_display_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color
     gfx->draw16bitRGBBitmap(area->x1, area->y1, (uint16_t *)&color_p->full, w, h);
 #endif
 
+    ui_screens_on_flush();
+    bool lastArea = lv_disp_flush_is_last(disp_drv);
+    telemetry_record_flush(w * h * sizeof(lv_color_t), lastArea);
+    perf_hud_record_flush(w * h * sizeof(lv_color_t), lastArea);
+    replay_bench_record_flush(w * h * sizeof(lv_color_t), lastArea);
+    render_bench_record_flush(w * h * sizeof(lv_color_t));
+    caller_directory_record_flush(lastArea);
+    nav_lookahead_record_flush(lastArea);
+
     // Inform LVGL that flushing is done
     lv_disp_flush_ready(disp_drv);
 }
@@ -74,6 +92,11 @@ void lvgl_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data) {
     }
 }
 
+// Partial rendering: two bands of 40 lines (like the working example)
+uint32_t lvgl_display_buffer_bytes(Arduino_GFX *display) {
+    return display->width() * 40 * 2 * sizeof(lv_color_t);
+}
+
 /**
  * Initialize LVGL display driver
  * Based on working example - uses proper ESP32 memory allocation
@@ -85,7 +108,7 @@ void lvgl_display_init(Arduino_GFX *display) {
     
     // Calculate buffer size (use partial buffer for efficiency)
     // Working example uses screenWidth * 40 for partial rendering
-    bufSize = screenWidth * 40;
+    bufSize = lvgl_display_buffer_bytes(display) / (2 * sizeof(lv_color_t));
     
     Serial.printf("[LVGL] Screen: %dx%d, Buffer size: %d pixels\n", screenWidth, screenHeight, bufSize);
     
@@ -137,6 +160,24 @@ void lvgl_display_init(Arduino_GFX *display) {
  * Based on working example - MUST call lv_init() first!
  */
 void lvgl_init(void) {
+    // Create the LVGL heap pool before lv_init() makes its first allocation,
+    // leaving internal RAM for the buffers allocated after it
+    lv_mem_pool_reserve(lvgl_display_buffer_bytes(gfx));
+    lv_mem_pool_reserve(ui_transition_buffer_bytes(gfx->width(), gfx->height()));
+    bool pooled = lv_mem_pool_init();
+    lv_mem_pool_stats_t stats;
+    lv_mem_pool_get_stats(&stats);
+    if (pooled) {
+        Serial.printf("[LVGL] Memory pool: %lu bytes (TLSF), %lu bytes reserved for buffers and BLE\n",
+                      stats.total_size, stats.reserved_bytes);
+    } else {
+        Serial.println("[LVGL] Warning: memory pool unavailable, using system heap");
+    }
+    if (stats.shortfall > 0) {
+        Serial.printf("[LVGL] ERROR: internal RAM is %lu bytes short of pool + reserve "
+                      "(transitions fall back to immediate loads)\n", stats.shortfall);
+    }
+    
     // Initialize LVGL FIRST (before anything else)
     lv_init();
     
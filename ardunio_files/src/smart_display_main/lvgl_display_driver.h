@@ -38,6 +38,11 @@ void lvgl_display_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color
  */
 void lvgl_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
 
+/**
+ * Bytes lvgl_display_init allocates for the draw buffers
+ */
+uint32_t lvgl_display_buffer_bytes(Arduino_GFX *display);
+
 /**
  * Initialize LVGL display driver
  * Sets up display buffers, flush callback, and touch input
@@ -46,7 +51,8 @@ void lvgl_display_init(Arduino_GFX *display);
 
 /**
  * Initialize LVGL library
- * Must be called before using any LVGL functions
+ * Must be called before using any LVGL functions. Creates the LVGL memory
+ * pool, leaving room for the draw and snapshot buffers allocated after it.
  */
 void lvgl_init(void);
 
@@ -0,0 +1,121 @@
+#include <Arduino.h>
+#include "nav_estimator.h"
+
+// Last ground-truth sample and the closing speed derived from it
+static int32_t sample_distance_m = 0;
+static uint32_t sample_ms = 0;
+static bool has_sample = false;
+static int32_t speed_mms = 0;   // Closing speed in mm/s (0 = unknown / not closing)
+
+// Samples arrive on the BLE task, predictions run on the UI task
+static portMUX_TYPE estimator_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Statistics
+static uint32_t stat_samples = 0;
+static uint32_t stat_resets = 0;          // Distance went up (new step / reroute)
+static uint32_t stat_local_updates = 0;
+static uint32_t stat_error_samples = 0;   // Samples that arrived while extrapolating
+static uint32_t stat_error_sum_m = 0;
+static uint32_t stat_error_max_m = 0;
+
+static int32_t predict_locked(uint32_t now_ms) {
+    if (!has_sample) return 0;
+    if (speed_mms <= 0) return sample_distance_m;
+
+    uint32_t elapsed = now_ms - sample_ms;
+    if (elapsed > NAV_ESTIMATOR_MAX_EXTRAPOLATE) elapsed = NAV_ESTIMATOR_MAX_EXTRAPOLATE;
+
+    int32_t travelled_m = (int32_t)((int64_t)speed_mms * elapsed / 1000000);
+    int32_t d = sample_distance_m - travelled_m;
+    return d > 0 ? d : 0;
+}
+
+void nav_estimator_reset(void) {
+    portENTER_CRITICAL(&estimator_mux);
+    has_sample = false;
+    speed_mms = 0;
+    sample_distance_m = 0;
+    portEXIT_CRITICAL(&estimator_mux);
+}
+
+void nav_estimator_add_sample(int32_t distance_m, uint32_t now_ms) {
+    portENTER_CRITICAL(&estimator_mux);
+    stat_samples++;
+
+    if (!has_sample || distance_m <= 0) {
+        has_sample = distance_m > 0;
+        sample_distance_m = distance_m;
+        sample_ms = now_ms;
+        speed_mms = 0;
+        portEXIT_CRITICAL(&estimator_mux);
+        return;
+    }
+
+    // Estimate error at the moment ground truth arrives
+    if (speed_mms > 0) {
+        int32_t err = predict_locked(now_ms) - distance_m;
+        uint32_t abs_err = err < 0 ? -err : err;
+        stat_error_samples++;
+        stat_error_sum_m += abs_err;
+        if (abs_err > stat_error_max_m) stat_error_max_m = abs_err;
+    }
+
+    uint32_t dt = now_ms - sample_ms;
+    int32_t closed_m = sample_distance_m - distance_m;
+
+    if (closed_m < 0) {
+        // Distance grew: next maneuver or reroute - start over
+        speed_mms = 0;
+        stat_resets++;
+    } else if (dt >= NAV_ESTIMATOR_MIN_DT_MS && dt <= NAV_ESTIMATOR_MAX_DT_MS) {
+        int32_t measured = (int32_t)((int64_t)closed_m * 1000000 / dt);
+        if (measured <= NAV_ESTIMATOR_MAX_SPEED_MMS) {
+            // Smooth with the previous estimate (1/2 weight each)
+            speed_mms = speed_mms > 0 ? (speed_mms + measured) / 2 : measured;
+        }
+    } else if (dt > NAV_ESTIMATOR_MAX_DT_MS) {
+        speed_mms = 0;
+    }
+
+    // Repeated distances within MIN_DT keep the old time base
+    if (dt >= NAV_ESTIMATOR_MIN_DT_MS || closed_m != 0) {
+        sample_ms = now_ms;
+    }
+    sample_distance_m = distance_m;
+    portEXIT_CRITICAL(&estimator_mux);
+}
+
+void nav_estimator_rebase(int32_t distance_m, uint32_t now_ms) {
+    portENTER_CRITICAL(&estimator_mux);
+    has_sample = distance_m > 0;
+    sample_distance_m = distance_m;
+    sample_ms = now_ms;
+    portEXIT_CRITICAL(&estimator_mux);
+}
+
+int32_t nav_estimator_predict(uint32_t now_ms) {
+    portENTER_CRITICAL(&estimator_mux);
+    int32_t d = predict_locked(now_ms);
+    portEXIT_CRITICAL(&estimator_mux);
+    return d;
+}
+
+bool nav_estimator_active(uint32_t now_ms) {
+    portENTER_CRITICAL(&estimator_mux);
+    bool active = has_sample && speed_mms > 0 && (now_ms - sample_ms) <= NAV_ESTIMATOR_MAX_EXTRAPOLATE;
+    portEXIT_CRITICAL(&estimator_mux);
+    return active;
+}
+
+void nav_estimator_record_local_update(void) {
+    stat_local_updates++;
+}
+
+void nav_estimator_log_stats(void) {
+    Serial.printf("[NAV-DR] samples=%lu resets=%lu local_updates=%lu speed=%ldmm/s\n",
+                  stat_samples, stat_resets, stat_local_updates, speed_mms);
+    Serial.printf("[NAV-DR] error at resync: n=%lu avg=%lum max=%lum\n",
+                  stat_error_samples,
+                  stat_error_samples ? stat_error_sum_m / stat_error_samples : 0,
+                  stat_error_max_m);
+}
@@ -0,0 +1,62 @@
+#ifndef NAV_ESTIMATOR_H
+#define NAV_ESTIMATOR_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Distance dead-reckoning between phone updates
+// Closing speed is estimated from successive (distance, time) samples and the
+// distance is counted down locally. Integer math only; every new sample
+// snaps the estimate back to ground truth.
+// ============================================================================
+
+#define NAV_ESTIMATOR_TICK_MS          250     // Local countdown rate (UI timer period)
+#define NAV_ESTIMATOR_MIN_DT_MS        200     // Samples closer than this don't update the speed
+#define NAV_ESTIMATOR_MAX_DT_MS        30000   // Older previous sample = no usable speed
+#define NAV_ESTIMATOR_MAX_EXTRAPOLATE  15000   // Stop counting this long after the last sample
+#define NAV_ESTIMATOR_MAX_SPEED_MMS    70000   // 252 km/h - faster closing speeds are rejected
+
+/**
+ * Forget all samples (new route, navigation cleared)
+ */
+void nav_estimator_reset(void);
+
+/**
+ * Add a ground-truth sample from the phone
+ * Safe to call from any task.
+ * @param distance_m Distance to the next maneuver in meters
+ * @param now_ms Sample time (sys_clock_ms())
+ */
+void nav_estimator_add_sample(int32_t distance_m, uint32_t now_ms);
+
+/**
+ * Start counting down from a new distance at the current speed
+ * (the display moved on to the next maneuver before the phone did)
+ * @param distance_m Distance to the new maneuver in meters (0 = unknown, stops the countdown)
+ * @param now_ms Time of the switch (sys_clock_ms())
+ */
+void nav_estimator_rebase(int32_t distance_m, uint32_t now_ms);
+
+/**
+ * Estimated distance at a given time
+ * @param now_ms Current time (sys_clock_ms())
+ * @return Distance in meters (the last sample if no speed is known, never below 0)
+ */
+int32_t nav_estimator_predict(uint32_t now_ms);
+
+/**
+ * Check if the estimate is currently counting down
+ */
+bool nav_estimator_active(uint32_t now_ms);
+
+/**
+ * Count one label refresh driven by the estimator (for stats)
+ */
+void nav_estimator_record_local_update(void);
+
+/**
+ * Print sample count, local refreshes and estimate error over serial
+ */
+void nav_estimator_log_stats(void);
+
+#endif // NAV_ESTIMATOR_H
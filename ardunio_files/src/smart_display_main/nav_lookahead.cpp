@@ -0,0 +1,67 @@
+#include <Arduino.h>
+#include "nav_lookahead.h"
+
+typedef struct {
+    uint32_t switches;
+    uint32_t timed;                      // Switches whose frame reached the glass
+    uint32_t latency_sum_us;
+    uint32_t latency_max_us;
+    uint32_t build_sum_us;
+} switch_stats_t;
+
+// Switches are marked from the BLE task (phone frames) and the UI task
+// (countdown), the flush hook runs on the UI task
+static portMUX_TYPE lookahead_mux = portMUX_INITIALIZER_UNLOCKED;
+static switch_stats_t stats[NAV_SWITCH_KIND_COUNT];
+static bool pending = false;
+static NavSwitchKind pending_kind = NAV_SWITCH_LOCAL;
+static uint32_t pending_start_us = 0;
+
+static uint32_t stat_staged = 0;
+static uint32_t stat_stage_sum_us = 0;
+
+void nav_lookahead_record_stage(uint32_t build_us) {
+    portENTER_CRITICAL(&lookahead_mux);
+    stat_staged++;
+    stat_stage_sum_us += build_us;
+    portEXIT_CRITICAL(&lookahead_mux);
+}
+
+void nav_lookahead_mark_switch(NavSwitchKind kind, uint32_t start_us, uint32_t build_us) {
+    if (kind >= NAV_SWITCH_KIND_COUNT) return;
+    portENTER_CRITICAL(&lookahead_mux);
+    stats[kind].switches++;
+    stats[kind].build_sum_us += build_us;
+    // A switch before the last one was drawn replaces it
+    pending = true;
+    pending_kind = kind;
+    pending_start_us = start_us;
+    portEXIT_CRITICAL(&lookahead_mux);
+}
+
+void nav_lookahead_record_flush(bool last) {
+    if (!last || !pending) return;
+    uint32_t now_us = micros();
+    portENTER_CRITICAL(&lookahead_mux);
+    if (pending) {
+        switch_stats_t *s = &stats[pending_kind];
+        uint32_t latency_us = now_us - pending_start_us;
+        s->timed++;
+        s->latency_sum_us += latency_us;
+        if (latency_us > s->latency_max_us) s->latency_max_us = latency_us;
+        pending = false;
+    }
+    portEXIT_CRITICAL(&lookahead_mux);
+}
+
+void nav_lookahead_log_stats(void) {
+    static const char *const kind_names[NAV_SWITCH_KIND_COUNT] = { "local", "staged", "unstaged" };
+    Serial.printf("[LOOKAHEAD] staged=%lu build avg=%luus\n",
+                  stat_staged, stat_staged ? stat_stage_sum_us / stat_staged : 0);
+    for (int i = 0; i < NAV_SWITCH_KIND_COUNT; i++) {
+        const switch_stats_t *s = &stats[i];
+        Serial.printf("[LOOKAHEAD] %-8s switches=%lu build avg=%luus switch->glass avg=%luus max=%luus\n",
+                      kind_names[i], s->switches, s->switches ? s->build_sum_us / s->switches : 0,
+                      s->timed ? s->latency_sum_us / s->timed : 0, s->latency_max_us);
+    }
+}
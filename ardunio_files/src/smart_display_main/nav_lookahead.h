@@ -0,0 +1,55 @@
+#ifndef NAV_LOOKAHEAD_H
+#define NAV_LOOKAHEAD_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Maneuver lookahead
+// Navigation frames may list the next one or two maneuvers:
+//   "next":[["left",250,"Turn left onto MG Road"],["right",900]]
+// Each entry is [direction, meters from the previous maneuver (0 = unknown),
+// optional text or phrase tokens (phrase_dict.h)]. The navigation screen
+// builds the first one's arrow in a hidden widget group and shows a small
+// "then" glyph. At the turn - the local distance countdown reaching zero, or
+// a phone frame with that direction - it swaps the groups instead of building
+// the arrow then.
+//
+// This module times each switch from the swap (or build) to the end of the
+// next flushed frame, per switch kind.
+// ============================================================================
+
+#define NAV_LOOKAHEAD_MAX      2        // Upcoming maneuvers kept
+#define NAV_LOOKAHEAD_HOLD_MS  5000     // Ignore frames for the passed maneuver this long after a local switch
+
+typedef enum {
+    NAV_SWITCH_LOCAL = 0,               // Countdown reached zero, staged arrow shown
+    NAV_SWITCH_PHONE_STAGED,            // Phone sent the staged maneuver
+    NAV_SWITCH_PHONE_UNSTAGED,          // Phone sent a maneuver that had to be built
+    NAV_SWITCH_KIND_COUNT
+} NavSwitchKind;
+
+/**
+ * Count an arrow built ahead of time (UI task)
+ * @param build_us Time spent building its geometry
+ */
+void nav_lookahead_record_stage(uint32_t build_us);
+
+/**
+ * Start timing a maneuver switch (UI task)
+ * @param start_us micros() when the switch started
+ * @param build_us Geometry build time within the switch (0 if it was staged)
+ */
+void nav_lookahead_mark_switch(NavSwitchKind kind, uint32_t start_us, uint32_t build_us);
+
+/**
+ * Record one flushed area (display flush callback)
+ * @param last True for the last area of a frame
+ */
+void nav_lookahead_record_flush(bool last);
+
+/**
+ * Print switch counts and switch-to-glass latency per kind over serial
+ */
+void nav_lookahead_log_stats(void);
+
+#endif // NAV_LOOKAHEAD_H
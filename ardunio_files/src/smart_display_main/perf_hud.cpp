@@ -0,0 +1,214 @@
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "perf_hud.h"
+#include "ui_theme.h"
+#include "ble_frame.h"
+#include "lv_mem_pool.h"
+
+#define HUD_WIDTH   164
+#define HUD_HEIGHT  112
+
+static lv_obj_t *hud = nullptr;
+static lv_obj_t *hud_label = nullptr;
+static char hud_text[192];           // Shown in place (lv_label_set_text_static)
+
+// Requested from any task, applied by the refresh timer
+static volatile bool requested_visible = false;
+static bool shown = false;
+
+// Long press tracking (UI task)
+static uint32_t press_start_ms = 0;
+static bool press_toggled = false;
+
+// Current window (UI task, except the message fields)
+static uint32_t window_start_ms = 0;
+static uint32_t frames = 0;
+static uint32_t worst_frame_us = 0;
+static uint32_t flush_bytes = 0;
+static bool frame_flushed = false;
+static uint32_t queue_hwm = 0;
+
+// Messages and their latency to the next flushed frame
+static portMUX_TYPE msg_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t messages = 0;
+static uint32_t pending_msg_us = 0;  // Receive time of the oldest message not yet on glass
+static bool msg_pending = false;
+static uint32_t latency_us[PERF_HUD_LATENCY_SAMPLES];
+static uint8_t latency_count = 0;
+static uint8_t latency_next = 0;
+
+static void reset_window(uint32_t now_ms) {
+    window_start_ms = now_ms;
+    frames = 0;
+    worst_frame_us = 0;
+    flush_bytes = 0;
+    queue_hwm = 0;
+    portENTER_CRITICAL(&msg_mux);
+    messages = 0;
+    portEXIT_CRITICAL(&msg_mux);
+}
+
+static uint32_t latency_p95_us(uint8_t *samples) {
+    uint32_t sorted[PERF_HUD_LATENCY_SAMPLES];
+    portENTER_CRITICAL(&msg_mux);
+    uint8_t n = latency_count;
+    memcpy(sorted, latency_us, n * sizeof(sorted[0]));
+    portEXIT_CRITICAL(&msg_mux);
+
+    *samples = n;
+    if (n == 0) return 0;
+    // Insertion sort: at most 32 samples, twice a second
+    for (uint8_t i = 1; i < n; i++) {
+        uint32_t v = sorted[i];
+        int j = i - 1;
+        while (j >= 0 && sorted[j] > v) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+    return sorted[(n * 95 + 99) / 100 - 1];
+}
+
+static void refresh_cb(lv_timer_t *timer) {
+    (void)timer;
+    uint32_t now_ms = lv_tick_get();
+
+    if (requested_visible != shown) {
+        shown = requested_visible;
+        if (shown) {
+            lv_obj_clear_flag(hud, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(hud, LV_OBJ_FLAG_HIDDEN);
+        }
+        reset_window(now_ms);
+        Serial.printf("[HUD] %s\n", shown ? "Shown" : "Hidden");
+        return;
+    }
+    if (!shown) return;
+
+    uint32_t elapsed_ms = now_ms - window_start_ms;
+    if (elapsed_ms == 0) return;
+
+    portENTER_CRITICAL(&msg_mux);
+    uint32_t msg_count = messages;
+    portEXIT_CRITICAL(&msg_mux);
+
+    uint8_t samples;
+    uint32_t p95_us = latency_p95_us(&samples);
+
+    lv_mem_pool_stats_t pool;
+    lv_mem_pool_get_stats(&pool);
+
+    snprintf(hud_text, sizeof(hud_text),
+             "FPS %lu  worst %lu.%lums\n"
+             "flush %lu KB/s\n"
+             "BLE %lu.%lu msg/s\n"
+             "lat p95 %lums (%u)\n"
+             "ack q hwm %lu\n"
+             "lvgl free %luK/%luK\n"
+             "heap %luK",
+             frames * 1000 / elapsed_ms, worst_frame_us / 1000, (worst_frame_us / 100) % 10,
+             flush_bytes / elapsed_ms,   // bytes/ms = KB/s
+             msg_count * 1000 / elapsed_ms, (msg_count * 10000 / elapsed_ms) % 10,
+             p95_us / 1000, samples,
+             queue_hwm,
+             pool.free_bytes / 1024, pool.largest_free / 1024,
+             (uint32_t)heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024);
+    lv_label_set_text_static(hud_label, hud_text);  // Invalidates only the label
+
+    reset_window(now_ms);
+}
+
+static void press_event_cb(lv_event_t *e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_PRESSED) {
+        press_start_ms = lv_tick_get();
+        press_toggled = false;
+    } else if (code == LV_EVENT_LONG_PRESSED_REPEAT) {
+        if (!press_toggled && lv_tick_elaps(press_start_ms) >= PERF_HUD_LONG_PRESS_MS) {
+            press_toggled = true;
+            perf_hud_request(!perf_hud_visible());
+        }
+    }
+}
+
+void perf_hud_init(void) {
+    hud = lv_obj_create(lv_layer_top());
+    lv_obj_remove_style_all(hud);
+    lv_obj_set_size(hud, HUD_WIDTH, HUD_HEIGHT);
+    lv_obj_align(hud, LV_ALIGN_TOP_LEFT, 4, 4);
+    // Opaque: nothing underneath has to be blended into the HUD area
+    lv_obj_set_style_bg_color(hud, lv_color_hex(COLOR_BG_PRIMARY), 0);
+    lv_obj_set_style_bg_opa(hud, LV_OPA_COVER, 0);
+    lv_obj_set_style_border_color(hud, lv_color_hex(COLOR_ACCENT_GREEN), 0);
+    lv_obj_set_style_border_width(hud, 1, 0);
+    lv_obj_set_style_pad_all(hud, 3, 0);
+    lv_obj_clear_flag(hud, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(hud, LV_OBJ_FLAG_HIDDEN);
+
+    hud_label = lv_label_create(hud);
+    lv_obj_set_size(hud_label, LV_PCT(100), LV_PCT(100));   // Fixed size: new text never relayouts
+    lv_label_set_long_mode(hud_label, LV_LABEL_LONG_CLIP);
+    lv_obj_set_style_text_font(hud_label, &lv_font_montserrat_12, 0);
+    lv_obj_set_style_text_color(hud_label, lv_color_hex(COLOR_ACCENT_GREEN), 0);
+    hud_text[0] = '\0';
+    lv_label_set_text_static(hud_label, hud_text);
+
+    lv_timer_create(refresh_cb, PERF_HUD_REFRESH_MS, nullptr);
+}
+
+void perf_hud_bind_screen(lv_obj_t *screen) {
+    lv_obj_add_event_cb(screen, press_event_cb, LV_EVENT_PRESSED, nullptr);
+    lv_obj_add_event_cb(screen, press_event_cb, LV_EVENT_LONG_PRESSED_REPEAT, nullptr);
+}
+
+void perf_hud_request(bool visible) {
+    requested_visible = visible;
+}
+
+bool perf_hud_visible(void) {
+    return requested_visible;
+}
+
+void perf_hud_record_frame(uint32_t us) {
+    if (!shown) return;
+    if (us > worst_frame_us) worst_frame_us = us;
+    if (frame_flushed) {
+        frames++;
+        frame_flushed = false;
+    }
+    uint32_t backlog = ble_frame_ack_backlog();
+    if (backlog > queue_hwm) queue_hwm = backlog;
+}
+
+void perf_hud_record_flush(uint32_t bytes, bool last) {
+    if (!shown) return;
+    flush_bytes += bytes;
+    if (!last) return;
+    frame_flushed = true;
+
+    uint32_t now_us = micros();
+    portENTER_CRITICAL(&msg_mux);
+    if (msg_pending) {
+        latency_us[latency_next] = now_us - pending_msg_us;
+        latency_next = (latency_next + 1) % PERF_HUD_LATENCY_SAMPLES;
+        if (latency_count < PERF_HUD_LATENCY_SAMPLES) latency_count++;
+        msg_pending = false;
+    }
+    portEXIT_CRITICAL(&msg_mux);
+}
+
+void perf_hud_record_message(void) {
+    if (!shown) return;
+    uint32_t now_us = micros();
+    portENTER_CRITICAL(&msg_mux);
+    messages++;
+    if (!msg_pending) {
+        pending_msg_us = now_us;
+        msg_pending = true;
+    }
+    portEXIT_CRITICAL(&msg_mux);
+}
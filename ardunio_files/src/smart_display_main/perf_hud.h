@@ -0,0 +1,59 @@
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+#include <lvgl.h>
+
+// ============================================================================
+// Performance HUD
+// Hidden debug overlay on lv_layer_top(): FPS, worst frame, flush throughput,
+// BLE messages/s, message-to-glass latency p95, ack queue high-water mark
+// and heap headroom. Refreshes at 2 Hz; only its own fixed-size labels are
+// invalidated. Toggled by a long press anywhere or a BLE debug command.
+// ============================================================================
+
+#define PERF_HUD_REFRESH_MS        500
+#define PERF_HUD_LONG_PRESS_MS     1500   // Hold this long to toggle
+#define PERF_HUD_LATENCY_SAMPLES   32     // Latest messages considered for p95
+
+/**
+ * Create the (hidden) overlay
+ * Must be called from the UI task after the display is registered
+ */
+void perf_hud_init(void);
+
+/**
+ * Toggle the overlay by long press on this screen
+ * Called for every screen when it is built
+ */
+void perf_hud_bind_screen(lv_obj_t *screen);
+
+/**
+ * Request the overlay to be shown or hidden (safe from any task)
+ * Applied by the next refresh tick.
+ */
+void perf_hud_request(bool visible);
+
+/**
+ * Check if the overlay is shown (or requested to be)
+ */
+bool perf_hud_visible(void);
+
+/**
+ * Record one lv_timer_handler() call (UI task)
+ */
+void perf_hud_record_frame(uint32_t us);
+
+/**
+ * Record one flushed area (display flush callback)
+ * @param bytes Pixel bytes sent to the panel
+ * @param last True for the last area of a frame
+ */
+void perf_hud_record_flush(uint32_t bytes, bool last);
+
+/**
+ * Record a received BLE message (BLE task)
+ * Its latency runs until the end of the next flushed frame.
+ */
+void perf_hud_record_message(void);
+
+#endif // PERF_HUD_H
@@ -0,0 +1,55 @@
+#include <Arduino.h>
+#include <string.h>
+#include "phrase_dict.h"
+
+// Expansion runs on the BLE task (and on replays); the report only reads
+static uint32_t stat_frames = 0;
+static uint32_t stat_tokens = 0;
+static uint32_t stat_token_bytes = 0;     // "mt" array as received
+static uint32_t stat_text_bytes = 0;      // Same text as a quoted JSON string
+static uint32_t stat_rejected = 0;
+
+int phrase_dict_expand(JsonArrayConst tokens, uint32_t version, char *out, size_t out_size) {
+    if (out_size == 0) return -1;
+    out[0] = '\0';
+    if (version != PHRASE_DICT_VERSION) {
+        stat_rejected++;
+        return -1;
+    }
+
+    size_t len = 0;
+    uint32_t count = 0;
+    for (JsonVariantConst token : tokens) {
+        const char *text;
+        if (token.is<const char *>()) {
+            text = token.as<const char *>();
+        } else if (token.is<uint32_t>() && token.as<uint32_t>() > 0 && token.as<uint32_t>() < PHRASE_DICT_COUNT) {
+            text = phrase_dict[token.as<uint32_t>()];
+        } else {
+            out[0] = '\0';
+            stat_rejected++;
+            return -1;
+        }
+        count++;
+
+        // Single space between tokens; anything past the buffer is dropped
+        if (len > 0 && len + 1 < out_size) out[len++] = ' ';
+        if (len + 1 < out_size) {
+            size_t n = strlcpy(out + len, text, out_size - len);
+            len = (len + n < out_size) ? len + n : out_size - 1;
+        }
+    }
+    out[len] = '\0';
+
+    stat_frames++;
+    stat_tokens += count;
+    stat_token_bytes += measureJson(tokens);
+    stat_text_bytes += len + 2;
+    return (int)len;
+}
+
+void phrase_dict_log_stats(void) {
+    Serial.printf("[PHRASE] v%d frames=%lu tokens=%lu token_bytes=%lu text_bytes=%lu ratio=%lu%% rejected=%lu\n",
+                  PHRASE_DICT_VERSION, stat_frames, stat_tokens, stat_token_bytes, stat_text_bytes,
+                  stat_text_bytes ? stat_token_bytes * 100 / stat_text_bytes : 0, stat_rejected);
+}
@@ -0,0 +1,157 @@
+#ifndef PHRASE_DICT_H
+#define PHRASE_DICT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <ArduinoJson.h>
+
+// ============================================================================
+// Maneuver phrase dictionary
+// Navigation frames may carry the maneuver text as tokens instead of a string:
+//   {"type":"NAVIGATION",...,"mt":[4,"MG Road",79,101],"mv":1}
+// A number is a phrase ID from the table below, a string is literal text; the
+// text is the tokens joined by single spaces ("Turn right onto MG Road then
+// Ring Road" above). "mv" is PHRASE_DICT_VERSION - frames built with another
+// version are rejected rather than expanded into the wrong words.
+//
+// The phone has the same table (PhraseDictionary.kt). IDs are never reused:
+// change a phrase only together with a version bump on both sides.
+// ============================================================================
+
+#define PHRASE_DICT_VERSION 1
+
+static constexpr const char *const phrase_dict[] = {
+    nullptr,                                    // 0: not a phrase
+    "Turn left",                                // 1
+    "Turn right",                               // 2
+    "Turn left onto",                           // 3
+    "Turn right onto",                          // 4
+    "Slight left",                              // 5
+    "Slight right",                             // 6
+    "Slight left onto",                         // 7
+    "Slight right onto",                        // 8
+    "Sharp left",                               // 9
+    "Sharp right",                              // 10
+    "Sharp left onto",                          // 11
+    "Sharp right onto",                         // 12
+    "Keep left",                                // 13
+    "Keep right",                               // 14
+    "Keep left at the fork",                    // 15
+    "Keep right at the fork",                   // 16
+    "Keep left to continue on",                 // 17
+    "Keep right to continue on",                // 18
+    "Keep left to stay on",                     // 19
+    "Keep right to stay on",                    // 20
+    "Make a U-turn",                            // 21
+    "Make a U-turn at",                         // 22
+    "Head north",                               // 23
+    "Head south",                               // 24
+    "Head east",                                // 25
+    "Head west",                                // 26
+    "Head northeast",                           // 27
+    "Head northwest",                           // 28
+    "Head southeast",                           // 29
+    "Head southwest",                           // 30
+    "Head north on",                            // 31
+    "Head south on",                            // 32
+    "Head east on",                             // 33
+    "Head west on",                             // 34
+    "Continue",                                 // 35
+    "Continue onto",                            // 36
+    "Continue on",                              // 37
+    "Continue straight",                        // 38
+    "Continue straight onto",                   // 39
+    "Continue straight to stay on",             // 40
+    "At the roundabout,",                       // 41
+    "take the 1st exit",                        // 42
+    "take the 2nd exit",                        // 43
+    "take the 3rd exit",                        // 44
+    "take the 4th exit",                        // 45
+    "take the 5th exit",                        // 46
+    "At the roundabout, take the 1st exit",     // 47
+    "At the roundabout, take the 2nd exit",     // 48
+    "At the roundabout, take the 3rd exit",     // 49
+    "At the roundabout, take the 4th exit",     // 50
+    "At the roundabout, take the 5th exit",     // 51
+    "Go through 1 roundabout",                  // 52
+    "Go through 2 roundabouts",                 // 53
+    "Exit the roundabout",                      // 54
+    "onto",                                     // 55
+    "Take the exit",                            // 56
+    "Take exit",                                // 57
+    "Take the exit toward",                     // 58
+    "Take the ramp",                            // 59
+    "Take the ramp onto",                       // 60
+    "Take the ramp to",                         // 61
+    "Take the",                                 // 62
+    "exit",                                     // 63
+    "exit onto",                                // 64
+    "Merge onto",                               // 65
+    "Merge with",                               // 66
+    "Use the left lane",                        // 67
+    "Use the right lane",                       // 68
+    "Use the left 2 lanes",                     // 69
+    "Use the right 2 lanes",                    // 70
+    "Use any lane",                             // 71
+    "to turn left",                             // 72
+    "to turn right",                            // 73
+    "to take the",                              // 74
+    "to stay on",                               // 75
+    "to continue on",                           // 76
+    "then turn left",                           // 77
+    "then turn right",                          // 78
+    "then",                                     // 79
+    "toward",                                   // 80
+    "on",                                       // 81
+    "at",                                       // 82
+    "and",                                      // 83
+    "for",                                      // 84
+    "the",                                      // 85
+    "Destination reached",                      // 86
+    "Your destination is on the left",          // 87
+    "Your destination is on the right",         // 88
+    "Arrive at",                                // 89
+    "Pass by",                                  // 90
+    "Road",                                     // 91
+    "Rd",                                       // 92
+    "Street",                                   // 93
+    "St",                                       // 94
+    "Main Road",                                // 95
+    "Highway",                                  // 96
+    "Expressway",                               // 97
+    "Flyover",                                  // 98
+    "Bridge",                                   // 99
+    "Service Road",                             // 100
+    "Ring Road",                                // 101
+    "Cross",                                    // 102
+    "Marg",                                     // 103
+    "Nagar",                                    // 104
+    "Avenue",                                   // 105
+    "Lane",                                     // 106
+    "Circle",                                   // 107
+    "Junction",                                 // 108
+    "Nagar Main Road",                          // 109
+    "Layout",                                   // 110
+    "Bypass",                                   // 111
+    "km",                                       // 112
+    "m",                                        // 113
+};
+
+static constexpr size_t PHRASE_DICT_COUNT = sizeof(phrase_dict) / sizeof(phrase_dict[0]);
+static_assert(PHRASE_DICT_COUNT <= 256, "Phrase IDs must fit in a byte");
+
+/**
+ * Expand a token list into text
+ * Writes straight into the caller's buffer (truncated to fit, always terminated).
+ * @param tokens "mt" array of phrase IDs and literal strings
+ * @param version "mv" of the frame
+ * @return Text length, or -1 for another dictionary version or an unknown token
+ */
+int phrase_dict_expand(JsonArrayConst tokens, uint32_t version, char *out, size_t out_size);
+
+/**
+ * Print expanded frames and token vs text bytes over serial
+ */
+void phrase_dict_log_stats(void);
+
+#endif // PHRASE_DICT_H
@@ -0,0 +1,395 @@
+#include <Arduino.h>
+#include <string.h>
+#include "render_bench.h"
+#include "render_bench_baseline.h"
+#include "bench_stats.h"
+#include "ui_screens.h"
+#include "ui_transition.h"
+#include "ui_welcome_screen.h"
+#include "ui_idle_screen.h"
+#include "ui_navigation_screen.h"
+#include "ui_incoming_call_screen.h"
+#include "ui_outgoing_call_screen.h"
+#include "ui_missed_call_screen.h"
+#include "lv_mem_pool.h"
+#include "ui_anim.h"
+
+// One scripted scenario: setup() is not measured, then one frame per step
+typedef struct {
+    const char *name;
+    UIScreen screen;
+    const char *arg;                             // Passed to setup/step (maneuver kind)
+    void (*setup)(const char *arg);
+    void (*step)(uint8_t step, const char *arg);
+    uint8_t steps;
+    bool animated;                               // Let RENDER_BENCH_FRAME_MS pass before each frame
+} bench_scenario_t;
+
+typedef struct {
+    uint32_t render_us;
+    uint32_t inv_px;
+    uint32_t flush_bytes;
+    uint32_t flushes;
+    int32_t heap;
+} bench_frame_t;
+
+static volatile bool requested = false;
+
+// Flush counters (the flush callback runs inside lv_refr_now on the UI task)
+static bool measuring = false;
+static uint32_t frame_flushes = 0;
+static uint32_t frame_flush_bytes = 0;
+
+// ---- Scenario scripts ----
+
+static void welcome_setup(const char *arg) {
+    ui_welcome_screen_update_ble_status(false);
+}
+
+static void welcome_step(uint8_t step, const char *arg) {
+    ui_welcome_screen_update_ble_status(step % 2 == 0);
+}
+
+static void idle_setup(const char *arg) {
+    ui_idle_screen_stop_animations();
+    ui_idle_screen_set_no_nav_msg(false);
+    ui_idle_screen_update_ble_status(false);
+}
+
+static void idle_step(uint8_t step, const char *arg) {
+    if (step == 0) ui_idle_screen_update_ble_status(true);
+    else if (step == 1) ui_idle_screen_set_no_nav_msg(true);
+    else if (step == 2) ui_idle_screen_start_pulse();
+    // Later steps: pulse animation frames
+}
+
+static void nav_setup(const char *arg) {
+    ui_navigation_screen_clear();
+    ui_navigation_screen_update_direction("straight", false);
+    ui_navigation_screen_update_distance(1500, false);
+    ui_navigation_screen_update_maneuver("Continue on the current road");
+    ui_navigation_screen_update_eta("12 min");
+    ui_navigation_screen_show_critical_alert(false);
+}
+
+// A maneuver approached from 800 m down to the turn, as the phone sends it
+static void nav_step(uint8_t step, const char *arg) {
+    static const int distances[] = { 800, 450, 200, 80 };
+    switch (step) {
+        case 0: ui_navigation_screen_update_direction(arg, false); break;
+        case 1: ui_navigation_screen_update_maneuver("Turn onto Market Street toward Central Station"); break;
+        case 2: case 3: case 4: case 5:
+            ui_navigation_screen_update_distance(distances[step - 2], false);
+            if (step == 5) ui_navigation_screen_show_critical_alert(true);
+            break;
+        case 6: ui_navigation_screen_update_eta("9 min"); break;
+        default:
+            ui_navigation_screen_update_distance(0, false);
+            ui_navigation_screen_show_critical_alert(false);
+            break;
+    }
+}
+
+// The phone announces the next maneuver, then confirms it (staged arrow swap)
+static void nav_lookahead_step(uint8_t step, const char *arg) {
+    const char *const next_dirs[] = { arg, "right" };
+    static const int next_gaps[] = { 0, 400 };
+    static const char *const next_texts[] = { "Turn onto Market Street", "Turn right onto Hill Road" };
+    switch (step) {
+        case 0: ui_navigation_screen_set_next(next_dirs, next_gaps, next_texts, 2); break;
+        case 1: ui_navigation_screen_update_distance(120, false); break;
+        case 2: ui_navigation_screen_update_distance(40, false); break;
+        case 3:
+            ui_navigation_screen_update_direction(arg, false);
+            ui_navigation_screen_set_next(&next_dirs[1], &next_gaps[1], &next_texts[1], 1);
+            break;
+        case 4: ui_navigation_screen_update_distance(400, false); break;
+        case 5: ui_navigation_screen_update_maneuver(next_texts[0]); break;
+        default:
+            ui_navigation_screen_set_next(nullptr, nullptr, nullptr, 0);
+            break;
+    }
+}
+
+static void incoming_setup(const char *arg) {
+    ui_incoming_call_screen_stop_animations();
+    ui_incoming_call_screen_update("Unknown", "");
+}
+
+static void incoming_step(uint8_t step, const char *arg) {
+    if (step == 0) ui_incoming_call_screen_update("Alice Johnson", "+1 555 0100");
+    else if (step == 1) ui_incoming_call_screen_start_ringing();
+    // Later steps: ringing animation frames
+}
+
+static void outgoing_connecting_setup(const char *arg) {
+    ui_outgoing_call_screen_update("Unknown");
+    ui_outgoing_call_screen_set_connecting(false);
+}
+
+static void outgoing_connecting_step(uint8_t step, const char *arg) {
+    if (step == 0) ui_outgoing_call_screen_update("Bob Smith");
+    else if (step == 1) ui_outgoing_call_screen_set_connecting(true);
+    // Later steps: calling animation frames
+}
+
+static void outgoing_connected_setup(const char *arg) {
+    ui_outgoing_call_screen_update("Bob Smith");
+    ui_outgoing_call_screen_set_connecting(true);
+}
+
+static void outgoing_connected_step(uint8_t step, const char *arg) {
+    if (step == 0) ui_outgoing_call_screen_set_connecting(false);
+    else ui_outgoing_call_screen_update_duration(step);   // Once a second on the phone
+}
+
+static void missed_setup(const char *arg) {
+    ui_missed_call_screen_hide();
+    ui_missed_call_screen_update("Unknown", "", 1, "");
+}
+
+// arg: count shown ("1" = no badge)
+static void missed_step(uint8_t step, const char *arg) {
+    if (step == 0) ui_missed_call_screen_update("Carol White", "+1 555 0199", atoi(arg), "Just now");
+    else if (step == 1) ui_missed_call_screen_show();
+    // Later steps: card slide and badge blink frames
+}
+
+static const bench_scenario_t scenarios[] = {
+    { "welcome",             UI_SCREEN_WELCOME,       "",             welcome_setup,             welcome_step,             4, false },
+    { "idle",                UI_SCREEN_IDLE,          "",             idle_setup,                idle_step,                8, true  },
+    { "nav_straight",        UI_SCREEN_NAVIGATION,    "straight",     nav_setup,                 nav_step,                 8, false },
+    { "nav_left",            UI_SCREEN_NAVIGATION,    "left",         nav_setup,                 nav_step,                 8, false },
+    { "nav_right",           UI_SCREEN_NAVIGATION,    "right",        nav_setup,                 nav_step,                 8, false },
+    { "nav_slight_left",     UI_SCREEN_NAVIGATION,    "slight_left",  nav_setup,                 nav_step,                 8, false },
+    { "nav_sharp_right",     UI_SCREEN_NAVIGATION,    "sharp_right",  nav_setup,                 nav_step,                 8, false },
+    { "nav_keep_left",       UI_SCREEN_NAVIGATION,    "keep_left",    nav_setup,                 nav_step,                 8, false },
+    { "nav_uturn",           UI_SCREEN_NAVIGATION,    "uturn",        nav_setup,                 nav_step,                 8, false },
+    { "nav_roundabout",      UI_SCREEN_NAVIGATION,    "roundabout",   nav_setup,                 nav_step,                 8, false },
+    { "nav_lookahead",       UI_SCREEN_NAVIGATION,    "left",         nav_setup,                 nav_lookahead_step,       8, false },
+    { "nav_destination",     UI_SCREEN_NAVIGATION,    "destination",  nav_setup,                 nav_step,                 8, false },
+    { "incoming",            UI_SCREEN_INCOMING_CALL, "",             incoming_setup,            incoming_step,            8, true  },
+    { "outgoing_connecting", UI_SCREEN_OUTGOING_CALL, "",             outgoing_connecting_setup, outgoing_connecting_step, 8, true  },
+    { "outgoing_connected",  UI_SCREEN_OUTGOING_CALL, "",             outgoing_connected_setup,  outgoing_connected_step,  6, false },
+    { "missed",              UI_SCREEN_MISSED_CALL,   "1",            missed_setup,              missed_step,              8, true  },
+    { "missed_badge",        UI_SCREEN_MISSED_CALL,   "3",            missed_setup,              missed_step,              8, true  },
+};
+
+#define SCENARIO_COUNT (sizeof(scenarios) / sizeof(scenarios[0]))
+
+// ---- Measurement ----
+
+static int32_t lvgl_live_bytes(void) {
+    lv_mem_pool_stats_t stats;
+    lv_mem_pool_get_stats(&stats);
+    return (int32_t)stats.live_bytes;
+}
+
+// Area queued for redraw, before LVGL merges overlapping areas
+static uint32_t invalidated_px(void) {
+    lv_disp_t *disp = lv_disp_get_default();
+    uint32_t px = 0;
+    for (uint16_t i = 0; i < disp->inv_p; i++) {
+        if (!disp->inv_area_joined[i]) px += lv_area_get_size(&disp->inv_areas[i]);
+    }
+    return px;
+}
+
+static void measure_frame(const bench_scenario_t *sc, uint8_t step, bench_frame_t *frame) {
+    if (sc->animated) delay(RENDER_BENCH_FRAME_MS);
+
+    int32_t heap_before = lvgl_live_bytes();
+    sc->step(step, sc->arg);
+    frame->inv_px = invalidated_px();
+
+    frame_flushes = 0;
+    frame_flush_bytes = 0;
+    measuring = true;
+    uint32_t start_us = micros();
+    lv_refr_now(NULL);
+    frame->render_us = micros() - start_us;
+    measuring = false;
+
+    frame->flushes = frame_flushes;
+    frame->flush_bytes = frame_flush_bytes;
+    frame->heap = lvgl_live_bytes() - heap_before;
+}
+
+static uint32_t total_render_us(const bench_frame_t *frames, uint8_t count) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < count; i++) total += frames[i].render_us;
+    return total;
+}
+
+static const render_bench_baseline_t *find_baseline(const char *name) {
+    return bench_stats_find_baseline(render_bench_baseline, name);
+}
+
+// Run one scenario RENDER_BENCH_RUNS times and report the fastest run
+// @return true if it regressed against its baseline
+static bool run_scenario(const bench_scenario_t *sc) {
+    bench_frame_t best[RENDER_BENCH_MAX_FRAMES];
+    bench_frame_t frames[RENDER_BENCH_MAX_FRAMES];
+    uint32_t best_us = UINT32_MAX;
+    int32_t best_heap = 0;
+    uint8_t steps = sc->steps < RENDER_BENCH_MAX_FRAMES ? sc->steps : RENDER_BENCH_MAX_FRAMES;
+
+    for (uint8_t run = 0; run < RENDER_BENCH_RUNS; run++) {
+        // Unmeasured: switch, build if needed, reset content and render it
+        ui_show_screen(sc->screen, 0);
+        ui_screens_process_pending();
+        sc->setup(sc->arg);
+        lv_refr_now(NULL);
+
+        int32_t heap_start = lvgl_live_bytes();
+        for (uint8_t i = 0; i < steps; i++) {
+            measure_frame(sc, i, &frames[i]);
+        }
+        uint32_t us = total_render_us(frames, steps);
+        if (us < best_us) {
+            best_us = us;
+            best_heap = lvgl_live_bytes() - heap_start;
+            memcpy(best, frames, sizeof(bench_frame_t) * steps);
+        }
+    }
+
+    uint32_t max_us = 0;
+    uint32_t inv_px = 0;
+    uint32_t flush_bytes = 0;
+    uint32_t flushes = 0;
+    for (uint8_t i = 0; i < steps; i++) {
+        const bench_frame_t *f = &best[i];
+        Serial.printf("[RBENCH] FRAME scenario=%s frame=%u render_us=%lu inv_px=%lu flush_bytes=%lu flushes=%lu heap=%ld\n",
+                      sc->name, i, f->render_us, f->inv_px, f->flush_bytes, f->flushes, f->heap);
+        if (f->render_us > max_us) max_us = f->render_us;
+        inv_px += f->inv_px;
+        flush_bytes += f->flush_bytes;
+        flushes += f->flushes;
+    }
+    Serial.printf("[RBENCH] RESULT scenario=%s frames=%u render_us=%lu max_frame_us=%lu inv_px=%lu flush_bytes=%lu flushes=%lu heap=%ld\n",
+                  sc->name, steps, best_us, max_us, inv_px, flush_bytes, flushes, best_heap);
+
+    bool regressed = false;
+    const render_bench_baseline_t *base = find_baseline(sc->name);
+    if (base != nullptr) {
+        const render_bench_baseline_t result = { sc->name, best_us, inv_px, flushes, best_heap };
+        regressed = bench_stats_regressed(&result, base, RENDER_BENCH_TIME_TOLERANCE);
+        Serial.printf("[RBENCH] COMPARE scenario=%s render_us=%+ld%% inv_px=%+ld%% flushes=%+ld%% heap=%+ld %s\n",
+                      sc->name, bench_stats_pct_change(best_us, base->render_us),
+                      bench_stats_pct_change(inv_px, base->inv_px),
+                      bench_stats_pct_change(flushes, base->flushes), best_heap - base->heap,
+                      regressed ? "REGRESSION" : "ok");
+    }
+    Serial.printf("[RBENCH] BASELINE { \"%s\", %lu, %lu, %lu, %ld },\n",
+                  sc->name, best_us, inv_px, flushes, best_heap);
+    return regressed;
+}
+
+// ---- Animation soak ----
+
+// One call state per cycle; each starts (or restarts) that screen's animations
+static void soak_state(uint32_t cycle) {
+    switch (cycle % 4) {
+        case 0:
+            ui_show_screen(UI_SCREEN_INCOMING_CALL, 0);
+            ui_screens_process_pending();
+            ui_incoming_call_screen_update("Alice Johnson", "+1 555 0100");
+            ui_incoming_call_screen_start_ringing();
+            break;
+        case 1:
+            ui_show_screen(UI_SCREEN_MISSED_CALL, 0);
+            ui_screens_process_pending();
+            ui_missed_call_screen_update("Alice Johnson", "+1 555 0100", (int)(cycle % 3) + 1, "Just now");
+            ui_missed_call_screen_show();
+            break;
+        case 2:
+            ui_show_screen(UI_SCREEN_OUTGOING_CALL, 0);
+            ui_screens_process_pending();
+            ui_outgoing_call_screen_update("Bob Smith");
+            ui_outgoing_call_screen_set_connecting(true);
+            break;
+        default:
+            ui_show_screen(UI_SCREEN_IDLE, 0);
+            ui_screens_process_pending();
+            ui_idle_screen_start_pulse();
+            break;
+    }
+}
+
+static void soak_frame(void) {
+    ui_anim_frame_begin();
+    lv_timer_handler();
+}
+
+// @return true if it passed
+static bool run_anim_soak(void) {
+    // Warm-up: every screen is built before the heap is sampled
+    for (uint32_t cycle = 0; cycle < 4; cycle++) {
+        soak_state(cycle);
+        soak_frame();
+    }
+
+    ui_anim_stats_t before;
+    ui_anim_stats_t after;
+    ui_anim_get_stats(&before);
+    int32_t heap_start = lvgl_live_bytes();
+    uint32_t start_ms = millis();
+
+    // 1-3 frames per state, so most animations are cut off by the next switch
+    for (uint32_t cycle = 0; cycle < RENDER_BENCH_SOAK_CYCLES; cycle++) {
+        soak_state(cycle);
+        for (uint32_t frame = 0; frame <= cycle % 3; frame++) soak_frame();
+    }
+
+    // Leaving the last screen must take its animations along
+    ui_idle_screen_stop_animations();
+    ui_show_screen(UI_SCREEN_NAVIGATION, 0);
+    ui_screens_process_pending();
+    soak_frame();
+
+    ui_anim_get_stats(&after);
+    int32_t heap = lvgl_live_bytes() - heap_start;
+    uint32_t over_budget = after.over_budget - before.over_budget;
+    uint32_t dropped = after.dropped_requests - before.dropped_requests;
+    bool passed = after.active == 0 && over_budget == 0 && dropped == 0 && heap <= 0;
+    Serial.printf("[RBENCH] ANIMSOAK cycles=%d ms=%lu started=%lu cancelled=%lu stale=%lu deferred=%lu "
+                  "peak_frame_px=%lu over_budget=%lu dropped=%lu active=%u heap=%ld %s\n",
+                  RENDER_BENCH_SOAK_CYCLES, millis() - start_ms, after.started - before.started,
+                  after.cancelled - before.cancelled, after.stale - before.stale,
+                  after.deferred - before.deferred, after.peak_frame_area, over_budget, dropped,
+                  after.active, heap, passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+void render_bench_request(void) {
+    requested = true;
+}
+
+uint32_t render_bench_run(void) {
+    Serial.printf("[RBENCH] Rendering %u scenarios (%d runs each)...\n", (unsigned)SCENARIO_COUNT, RENDER_BENCH_RUNS);
+    ui_transition_finish();
+    uint32_t start_ms = millis();
+    uint32_t compared = 0;
+    uint32_t regressions = 0;
+    for (size_t i = 0; i < SCENARIO_COUNT; i++) {
+        if (find_baseline(scenarios[i].name) != nullptr) compared++;
+        if (run_scenario(&scenarios[i])) regressions++;
+    }
+    if (!run_anim_soak()) regressions++;
+    Serial.printf("[RBENCH] SUMMARY scenarios=%u compared=%lu regressions=%lu ms=%lu\n",
+                  (unsigned)SCENARIO_COUNT, compared, regressions, millis() - start_ms);
+    return regressions;
+}
+
+bool render_bench_process(void) {
+    if (!requested) return false;
+    requested = false;
+    render_bench_run();
+    return true;
+}
+
+void render_bench_record_flush(uint32_t bytes) {
+    if (!measuring) return;
+    frame_flushes++;
+    frame_flush_bytes += bytes;
+}
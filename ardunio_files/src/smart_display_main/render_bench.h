@@ -0,0 +1,76 @@
+#ifndef RENDER_BENCH_H
+#define RENDER_BENCH_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Screen render benchmark
+// Runs a scripted update sequence on every screen (welcome, idle, navigation
+// for each maneuver kind, incoming, outgoing connecting/connected, missed
+// with and without a count badge) and renders one frame per step on the
+// real panel. Setup (screen switch, first build) is not measured.
+//
+// Per frame: render time (lv_refr_now), invalidated area (as queued, before
+// LVGL joins areas), flushed bytes, flush calls and LVGL heap delta. Each
+// scenario runs RENDER_BENCH_RUNS times; the run with the lowest total render
+// time is reported.
+//
+// Output, per scenario:
+//   [RBENCH] FRAME scenario=nav_left frame=2 render_us=.. inv_px=.. flush_bytes=.. flushes=.. heap=..
+//   [RBENCH] RESULT scenario=nav_left frames=.. render_us=.. max_frame_us=.. inv_px=.. ...
+//   [RBENCH] COMPARE scenario=nav_left render_us=+4% ... ok|REGRESSION
+//   [RBENCH] BASELINE { "nav_left", .., .., .., .. },
+// BASELINE lines go into render_bench_baseline.h to make a run the new
+// reference.
+//
+// Animation soak (after the scenarios): switches call states as fast as the
+// UI task allows, with ringing, badge blink, card slide and idle pulse
+// animations cut off mid-flight, then checks the animation service counters:
+//   [RBENCH] ANIMSOAK cycles=.. ms=.. started=.. cancelled=.. stale=.. deferred=..
+//            peak_frame_px=.. over_budget=.. dropped=.. active=.. heap=.. PASS|FAIL
+// It fails if an animation outlives its screen, a request is lost, animations
+// together pass the per-frame area budget, or the LVGL heap grows.
+// ============================================================================
+
+#define RENDER_BENCH_RUNS            3     // Runs per scenario (fastest is kept)
+#define RENDER_BENCH_MAX_FRAMES      12    // Measured steps per scenario
+#define RENDER_BENCH_FRAME_MS        33    // Time between animated frames
+#define RENDER_BENCH_TIME_TOLERANCE  10    // % slower than the baseline before it counts
+#define RENDER_BENCH_SOAK_CYCLES     400   // Call state changes in the animation soak
+
+/**
+ * Reference numbers for one scenario (render_bench_baseline.h)
+ */
+typedef struct {
+    const char *scenario;            // nullptr ends the table
+    uint32_t render_us;              // Total render time over all frames
+    uint32_t inv_px;                 // Total invalidated area
+    uint32_t flushes;                // Total flush calls
+    int32_t heap;                    // LVGL heap change over the scenario
+} render_bench_baseline_t;
+
+/**
+ * Ask for a run (safe from any task; runs on the next render_bench_process())
+ */
+void render_bench_request(void);
+
+/**
+ * Run the benchmark now (UI task; takes over the display until done)
+ * The caller restores the screen that should be showing afterwards.
+ * @return Number of scenarios slower or larger than their baseline (plus 1 if the soak failed)
+ */
+uint32_t render_bench_run(void);
+
+/**
+ * Run a requested benchmark (call from loop() before lv_timer_handler())
+ * @return true if a run happened (the caller restores its screen)
+ */
+bool render_bench_process(void);
+
+/**
+ * Record one flushed area (display flush callback)
+ * @param bytes Pixel bytes sent to the panel
+ */
+void render_bench_record_flush(uint32_t bytes);
+
+#endif // RENDER_BENCH_H
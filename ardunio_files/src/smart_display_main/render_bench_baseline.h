@@ -0,0 +1,13 @@
+#ifndef RENDER_BENCH_BASELINE_H
+#define RENDER_BENCH_BASELINE_H
+
+#include "render_bench.h"
+
+// Reference results for render_bench.cpp, one entry per scenario.
+// Replace the entries with the "[RBENCH] BASELINE" lines of a run on the
+// reference build; scenarios without an entry are reported but not compared.
+static const render_bench_baseline_t render_bench_baseline[] = {
+    { nullptr, 0, 0, 0, 0 }
+};
+
+#endif // RENDER_BENCH_BASELINE_H
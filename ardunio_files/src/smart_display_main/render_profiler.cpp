@@ -0,0 +1,173 @@
+#include <Arduino.h>
+#include <string.h>
+#include "render_profiler.h"
+#include "ui_screens.h"
+
+// One profiled object (UI task only)
+typedef struct {
+    lv_obj_t *obj;                   // nullptr once deleted (stats are kept)
+    const char *screen;              // Screen name at attach time
+    const lv_obj_class_t *cls;
+    char text[16];                   // Label text captured at attach time
+    uint32_t begin_us;
+    uint32_t draws;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint64_t pixels;
+} profile_entry_t;
+
+static profile_entry_t entries[RENDER_PROFILER_MAX_OBJECTS];
+static uint8_t entry_count = 0;
+static uint32_t skipped_objects = 0;
+static bool running = false;
+static uint32_t started_ms = 0;
+
+static volatile bool requested = false;
+
+static const char *class_name(const lv_obj_class_t *cls) {
+    if (cls == &lv_label_class) return "label";
+    if (cls == &lv_line_class) return "line";
+    if (cls == &lv_img_class) return "img";
+    if (cls == &lv_btn_class) return "btn";
+    if (cls == &lv_arc_class) return "arc";
+    if (cls == &lv_bar_class) return "bar";
+    return "obj";
+}
+
+static void draw_event_cb(lv_event_t *e) {
+    profile_entry_t *entry = (profile_entry_t *)lv_event_get_user_data(e);
+    lv_event_code_t code = lv_event_get_code(e);
+
+    if (code == LV_EVENT_DRAW_MAIN_BEGIN) {
+        // Pixels of this object inside the area being redrawn
+        lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+        lv_area_t coords;
+        lv_area_t visible;
+        lv_obj_get_coords(entry->obj, &coords);
+        if (_lv_area_intersect(&visible, draw_ctx->clip_area, &coords)) {
+            entry->pixels += lv_area_get_size(&visible);
+        }
+        entry->begin_us = micros();
+    } else if (code == LV_EVENT_DRAW_MAIN_END) {
+        uint32_t us = micros() - entry->begin_us;
+        entry->draws++;
+        entry->total_us += us;
+        if (us > entry->max_us) entry->max_us = us;
+    } else if (code == LV_EVENT_DELETE) {
+        entry->obj = nullptr;
+    }
+}
+
+static lv_obj_tree_walk_res_t attach_cb(lv_obj_t *obj, void *user_data) {
+    const char *screen_name = (const char *)user_data;
+    if (entry_count >= RENDER_PROFILER_MAX_OBJECTS) {
+        skipped_objects++;
+        return LV_OBJ_TREE_WALK_NEXT;
+    }
+
+    profile_entry_t *entry = &entries[entry_count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->obj = obj;
+    entry->screen = screen_name;
+    entry->cls = lv_obj_get_class(obj);
+    if (entry->cls == &lv_label_class) {
+        strncpy(entry->text, lv_label_get_text(obj), sizeof(entry->text) - 1);
+    }
+
+    lv_obj_add_event_cb(obj, draw_event_cb, LV_EVENT_DRAW_MAIN_BEGIN, entry);
+    lv_obj_add_event_cb(obj, draw_event_cb, LV_EVENT_DRAW_MAIN_END, entry);
+    lv_obj_add_event_cb(obj, draw_event_cb, LV_EVENT_DELETE, entry);
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+void render_profiler_attach_screen(lv_obj_t *screen) {
+    if (!running || screen == nullptr) return;
+    lv_obj_tree_walk(screen, attach_cb, (void *)ui_screens_name(screen));
+}
+
+static void start(void) {
+    entry_count = 0;
+    skipped_objects = 0;
+    running = true;
+    started_ms = millis();
+
+    lv_disp_t *disp = lv_disp_get_default();
+    for (uint32_t i = 0; i < disp->screen_cnt; i++) {
+        render_profiler_attach_screen(disp->screens[i]);
+    }
+    lv_obj_invalidate(lv_scr_act());   // Profile a full frame first
+    Serial.printf("[PROFILE] Started: %u objects instrumented (%lu skipped)\n", entry_count, skipped_objects);
+}
+
+static void stop(void) {
+    render_profiler_log_stats();
+    for (uint8_t i = 0; i < entry_count; i++) {
+        profile_entry_t *entry = &entries[i];
+        if (entry->obj == nullptr) continue;
+        while (lv_obj_remove_event_cb_with_user_data(entry->obj, draw_event_cb, entry)) {
+        }
+        entry->obj = nullptr;
+    }
+    entry_count = 0;
+    running = false;
+    Serial.println("[PROFILE] Stopped");
+}
+
+void render_profiler_request(bool enabled) {
+    requested = enabled;
+}
+
+void render_profiler_process(void) {
+    if (requested == running) return;
+    if (requested) {
+        start();
+    } else {
+        stop();
+    }
+}
+
+void render_profiler_log_stats(void) {
+    if (entry_count == 0) return;
+
+    // Indices sorted by screen, then by total time (insertion sort, UI task)
+    uint8_t order[RENDER_PROFILER_MAX_OBJECTS];
+    for (uint8_t i = 0; i < entry_count; i++) {
+        uint8_t j = i;
+        while (j > 0) {
+            const profile_entry_t *a = &entries[order[j - 1]];
+            const profile_entry_t *b = &entries[i];
+            int cmp = strcmp(a->screen, b->screen);
+            if (cmp < 0 || (cmp == 0 && a->total_us >= b->total_us)) break;
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    Serial.printf("[PROFILE] ===== Render cost per object (%lu s) =====\n", (millis() - started_ms) / 1000);
+    uint8_t i = 0;
+    while (i < entry_count) {
+        const char *screen = entries[order[i]].screen;
+        uint64_t screen_us = 0;
+        uint8_t end = i;
+        while (end < entry_count && strcmp(entries[order[end]].screen, screen) == 0) {
+            screen_us += entries[order[end]].total_us;
+            end++;
+        }
+        if (screen_us == 0) {
+            i = end;
+            continue;   // Never drawn while profiling
+        }
+
+        Serial.printf("[PROFILE] %s: %lu us total\n", screen, (uint32_t)screen_us);
+        for (; i < end; i++) {
+            const profile_entry_t *entry = &entries[order[i]];
+            if (entry->draws == 0) continue;
+            Serial.printf("[PROFILE]   %-5s %-15s draws=%-5lu avg=%5luus max=%5luus px/draw=%-6lu share=%u%%\n",
+                          class_name(entry->cls), entry->text, entry->draws,
+                          (uint32_t)(entry->total_us / entry->draws), entry->max_us,
+                          (uint32_t)(entry->pixels / entry->draws),
+                          (unsigned)(entry->total_us * 100 / screen_us));
+        }
+    }
+}
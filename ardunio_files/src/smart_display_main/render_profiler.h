@@ -0,0 +1,39 @@
+#ifndef RENDER_PROFILER_H
+#define RENDER_PROFILER_H
+
+#include <lvgl.h>
+
+// ============================================================================
+// Per-widget render profiler
+// While running, every object on the built screens carries draw event hooks
+// (LV_EVENT_DRAW_MAIN_BEGIN/END) that attribute its own drawing time and the
+// pixels it covered. Children are drawn after their parent's DRAW_MAIN_END,
+// so each object's cost is exclusive of its children. Results are grouped
+// per screen and printed as a table sorted by total time.
+// ============================================================================
+
+#define RENDER_PROFILER_MAX_OBJECTS  96   // Objects beyond this are not profiled
+
+/**
+ * Request profiling on or off (safe from any task)
+ * Stopping prints the final table. Applied by render_profiler_process().
+ */
+void render_profiler_request(bool enabled);
+
+/**
+ * Apply a pending start/stop request
+ * Call from loop() before lv_timer_handler()
+ */
+void render_profiler_process(void);
+
+/**
+ * Instrument a screen built while profiling is running (no-op otherwise)
+ */
+void render_profiler_attach_screen(lv_obj_t *screen);
+
+/**
+ * Print the per-screen tables over serial (no-op while not running)
+ */
+void render_profiler_log_stats(void);
+
+#endif // RENDER_PROFILER_H
@@ -0,0 +1,340 @@
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "replay_bench.h"
+#include "ble_frame.h"
+#include "frame_dedup.h"
+#include "bench_stats.h"
+
+#define BENCH_STACK_SIZE  6144   // Runs the whole message path
+#define BENCH_PRIORITY    1      // Same as loop(): the display keeps rendering
+
+static const char *const scenario_names[REPLAY_BENCH_SCENARIO_COUNT] = {
+    "city", "highway", "roundabout", "calls"
+};
+
+static replay_bench_sink_t bench_sink = nullptr;
+static TaskHandle_t bench_task = nullptr;
+
+// Requested run (set by replay_bench_request, read by the bench task)
+static volatile bool running = false;
+static volatile bool stop_requested = false;
+static volatile uint8_t requested_scenario = 0;
+static volatile uint8_t requested_speed = 1;
+
+// Current measurement
+typedef struct {
+    uint32_t us[REPLAY_BENCH_SAMPLES];
+    uint16_t count;
+    uint16_t next;
+} stage_samples_t;
+
+static volatile bool measuring = false;
+static const char *run_source = "";
+static uint8_t run_speed = 1;
+static uint32_t run_start_ms = 0;
+static uint32_t run_end_ms = 0;
+static uint32_t writes = 0;
+static uint32_t messages = 0;
+static uint32_t decode_in_write_us = 0;   // Decode time of the current write
+static stage_samples_t frame_stage;
+static stage_samples_t decode_stage;
+static stage_samples_t glass_stage;       // Written by the UI task
+
+// Flush side (UI task)
+static portMUX_TYPE glass_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t pending_write_us = 0;     // Oldest write not yet on the glass
+static bool write_pending = false;
+static uint32_t frames = 0;
+static uint64_t flush_bytes = 0;
+
+static void add_sample(stage_samples_t *stage, uint32_t us) {
+    stage->us[stage->next] = us;
+    stage->next = (stage->next + 1) % REPLAY_BENCH_SAMPLES;
+    if (stage->count < REPLAY_BENCH_SAMPLES) stage->count++;
+}
+
+static void reset_stage(stage_samples_t *stage) {
+    stage->count = 0;
+    stage->next = 0;
+}
+
+// p50/p95/p99/max of a stage
+static void percentiles(const stage_samples_t *stage, uint32_t out[4]) {
+    static uint32_t sorted[REPLAY_BENCH_SAMPLES];
+    bench_stats_percentiles(stage->us, stage->count, sorted, out);
+}
+
+// ---- Scenarios ----
+// Each step is one write; delay_ms is the gap before it at 1x.
+
+static const char *const streets[] = { "MG Road", "Residency Road", "Brigade Road", "Church Street" };
+static const char *const ordinals[] = { "1st", "2nd", "3rd", "4th" };
+
+static int nav_json(char *buf, size_t size, const char *dir, int dist, const char *maneuver, int eta_s) {
+    return snprintf(buf, size,
+                    "{\"type\":\"NAVIGATION\",\"direction\":\"%s\",\"distance\":%d,"
+                    "\"maneuver\":\"%s\",\"eta\":\"%d min\",\"eta_s\":%d}",
+                    dir, dist, maneuver, (eta_s + 59) / 60, eta_s);
+}
+
+static int city_json(uint32_t step, char *buf, size_t size) {
+    static const char *const dirs[] = { "right", "left", "slight_right", "straight" };
+    static char maneuver[64];
+    uint32_t leg = step / 15;
+    const char *dir = dirs[leg % 4];
+    snprintf(maneuver, sizeof(maneuver), "Turn %s onto %s", dir, streets[leg % 4]);
+    return nav_json(buf, size, dir, 300 - (int)(step % 15) * 20, maneuver, 900 - (int)step * 4);
+}
+
+static bool scenario_step(uint8_t scenario, uint32_t step, uint8_t *stream, char *buf, size_t size,
+                          int *len, uint32_t *delay_ms) {
+    static char maneuver[64];
+    *stream = BLE_STREAM_NAV;
+
+    switch (scenario) {
+        case REPLAY_BENCH_CITY:
+            if (step >= 180) return false;
+            *delay_ms = 1000;
+            *len = city_json(step, buf, size);
+            return true;
+
+        case REPLAY_BENCH_HIGHWAY: {
+            if (step >= 180) return false;
+            *delay_ms = 1000;
+            int dist = 12000 - (int)step * 30;
+            if (step % 60 >= 50) {
+                snprintf(maneuver, sizeof(maneuver), "Keep left to take exit %lu", step / 60 + 21);
+                *len = nav_json(buf, size, "keep_left", 500 - (int)(step % 60 - 50) * 50, maneuver, 2400 - (int)step);
+            } else {
+                snprintf(maneuver, sizeof(maneuver), "Continue on NH 48 for %d km", dist / 1000);
+                *len = nav_json(buf, size, "straight", dist, maneuver, 2400 - (int)step);
+            }
+            return true;
+        }
+
+        case REPLAY_BENCH_ROUNDABOUT: {
+            static const char *const dirs[] = { "roundabout_left", "roundabout_right", "roundabout" };
+            if (step >= 96) return false;
+            uint32_t burst = step / 8;
+            uint32_t i = step % 8;
+            *delay_ms = (i == 0) ? 1000 : 40;
+            snprintf(maneuver, sizeof(maneuver), "At the roundabout, take the %s exit onto %s",
+                     ordinals[burst % 4], streets[burst % 4]);
+            *len = nav_json(buf, size, dirs[burst % 3], 80 - (int)i * 10, maneuver, 600 - (int)burst * 10);
+            return true;
+        }
+
+        case REPLAY_BENCH_CALLS: {
+            static const char *const names[] = { "Asha", "Ravi Kumar", "Office", "Unknown" };
+            if (step >= 160) return false;
+            *delay_ms = 100;
+            if (step % 2 == 0) {
+                *len = city_json(step / 2, buf, size);
+                return true;
+            }
+            // INCOMING, ONGOING (calling), ONGOING (connected), ENDED - every 4th call is missed
+            uint32_t call = step / 10;
+            uint32_t phase = (step / 2) % 5;
+            const char *state;
+            int duration = 0;
+            switch (phase) {
+                case 0: state = "INCOMING"; break;
+                case 1: state = "ONGOING"; break;
+                case 2: state = "ONGOING"; duration = (int)step; break;
+                case 3: state = (call % 4 == 3) ? "MISSED" : "ENDED"; break;
+                default: state = "ENDED"; break;
+            }
+            *stream = BLE_STREAM_CALL;
+            *len = snprintf(buf, size,
+                            "{\"type\":\"phone_call\",\"caller_name\":\"%s\",\"caller_number\":\"+91 98450 %05lu\","
+                            "\"call_state\":\"%s\",\"duration\":%d}",
+                            names[call % 4], 10000 + call % 4, state, duration);
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+static void run_scenario(uint8_t scenario, uint8_t speed) {
+    static uint8_t write_buf[BLE_FRAME_HEADER_LEN + 256];
+    uint16_t seq[BLE_STREAM_COUNT] = { 0 };
+
+    // Fresh sequence and duplicate state, as after a connect (the live state is set aside)
+    ble_frame_save();
+    ble_frame_reset();
+    frame_dedup_reset();
+    replay_bench_begin(scenario_names[scenario], speed);
+
+    uint8_t stream;
+    int len;
+    uint32_t delay_ms;
+    char *json = (char *)write_buf + BLE_FRAME_HEADER_LEN;
+    for (uint32_t step = 0; !stop_requested; step++) {
+        if (!scenario_step(scenario, step, &stream, json, sizeof(write_buf) - BLE_FRAME_HEADER_LEN, &len, &delay_ms)) break;
+        if (len <= 0 || len >= (int)(sizeof(write_buf) - BLE_FRAME_HEADER_LEN)) continue;
+
+        write_buf[0] = BLE_FRAME_MAGIC;
+        write_buf[1] = stream;
+        write_buf[2] = seq[stream] & 0xFF;
+        write_buf[3] = seq[stream] >> 8;
+        seq[stream]++;
+
+        if (speed > 0 && step > 0) {
+            vTaskDelay(pdMS_TO_TICKS(delay_ms / speed));
+        } else {
+            taskYIELD();
+        }
+        bench_sink(stream, write_buf, BLE_FRAME_HEADER_LEN + len);
+    }
+
+    replay_bench_end();
+    ble_frame_restore();   // Live writes resume where the phone left off
+    frame_dedup_reset();   // The UI shows scenario data: re-apply the next live frames
+}
+
+static void bench_task_fn(void *arg) {
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        run_scenario(requested_scenario, requested_speed);
+        running = false;
+    }
+}
+
+void replay_bench_init(replay_bench_sink_t sink) {
+    bench_sink = sink;
+    if (xTaskCreate(bench_task_fn, "bench", BENCH_STACK_SIZE, nullptr, BENCH_PRIORITY, &bench_task) != pdPASS) {
+        Serial.println("[BENCH] Task not created - scenarios unavailable");
+        bench_task = nullptr;
+    }
+}
+
+bool replay_bench_request(const char *name, uint8_t speed) {
+    if (bench_task == nullptr || name == nullptr) return false;
+    if (running || measuring) {
+        Serial.println("[BENCH] A run is already going");
+        return false;
+    }
+    for (uint8_t i = 0; i < REPLAY_BENCH_SCENARIO_COUNT; i++) {
+        if (strcmp(name, scenario_names[i]) == 0) {
+            requested_scenario = i;
+            requested_speed = speed;
+            stop_requested = false;
+            running = true;   // Live writes are ignored from here on
+            xTaskNotifyGive(bench_task);
+            return true;
+        }
+    }
+    Serial.printf("[BENCH] Unknown scenario '%s' (city, highway, roundabout, calls)\n", name);
+    return false;
+}
+
+void replay_bench_stop(void) {
+    stop_requested = true;
+}
+
+bool replay_bench_running(void) {
+    return running;
+}
+
+void replay_bench_begin(const char *source, uint8_t speed) {
+    run_source = source;
+    run_speed = speed;
+    writes = 0;
+    messages = 0;
+    decode_in_write_us = 0;
+    reset_stage(&frame_stage);
+    reset_stage(&decode_stage);
+    portENTER_CRITICAL(&glass_mux);
+    reset_stage(&glass_stage);
+    write_pending = false;
+    frames = 0;
+    flush_bytes = 0;
+    portEXIT_CRITICAL(&glass_mux);
+    run_start_ms = millis();
+    measuring = true;
+    if (speed == 0) {
+        Serial.printf("[BENCH] Started: %s at full speed\n", source);
+    } else {
+        Serial.printf("[BENCH] Started: %s at %ux\n", source, speed);
+    }
+}
+
+bool replay_bench_measuring(void) {
+    return measuring;
+}
+
+void replay_bench_end(void) {
+    if (!measuring) return;
+    run_end_ms = millis();
+    vTaskDelay(pdMS_TO_TICKS(REPLAY_BENCH_SETTLE_MS));
+    measuring = false;
+
+    uint32_t elapsed_ms = run_end_ms - run_start_ms;
+    uint32_t frame_p[4], decode_p[4], glass_p[4];
+    percentiles(&frame_stage, frame_p);
+    percentiles(&decode_stage, decode_p);
+    portENTER_CRITICAL(&glass_mux);
+    uint32_t frame_count = frames;
+    uint64_t bytes = flush_bytes;
+    portEXIT_CRITICAL(&glass_mux);
+    percentiles(&glass_stage, glass_p);   // The UI task no longer adds samples
+    float msg_per_s = elapsed_ms ? messages * 1000.0f / elapsed_ms : 0.0f;
+    uint32_t pixels = (uint32_t)(bytes / 2);   // RGB565
+
+    Serial.printf("[BENCH] ===== %s @ %ux (0 = full speed) =====\n", run_source, run_speed);
+    Serial.printf("[BENCH] %lu writes, %lu messages in %lu ms: %.1f msg/s\n", writes, messages, elapsed_ms, msg_per_s);
+    Serial.printf("[BENCH] frame  p50=%6luus p95=%6luus p99=%6luus max=%6luus\n", frame_p[0], frame_p[1], frame_p[2], frame_p[3]);
+    Serial.printf("[BENCH] decode p50=%6luus p95=%6luus p99=%6luus max=%6luus\n", decode_p[0], decode_p[1], decode_p[2], decode_p[3]);
+    Serial.printf("[BENCH] glass  p50=%6luus p95=%6luus p99=%6luus max=%6luus\n", glass_p[0], glass_p[1], glass_p[2], glass_p[3]);
+    Serial.printf("[BENCH] %lu frames rendered, %lu pixels flushed\n", frame_count, pixels);
+    Serial.printf("[BENCH] RESULT source=%s speed=%u writes=%lu msgs=%lu ms=%lu msg_per_s=%.1f "
+                  "frame_p50_us=%lu frame_p95_us=%lu frame_p99_us=%lu "
+                  "decode_p50_us=%lu decode_p95_us=%lu decode_p99_us=%lu "
+                  "glass_p50_us=%lu glass_p95_us=%lu glass_p99_us=%lu frames=%lu pixels=%lu\n",
+                  run_source, run_speed, writes, messages, elapsed_ms, msg_per_s,
+                  frame_p[0], frame_p[1], frame_p[2], decode_p[0], decode_p[1], decode_p[2],
+                  glass_p[0], glass_p[1], glass_p[2], frame_count, pixels);
+}
+
+void replay_bench_record_write(uint32_t us) {
+    if (!measuring) return;
+    writes++;
+    add_sample(&frame_stage, us > decode_in_write_us ? us - decode_in_write_us : 0);
+    decode_in_write_us = 0;
+
+    uint32_t received_us = micros() - us;
+    portENTER_CRITICAL(&glass_mux);
+    if (!write_pending) {
+        pending_write_us = received_us;
+        write_pending = true;
+    }
+    portEXIT_CRITICAL(&glass_mux);
+}
+
+void replay_bench_record_decode(uint32_t us) {
+    if (!measuring) return;
+    messages++;
+    decode_in_write_us += us;
+    add_sample(&decode_stage, us);
+}
+
+void replay_bench_record_flush(uint32_t bytes, bool last) {
+    if (!measuring) return;
+    uint32_t now_us = micros();
+    portENTER_CRITICAL(&glass_mux);
+    flush_bytes += bytes;
+    if (last) {
+        frames++;
+        if (write_pending) {
+            add_sample(&glass_stage, now_us - pending_write_us);
+            write_pending = false;
+        }
+    }
+    portEXIT_CRITICAL(&glass_mux);
+}
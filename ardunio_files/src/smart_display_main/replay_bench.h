@@ -0,0 +1,106 @@
+#ifndef REPLAY_BENCH_H
+#define REPLAY_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Message pipeline benchmark
+// Feeds BLE writes through the firmware's own write path (frame check,
+// reassembly, JSON decode, state and UI updates) while the real display
+// renders them, and prints one comparable result per run.
+//
+// Sources: a built-in scenario (city, highway, roundabout, calls) run on the
+// bench task, or a flight recorder replay (measured the same way). Writes
+// follow the scenario's timing at 1x, N times faster, or back to back
+// (speed 0). Live writes are ignored while a run is going, and the live
+// connection's sequence and ack state is put back when it ends.
+//
+// Stages (percentiles over the last REPLAY_BENCH_SAMPLES messages):
+//   frame  - header parse, sequence check, reassembly
+//   decode - JSON decode, state and UI calls
+//   glass  - write received to the end of the next flushed frame
+// Result line, one per run:
+//   [BENCH] RESULT source=city speed=10 writes=.. msgs=.. ms=.. msg_per_s=..
+//           frame_p50_us=.. .. glass_p99_us=.. frames=.. pixels=..
+// ============================================================================
+
+#define REPLAY_BENCH_SAMPLES    256   // Latest messages kept per stage
+#define REPLAY_BENCH_SETTLE_MS  250   // Wait for the last write to reach the glass
+
+/**
+ * Built-in scenarios
+ */
+enum ReplayBenchScenario {
+    REPLAY_BENCH_CITY = 0,          // Turn every ~15 s, 1 Hz updates
+    REPLAY_BENCH_HIGHWAY,           // Long straights, occasional exits
+    REPLAY_BENCH_ROUNDABOUT,        // Bursts of 8 updates 40 ms apart
+    REPLAY_BENCH_CALLS,             // Call state changes interleaved with 10 Hz nav
+    REPLAY_BENCH_SCENARIO_COUNT
+};
+
+/**
+ * Write target: handles one write as if received on a stream characteristic
+ */
+typedef void (*replay_bench_sink_t)(uint8_t stream, const uint8_t *data, size_t len);
+
+/**
+ * Start the (idle) bench task
+ * Call once during boot.
+ */
+void replay_bench_init(replay_bench_sink_t sink);
+
+/**
+ * Run a scenario on the bench task (safe from any task)
+ * @param name Scenario name ("city", "highway", "roundabout", "calls")
+ * @param speed 1 = real time, N = N times faster, 0 = as fast as possible
+ * @return false for an unknown name or while a run is going
+ */
+bool replay_bench_request(const char *name, uint8_t speed);
+
+/**
+ * Stop a running scenario (its result is still printed)
+ */
+void replay_bench_stop(void);
+
+/**
+ * Check if a scenario is running (live writes are ignored)
+ */
+bool replay_bench_running(void);
+
+/**
+ * Start measuring a run (scenarios do this themselves; flight recorder replays call it)
+ * @param source Name printed with the result (string literal)
+ */
+void replay_bench_begin(const char *source, uint8_t speed);
+
+/**
+ * Check if a run is being measured
+ */
+bool replay_bench_measuring(void);
+
+/**
+ * Let the last write reach the glass, stop measuring and print the result
+ * Blocks for REPLAY_BENCH_SETTLE_MS; call from the task that fed the writes.
+ */
+void replay_bench_end(void);
+
+/**
+ * Record one handled write (the feeding task)
+ * @param us Whole write path, decode included
+ */
+void replay_bench_record_write(uint32_t us);
+
+/**
+ * Record one decoded message (there are several per batch write)
+ */
+void replay_bench_record_decode(uint32_t us);
+
+/**
+ * Record one flushed area (display flush callback)
+ * @param bytes Pixel bytes sent to the panel
+ * @param last True for the last area of a frame
+ */
+void replay_bench_record_flush(uint32_t bytes, bool last);
+
+#endif // REPLAY_BENCH_H
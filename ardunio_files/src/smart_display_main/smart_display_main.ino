@@ -18,9 +18,27 @@
 #include "ui_incoming_call_screen.h"
 #include "ui_outgoing_call_screen.h"
 #include "ui_missed_call_screen.h"
+#include "ui_anim.h"
+#include "ui_transition.h"
+#include "alloc_guard.h"
+#include "ui_format.h"
+#include "nav_estimator.h"
+#include "frame_dedup.h"
+#include "ble_frame.h"
+#include "telemetry.h"
+#include "perf_hud.h"
+#include "render_profiler.h"
+#include "flight_recorder.h"
+#include "replay_bench.h"
+#include "sys_clock.h"
+#include "render_bench.h"
+#include "caller_directory.h"
+#include "phrase_dict.h"
+#include "nav_lookahead.h"
+#include "esp_gap_ble_api.h"
 
 // Touch variables
-bool touchEnabled = true;
+bool touchEnabled = false;  // Set once the boot sequencer has initialized touch
 int touchX = 0;
 int touchY = 0;
 unsigned long lastTouchTime = 0;
@@ -35,8 +53,27 @@ unsigned long lastTouchTime = 0;
 
 // ==== BLE Configuration ====
 #define SERVICE_UUID "12345678-1234-1234-1234-1234567890ab"
-#define CHARACTERISTIC_UUID "abcd1234-5678-90ab-cdef-1234567890ab"
-BLECharacteristic *pCharacteristic;
+#define CHARACTERISTIC_UUID "abcd1234-5678-90ab-cdef-1234567890ab"  // Legacy/batch writes, frame acks
+// One write-without-response characteristic per stream: routed by handle, no type parsing
+#define NAV_CHARACTERISTIC_UUID "abcd1235-5678-90ab-cdef-1234567890ab"
+#define CALL_CHARACTERISTIC_UUID "abcd1236-5678-90ab-cdef-1234567890ab"
+#define NOTIFY_CHARACTERISTIC_UUID "abcd1237-5678-90ab-cdef-1234567890ab"
+#define TELEMETRY_CHARACTERISTIC_UUID "abcd1238-5678-90ab-cdef-1234567890ab"  // Records (notify), period (write)
+#define FLIGHTREC_CHARACTERISTIC_UUID "abcd1239-5678-90ab-cdef-1234567890ab"  // Recorder commands (write), dump (notify)
+#define CAPS_CHARACTERISTIC_UUID "abcd123a-5678-90ab-cdef-1234567890ab"  // Capabilities (read): [phrase dictionary version]
+#define BLE_SERVICE_HANDLES 30  // Bluedroid's default (15) doesn't fit seven characteristics
+#define BLE_RX_MAX 512  // Largest attribute value a write can carry
+#define BLE_DEFAULT_MTU 23
+#define BLE_PREFERRED_MTU 247  // Fits a typical nav frame in one write (Data Length Extension size)
+#define FLIGHTREC_DUMP_INTERVAL_MS 15  // One dump notification per interval (keeps the link queue short)
+uint16_t negotiatedMtu = BLE_DEFAULT_MTU;
+BLECharacteristic *pCharacteristic = nullptr;
+BLECharacteristic *pTelemetryCharacteristic = nullptr;
+BLECharacteristic *pFlightRecorderCharacteristic = nullptr;
+esp_bd_addr_t peerAddress;        // Connected phone (for RSSI reads)
+bool peerAddressValid = false;
+uint32_t notificationsReceived = 0;
+BLEServer *pServer = nullptr;
 bool deviceConnected = false;
 
 // ==== Display Configuration ====
@@ -76,10 +113,27 @@ Arduino_GFX *gfx = new Arduino_ST7789(bus, 22 /* RST */, 0, false, 172, 320, 34,
 #define DEBUG_CALLS true
 #define DEBUG_NAVIGATION true
 
+// Performance reporting
+#define PERF_REPORT_INTERVAL 10000  // Print UI performance stats every 10 seconds
+#define RUN_SCREEN_BENCHMARK false  // Measure cold screen construction at boot
+#define RUN_FORMAT_BENCHMARK false  // Compare ui_format with snprintf at boot
+#define RUN_RENDER_BENCHMARK false  // Render every screen scenario at boot (see render_bench.h)
+#define ENABLE_DEBUG_COMMANDS false  // Accept {"type":"debug"} over BLE (HUD, profiler, benches, clock)
+#define ZERO_ALLOC_STEADY_STATE false  // Prebuild and pin the call screens too (no lazy build or eviction)
+
 // ==== Global State ====
-String currentETA = "";
-String currentManeuver = "";
-String currentDirection = "";
+// Fixed-size text buffers (no heap use once booted); sizes match the LVGL screens
+#define NAV_DIRECTION_LEN 32
+#define NAV_MANEUVER_LEN 64
+#define NAV_ETA_LEN 32
+#define CALL_NAME_LEN 48
+#define CALL_NUMBER_LEN 32
+#define CALL_STATE_LEN 12
+
+char currentETA[NAV_ETA_LEN] = "";
+unsigned long currentArrivalMs = 0;  // sys_clock_ms() at arrival when the phone sent eta_s (0 = text only)
+char currentManeuver[NAV_MANEUVER_LEN] = "";
+char currentDirection[NAV_DIRECTION_LEN] = "";
 int currentDistance = 0;
 int scrollOffset = 0;
 unsigned long lastScrollTime = 0;
@@ -89,39 +143,54 @@ unsigned long lastNavUpdate = 0; // Track last time we received nav data
 bool isPhoneCallActive = false;
 bool isMissedCallShowing = false;
 int missedCallCount = 0;
-String currentCallerName = "";
-String currentCallerNumber = "";
+char currentCallerName[CALL_NAME_LEN] = "";
+char currentCallerNumber[CALL_NUMBER_LEN] = "";
 unsigned long callStartTime = 0;
 unsigned long missedCallTime = 0;
-String currentCallState = "";
+char currentCallState[CALL_STATE_LEN] = "";
 unsigned long phoneCallDisplayStartTime = 0;  // Track when call display started
 #define MIN_PHONE_CALL_DISPLAY_TIME 5000  // Minimum 5 seconds for phone call display
 
 // Navigation state before phone call
 bool wasNavigationActive = false;
-String savedDirection = "";
+char savedDirection[NAV_DIRECTION_LEN] = "";
 int savedDistance = 0;
-String savedManeuver = "";
-String savedETA = "";
+char savedManeuver[NAV_MANEUVER_LEN] = "";
+char savedETA[NAV_ETA_LEN] = "";
+unsigned long savedArrivalMs = 0;
 
 // Persistent missed call tracking
 struct MissedCallInfo {
-    String callerName;
-    String callerNumber;
+    char callerName[CALL_NAME_LEN];
+    char callerNumber[CALL_NUMBER_LEN];
+    uint32_t numberHash;  // caller_directory_hash_number(), also known for contact-ID frames
     int count;
     unsigned long firstMissedTime;
     bool acknowledged;  // User tapped to dismiss
 };
-MissedCallInfo persistentMissedCall = {"", "", 0, 0, false};
+MissedCallInfo persistentMissedCall = {"", "", 0, 0, 0, false};
+
+// Copy helper for the fixed-size state buffers
+#define COPY_TEXT(dst, src) strlcpy((dst), (src) ? (src) : "", sizeof(dst))
 unsigned long lastMissedCallReminderTime = 0;
 #define MISSED_CALL_REMINDER_INTERVAL 60000  // Show reminder every 60 seconds
 #define INITIAL_MISSED_CALL_DISPLAY_TIME 10000  // Show missed call for 10 seconds initially
 #define REMINDER_DISPLAY_TIME 5000  // Show reminder for 5 seconds
 
 // ==== LCD Register Init ====
+#define LCD_SLEEP_OUT_DELAY 120  // Panel needs 120ms after sleep-out before register writes
+
+// Sleep-out only - the caller does useful work during the 120ms wait
+void lcd_sleep_out(void) {
+    static const uint8_t sleep_out_operations[] = {
+        BEGIN_WRITE, WRITE_COMMAND_8, 0x11, END_WRITE
+    };
+    bus->batchOperation(sleep_out_operations, sizeof(sleep_out_operations));
+}
+
+// Remaining register init (call LCD_SLEEP_OUT_DELAY ms after lcd_sleep_out)
 void lcd_reg_init(void) {
     static const uint8_t init_operations[] = {
-        BEGIN_WRITE, WRITE_COMMAND_8, 0x11, END_WRITE, DELAY, 120,
         BEGIN_WRITE, WRITE_C8_D16, 0xDF, 0x98, 0x53, WRITE_C8_D8, 0xB2, 0x23, WRITE_COMMAND_8, 0xB7,
         WRITE_BYTES, 4, 0x00, 0x47, 0x00, 0x6F, WRITE_COMMAND_8, 0xBB, WRITE_BYTES, 6, 0x1C, 0x1A, 0x55, 0x73, 0x63, 0xF0,
         WRITE_C8_D16, 0xC0, 0x44, 0xA4, WRITE_C8_D8, 0xC1, 0x16, WRITE_COMMAND_8, 0xC3,
@@ -299,19 +368,19 @@ void drawUTurn(int x, int y) {
 }
 
 // ROUNDABOUT - Yellow circle (Enhanced)
-void drawRoundabout(int x, int y, String dir) {
+void drawRoundabout(int x, int y, const char *dir) {
     // Draw white outline first
     gfx->drawCircle(x, y, 35, COLOR_WHITE); // White outline
     
     // Draw colored roundabout on top
     gfx->drawCircle(x, y, 33, COLOR_YELLOW); // Yellow circle
     
-    if (dir == "roundabout_left") {
+    if (strcmp(dir, "roundabout_left") == 0) {
         // Exit left with outline
         gfx->drawLine(x-35, y, x-49, y-28, COLOR_WHITE); // White outline
         gfx->drawLine(x-33, y, x-47, y-26, COLOR_YELLOW); // Yellow line
         gfx->fillTriangle(x-70, y-35, x-47, y-21, x-47, y-35, COLOR_YELLOW);
-    } else if (dir == "roundabout_right") {
+    } else if (strcmp(dir, "roundabout_right") == 0) {
         // Exit right with outline
         gfx->drawLine(x+35, y, x+49, y-28, COLOR_WHITE); // White outline
         gfx->drawLine(x+33, y, x+47, y-26, COLOR_YELLOW); // Yellow line
@@ -349,43 +418,43 @@ void drawKeepRight(int x, int y) {
 }
 
 // MAIN ARROW FUNCTION
-void drawArrow(String dir) {
+void drawArrow(const char *dir) {
     // DISABLED - LVGL handles all navigation drawing now
     // Using Arduino_GFX causes overlap with LVGL screens
     return;
     if (DEBUG_NAVIGATION) {
-        Serial.printf("[NAV] Drawing arrow: %s at zone (Y:%d, H:%d)\n", dir.c_str(), ZONE_ARROW_Y, ZONE_ARROW_H);
+        Serial.printf("[NAV] Drawing arrow: %s at zone (Y:%d, H:%d)\n", dir, ZONE_ARROW_Y, ZONE_ARROW_H);
     }
     
     gfx->fillRect(0, ZONE_ARROW_Y, SCREEN_WIDTH, ZONE_ARROW_H, COLOR_BLACK); // Black background
     int midX = SCREEN_WIDTH / 2;
     int midY = ZONE_ARROW_Y + ZONE_ARROW_H / 2; // Center of expanded arrow area
     
-    if (dir == "left" || dir == "sharp_left" || dir == "slight_left") {
-        if (dir == "sharp_left") drawSharpLeftArrow(midX, midY);
-        else if (dir == "slight_left") drawSlightLeftArrow(midX, midY);
+    if (!strcmp(dir, "left") || !strcmp(dir, "sharp_left") || !strcmp(dir, "slight_left")) {
+        if (!strcmp(dir, "sharp_left")) drawSharpLeftArrow(midX, midY);
+        else if (!strcmp(dir, "slight_left")) drawSlightLeftArrow(midX, midY);
         else drawLeftArrow(midX, midY);
-    } else if (dir == "right" || dir == "sharp_right" || dir == "slight_right") {
-        if (dir == "sharp_right") drawSharpRightArrow(midX, midY);
-        else if (dir == "slight_right") drawSlightRightArrow(midX, midY);
+    } else if (!strcmp(dir, "right") || !strcmp(dir, "sharp_right") || !strcmp(dir, "slight_right")) {
+        if (!strcmp(dir, "sharp_right")) drawSharpRightArrow(midX, midY);
+        else if (!strcmp(dir, "slight_right")) drawSlightRightArrow(midX, midY);
         else drawRightArrow(midX, midY);
-    } else if (dir == "straight" || dir == "forward") {
+    } else if (!strcmp(dir, "straight") || !strcmp(dir, "forward")) {
         drawStraightArrow(midX, midY);
-    } else if (dir == "uturn" || dir == "u_turn" || dir == "turn_around") {
+    } else if (!strcmp(dir, "uturn") || !strcmp(dir, "u_turn") || !strcmp(dir, "turn_around")) {
         drawUTurn(midX, midY);
-    } else if (dir == "destination" || dir == "arrived" || dir == "end") {
+    } else if (!strcmp(dir, "destination") || !strcmp(dir, "arrived") || !strcmp(dir, "end")) {
         drawDestination(midX, midY);
-    } else if (dir.indexOf("roundabout") >= 0) {
+    } else if (strstr(dir, "roundabout") != nullptr) {
         drawRoundabout(midX, midY, dir);
-    } else if (dir == "keep_left") {
+    } else if (!strcmp(dir, "keep_left")) {
         drawKeepLeft(midX, midY);
-    } else if (dir == "keep_right") {
+    } else if (!strcmp(dir, "keep_right")) {
         drawKeepRight(midX, midY);
     }
 }
 
 // STATUS BAR (Enhanced with icons)
-void displayStatus(String text, uint16_t color) {
+void displayStatus(const char *text, uint16_t color) {
     // DISABLED - LVGL handles all status display now
     return;
     gfx->fillRect(0, ZONE_STATUS_Y, SCREEN_WIDTH, ZONE_STATUS_H, COLOR_BLACK);
@@ -461,7 +530,7 @@ void displayDistance(int dist) {
 }
 
 // ETA DISPLAY (ETA-focused approach)
-void displayETA(String eta) {
+void displayETA(const char *eta) {
     // DISABLED - LVGL handles all ETA display now
     return;
     gfx->fillRect(0, ZONE_SPEED_Y, SCREEN_WIDTH, ZONE_SPEED_H, COLOR_BLACK);
@@ -479,19 +548,97 @@ void displayETA(String eta) {
     gfx->print("ETA");
 }
 
+// Show the ETA on the LVGL navigation screen: counted down locally when the
+// phone sent a structured ETA, otherwise the phone's text as-is
+void showNavigationETA(const char *eta, unsigned long arrival_ms) {
+    if (arrival_ms != 0) {
+        ui_navigation_screen_set_arrival(arrival_ms);
+    } else {
+        ui_navigation_screen_update_eta(eta);
+    }
+}
+
+// True if the current navigation state has anything worth showing
+bool hasNavigationData() {
+    const bool dirValid = (currentDirection[0] != '\0' && strcmp(currentDirection, "straight") != 0 && strcmp(currentDirection, "forward") != 0);
+    const bool distValid = (currentDistance > 0);
+    const bool manValid = (currentManeuver[0] != '\0');
+    const bool etaValid = (currentETA[0] != '\0' || currentArrivalMs != 0);
+    return (dirValid || distValid || manValid || etaValid);
+}
+
+// Batched frame acknowledgements (NOTIFY on the data characteristic)
+void sendFrameAcks() {
+    if (!deviceConnected || pCharacteristic == nullptr) return;
+    if (flight_recorder_replaying() || replay_bench_running()) return;  // Replayed frames are not the phone's to retire
+    if (!ble_frame_ack_due(millis())) return;
+    
+    uint8_t ack[BLE_FRAME_ACK_MAX_LEN];
+    size_t len = ble_frame_build_ack(ack, sizeof(ack));
+    if (len == 0) return;
+    pCharacteristic->setValue(ack, len);
+    pCharacteristic->notify();
+}
+
+// Periodic telemetry record (NOTIFY on the telemetry characteristic, only while subscribed)
+void sendTelemetry() {
+    if (!deviceConnected || pTelemetryCharacteristic == nullptr) return;
+    uint32_t now = millis();
+    if (!telemetry_due(now)) return;
+    
+    // The reading arrives in the GAP handler and goes into the next record
+    if (peerAddressValid) esp_ble_gap_read_rssi(peerAddress);
+    
+    UIScreen screen = ui_get_current_screen();
+    uint8_t flags = 0;
+    if (screen == UI_SCREEN_NAVIGATION) flags |= TELEMETRY_FLAG_NAV_SCREEN;
+    if (screen == UI_SCREEN_INCOMING_CALL || screen == UI_SCREEN_OUTGOING_CALL || screen == UI_SCREEN_MISSED_CALL) {
+        flags |= TELEMETRY_FLAG_CALL;
+    }
+    
+    telemetry_record_t record;
+    if (!telemetry_build(&record, flags, now)) return;
+    pTelemetryCharacteristic->setValue((uint8_t *)&record, TELEMETRY_RECORD_LEN);
+    pTelemetryCharacteristic->notify();
+}
+
+// Flight recorder dump (NOTIFY on the recorder characteristic, paced by FLIGHTREC_DUMP_INTERVAL_MS)
+void sendFlightRecorderDump() {
+    static uint32_t lastChunkMs = 0;
+    if (!deviceConnected || pFlightRecorderCharacteristic == nullptr) return;
+    if (!flight_recorder_dumping()) return;
+    uint32_t now = millis();
+    if (now - lastChunkMs < FLIGHTREC_DUMP_INTERVAL_MS) return;
+    
+    uint8_t chunk[BLE_PREFERRED_MTU - 3];
+    size_t size = negotiatedMtu - 3;
+    if (size > sizeof(chunk)) size = sizeof(chunk);
+    size_t len = flight_recorder_dump_next(chunk, size);
+    if (len == 0) return;
+    pFlightRecorderCharacteristic->setValue(chunk, len);
+    pFlightRecorderCharacteristic->notify();
+    lastChunkMs = now;
+}
+
+void telemetryGapHandler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
+    if (event == ESP_GAP_BLE_READ_RSSI_COMPLETE_EVT && param->read_rssi_cmpl.status == ESP_BT_STATUS_SUCCESS) {
+        telemetry_set_rssi(param->read_rssi_cmpl.rssi);
+    }
+}
+
 // MANEUVER
-void displayManeuver(String text, bool immediateRender = false) {
+void displayManeuver(const char *text, bool immediateRender = false) {
     // DISABLED - LVGL handles all maneuver display now
     // Keep currentManeuver update for state tracking
-    currentManeuver = text;
+    COPY_TEXT(currentManeuver, text);
     return;
     gfx->fillRect(0, ZONE_MANEUVER_Y, SCREEN_WIDTH, ZONE_MANEUVER_H, COLOR_BLACK);
     
     // Reset scroll offset when text changes or when called with immediateRender
-    static String lastText = "";
-    if (lastText != text || immediateRender) {
+    static char lastText[NAV_MANEUVER_LEN] = "";
+    if (strcmp(lastText, text) != 0 || immediateRender) {
         scrollOffset = 0;
-        lastText = text;
+        COPY_TEXT(lastText, text);
     }
     
     // Only update scrolling if not immediately rendering
@@ -499,7 +646,7 @@ void displayManeuver(String text, bool immediateRender = false) {
         unsigned long currentTime = millis();
         if (currentTime - lastScrollTime > 100) { // Scroll every 100ms
             scrollOffset++;
-            if (scrollOffset > text.length() * 6) { // Approximate character width
+            if (scrollOffset > (int)strlen(text) * 6) { // Approximate character width
                 scrollOffset = -SCREEN_WIDTH;
             }
             lastScrollTime = currentTime;
@@ -514,7 +661,7 @@ void displayManeuver(String text, bool immediateRender = false) {
 }
 
 // PHONE CALL DISPLAY FUNCTIONS
-void displayIncomingCall(String name, String number) {
+void displayIncomingCall(const char *name, const char *number) {
     // DISABLED - LVGL handles all incoming call screens now
     // This function is kept for compatibility but does nothing to prevent overlap
     Serial.println("[CALL] displayIncomingCall() disabled - LVGL handles this");
@@ -522,22 +669,23 @@ void displayIncomingCall(String name, String number) {
     // Save navigation state before showing call
     if (!isPhoneCallActive && !isMissedCallShowing) {
         wasNavigationActive = true;
-        savedDirection = currentDirection;
+        COPY_TEXT(savedDirection, currentDirection);
         savedDistance = currentDistance;
-        savedManeuver = currentManeuver;
-        savedETA = currentETA;
+        COPY_TEXT(savedManeuver, currentManeuver);
+        COPY_TEXT(savedETA, currentETA);
+        savedArrivalMs = currentArrivalMs;
         
         if (DEBUG_CALLS) {
             Serial.printf("[CALL] Saving navigation state: dir=%s, dist=%d\n", 
-                          savedDirection.c_str(), savedDistance);
+                          savedDirection, savedDistance);
         }
     }
     
     isPhoneCallActive = true;
-    currentCallerName = name;
-    currentCallerNumber = number;
-    currentCallState = "INCOMING";
-    callStartTime = millis();
+    COPY_TEXT(currentCallerName, name);
+    COPY_TEXT(currentCallerNumber, number);
+    COPY_TEXT(currentCallState, "INCOMING");
+    callStartTime = sys_clock_ms();
     
     // Clear screen completely
     gfx->fillScreen(COLOR_BLACK);
@@ -558,7 +706,7 @@ void displayIncomingCall(String name, String number) {
     gfx->print(name);
     
     // Phone number (medium) - only show if not "Unknown"
-    if (number != "Unknown" && number.length() > 0) {
+    if (strcmp(number, "Unknown") != 0 && number[0] != '\0') {
         gfx->setCursor(10, 100);
         gfx->setTextColor(COLOR_WHITE);
         gfx->setTextSize(1);
@@ -578,14 +726,14 @@ void displayIncomingCall(String name, String number) {
     Serial.println("[CALL] Incoming call screen drawn");
 }
 
-void displayOngoingCall(String name, int duration) {
+void displayOngoingCall(const char *name, int duration) {
     // Arduino_GFX version is DISABLED - LVGL handles all call screens
     // This function is kept for compatibility but does nothing
     Serial.println("[CALL] displayOngoingCall() disabled - LVGL handles this");
     return;
 }
 
-void displayMissedCall(String name, String number, int count) {
+void displayMissedCall(const char *name, const char *number, int count) {
     // Check if we should use LVGL screen instead of Arduino_GFX
     UIScreen currentScreen = ui_get_current_screen();
     
@@ -595,14 +743,15 @@ void displayMissedCall(String name, String number, int count) {
         Serial.println("[CALL] Using LVGL missed call screen");
         ui_navigation_hide_all_objects(); // Hide navigation objects
         ui_show_screen(UI_SCREEN_MISSED_CALL, 0);  // No animation
-        ui_missed_call_screen_update(name.c_str(), number.c_str(), count, "Just now");
+        ui_missed_call_screen_update(name, number, count, "Just now");
+        ui_missed_call_screen_show();  // Slide card into view
         
         // Update state
         isPhoneCallActive = false;
         isMissedCallShowing = true;
-        currentCallerName = name;
-        currentCallerNumber = number;
-        currentCallState = "MISSED";
+        if (name != currentCallerName) COPY_TEXT(currentCallerName, name);
+        if (number != currentCallerNumber) COPY_TEXT(currentCallerNumber, number);
+        COPY_TEXT(currentCallState, "MISSED");
         return;  // Skip Arduino_GFX drawing
     }
     
@@ -612,23 +761,24 @@ void displayMissedCall(String name, String number, int count) {
     // Save navigation state before showing missed call (if not already saved)
     if (!isPhoneCallActive && !isMissedCallShowing && !wasNavigationActive) {
         wasNavigationActive = true;
-        savedDirection = currentDirection;
+        COPY_TEXT(savedDirection, currentDirection);
         savedDistance = currentDistance;
-        savedManeuver = currentManeuver;
-        savedETA = currentETA;
+        COPY_TEXT(savedManeuver, currentManeuver);
+        COPY_TEXT(savedETA, currentETA);
+        savedArrivalMs = currentArrivalMs;
         
         if (DEBUG_CALLS) {
             Serial.printf("[CALL] Saving navigation state for missed call: dir=%s, dist=%d\n", 
-                          savedDirection.c_str(), savedDistance);
+                          savedDirection, savedDistance);
         }
     }
     
     isMissedCallShowing = true;
     missedCallCount = count;
-    currentCallerName = name;
-    currentCallerNumber = number;
-    currentCallState = "MISSED";
-    missedCallTime = millis();
+    if (name != currentCallerName) COPY_TEXT(currentCallerName, name);
+    if (number != currentCallerNumber) COPY_TEXT(currentCallerNumber, number);
+    COPY_TEXT(currentCallState, "MISSED");
+    missedCallTime = sys_clock_ms();
     
     // Clear screen completely
     gfx->fillScreen(COLOR_BLACK);
@@ -651,7 +801,7 @@ void displayMissedCall(String name, String number, int count) {
     gfx->print(name);
     
     // Phone number - only show if not "Unknown"
-    if (number != "Unknown" && number.length() > 0) {
+    if (strcmp(number, "Unknown") != 0 && number[0] != '\0') {
         gfx->setCursor(10, 100);
         gfx->setTextColor(COLOR_GRAY);
         gfx->setTextSize(1);
@@ -678,9 +828,9 @@ void displayMissedCall(String name, String number, int count) {
 void clearPhoneDisplay() {
     isPhoneCallActive = false;
     isMissedCallShowing = false;
-    currentCallerName = "";
-    currentCallerNumber = "";
-    currentCallState = "";
+    currentCallerName[0] = '\0';
+    currentCallerNumber[0] = '\0';
+    currentCallState[0] = '\0';
     
     Serial.println("[CALL] Phone call dismissed - checking navigation state");
     
@@ -689,47 +839,50 @@ void clearPhoneDisplay() {
     
     // Check if we have active navigation data (either saved or current)
     bool hasNavigation = false;
-    String nav_direction = "";
+    const char *nav_direction = "";
     int nav_distance = 0;
-    String nav_maneuver = "";
-    String nav_eta = "";
+    const char *nav_maneuver = "";
+    const char *nav_eta = "";
+    unsigned long nav_arrival = 0;
     
     // First check saved navigation state
-    if (wasNavigationActive && savedDirection.length() > 0) {
+    if (wasNavigationActive && savedDirection[0] != '\0') {
         hasNavigation = true;
         nav_direction = savedDirection;
         nav_distance = savedDistance;
         nav_maneuver = savedManeuver;
         nav_eta = savedETA;
+        nav_arrival = savedArrivalMs;
         Serial.println("[CALL] Using saved navigation state");
     } 
     // Else check current navigation data
-    else if (currentDirection.length() > 0 || currentDistance > 0 || currentManeuver.length() > 0 || currentETA.length() > 0) {
+    else if (currentDirection[0] != '\0' || currentDistance > 0 || currentManeuver[0] != '\0' || currentETA[0] != '\0') {
         hasNavigation = true;
         nav_direction = currentDirection;
         nav_distance = currentDistance;
         nav_maneuver = currentManeuver;
         nav_eta = currentETA;
+        nav_arrival = currentArrivalMs;
         Serial.println("[CALL] Using current navigation data");
     }
     
     if (hasNavigation) {
         // Go back to NAVIGATION screen
         Serial.println("[CALL] Returning to navigation screen");
-        ui_show_screen(UI_SCREEN_NAVIGATION, 0);  // No animation
+        ui_transition_fade(ui_get_current_screen(), UI_SCREEN_NAVIGATION, ANIM_TIME_SCREEN);
         
         // Update navigation screen with data
-        if (nav_direction.length() > 0) {
-            ui_navigation_screen_update_direction(nav_direction.c_str(), false);
+        if (nav_direction[0] != '\0') {
+            ui_navigation_screen_update_direction(nav_direction, false);
         }
         if (nav_distance > 0) {
             ui_navigation_screen_update_distance(nav_distance, false);
         }
-        if (nav_maneuver.length() > 0) {
-            ui_navigation_screen_update_maneuver(nav_maneuver.c_str());
+        if (nav_maneuver[0] != '\0') {
+            ui_navigation_screen_update_maneuver(nav_maneuver);
         }
-        if (nav_eta.length() > 0) {
-            ui_navigation_screen_update_eta(nav_eta.c_str());
+        if (nav_eta[0] != '\0' || nav_arrival != 0) {
+            showNavigationETA(nav_eta, nav_arrival);
         }
         ui_navigation_screen_show_critical_alert(nav_distance > 0 && nav_distance < 100);
         
@@ -737,7 +890,7 @@ void clearPhoneDisplay() {
     } else {
         // No navigation - go to IDLE screen
         Serial.println("[CALL] No navigation active - returning to idle screen");
-        ui_show_screen(UI_SCREEN_IDLE, 0);  // No animation
+        ui_transition_fade(ui_get_current_screen(), UI_SCREEN_IDLE, ANIM_TIME_SCREEN);
         ui_idle_screen_update_ble_status(deviceConnected);
         if (deviceConnected) {
             ui_idle_screen_start_pulse();
@@ -745,6 +898,17 @@ void clearPhoneDisplay() {
     }
 }
 
+// Put back the screen the current state calls for (the render benchmark took over the display)
+void restoreScreenAfterBenchmark() {
+    if (isPhoneCallActive || isMissedCallShowing) return;  // A call arrived meanwhile; its screen stands
+    if (!deviceConnected) {
+        ui_show_screen(UI_SCREEN_WELCOME, 0);
+        ui_welcome_screen_update_ble_status(false);
+        return;
+    }
+    clearPhoneDisplay();  // Navigation if there is any, otherwise idle
+}
+
 void drawRingingAnimation() {
     // DISABLED - LVGL handles call animations now
     return;
@@ -812,21 +976,22 @@ void drawMissedCallAnimation() {
 void handlePhoneCallTouch(int x, int y) {
     if (DEBUG_TOUCH) {
         Serial.printf("[TOUCH] State: active=%d, missed=%d, state='%s'\n", 
-                      isPhoneCallActive, isMissedCallShowing, currentCallState.c_str());
+                      isPhoneCallActive, isMissedCallShowing, currentCallState);
     }
     
     if (isPhoneCallActive || isMissedCallShowing) {
         if (DEBUG_TOUCH) Serial.printf("[TOUCH] Phone call tapped at (%d,%d)\n", x, y);
         
-        if (currentCallState == "INCOMING") {
+        if (strcmp(currentCallState, "INCOMING") == 0) {
             Serial.println("[CALL] Rejected by user");
             displayMissedCall(currentCallerName, currentCallerNumber, 1);
-        } else if (currentCallState == "MISSED" || isMissedCallShowing) {
+        } else if (strcmp(currentCallState, "MISSED") == 0 || isMissedCallShowing) {
             // User acknowledged missed call - mark as acknowledged and clear
             Serial.println("[CALL] Missed call acknowledged by user");
             persistentMissedCall.acknowledged = true;
-            persistentMissedCall.callerName = "";
-            persistentMissedCall.callerNumber = "";
+            persistentMissedCall.callerName[0] = '\0';
+            persistentMissedCall.callerNumber[0] = '\0';
+            persistentMissedCall.numberHash = 0;
             persistentMissedCall.count = 0;
             persistentMissedCall.firstMissedTime = 0;
             clearPhoneDisplay();
@@ -841,6 +1006,9 @@ void handlePhoneCallTouch(int x, int y) {
 class MyServerCallbacks : public BLEServerCallbacks {
     void onConnect(BLEServer *pServer) {
         deviceConnected = true;
+        ble_frame_reset_live();  // The phone starts new sequence numbers per connection
+        flight_recorder_mark_connect();
+        negotiatedMtu = BLE_DEFAULT_MTU;
         Serial.println("[BLE] Device connected - callback triggered");
         
         // Update welcome screen status (if on welcome screen)
@@ -858,17 +1026,29 @@ class MyServerCallbacks : public BLEServerCallbacks {
         Serial.println("[BLE] Connection callback complete - loop() will handle transition");
     }
     
+    void onConnect(BLEServer *pServer, esp_ble_gatts_cb_param_t *param) {
+        memcpy(peerAddress, param->connect.remote_bda, sizeof(peerAddress));
+        peerAddressValid = true;
+    }
+    
+    void onMtuChanged(BLEServer *pServer, esp_ble_gatts_cb_param_t *param) {
+        negotiatedMtu = param->mtu.mtu;
+        Serial.printf("[BLE] MTU negotiated: %u (%u payload bytes per write after the frame header)\n",
+                      negotiatedMtu, negotiatedMtu - 3 - BLE_FRAME_HEADER_LEN);
+    }
+    
     void onDisconnect(BLEServer *pServer) {
         deviceConnected = false;
+        frame_dedup_reset();  // Re-apply everything the next connection sends
+        ble_frame_reset_live();
+        caller_directory_clear();  // The next connection pushes its contacts again
+        telemetry_set_enabled(false);  // The next connection subscribes again
+        flight_recorder_stop_dump();
+        peerAddressValid = false;
         Serial.println("[BLE] Device disconnected - restarting advertising");
         
         // Restart advertising after disconnect
-        // Use non-blocking delay - process LVGL while waiting
-        unsigned long disconnect_start = millis();
-        while (millis() - disconnect_start < 500 && deviceConnected) {
-            lv_timer_handler();
-            delay(10);  // Small delay to avoid CPU spinning
-        }
+        // (never run lv_timer_handler() here - this is the BLE task)
         BLEDevice::startAdvertising();
         Serial.println("[BLE] Restarted advertising - waiting for new connection");
         
@@ -887,64 +1067,312 @@ class MyServerCallbacks : public BLEServerCallbacks {
         // Call screens don't need BLE status updates
 
         // Always return to welcome screen on disconnect to reinitiate connection
-        ui_show_screen(UI_SCREEN_WELCOME, 0);
+        ui_transition_fade(currentScreen, UI_SCREEN_WELCOME, ANIM_TIME_SCREEN);
         ui_welcome_screen_update_ble_status(false);
     }
 };
 
+// Telemetry period: the phone writes it as 2 bytes (ms, little-endian)
+class TelemetryCallbacks : public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic *pChar) {
+        if (pChar->getLength() < 2) return;
+        const uint8_t *data = pChar->getData();
+        telemetry_set_period((uint16_t)(data[0] | (data[1] << 8)));
+    }
+};
+
+// Telemetry runs only while the phone has notifications enabled
+class TelemetryCccdCallbacks : public BLEDescriptorCallbacks {
+    void onWrite(BLEDescriptor *pDescriptor) {
+        telemetry_set_enabled(((BLE2902 *)pDescriptor)->getNotifications());
+    }
+};
+
+// Flight recorder commands (see flight_recorder.h)
+class FlightRecorderCallbacks : public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic *pChar) {
+        const uint8_t *data = pChar->getData();
+        size_t len = pChar->getLength();
+        if (len > 0 && data[0] == 'S') {
+            replay_bench_stop();  // Live debug commands are ignored while a scenario runs
+        }
+        if (len > 0 && data[0] == 'P' && replay_bench_running()) {
+            Serial.println("[FLIGHTREC] Replay rejected - a bench scenario is running");
+            return;
+        }
+        if (!flight_recorder_command(data, len)) {
+            Serial.println("[FLIGHTREC] Command rejected (unknown, or a dump/replay is running)");
+        }
+    }
+};
+
 class MyCallbacks : public BLECharacteristicCallbacks {
+public:
+    // BLE_STREAM_LEGACY: the frame header (or the JSON type) names the stream
+    explicit MyCallbacks(BleStream stream = BLE_STREAM_LEGACY) : stream(stream) {}
+    
     void onWrite(BLECharacteristic *pChar) {
-        Serial.println("\n=== onWrite CALLBACK TRIGGERED ===");
-        Serial.flush();
+        // A replay or bench run owns the message path until it ends
+        if (flight_recorder_replaying() || replay_bench_running()) return;
+        
+        // Snapshot the write: loop() reuses the characteristic value for acks
+        static uint8_t rxBuffer[BLE_RX_MAX];
+        size_t rxLength = pChar->getLength();
+        if (rxLength > sizeof(rxBuffer)) rxLength = sizeof(rxBuffer);
+        memcpy(rxBuffer, pChar->getData(), rxLength);
+        flight_recorder_record(rxBuffer, rxLength, stream);
+        perf_hud_record_message();
+        
+        handleWrite(rxBuffer, rxLength);
+    }
+    
+    // Everything after the snapshot; the flight recorder replays writes through here
+    void handleWrite(const uint8_t *rxBuffer, size_t rxLength) {
+        writeStartUs = micros();
+        
+        // Message handling must not touch the heap once booted
+        AllocGuardScope allocScope;
+        
+        // Frame header: drop stale and duplicate frames per stream
+        ble_frame_t frame;
+        if (!ble_frame_parse(rxBuffer, rxLength, &frame)) {
+            Serial.println("[FRAME] Malformed frame header - dropped");
+            return;
+        }
+        if (stream != BLE_STREAM_LEGACY) {
+            // Stream characteristic: the handle decides; a header must agree with it
+            if (!frame.has_header) {
+                frame.stream = stream;
+            } else if (frame.stream != stream) {
+                Serial.printf("[FRAME] Stream %u frame on stream %u characteristic - dropped\n", frame.stream, stream);
+                return;
+            }
+        }
+        BleFrameVerdict verdict = ble_frame_check(&frame);
+        if (verdict != BLE_FRAME_ACCEPT) {
+            allocScope.set_kind("dropped");
+            if (DEBUG_BLE) {
+                alloc_guard_printf("[FRAME] %s frame dropped (stream=%u seq=%u)\n",
+                                   verdict == BLE_FRAME_STALE ? "Stale" : "Duplicate", frame.stream, frame.seq);
+            }
+            return;
+        }
+        
+        // Fragments collect until the END fragment completes the message
+        const uint8_t *message;
+        size_t messageLength;
+        if (!ble_frame_reassemble(&frame, millis(), &message, &messageLength)) {
+            allocScope.set_kind("fragment");
+            return;
+        }
+        
+        // Batch: several messages in one write, applied in order as one UI commit
+        if (frame.stream == BLE_STREAM_BATCH) {
+            ui_screens_batch_begin();
+            const uint8_t *cursor = message;
+            const uint8_t *end = message + messageLength;
+            ble_frame_t sub;
+            uint8_t applied = 0;
+            uint8_t dropped = 0;
+            while (ble_frame_next_sub(&cursor, end, &sub)) {
+                // Sub-messages are sequenced on their own streams
+                if (ble_frame_check(&sub) != BLE_FRAME_ACCEPT) {
+                    dropped++;
+                    continue;
+                }
+                uint32_t decodeStartUs = micros();
+                handleMessage((const char *)sub.payload, sub.payload_len, (BleStream)sub.stream, allocScope);
+                replay_bench_record_decode(micros() - decodeStartUs);
+                applied++;
+            }
+            ui_screens_batch_end();
+            allocScope.set_kind("batch");   // Counted as one write, whatever it carried
+            if (DEBUG_BLE) {
+                alloc_guard_printf("[FRAME] Batch seq=%u: %u applied, %u dropped\n", frame.seq, applied, dropped);
+            }
+            return;
+        }
+        
+        uint32_t decodeStartUs = micros();
+        handleMessage((const char *)message, messageLength, (BleStream)frame.stream, allocScope);
+        replay_bench_record_decode(micros() - decodeStartUs);
+    }
+    
+private:
+    BleStream stream;
+    uint32_t writeStartUs = 0;  // When the write being handled arrived
+    
+    // Decode one complete JSON message and update the UI (BLE task)
+    // Legacy messages are routed by their "type" field, everything else by stream.
+    void handleMessage(const char *value, size_t valueLength, BleStream msgStream, AllocGuardScope &allocScope) {
+        // A nav frame only counts as shown while its screen (or a call on top of it) is up
+        if (ui_get_current_screen() != UI_SCREEN_NAVIGATION && !isPhoneCallActive && !isMissedCallShowing) {
+            frame_dedup_forget(FRAME_KIND_NAV);
+        }
+        
+        // Identical to the last frame of its type: skip decode and UI updates
+        uint32_t frameHash = frame_dedup_hash((const uint8_t *)value, valueLength);
+        FrameKind duplicateKind = (valueLength > 0) ? frame_dedup_match(frameHash, valueLength, sys_clock_ms()) : FRAME_KIND_NONE;
+        if (duplicateKind == FRAME_KIND_NAV) {
+            allocScope.set_kind("nav-dup");
+            if (hasNavigationData()) {
+                lastNavUpdate = sys_clock_ms();
+            }
+            // Same distance again is still a sample (e.g. stopped at a light)
+            if (currentDistance > 0 && ui_get_current_screen() == UI_SCREEN_NAVIGATION) {
+                nav_estimator_add_sample(currentDistance, sys_clock_ms());
+            }
+            if (DEBUG_NAVIGATION) Serial.println("[DEDUP] Duplicate nav frame - decode skipped");
+            return;
+        }
+        if (duplicateKind == FRAME_KIND_CALL) {
+            allocScope.set_kind("call-dup");
+            if (DEBUG_CALLS) Serial.println("[DEDUP] Duplicate call frame - decode skipped");
+            return;
+        }
+        FrameDedupDecode frameDecode(frameHash, valueLength);
         
-        String value = pChar->getValue();
-        Serial.print("Value length: ");
-        Serial.println(value.length());
-        Serial.flush();
+        // Payload echo: blocking serial writes would be timed as decode
+        if (DEBUG_BLE) {
+            Serial.println("\n=== onWrite CALLBACK TRIGGERED ===");
+            Serial.print("Value length: ");
+            Serial.println(valueLength);
+        }
         
-        if (value.length() > 0) {
-            Serial.print("Received: ");
-            Serial.println(value);
-            Serial.flush();
+        if (valueLength > 0) {
+            if (DEBUG_BLE) {
+                Serial.print("Received: ");
+                Serial.write((const uint8_t *)value, valueLength);
+                Serial.println();
+            }
             
-            StaticJsonDocument<256> doc;
-            DeserializationError error = deserializeJson(doc, value);
+            // Static: reassembled messages are larger than the BLE task stack should hold
+            static StaticJsonDocument<BLE_FRAME_REASSEMBLY_MAX + 256> doc;
+            DeserializationError error = deserializeJson(doc, value, valueLength);
             
-            Serial.print("JSON parse error: ");
-            Serial.println(error.c_str());
-            Serial.flush();
+            if (error != DeserializationError::Ok || DEBUG_BLE) {
+                Serial.print("JSON parse error: ");
+                Serial.println(error.c_str());
+            }
             
             if (error == DeserializationError::Ok) {
-                const char* type = doc["type"];
+                const char* type = doc["type"] | "";
                 
-                if (type == nullptr) {
-                    Serial.println("ERROR: JSON missing 'type' field");
-                    Serial.flush();
-                    return;
+                if (msgStream == BLE_STREAM_LEGACY) {
+                    if (type[0] == '\0') {
+                        Serial.println("ERROR: JSON missing 'type' field");
+                        return;
+                    }
+                    if (strcmp(type, "debug") == 0) {
+                        // {"type":"debug","hud":true|false,"profile":true|false,"bench":"city","speed":10,
+                        //  "fast_forward":true|false,"advance_s":N,"render_bench":true}
+                        // - a bare debug command toggles the HUD
+                        allocScope.set_kind("debug");
+                        if (!ENABLE_DEBUG_COMMANDS) {
+                            Serial.println("[DEBUG] Debug command ignored - built without ENABLE_DEBUG_COMMANDS");
+                            return;
+                        }
+                        if (flight_recorder_replaying() || replay_bench_running()) {
+                            // Recorded commands already ran live; replaying them would restart benches or move the clock
+                            Serial.println("[DEBUG] Debug command skipped during a replay");
+                            return;
+                        }
+                        bool otherCommand = doc.containsKey("profile") || doc.containsKey("bench") ||
+                                            doc.containsKey("fast_forward") || doc.containsKey("advance_s") ||
+                                            doc.containsKey("render_bench");
+                        if (!otherCommand || doc.containsKey("hud")) {
+                            perf_hud_request(doc["hud"] | !perf_hud_visible());
+                        }
+                        if (doc.containsKey("profile")) {
+                            render_profiler_request(doc["profile"] | false);
+                        }
+                        if (doc.containsKey("bench")) {
+                            replay_bench_request(doc["bench"] | "", doc["speed"] | 1);
+                        }
+                        if (doc["render_bench"] | false) {
+                            if (isPhoneCallActive || isMissedCallShowing) {
+                                Serial.println("[RBENCH] Rejected - a call screen is showing");
+                            } else {
+                                render_bench_request();
+                            }
+                        }
+                        if (doc.containsKey("fast_forward")) {
+                            sys_clock_set_fast_forward(doc["fast_forward"] | false);
+                        }
+                        if (doc.containsKey("advance_s")) {
+                            uint32_t advanceS = doc["advance_s"] | 0;
+                            sys_clock_advance(advanceS * 1000UL);
+                            Serial.printf("[CLOCK] Advanced %lu s\n", advanceS);
+                        }
+                        return;
+                    }
+                    if (strcasecmp(type, "phone_call") == 0 || strcmp(type, "contacts") == 0) {
+                        msgStream = BLE_STREAM_CALL;
+                    } else if (strcasecmp(type, "NAVIGATION") == 0 || strcmp(type, "nav") == 0) {
+                        msgStream = BLE_STREAM_NAV;
+                    } else {
+                        msgStream = BLE_STREAM_NOTIFY;  // Messages, banking, ... must not reach the nav screen
+                    }
                 }
                 
-                Serial.print("Message type: ");
-                Serial.println(type);
-                Serial.flush();
+                if (DEBUG_BLE) {
+                    Serial.print("Message type: ");
+                    Serial.println(type);
+                }
                 
-                if (strcmp(type, "phone_call") == 0) {
+                if (msgStream == BLE_STREAM_NOTIFY) {
+                    // No notification screen yet: count it and leave the UI alone
+                    allocScope.set_kind("notify");
+                    notificationsReceived++;
+                    if (DEBUG_BLE) {
+                        alloc_guard_printf("[NOTIFY] type=%s ignored (%lu received)\n", type, notificationsReceived);
+                    }
+                } else if (msgStream == BLE_STREAM_CALL && strcmp(type, "contacts") == 0) {
+                    // Caller directory, pushed once per connection (see caller_directory.h)
+                    allocScope.set_kind("contacts");
+                    if (doc["reset"] | false) caller_directory_clear();
+                    uint16_t stored = 0;
+                    for (JsonArrayConst entry : doc["c"].as<JsonArrayConst>()) {
+                        if (caller_directory_put(entry[0] | 0, entry[2].as<uint32_t>(), entry[1] | "")) stored++;
+                    }
+                    if (DEBUG_CALLS) alloc_guard_printf("[CALLERS] %u contact(s) stored\n", stored);
+                } else if (msgStream == BLE_STREAM_CALL) {
+                    allocScope.set_kind("call");
+                    frameDecode.set_kind(FRAME_KIND_CALL);
+                    
                     // Handle phone call data
                     const char* callerName = doc["caller_name"];
                     const char* callerNumber = doc["caller_number"];
                     const char* callState = doc["call_state"];
                     int duration = doc["duration"] | 0;
                     
-                    if (DEBUG_CALLS) {
-                        Serial.printf("[CALL] Type=%s, State=%s, Name=%s, Number=%s\n", type, callState, callerName, callerNumber);
+                    if (callState == nullptr) callState = "";
+                    
+                    // A listed caller arrives as a contact ID instead of name and number
+                    char contactName[CALLER_DIRECTORY_NAME_LEN];
+                    uint32_t numberHash = 0;
+                    uint16_t contactId = doc["contact"] | 0;
+                    bool byContactId = contactId != 0 &&
+                                       caller_directory_lookup(contactId, contactName, sizeof(contactName), &numberHash);
+                    if (byContactId) {
+                        callerName = contactName;
+                        callerNumber = "";
+                    } else {
+                        if (contactId != 0) alloc_guard_printf("[CALLERS] Unknown contact %u\n", contactId);
+                        numberHash = caller_directory_hash_number(callerNumber);
                     }
+                    caller_directory_record_call_frame(valueLength, byContactId);
                     
-                    Serial.printf("[DEBUG] Comparing callState='%s' with 'INCOMING' = %d\n", callState, strcmp(callState, "INCOMING"));
+                    if (DEBUG_CALLS) {
+                        alloc_guard_printf("[CALL] Type=%s, State=%s, Name=%s, Number=%s\n", type, callState, callerName, callerNumber);
+                        alloc_guard_printf("[DEBUG] Comparing callState='%s' with 'INCOMING' = %d\n", callState, strcmp(callState, "INCOMING"));
+                    }
                     
                     if (strcmp(callState, "INCOMING") == 0) {
                         // Don't override MISSED state with INCOMING - prioritize missed calls
                         if (!isMissedCallShowing) {
                             Serial.println("[CALL] Displaying INCOMING call via LVGL");
-                            phoneCallDisplayStartTime = millis();  // Track display start time
+                            phoneCallDisplayStartTime = sys_clock_ms();  // Track display start time
                             
                             // Use LVGL screen instead of Arduino_GFX (NO ANIMATION for stability)
                             ui_navigation_hide_all_objects(); // Hide navigation objects
@@ -956,16 +1384,17 @@ class MyCallbacks : public BLECharacteristicCallbacks {
                             
                             // Start ringing animation
                             ui_incoming_call_screen_start_ringing();
+                            caller_directory_mark_incoming(writeStartUs, byContactId);
                             
                             // DON'T use Arduino_GFX displayIncomingCall - it will overwrite LVGL!
-                            // displayIncomingCall(String(callerName ? callerName : "Unknown"), String(callerNumber ? callerNumber : ""));
+                            // displayIncomingCall(callerName ? callerName : "Unknown", callerNumber ? callerNumber : "");
                             Serial.println("[CALL] LVGL incoming call screen should be visible now");
                         } else {
                             Serial.println("[CALL] INCOMING ignored - missed call is showing");
                         }
                     } else if (strcmp(callState, "ONGOING") == 0) {
                         Serial.println("[CALL] Displaying ONGOING call via LVGL");
-                        phoneCallDisplayStartTime = millis();  // Track display start time
+                        phoneCallDisplayStartTime = sys_clock_ms();  // Track display start time
                         
                         // Use LVGL screen for ongoing/outgoing calls (NO ANIMATION)
                         ui_navigation_hide_all_objects(); // Hide navigation objects
@@ -982,23 +1411,25 @@ class MyCallbacks : public BLECharacteristicCallbacks {
                         
                         // Update call state
                         isPhoneCallActive = true;
-                        currentCallerName = callerName ? String(callerName) : "Unknown";
-                        currentCallState = "ONGOING";
+                        COPY_TEXT(currentCallerName, callerName ? callerName : "Unknown");
+                        COPY_TEXT(currentCallState, "ONGOING");
                         
                         Serial.println("[CALL] LVGL outgoing/ongoing call screen should be visible now");
                     } else if (strcmp(callState, "MISSED") == 0) {
-                        String name = currentCallerName.length() > 0 ? currentCallerName : String(callerName ? callerName : "Unknown");
-                        String number = currentCallerNumber.length() > 0 ? currentCallerNumber : String(callerNumber ? callerNumber : "");
+                        const char *name = currentCallerName[0] != '\0' ? currentCallerName : (callerName ? callerName : "Unknown");
+                        const char *number = currentCallerNumber[0] != '\0' ? currentCallerNumber : (callerNumber ? callerNumber : "");
+                        uint32_t missedHash = currentCallerNumber[0] != '\0' ? caller_directory_hash_number(currentCallerNumber) : numberHash;
                         
                         // Store persistent missed call info (increment count if same number, replace if different)
-                        if (persistentMissedCall.callerNumber == String(number)) {
+                        if (persistentMissedCall.numberHash == missedHash) {
                             persistentMissedCall.count++;
                         } else {
-                            persistentMissedCall.callerName = name;
-                            persistentMissedCall.callerNumber = number;
+                            COPY_TEXT(persistentMissedCall.callerName, name);
+                            COPY_TEXT(persistentMissedCall.callerNumber, number);
+                            persistentMissedCall.numberHash = missedHash;
                             persistentMissedCall.count = 1;
                         }
-                        persistentMissedCall.firstMissedTime = millis();
+                        persistentMissedCall.firstMissedTime = sys_clock_ms();
                         persistentMissedCall.acknowledged = false;
                         // Initialize reminder timer for first time
                         lastMissedCallReminderTime = 0;
@@ -1011,91 +1442,107 @@ class MyCallbacks : public BLECharacteristicCallbacks {
                         clearPhoneDisplay();
                     }
                 } else {
+                    allocScope.set_kind("nav");
+                    frameDecode.set_kind(FRAME_KIND_NAV);
+                    
                     // Handle navigation data - ALWAYS UPDATE SAVED STATE, BUT ONLY REDRAW IF NO CALL
                     const char* dir = doc["direction"] | "";
                     int dist = doc["distance"] | 0;
                     const char* man = doc["maneuver"] | "";
+                    JsonArrayConst maneuverTokens = doc["mt"];  // Phrase dictionary form of "maneuver"
                     const char* eta = doc["eta"] | "";
+                    long etaSeconds = doc["eta_s"] | -1L;  // Optional structured ETA (remaining seconds)
                     
-                    String newDirection = String(dir ? dir : "");
+                    // Optional lookahead: [direction, meters after this maneuver, text or tokens]
+                    const char *nextDirections[NAV_LOOKAHEAD_MAX];
+                    int nextGaps[NAV_LOOKAHEAD_MAX];
+                    char nextManeuvers[NAV_LOOKAHEAD_MAX][NAV_MANEUVER_LEN];
+                    const char *nextManeuverTexts[NAV_LOOKAHEAD_MAX];
+                    uint8_t nextCount = 0;
+                    for (JsonArrayConst entry : doc["next"].as<JsonArrayConst>()) {
+                        if (nextCount >= NAV_LOOKAHEAD_MAX) break;
+                        nextDirections[nextCount] = entry[0] | "";
+                        nextGaps[nextCount] = entry[1] | 0;
+                        if (entry[2].is<JsonArrayConst>()) {
+                            phrase_dict_expand(entry[2], doc["mv"] | 0u, nextManeuvers[nextCount], sizeof(nextManeuvers[nextCount]));
+                        } else {
+                            COPY_TEXT(nextManeuvers[nextCount], entry[2] | "");
+                        }
+                        nextManeuverTexts[nextCount] = nextManeuvers[nextCount];
+                        nextCount++;
+                    }
                     
                     if (DEBUG_NAVIGATION) {
-                        Serial.printf("[NAV] dir=%s, dist=%d, man=%s, eta=%s\n", dir, dist, man, eta);
+                        alloc_guard_printf("[NAV] dir=%s, dist=%d, man=%s, eta=%s\n", dir, dist, man, eta);
                     }
                     
-                    // Store old direction BEFORE updating for comparison
-                    String oldDirection = currentDirection;
-                    
                     // ALWAYS update both current AND saved state (silently during calls)
-                    currentDirection = String(dir ? dir : "");
+                    COPY_TEXT(currentDirection, dir);
                     currentDistance = dist;
-                    currentManeuver = String(man ? man : "");
-                    currentETA = String(eta ? eta : "");
+                    if (maneuverTokens.isNull()) {
+                        COPY_TEXT(currentManeuver, man);
+                    } else if (phrase_dict_expand(maneuverTokens, doc["mv"] | 0u, currentManeuver, sizeof(currentManeuver)) < 0) {
+                        // Built for another dictionary: better no text than the wrong words
+                        alloc_guard_printf("[NAV] Maneuver tokens rejected (dictionary v%d, frame v%u)\n",
+                                           PHRASE_DICT_VERSION, doc["mv"] | 0u);
+                    }
+                    COPY_TEXT(currentETA, eta);
+                    currentArrivalMs = (etaSeconds >= 0) ? sys_clock_ms() + (unsigned long)etaSeconds * 1000UL : 0;
                     
-                    savedDirection = currentDirection;
+                    COPY_TEXT(savedDirection, currentDirection);
                     savedDistance = currentDistance;
-                    savedManeuver = currentManeuver;
-                    savedETA = currentETA;
+                    COPY_TEXT(savedManeuver, currentManeuver);
+                    COPY_TEXT(savedETA, currentETA);
+                    savedArrivalMs = currentArrivalMs;
                     wasNavigationActive = true;
-                    lastNavUpdate = millis(); // Update last navigation update time
+                    lastNavUpdate = sys_clock_ms(); // Update last navigation update time
                     
                     if (DEBUG_NAVIGATION) {
-                        Serial.printf("[NAV] Stored state - dir:%s, dist:%d, man:%s, eta:%s\n", 
-                                      currentDirection.c_str(), currentDistance, currentManeuver.c_str(), currentETA.c_str());
+                        alloc_guard_printf("[NAV] Stored state - dir:%s, dist:%d, man:%s, eta:%s\n", 
+                                           currentDirection, currentDistance, currentManeuver, currentETA);
                     }
                     
                     // Determine if we have real navigation data
-                    bool hasNav = false;
-                    {
-                        const bool dirValid = (currentDirection.length() > 0 && currentDirection != "straight" && currentDirection != "forward");
-                        const bool distValid = (currentDistance > 0);
-                        const bool manValid = (currentManeuver.length() > 0);
-                        const bool etaValid = (currentETA.length() > 0);
-                        hasNav = (dirValid || distValid || manValid || etaValid);
-                    }
+                    bool hasNav = hasNavigationData();
                     if (hasNav) {
-                        lastNavUpdate = millis(); // Only when real nav present
+                        lastNavUpdate = sys_clock_ms(); // Only when real nav present
                     }
 
                     // Only redraw navigation if no call is active AND we have real nav data
-                    if (!isPhoneCallActive && !isMissedCallShowing && hasNav) {
+                    if (!isPhoneCallActive && !isMissedCallShowing && hasNav &&
+                        ui_navigation_screen_is_passed(currentDirection)) {
+                        // The screen already switched to the next maneuver at the turn
+                        if (DEBUG_NAVIGATION) Serial.println("[NAV] Frame for the passed maneuver - not drawn");
+                    } else if (!isPhoneCallActive && !isMissedCallShowing && hasNav) {
                         UIScreen currentScreen = ui_get_current_screen();
                         
                         // Switch to navigation screen if not already there
                         if (currentScreen != UI_SCREEN_NAVIGATION) {
                             Serial.println("[NAV] Switching to LVGL navigation screen");
-                            ui_show_screen(UI_SCREEN_NAVIGATION, 0);  // Immediate load, no animation
-                            
-                            // Process LVGL a few times to ensure screen is ready
-                            for (int i = 0; i < 3; i++) {
-                                lv_timer_handler();
-                                delay(1);
-                            }
-                            Serial.println("[NAV] Navigation screen ready");
+                            // Committed at the start of the next UI frame in loop()
+                            ui_show_screen(UI_SCREEN_NAVIGATION, ANIM_TIME_SCREEN);
                         }
                         
                         // Update LVGL navigation screen with latest data
-                        if (currentDirection.length() > 0 && currentDirection != "straight" && currentDirection != "forward") {
-                            ui_navigation_screen_update_direction(currentDirection.c_str(), false);
+                        if (currentDirection[0] != '\0' && strcmp(currentDirection, "straight") != 0 && strcmp(currentDirection, "forward") != 0) {
+                            ui_navigation_screen_update_direction(currentDirection, false);
                         } else {
                             // Hide arrows if direction not meaningful
                             ui_navigation_screen_update_direction("", false);
                         }
+                        ui_navigation_screen_set_next(nextDirections, nextGaps, nextManeuverTexts, nextCount);
                         if (currentDistance > 0) {
-                            ui_navigation_screen_update_distance(currentDistance, false);
+                            // Fresh ground truth: the screen counts down from here until the next message
+                            ui_navigation_screen_update_distance(currentDistance, true);
                         } else {
                             ui_navigation_screen_update_distance(0, false);
                         }
-                        if (currentManeuver.length() > 0) {
-                            ui_navigation_screen_update_maneuver(currentManeuver.c_str());
+                        if (currentManeuver[0] != '\0') {
+                            ui_navigation_screen_update_maneuver(currentManeuver);
                         } else {
                             ui_navigation_screen_update_maneuver("");
                         }
-                        if (currentETA.length() > 0) {
-                            ui_navigation_screen_update_eta(currentETA.c_str());
-                        } else {
-                            ui_navigation_screen_update_eta("");
-                        }
+                        showNavigationETA(currentETA, currentArrivalMs);
                         
                         Serial.println("[NAV] Navigation screen updated");
                     } else if (!isPhoneCallActive && !isMissedCallShowing && !hasNav) {
@@ -1113,106 +1560,330 @@ class MyCallbacks : public BLECharacteristicCallbacks {
     }
 };
 
+// Handle a replayed or scripted write as if written to the stream's characteristic
+void replayWrite(uint8_t stream, const uint8_t *data, size_t len) {
+    MyCallbacks target((BleStream)(stream < BLE_STREAM_COUNT ? stream : BLE_STREAM_LEGACY));
+    uint32_t startUs = micros();
+    target.handleWrite(data, len);
+    replay_bench_record_write(micros() - startUs);
+}
+
+// Flight recorder replay target (recorder task): each record goes through the
+// same path its write took; the run is measured like a bench scenario.
+// The live connection's sequence and ack state is set aside for the run.
+void replayFlightRecord(const flight_record_header_t *record, const uint8_t *data) {
+    if (record == nullptr) {
+        replay_bench_end();
+        ble_frame_restore();   // Live writes resume where the phone left off
+        frame_dedup_reset();   // The UI shows replayed data: re-apply the next live frames
+        return;
+    }
+    if (!replay_bench_measuring()) {
+        ble_frame_save();
+        ble_frame_reset();
+        frame_dedup_reset();
+        replay_bench_begin("flightrec", flight_recorder_replay_speed());
+    }
+    if (record->flags & (FLIGHT_RECORD_FLAG_BOOT | FLIGHT_RECORD_FLAG_CONNECT)) {
+        // New sequence numbers follow
+        ble_frame_reset();
+        frame_dedup_reset();
+        return;
+    }
+    replayWrite(record->source, data, record->length);
+}
+
 // ==== SETUP ====
+// ==== Boot Sequencer ====
+// setup() only brings the panel up and shows the welcome frame; the rest of
+// the boot runs one stage per loop() iteration so LVGL keeps rendering.
+enum BootStage {
+    BOOT_STAGE_TOUCH = 0,
+    BOOT_STAGE_BLE_STACK,
+    BOOT_STAGE_BLE_SERVICE,
+    BOOT_STAGE_PREBUILD_IDLE,
+    BOOT_STAGE_PREBUILD_NAV,
+    BOOT_STAGE_PREBUILD_CALLS,
+    BOOT_STAGE_ADVERTISE,
+    BOOT_STAGE_DONE
+};
+BootStage bootStage = BOOT_STAGE_TOUCH;
+
+#define MAX_BOOT_MILESTONES 16
+struct BootMilestone {
+    const char *name;
+    uint32_t us;  // Time since power-on (esp_timer starts at reset)
+};
+BootMilestone bootMilestones[MAX_BOOT_MILESTONES];
+uint8_t bootMilestoneCount = 0;
+uint32_t firstPixelUs = 0;
+uint32_t advertisingUs = 0;
+
+void bootMark(const char *name) {
+    uint32_t now = micros();
+    if (bootMilestoneCount < MAX_BOOT_MILESTONES) {
+        bootMilestones[bootMilestoneCount].name = name;
+        bootMilestones[bootMilestoneCount].us = now;
+        bootMilestoneCount++;
+    }
+    Serial.printf("[BOOT] %7.1f ms  %s\n", now / 1000.0f, name);
+}
+
+void printBootReport() {
+    Serial.println("[BOOT] ===== Boot timeline =====");
+    uint32_t prev = 0;
+    for (uint8_t i = 0; i < bootMilestoneCount; i++) {
+        Serial.printf("[BOOT] %-16s at %7.1f ms (+%6.1f ms)\n", bootMilestones[i].name,
+                      bootMilestones[i].us / 1000.0f, (bootMilestones[i].us - prev) / 1000.0f);
+        prev = bootMilestones[i].us;
+    }
+    Serial.printf("[BOOT] Power-on to first pixel: %.1f ms\n", firstPixelUs / 1000.0f);
+    Serial.printf("[BOOT] Power-on to advertising: %.1f ms\n", advertisingUs / 1000.0f);
+}
+
+// Run one boot stage (called from loop() between frames)
+void bootStep() {
+    switch (bootStage) {
+        case BOOT_STAGE_TOUCH: {
+            // Configure I2C pins for touch controller
+            Wire.begin(Touch_I2C_SDA, Touch_I2C_SCL);
+            
+            // Initialize touch controller using library's function
+            bsp_touch_init(&Wire, Touch_RST, Touch_INT, gfx->getRotation(), gfx->width(), gfx->height());
+            
+            // Initialize touch input device for LVGL
+            lv_indev_drv_init(&indev_drv);
+            indev_drv.type = LV_INDEV_TYPE_POINTER;
+            indev_drv.read_cb = lvgl_touchpad_read;
+            indev = lv_indev_drv_register(&indev_drv);
+            touchEnabled = true;
+            Serial.println("Touch controller initialized");
+            bootMark("touch_ready");
+            break;
+        }
+        
+        case BOOT_STAGE_BLE_STACK:
+            flight_recorder_init(replayFlightRecord);  // Before the first write can arrive
+            replay_bench_init(replayWrite);
+            BLEDevice::init("ESP32_BLE");
+            BLEDevice::setMTU(BLE_PREFERRED_MTU);  // The phone still has to request it
+            BLEDevice::setCustomGapHandler(telemetryGapHandler);  // RSSI readings
+            pServer = BLEDevice::createServer();
+            pServer->setCallbacks(new MyServerCallbacks());
+            bootMark("ble_stack");
+            break;
+        
+        case BOOT_STAGE_BLE_SERVICE: {
+            BLEService *pService = pServer->createService(BLEUUID(SERVICE_UUID), BLE_SERVICE_HANDLES);
+            pCharacteristic = pService->createCharacteristic(
+                CHARACTERISTIC_UUID,
+                BLECharacteristic::PROPERTY_READ |
+                BLECharacteristic::PROPERTY_WRITE |
+                BLECharacteristic::PROPERTY_NOTIFY
+            );
+            
+            pCharacteristic->setCallbacks(new MyCallbacks());
+            pCharacteristic->addDescriptor(new BLE2902());
+            
+            // Per-stream characteristics (the phone queues each stream separately)
+            const struct { const char *uuid; BleStream stream; } streamChars[] = {
+                { NAV_CHARACTERISTIC_UUID,    BLE_STREAM_NAV },
+                { CALL_CHARACTERISTIC_UUID,   BLE_STREAM_CALL },
+                { NOTIFY_CHARACTERISTIC_UUID, BLE_STREAM_NOTIFY },
+            };
+            for (const auto &sc : streamChars) {
+                BLECharacteristic *pStreamChar = pService->createCharacteristic(
+                    sc.uuid,
+                    BLECharacteristic::PROPERTY_WRITE |
+                    BLECharacteristic::PROPERTY_WRITE_NR
+                );
+                pStreamChar->setCallbacks(new MyCallbacks(sc.stream));
+            }
+            
+            pTelemetryCharacteristic = pService->createCharacteristic(
+                TELEMETRY_CHARACTERISTIC_UUID,
+                BLECharacteristic::PROPERTY_NOTIFY |
+                BLECharacteristic::PROPERTY_WRITE
+            );
+            pTelemetryCharacteristic->setCallbacks(new TelemetryCallbacks());
+            BLE2902 *telemetryCccd = new BLE2902();
+            telemetryCccd->setCallbacks(new TelemetryCccdCallbacks());
+            pTelemetryCharacteristic->addDescriptor(telemetryCccd);
+            
+            pFlightRecorderCharacteristic = pService->createCharacteristic(
+                FLIGHTREC_CHARACTERISTIC_UUID,
+                BLECharacteristic::PROPERTY_NOTIFY |
+                BLECharacteristic::PROPERTY_WRITE
+            );
+            pFlightRecorderCharacteristic->setCallbacks(new FlightRecorderCallbacks());
+            pFlightRecorderCharacteristic->addDescriptor(new BLE2902());
+            
+            // Read by the phone before it sends anything: "mt" tokens only for a matching dictionary
+            BLECharacteristic *pCapsCharacteristic = pService->createCharacteristic(
+                CAPS_CHARACTERISTIC_UUID,
+                BLECharacteristic::PROPERTY_READ
+            );
+            uint8_t caps[] = { PHRASE_DICT_VERSION };
+            pCapsCharacteristic->setValue(caps, sizeof(caps));
+            pService->start();
+            
+            BLEAdvertising *pAdvertising = BLEDevice::getAdvertising();
+            pAdvertising->addServiceUUID(SERVICE_UUID);
+            pAdvertising->setScanResponse(true);
+            pAdvertising->setMinPreferred(0x06);
+            bootMark("ble_service");
+            break;
+        }
+        
+        // Pinned screens must exist before the first BLE message can arrive
+        case BOOT_STAGE_PREBUILD_IDLE:
+            ui_screens_prebuild(UI_SCREEN_IDLE);
+            bootMark("idle_built");
+            break;
+        
+        case BOOT_STAGE_PREBUILD_NAV:
+            ui_screens_prebuild(UI_SCREEN_NAVIGATION);
+            bootMark("nav_built");
+            break;
+        
+        // Steady state: call screens exist before the first message too
+        // (one screen per frame)
+        case BOOT_STAGE_PREBUILD_CALLS: {
+            static int nextCallScreen = UI_SCREEN_INCOMING_CALL;
+            if (ZERO_ALLOC_STEADY_STATE && nextCallScreen <= UI_SCREEN_MISSED_CALL) {
+                ui_screens_prebuild((UIScreen)nextCallScreen);
+                ui_screens_pin((UIScreen)nextCallScreen);
+                nextCallScreen++;
+                return;  // Stay in this stage
+            }
+            bootMark("calls_built");
+            break;
+        }
+        
+        case BOOT_STAGE_ADVERTISE:
+            Serial.println("[BLE] Starting advertising...");
+            Serial.printf("[BLE] Device name: ESP32_BLE\n");
+            Serial.printf("[BLE] Service UUID: %s\n", SERVICE_UUID);
+            Serial.printf("[BLE] Characteristic UUID: %s\n", CHARACTERISTIC_UUID);
+            Serial.printf("[BLE] Stream characteristics: nav %s, call %s, notify %s, telemetry %s, flight recorder %s, capabilities %s\n",
+                          NAV_CHARACTERISTIC_UUID, CALL_CHARACTERISTIC_UUID,
+                          NOTIFY_CHARACTERISTIC_UUID, TELEMETRY_CHARACTERISTIC_UUID,
+                          FLIGHTREC_CHARACTERISTIC_UUID, CAPS_CHARACTERISTIC_UUID);
+            
+            BLEDevice::startAdvertising();
+            advertisingUs = micros();
+            bootMark("advertising");
+            Serial.println("[BLE] Advertising started - waiting for connection...");
+            Serial.println("[BLE] Make sure your Android app is scanning and connecting to 'ESP32_BLE'");
+            
+            if (RUN_SCREEN_BENCHMARK) {
+                ui_screens_benchmark_cold_show();
+            }
+            if (RUN_FORMAT_BENCHMARK) {
+                ui_format_benchmark();
+            }
+            if (RUN_RENDER_BENCHMARK) {
+                render_bench_run();
+                restoreScreenAfterBenchmark();
+            }
+            bootMark("boot_done");
+            printBootReport();
+            
+            // From here on BLE messages are checked for heap allocations
+            alloc_guard_mark_boot_complete();
+            break;
+        
+        default:
+            return;
+    }
+    bootStage = (BootStage)(bootStage + 1);
+}
+
 void setup() {
     Serial.begin(115200);
+    bootMark("serial");
     
+    // Keep backlight off until the first frame is on the panel
     pinMode(GFX_BL, OUTPUT);
-    digitalWrite(GFX_BL, HIGH);
+    digitalWrite(GFX_BL, LOW);
     gfx->begin();
-    lcd_reg_init();
+    bootMark("panel_begin");
     
-    // Don't clear screen or draw status here - LVGL will handle display
-    // gfx->fillScreen(0x0000);  // Commented out - LVGL manages display
-    // displayStatus("STARTING...", 0xFFE0);  // Commented out - LVGL shows welcome screen
-    
-    // Initialize touch
-    // Configure I2C pins for touch controller
-    Wire.begin(Touch_I2C_SDA, Touch_I2C_SCL);
-    
-    // Initialize touch controller using library's function
-    bsp_touch_init(&Wire, Touch_RST, Touch_INT, gfx->getRotation(), gfx->width(), gfx->height());
-    touchEnabled = true;
-    Serial.println("Touch controller initialized");
-    
-    BLEDevice::init("ESP32_BLE");
-    BLEServer *pServer = BLEDevice::createServer();
-    pServer->setCallbacks(new MyServerCallbacks());
-    
-    BLEService *pService = pServer->createService(SERVICE_UUID);
-    pCharacteristic = pService->createCharacteristic(
-        CHARACTERISTIC_UUID,
-        BLECharacteristic::PROPERTY_READ |
-        BLECharacteristic::PROPERTY_WRITE |
-        BLECharacteristic::PROPERTY_NOTIFY
-    );
-    
-    pCharacteristic->setCallbacks(new MyCallbacks());
-    pCharacteristic->addDescriptor(new BLE2902());
-    pService->start();
-    
-    BLEAdvertising *pAdvertising = BLEDevice::getAdvertising();
-    pAdvertising->addServiceUUID(SERVICE_UUID);
-    pAdvertising->setScanResponse(true);
-    pAdvertising->setMinPreferred(0x06);
-    
-    Serial.println("[BLE] Starting advertising...");
-    Serial.printf("[BLE] Device name: ESP32_BLE\n");
-    Serial.printf("[BLE] Service UUID: %s\n", SERVICE_UUID);
-    Serial.printf("[BLE] Characteristic UUID: %s\n", CHARACTERISTIC_UUID);
-    
-    BLEDevice::startAdvertising();
-    Serial.println("[BLE] Advertising started - waiting for connection...");
-    Serial.println("[BLE] Make sure your Android app is scanning and connecting to 'ESP32_BLE'");
+    lcd_sleep_out();
+    uint32_t sleepOutMs = millis();
     
+    // Overlap the panel's sleep-out delay with LVGL and welcome screen setup
     // Initialize LVGL - MUST call lv_init() first (done in lvgl_init)
-    // Then initialize display driver AFTER Arduino_GFX is ready
     Serial.println("[LVGL] Initializing LVGL...");
     lvgl_init();  // This calls lv_init() internally
+    alloc_guard_init();
     
     // Initialize display driver (allocates buffers, sets up flush callback)
     lvgl_display_init(gfx);
+    ui_transition_reserve();  // Takes the share lvgl_init budgeted before BLE init can use it
     
-    // Initialize touch input device for LVGL
-    lv_indev_drv_init(&indev_drv);
-    indev_drv.type = LV_INDEV_TYPE_POINTER;
-    indev_drv.read_cb = lvgl_touchpad_read;
-    indev = lv_indev_drv_register(&indev_drv);
-    Serial.println("[LVGL] Touch input device registered");
+    // Initialize animation service (binds it to this task, which runs lv_timer_handler)
+    ui_anim_init();
     
     // Initialize UI theme first (before screens)
     ui_theme_init();
     
-    // Initialize all UI screens
+    // Build the welcome screen (other screens are built by the boot sequencer / on first show)
     ui_screens_init();
-    Serial.println("[LVGL] All UI screens initialized");
-    
-    // Show welcome screen initially (will auto-transition to idle when BLE connects)
-    Serial.println("[LVGL] About to show welcome screen...");
     ui_show_screen(UI_SCREEN_WELCOME, 0);  // No animation for immediate display
     ui_welcome_screen_update_ble_status(deviceConnected);
-    Serial.println("[LVGL] Welcome screen displayed");
-    Serial.println("[LVGL] Make sure to call lv_timer_handler() in loop()!");
+    ui_screens_process_pending();
+    bootMark("welcome_built");
     
-    // Force first render by calling timer handler a few times
-    for (int i = 0; i < 10; i++) {
-        lv_timer_handler();
-        delay(10);
+    // Finish panel init once the sleep-out delay has elapsed
+    uint32_t elapsedMs = millis() - sleepOutMs;
+    if (elapsedMs < LCD_SLEEP_OUT_DELAY) {
+        delay(LCD_SLEEP_OUT_DELAY - elapsedMs);
     }
-    Serial.println("[LVGL] Initial render completed");
+    lcd_reg_init();
+    bootMark("lcd_init_done");
+    
+    // Render the welcome frame right away, then light the panel
+    lv_refr_now(NULL);
+    digitalWrite(GFX_BL, HIGH);
+    firstPixelUs = micros();
+    bootMark("first_pixel");
     
     // Register dismiss callbacks for all call screens
-    Serial.println("[UI] Registering dismiss callbacks for all call screens...");
     ui_incoming_call_screen_set_callbacks(nullptr, clearPhoneDisplay);
     ui_outgoing_call_screen_set_hangup_callback(clearPhoneDisplay);
     ui_missed_call_screen_set_dismiss_callback(clearPhoneDisplay);
     Serial.println("[UI] All dismiss callbacks registered");
+    
+    perf_hud_init();  // Hidden until a long press or BLE debug command
+    
+    // Touch, BLE and remaining screens continue in loop() via bootStep()
 }
 
 void loop() {
     // LVGL task handler (must be called every 5-10ms for smooth UI)
     // This is CRITICAL - without this, LVGL screens won't update!
+    // The frame lock keeps a batch being applied on the BLE task out of this
+    // frame: it lands whole, between two frames
+    ui_screens_lock();
+    ui_screens_process_pending();  // Commit the screen switch requested since last frame
+    ui_anim_frame_begin();  // Apply animation requests queued by the BLE task
+    render_profiler_process();
+    if (render_bench_process()) {
+        restoreScreenAfterBenchmark();
+    }
+    uint32_t frameStartUs = micros();
     lv_timer_handler();
+    uint32_t frameUs = micros() - frameStartUs;
+    ui_screens_unlock();
+    ui_transition_record_frame(frameUs);
+    telemetry_record_handler(frameUs);
+    perf_hud_record_frame(frameUs);
+    
+    // Continue boot between frames until everything is up
+    if (bootStage != BOOT_STAGE_DONE) {
+        bootStep();
+    }
     
     // Check for touch input using library's functions
     if (touchEnabled) {
@@ -1249,12 +1920,13 @@ void loop() {
     }
     
     // Add timeout check for incoming calls
-    if (isPhoneCallActive && currentCallState == "INCOMING") {
-        unsigned long currentTime = millis();
+    if (isPhoneCallActive && strcmp(currentCallState, "INCOMING") == 0) {
+        unsigned long currentTime = sys_clock_ms();
         if (currentTime - callStartTime > 30000) { // 30 seconds timeout
             Serial.println("Incoming call timeout - treating as missed");
             displayMissedCall(currentCallerName, currentCallerNumber, 1);
         } else {
+            sys_clock_deadline(callStartTime + 30001);
             // Animation disabled - LVGL handles this
             // drawRingingAnimation();
         }
@@ -1266,7 +1938,7 @@ void loop() {
     static bool showingMissedCallReminder = false;
     
     if (!persistentMissedCall.acknowledged && persistentMissedCall.count > 0) {
-        unsigned long currentTime = millis();
+        unsigned long currentTime = sys_clock_ms();
         
         // Check if initial display time has passed (10 seconds) OR if already in reminder mode
         if (currentTime - persistentMissedCall.firstMissedTime > INITIAL_MISSED_CALL_DISPLAY_TIME || lastMissedCallReminderTime > 0) {
@@ -1275,7 +1947,7 @@ void loop() {
                 // Start showing reminder
                 if (DEBUG_CALLS) {
                     Serial.printf("[CALL] Showing missed call reminder: %s (%d times)\n", 
-                                  persistentMissedCall.callerName.c_str(), persistentMissedCall.count);
+                                  persistentMissedCall.callerName, persistentMissedCall.count);
                 }
                 displayMissedCall(persistentMissedCall.callerName, 
                                   persistentMissedCall.callerNumber, 
@@ -1291,6 +1963,16 @@ void loop() {
                 showingMissedCallReminder = false;
             }
         }
+        
+        // Next reminder step (fast-forward jumps straight to it)
+        if (showingMissedCallReminder) {
+            sys_clock_deadline(missedCallReminderStartTime + REMINDER_DISPLAY_TIME + 1);
+        } else if (lastMissedCallReminderTime > 0 ||
+                   currentTime - persistentMissedCall.firstMissedTime > INITIAL_MISSED_CALL_DISPLAY_TIME) {
+            sys_clock_deadline(lastMissedCallReminderTime + MISSED_CALL_REMINDER_INTERVAL + 1);
+        } else {
+            sys_clock_deadline(persistentMissedCall.firstMissedTime + INITIAL_MISSED_CALL_DISPLAY_TIME + 1);
+        }
     } else {
         // Reset reminder state if call was acknowledged
         showingMissedCallReminder = false;
@@ -1325,17 +2007,17 @@ void loop() {
         currentScreen != UI_SCREEN_NAVIGATION &&
         currentScreen != UI_SCREEN_IDLE &&
         currentScreen != UI_SCREEN_WELCOME) {
-        const bool dirValid = (currentDirection.length() > 0 && currentDirection != "straight" && currentDirection != "forward");
+        const bool dirValid = (currentDirection[0] != '\0' && strcmp(currentDirection, "straight") != 0 && strcmp(currentDirection, "forward") != 0);
         const bool distValid = (currentDistance > 0);
-        const bool manValid = (currentManeuver.length() > 0);
-        const bool etaValid = (currentETA.length() > 0);
+        const bool manValid = (currentManeuver[0] != '\0');
+        const bool etaValid = (currentETA[0] != '\0' || currentArrivalMs != 0);
         bool hasNavAuto = (dirValid || distValid || manValid || etaValid);
         if (hasNavAuto) {
             ui_show_screen(UI_SCREEN_NAVIGATION, 0);
-            if (dirValid) ui_navigation_screen_update_direction(currentDirection.c_str(), false);
+            if (dirValid) ui_navigation_screen_update_direction(currentDirection, false);
             if (currentDistance > 0) ui_navigation_screen_update_distance(currentDistance, false);
-            if (manValid) ui_navigation_screen_update_maneuver(currentManeuver.c_str());
-            if (etaValid) ui_navigation_screen_update_eta(currentETA.c_str());
+            if (manValid) ui_navigation_screen_update_maneuver(currentManeuver);
+            if (etaValid) showNavigationETA(currentETA, currentArrivalMs);
         } else {
             ui_show_screen(UI_SCREEN_IDLE, 0);
             ui_idle_screen_set_no_nav_msg(true);
@@ -1354,9 +2036,34 @@ void loop() {
         lastHeartbeat = millis();
     }
     
+    // Periodic UI performance report
+    static unsigned long lastPerfReport = 0;
+    if (millis() - lastPerfReport > PERF_REPORT_INTERVAL) {
+        ui_anim_log_stats();
+        ui_screens_log_stats();
+        ui_transition_log_stats();
+        ui_screens_log_memory();
+        alloc_guard_log_stats();
+        nav_estimator_log_stats();
+        frame_dedup_log_stats();
+        ble_frame_log_stats();
+        render_profiler_log_stats();
+        flight_recorder_log_stats();
+        sys_clock_log_stats();
+        caller_directory_log_stats();
+        phrase_dict_log_stats();
+        nav_lookahead_log_stats();
+        lastPerfReport = millis();
+    }
+    
+    // Acknowledge received frames (batched by count or age)
+    sendFrameAcks();
+    sendTelemetry();
+    sendFlightRecorderDump();
+    
     // Periodically check/advertise BLE if disconnected
     if (millis() - lastBleAdvertiseCheck > 5000 && !deviceConnected) {
-        if (BLEDevice::getInitialized()) {
+        if (bootStage == BOOT_STAGE_DONE && BLEDevice::getInitialized()) {
             // Try to restart advertising if it stopped
             BLEDevice::startAdvertising();
             Serial.println("[BLE] Restarting advertising (still not connected)");
@@ -1364,6 +2071,9 @@ void loop() {
         lastBleAdvertiseCheck = millis();
     }
     
+    // Fast-forward: skip to the next deadline noted above
+    sys_clock_tick();
+    
     // Minimal delay - LVGL needs frequent updates (5ms is good)
     delay(5);
 }
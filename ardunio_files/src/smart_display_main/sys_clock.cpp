@@ -0,0 +1,63 @@
+#include <Arduino.h>
+#include "sys_clock.h"
+
+// The offset is read from every task (and by LVGL); aligned 32-bit reads are atomic
+static volatile uint32_t offset_ms = 0;
+static volatile bool fast_forward = false;
+static portMUX_TYPE clock_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Earliest deadline noted since the last tick (UI task only)
+static bool deadline_noted = false;
+static uint32_t next_deadline_ms = 0;
+
+static uint32_t stat_jumps = 0;
+static uint32_t stat_advances = 0;
+
+uint32_t sys_clock_ms(void) {
+    return millis() + offset_ms;
+}
+
+void sys_clock_advance(uint32_t ms) {
+    portENTER_CRITICAL(&clock_mux);
+    offset_ms += ms;
+    stat_advances++;
+    portEXIT_CRITICAL(&clock_mux);
+}
+
+void sys_clock_set_fast_forward(bool on) {
+    if (on != fast_forward) {
+        Serial.printf("[CLOCK] Fast-forward %s (offset %lu ms)\n", on ? "on" : "off", offset_ms);
+    }
+    fast_forward = on;
+}
+
+bool sys_clock_fast_forward(void) {
+    return fast_forward;
+}
+
+void sys_clock_deadline(uint32_t at_ms) {
+    // Wrap-safe: the earliest deadline is the one closest ahead of now
+    uint32_t now = sys_clock_ms();
+    if (!deadline_noted || (int32_t)(at_ms - now) < (int32_t)(next_deadline_ms - now)) {
+        next_deadline_ms = at_ms;
+        deadline_noted = true;
+    }
+}
+
+void sys_clock_tick(void) {
+    if (!deadline_noted) return;
+    deadline_noted = false;
+    if (!fast_forward) return;
+
+    int32_t wait_ms = (int32_t)(next_deadline_ms - sys_clock_ms());
+    if (wait_ms <= 0) return;   // Already due; handled on the next pass
+    portENTER_CRITICAL(&clock_mux);
+    offset_ms += (uint32_t)wait_ms;
+    stat_jumps++;
+    portEXIT_CRITICAL(&clock_mux);
+}
+
+void sys_clock_log_stats(void) {
+    Serial.printf("[CLOCK] offset=%lu ms fast_forward=%d jumps=%lu advances=%lu\n",
+                  offset_ms, fast_forward, stat_jumps, stat_advances);
+}
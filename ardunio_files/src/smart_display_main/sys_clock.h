@@ -0,0 +1,64 @@
+#ifndef SYS_CLOCK_H
+#define SYS_CLOCK_H
+
+// Firmware clock: millis() plus a virtual offset that only moves forward.
+// Also LVGL's tick source (LV_TICK_CUSTOM_SYS_TIME_EXPR) - keep it C.
+//
+// Behavior timing (call timeouts, missed-call reminders, navigation and ETA
+// times) reads this clock; transport and measurement timing (acks, dedup,
+// telemetry, profiling) stays on millis().
+//
+// Fast-forward: code waiting for a time notes it with sys_clock_deadline()
+// each loop; sys_clock_tick() at the end of the loop then jumps the clock to
+// the earliest one. Every deadline is still reached exactly, in order, so an
+// hour of reminders plays out in seconds with the same screens and logs.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Current time in ms (millis() + virtual offset)
+ */
+uint32_t sys_clock_ms(void);
+
+/**
+ * Move the clock forward (safe from any task)
+ */
+void sys_clock_advance(uint32_t ms);
+
+/**
+ * Turn fast-forward on or off (safe from any task)
+ */
+void sys_clock_set_fast_forward(bool on);
+
+/**
+ * Check if fast-forward is on
+ */
+bool sys_clock_fast_forward(void);
+
+/**
+ * Note a time something is waiting for (UI task, before sys_clock_tick())
+ * @param at_ms First sys_clock_ms() value at which the wait is over
+ */
+void sys_clock_deadline(uint32_t at_ms);
+
+/**
+ * End of a loop pass: with fast-forward on, jump to the earliest deadline
+ * noted since the last tick (UI task)
+ */
+void sys_clock_tick(void);
+
+/**
+ * Print offset and jump counters over serial
+ */
+void sys_clock_log_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYS_CLOCK_H
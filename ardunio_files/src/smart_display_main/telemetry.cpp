@@ -0,0 +1,108 @@
+#include <Arduino.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "telemetry.h"
+#include "ble_frame.h"
+#include "lv_mem_pool.h"
+
+static_assert(TELEMETRY_RECORD_LEN == 34, "telemetry record layout changed - bump TELEMETRY_VERSION");
+
+// Set from the BLE task, read by loop()
+static volatile bool enabled = false;
+static volatile int8_t last_rssi = 0;
+static uint16_t period_ms = TELEMETRY_DEFAULT_PERIOD_MS;
+
+// Current period (UI task only)
+static uint32_t period_start_ms = 0;
+static uint32_t frames = 0;
+static uint32_t handler_calls = 0;
+static uint32_t handler_sum_us = 0;
+static uint32_t handler_max_us = 0;
+static uint32_t flush_bytes = 0;
+static bool frame_flushed = false;
+static uint32_t dropped_at_period_start = 0;
+
+static void start_period(uint32_t now_ms) {
+    period_start_ms = now_ms;
+    frames = 0;
+    handler_calls = 0;
+    handler_sum_us = 0;
+    handler_max_us = 0;
+    flush_bytes = 0;
+    dropped_at_period_start = ble_frame_dropped_total();
+}
+
+static uint16_t saturate16(uint32_t v) {
+    return v > 0xFFFF ? 0xFFFF : (uint16_t)v;
+}
+
+void telemetry_set_enabled(bool on) {
+    if (on && !enabled) {
+        start_period(millis());
+    }
+    enabled = on;
+    Serial.printf("[TELEMETRY] %s (period %u ms)\n", on ? "Subscribed" : "Unsubscribed", period_ms);
+}
+
+bool telemetry_enabled(void) {
+    return enabled;
+}
+
+void telemetry_set_period(uint16_t ms) {
+    if (ms < TELEMETRY_MIN_PERIOD_MS) ms = TELEMETRY_MIN_PERIOD_MS;
+    if (ms > TELEMETRY_MAX_PERIOD_MS) ms = TELEMETRY_MAX_PERIOD_MS;
+    period_ms = ms;
+    Serial.printf("[TELEMETRY] Period set to %u ms\n", period_ms);
+}
+
+void telemetry_record_handler(uint32_t us) {
+    if (!enabled) return;
+    handler_calls++;
+    handler_sum_us += us;
+    if (us > handler_max_us) handler_max_us = us;
+    if (frame_flushed) {
+        frames++;
+        frame_flushed = false;
+    }
+}
+
+void telemetry_record_flush(uint32_t bytes, bool last) {
+    if (!enabled) return;
+    flush_bytes += bytes;
+    if (last) frame_flushed = true;
+}
+
+void telemetry_set_rssi(int8_t rssi) {
+    last_rssi = rssi;
+}
+
+bool telemetry_due(uint32_t now_ms) {
+    return enabled && now_ms - period_start_ms >= period_ms;
+}
+
+bool telemetry_build(telemetry_record_t *record, uint8_t flags, uint32_t now_ms) {
+    if (!enabled) return false;
+
+    lv_mem_pool_stats_t pool;
+    lv_mem_pool_get_stats(&pool);
+    uint32_t dropped = ble_frame_dropped_total() - dropped_at_period_start;
+
+    memset(record, 0, sizeof(*record));
+    record->version = TELEMETRY_VERSION;
+    record->flags = flags;
+    record->period_ms = saturate16(now_ms - period_start_ms);
+    record->uptime_ms = now_ms;
+    record->frames = saturate16(frames);
+    record->handler_avg_us = saturate16(handler_calls ? handler_sum_us / handler_calls : 0);
+    record->handler_max_us = saturate16(handler_max_us);
+    record->flush_bytes = flush_bytes;
+    record->ack_backlog = (uint8_t)(ble_frame_ack_backlog() > 0xFF ? 0xFF : ble_frame_ack_backlog());
+    record->dropped_frames = (uint8_t)(dropped > 0xFF ? 0xFF : dropped);
+    record->lvgl_used = pool.live_bytes;
+    record->lvgl_largest_free = pool.largest_free;
+    record->heap_internal_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    record->rssi = last_rssi;
+
+    start_period(now_ms);
+    return true;
+}
@@ -0,0 +1,96 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Performance telemetry over BLE
+// A fixed binary record is notified on the telemetry characteristic once per
+// period while the phone is subscribed. Unsubscribed, the recording hooks
+// return after a single flag test and nothing is sampled or sent.
+//
+// Record (little-endian, TELEMETRY_RECORD_LEN bytes):
+//   [version] [flags] [period ms:2] [uptime ms:4]
+//   [frames:2] [handler avg us:2] [handler max us:2] [flush bytes:4]
+//   [ack backlog] [dropped frames] [lvgl used:4] [lvgl largest free:4]
+//   [internal heap free:4] [rssi dBm (signed, 0 = unknown)] [reserved]
+// Counters (frames, handler times, flush bytes, dropped) cover one period.
+// ============================================================================
+
+#define TELEMETRY_VERSION            1
+#define TELEMETRY_DEFAULT_PERIOD_MS  1000
+#define TELEMETRY_MIN_PERIOD_MS      200
+#define TELEMETRY_MAX_PERIOD_MS      60000
+
+// Record flags
+#define TELEMETRY_FLAG_NAV_SCREEN    0x01   // Navigation screen is showing
+#define TELEMETRY_FLAG_CALL          0x02   // A call screen is showing
+
+typedef struct __attribute__((packed)) {
+    uint8_t version;
+    uint8_t flags;
+    uint16_t period_ms;
+    uint32_t uptime_ms;
+    uint16_t frames;                 // lv_timer_handler() calls that flushed pixels
+    uint16_t handler_avg_us;         // Over all lv_timer_handler() calls (saturates)
+    uint16_t handler_max_us;
+    uint32_t flush_bytes;
+    uint8_t ack_backlog;             // Received frames not yet acknowledged
+    uint8_t dropped_frames;          // Stale, duplicate, malformed or aborted BLE frames
+    uint32_t lvgl_used;
+    uint32_t lvgl_largest_free;
+    uint32_t heap_internal_free;
+    int8_t rssi;
+    uint8_t reserved;
+} telemetry_record_t;
+
+#define TELEMETRY_RECORD_LEN sizeof(telemetry_record_t)
+
+/**
+ * Start or stop sampling (the phone wrote the telemetry CCCD, or disconnected)
+ */
+void telemetry_set_enabled(bool enabled);
+
+/**
+ * Check if a subscriber wants telemetry
+ */
+bool telemetry_enabled(void);
+
+/**
+ * Set the reporting period (clamped to TELEMETRY_MIN/MAX_PERIOD_MS)
+ */
+void telemetry_set_period(uint16_t period_ms);
+
+/**
+ * Record one lv_timer_handler() call (UI task)
+ * @param us Duration of the call
+ */
+void telemetry_record_handler(uint32_t us);
+
+/**
+ * Record one flushed area (display flush callback)
+ * @param bytes Pixel bytes sent to the panel
+ * @param last True for the last area of a frame
+ */
+void telemetry_record_flush(uint32_t bytes, bool last);
+
+/**
+ * Latest RSSI reading of the connection (GAP callback)
+ */
+void telemetry_set_rssi(int8_t rssi);
+
+/**
+ * Check if a record should be sent now
+ * @param now_ms Current time (millis())
+ */
+bool telemetry_due(uint32_t now_ms);
+
+/**
+ * Sample the gauges, fill a record and start the next period
+ * @param flags TELEMETRY_FLAG_* describing the UI state
+ * @return false if telemetry is disabled
+ */
+bool telemetry_build(telemetry_record_t *record, uint8_t flags, uint32_t now_ms);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,362 @@
+#include <Arduino.h>
+#include "ui_anim.h"
+#include <string.h>
+
+// One slot per animated object
+typedef struct {
+    lv_obj_t *obj;
+    lv_obj_t *screen;              // Screen the object lives on (for unload cancel)
+    ui_anim_exec_cb_t exec_cb;
+    uint32_t last_frame;           // Frame of the last applied value
+    uint32_t area;                 // Pixels one update invalidates
+    int32_t pending_value;         // Value held back by the area budget
+    bool has_pending;
+    bool used;
+} ui_anim_slot_t;
+
+// Start/stop request posted from a non-UI task (BLE callbacks)
+typedef struct {
+    lv_obj_t *obj;
+    ui_anim_exec_cb_t exec_cb;
+    ui_anim_get_cb_t get_cb;       // Reads the start value when set (from is ignored)
+    int32_t from;
+    int32_t to;
+    uint32_t time;
+    uint32_t playback_time;
+    uint16_t repeat_count;
+    bool stop;
+} ui_anim_request_t;
+
+static ui_anim_slot_t slots[UI_ANIM_MAX_SLOTS];
+
+static ui_anim_request_t requests[UI_ANIM_MAX_REQUESTS];
+static uint8_t request_count = 0;
+static portMUX_TYPE request_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Task that owns LVGL (set in ui_anim_init)
+static TaskHandle_t ui_task = nullptr;
+static uint32_t frame_counter = 0;
+static uint32_t frame_area = 0;    // Pixels animations invalidated this frame
+
+// Statistics
+static uint32_t stat_started = 0;
+static uint32_t stat_cancelled = 0;
+static uint32_t stat_stale = 0;
+static uint32_t stat_deferred = 0;
+static uint32_t stat_dropped_requests = 0;
+static uint32_t stat_peak_frame_area = 0;
+static uint32_t stat_over_budget = 0;
+
+static bool on_ui_task(void) {
+    return ui_task == nullptr || xTaskGetCurrentTaskHandle() == ui_task;
+}
+
+static ui_anim_slot_t *find_slot(lv_obj_t *obj) {
+    for (int i = 0; i < UI_ANIM_MAX_SLOTS; i++) {
+        if (slots[i].used && slots[i].obj == obj) return &slots[i];
+    }
+    return nullptr;
+}
+
+static ui_anim_slot_t *alloc_slot(void) {
+    for (int i = 0; i < UI_ANIM_MAX_SLOTS; i++) {
+        if (!slots[i].used) return &slots[i];
+    }
+    return nullptr;
+}
+
+static void release_slot(ui_anim_slot_t *slot) {
+    memset(slot, 0, sizeof(*slot));
+}
+
+// Area an object invalidates when it changes (including shadow/arc overhang)
+static uint32_t obj_invalidated_area(lv_obj_t *obj) {
+    lv_coord_t ext = _lv_obj_get_ext_draw_size(obj);
+    uint32_t w = lv_obj_get_width(obj) + 2 * ext;
+    uint32_t h = lv_obj_get_height(obj) + 2 * ext;
+    return w * h;
+}
+
+// Apply a value, charging the frame budget unless the object already
+// changed this frame (its area is already queued for redraw)
+static void apply_value(ui_anim_slot_t *slot, int32_t value) {
+    if (slot->last_frame != frame_counter) {
+        // Only an object larger than the whole budget may exceed it, and only alone
+        if (frame_area > 0 && frame_area + slot->area > UI_ANIM_MAX_AREA_PER_FRAME) stat_over_budget++;
+        frame_area += slot->area;
+        if (frame_area > stat_peak_frame_area) stat_peak_frame_area = frame_area;
+        slot->last_frame = frame_counter;
+    }
+    slot->has_pending = false;
+    slot->exec_cb(slot->obj, value);
+}
+
+// Fits this frame's budget? An object larger than the whole budget gets a
+// frame to itself so it still moves.
+static bool fits_budget(const ui_anim_slot_t *slot) {
+    if (slot->last_frame == frame_counter) return true;
+    return frame_area == 0 || frame_area + slot->area <= UI_ANIM_MAX_AREA_PER_FRAME;
+}
+
+// Spend a fresh budget on last frame's deferred updates, longest waiting first
+static void apply_deferred(void) {
+    for (;;) {
+        ui_anim_slot_t *oldest = nullptr;
+        for (int i = 0; i < UI_ANIM_MAX_SLOTS; i++) {
+            ui_anim_slot_t *slot = &slots[i];
+            if (!slot->used || !slot->has_pending || slot->last_frame == frame_counter) continue;
+            if (oldest == nullptr || (frame_counter - slot->last_frame) > (frame_counter - oldest->last_frame)) {
+                oldest = slot;
+            }
+        }
+        if (oldest == nullptr || !fits_budget(oldest)) return;
+        apply_value(oldest, oldest->pending_value);
+    }
+}
+
+// All animations run through here so a deleted object is never touched
+static void anim_exec_trampoline(void *var, int32_t value) {
+    lv_obj_t *obj = (lv_obj_t *)var;
+    ui_anim_slot_t *slot = find_slot(obj);
+    if (slot == nullptr || slot->exec_cb == nullptr) {
+        stat_stale++;
+        lv_anim_del(var, anim_exec_trampoline);
+        return;
+    }
+
+    // Animations share UI_ANIM_MAX_AREA_PER_FRAME; past it the value waits
+    // for the next frame (ui_anim_frame_begin applies it first)
+    slot->area = obj_invalidated_area(obj);
+    if (!fits_budget(slot)) {
+        slot->pending_value = value;
+        slot->has_pending = true;
+        stat_deferred++;
+        return;
+    }
+    apply_value(slot, value);
+}
+
+static void anim_ready_trampoline(lv_anim_t *a) {
+    ui_anim_slot_t *slot = find_slot((lv_obj_t *)a->var);
+    if (slot == nullptr) return;
+    // Make sure the final value lands even if it was deferred
+    if (slot->has_pending && slot->exec_cb) {
+        slot->exec_cb(slot->obj, slot->pending_value);
+    }
+    release_slot(slot);
+}
+
+static void obj_delete_event_cb(lv_event_t *e) {
+    lv_obj_t *obj = lv_event_get_target(e);
+    ui_anim_slot_t *slot = find_slot(obj);
+    if (slot) {
+        lv_anim_del(obj, anim_exec_trampoline);
+        release_slot(slot);
+        stat_cancelled++;
+    }
+}
+
+static void screen_unloaded_event_cb(lv_event_t *e) {
+    ui_anim_cancel_screen(lv_event_get_target(e));
+}
+
+static void stop_now(lv_obj_t *obj) {
+    ui_anim_slot_t *slot = find_slot(obj);
+    if (slot == nullptr) return;
+    lv_anim_del(obj, anim_exec_trampoline);
+    release_slot(slot);
+}
+
+static bool start_now(const ui_anim_request_t *req) {
+    if (req->obj == nullptr || !lv_obj_is_valid(req->obj)) {
+        stat_stale++;
+        return false;
+    }
+
+    ui_anim_slot_t *slot = find_slot(req->obj);
+    if (slot) {
+        // Restart replaces the running animation for this object
+        lv_anim_del(req->obj, anim_exec_trampoline);
+        release_slot(slot);
+    } else {
+        slot = alloc_slot();
+        if (slot == nullptr) {
+            Serial.println("[ANIM] Warning: no free animation slot");
+            return false;
+        }
+    }
+
+    slot->used = true;
+    slot->obj = req->obj;
+    slot->screen = lv_obj_get_screen(req->obj);
+    slot->exec_cb = req->exec_cb;
+    slot->last_frame = frame_counter - 1;
+    slot->area = obj_invalidated_area(req->obj);
+
+    // Tie the slot to the object's lifetime (remove first so hooks never stack)
+    lv_obj_remove_event_cb(req->obj, obj_delete_event_cb);
+    lv_obj_add_event_cb(req->obj, obj_delete_event_cb, LV_EVENT_DELETE, nullptr);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, req->obj);
+    lv_anim_set_values(&a, req->get_cb ? req->get_cb(req->obj) : req->from, req->to);
+    lv_anim_set_time(&a, req->time);
+    lv_anim_set_playback_time(&a, req->playback_time);
+    lv_anim_set_repeat_count(&a, req->repeat_count);
+    lv_anim_set_exec_cb(&a, anim_exec_trampoline);
+    lv_anim_set_ready_cb(&a, anim_ready_trampoline);
+    lv_anim_start(&a);
+
+    stat_started++;
+    return true;
+}
+
+static bool post_request(const ui_anim_request_t *req) {
+    bool queued = false;
+    portENTER_CRITICAL(&request_mux);
+    // Collapse with a queued request for the same object
+    for (uint8_t i = 0; i < request_count; i++) {
+        if (requests[i].obj == req->obj) {
+            requests[i] = *req;
+            queued = true;
+            break;
+        }
+    }
+    if (!queued && request_count < UI_ANIM_MAX_REQUESTS) {
+        requests[request_count++] = *req;
+        queued = true;
+    }
+    if (!queued) stat_dropped_requests++;
+    portEXIT_CRITICAL(&request_mux);
+    return queued;
+}
+
+void ui_anim_init(void) {
+    memset(slots, 0, sizeof(slots));
+    request_count = 0;
+    ui_task = xTaskGetCurrentTaskHandle();
+    Serial.println("[ANIM] Animation service initialized");
+}
+
+void ui_anim_frame_begin(void) {
+    frame_counter++;
+    frame_area = 0;
+
+    ui_anim_request_t pending[UI_ANIM_MAX_REQUESTS];
+    uint8_t count;
+    portENTER_CRITICAL(&request_mux);
+    count = request_count;
+    memcpy(pending, requests, count * sizeof(ui_anim_request_t));
+    request_count = 0;
+    portEXIT_CRITICAL(&request_mux);
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (pending[i].stop) {
+            stop_now(pending[i].obj);
+        } else {
+            start_now(&pending[i]);
+        }
+    }
+
+    apply_deferred();
+}
+
+bool ui_anim_start(lv_obj_t *obj, ui_anim_exec_cb_t exec_cb, int32_t from, int32_t to,
+                   uint32_t time, uint32_t playback_time, uint16_t repeat_count) {
+    if (obj == nullptr || exec_cb == nullptr) return false;
+
+    ui_anim_request_t req;
+    req.obj = obj;
+    req.exec_cb = exec_cb;
+    req.get_cb = nullptr;
+    req.from = from;
+    req.to = to;
+    req.time = time;
+    req.playback_time = playback_time;
+    req.repeat_count = repeat_count;
+    req.stop = false;
+
+    if (!on_ui_task()) {
+        return post_request(&req);
+    }
+    return start_now(&req);
+}
+
+bool ui_anim_start_from(lv_obj_t *obj, ui_anim_get_cb_t get_cb, ui_anim_exec_cb_t exec_cb, int32_t to,
+                        uint32_t time, uint32_t playback_time, uint16_t repeat_count) {
+    if (obj == nullptr || get_cb == nullptr || exec_cb == nullptr) return false;
+
+    ui_anim_request_t req;
+    req.obj = obj;
+    req.exec_cb = exec_cb;
+    req.get_cb = get_cb;
+    req.from = 0;
+    req.to = to;
+    req.time = time;
+    req.playback_time = playback_time;
+    req.repeat_count = repeat_count;
+    req.stop = false;
+
+    if (!on_ui_task()) {
+        return post_request(&req);
+    }
+    return start_now(&req);
+}
+
+void ui_anim_stop(lv_obj_t *obj) {
+    if (obj == nullptr) return;
+
+    if (!on_ui_task()) {
+        ui_anim_request_t req;
+        memset(&req, 0, sizeof(req));
+        req.obj = obj;
+        req.stop = true;
+        post_request(&req);
+        return;
+    }
+    stop_now(obj);
+}
+
+void ui_anim_cancel_screen(lv_obj_t *screen) {
+    if (screen == nullptr) return;
+    for (int i = 0; i < UI_ANIM_MAX_SLOTS; i++) {
+        if (slots[i].used && slots[i].screen == screen) {
+            lv_anim_del(slots[i].obj, anim_exec_trampoline);
+            release_slot(&slots[i]);
+            stat_cancelled++;
+        }
+    }
+}
+
+void ui_anim_bind_screen(lv_obj_t *screen) {
+    if (screen == nullptr) return;
+    lv_obj_add_event_cb(screen, screen_unloaded_event_cb, LV_EVENT_SCREEN_UNLOADED, nullptr);
+}
+
+uint8_t ui_anim_active_count(void) {
+    uint8_t count = 0;
+    for (int i = 0; i < UI_ANIM_MAX_SLOTS; i++) {
+        if (slots[i].used) count++;
+    }
+    return count;
+}
+
+void ui_anim_get_stats(ui_anim_stats_t *stats) {
+    stats->active = ui_anim_active_count();
+    stats->started = stat_started;
+    stats->cancelled = stat_cancelled;
+    stats->stale = stat_stale;
+    stats->deferred = stat_deferred;
+    stats->dropped_requests = stat_dropped_requests;
+    stats->peak_frame_area = stat_peak_frame_area;
+    stats->over_budget = stat_over_budget;
+}
+
+void ui_anim_log_stats(void) {
+    Serial.printf("[ANIM] active=%u started=%lu cancelled=%lu stale=%lu deferred=%lu dropped=%lu "
+                  "peak_frame_px=%lu/%d over_budget=%lu\n",
+                  ui_anim_active_count(), stat_started, stat_cancelled, stat_stale, stat_deferred,
+                  stat_dropped_requests, stat_peak_frame_area, UI_ANIM_MAX_AREA_PER_FRAME,
+                  stat_over_budget);
+}
@@ -0,0 +1,111 @@
+#ifndef UI_ANIM_H
+#define UI_ANIM_H
+
+#include <lvgl.h>
+
+// ============================================================================
+// Animation Service Limits
+// ============================================================================
+
+#define UI_ANIM_MAX_SLOTS            8           // Concurrently animated objects
+#define UI_ANIM_MAX_REQUESTS         8           // Pending requests from other tasks
+#define UI_ANIM_MAX_AREA_PER_FRAME   (128 * 128) // Pixels all animations may invalidate per frame
+
+/**
+ * Animation service counters (ui_anim_get_stats)
+ */
+typedef struct {
+    uint8_t active;                  // Running animations
+    uint32_t started;
+    uint32_t cancelled;              // By object delete or screen unload
+    uint32_t stale;                  // Callbacks for objects without a slot (ignored)
+    uint32_t deferred;               // Updates held back by the frame budget
+    uint32_t dropped_requests;       // Cross-task requests lost to a full queue
+    uint32_t peak_frame_area;        // Most pixels animations invalidated in one frame
+    uint32_t over_budget;            // Updates that pushed a shared frame past the budget (stays 0)
+} ui_anim_stats_t;
+
+/**
+ * Animation exec callback
+ * @param obj Animated object (always alive when called)
+ * @param value Current animation value
+ */
+typedef void (*ui_anim_exec_cb_t)(lv_obj_t *obj, int32_t value);
+
+/**
+ * Animation start value callback (ui_anim_start_from)
+ * @param obj Animated object (always alive when called, on the UI task)
+ * @return Current value
+ */
+typedef int32_t (*ui_anim_get_cb_t)(lv_obj_t *obj);
+
+/**
+ * Initialize animation service
+ * Must be called from the UI task (the task running lv_timer_handler)
+ */
+void ui_anim_init(void);
+
+/**
+ * Start of a UI frame
+ * Applies requests posted from other tasks, resets the frame's area budget
+ * and spends it on updates deferred last frame (longest waiting first).
+ * Call from loop() right before lv_timer_handler().
+ */
+void ui_anim_frame_begin(void);
+
+/**
+ * Start (or restart) an animation bound to an object's lifetime
+ * Safe to call from any task - requests from other tasks are applied
+ * at the start of the next UI frame.
+ * @param obj Object to animate
+ * @param exec_cb Callback applying the value
+ * @param from Start value
+ * @param to End value
+ * @param time Duration in milliseconds
+ * @param playback_time Reverse duration in milliseconds (0 = no playback)
+ * @param repeat_count Repeat count (LV_ANIM_REPEAT_INFINITE for endless)
+ * @return True if started or queued
+ */
+bool ui_anim_start(lv_obj_t *obj, ui_anim_exec_cb_t exec_cb, int32_t from, int32_t to,
+                   uint32_t time, uint32_t playback_time, uint16_t repeat_count);
+
+/**
+ * Start an animation from the object's current value
+ * Like ui_anim_start(), but the start value is read with get_cb when the
+ * animation starts on the UI task, so other tasks never read LVGL state.
+ * @return True if started or queued
+ */
+bool ui_anim_start_from(lv_obj_t *obj, ui_anim_get_cb_t get_cb, ui_anim_exec_cb_t exec_cb, int32_t to,
+                        uint32_t time, uint32_t playback_time, uint16_t repeat_count);
+
+/**
+ * Stop the animation bound to an object (no-op if none)
+ */
+void ui_anim_stop(lv_obj_t *obj);
+
+/**
+ * Cancel every animation whose object lives on the given screen
+ */
+void ui_anim_cancel_screen(lv_obj_t *screen);
+
+/**
+ * Auto-cancel animations when this screen is unloaded
+ */
+void ui_anim_bind_screen(lv_obj_t *screen);
+
+/**
+ * Number of running animations
+ */
+uint8_t ui_anim_active_count(void);
+
+/**
+ * Get animation service counters
+ */
+void ui_anim_get_stats(ui_anim_stats_t *stats);
+
+/**
+ * Print animation statistics over serial
+ */
+void ui_anim_log_stats(void);
+
+#endif // UI_ANIM_H
@@ -0,0 +1,194 @@
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include "ui_format.h"
+
+// Output cursor (keeps room for the terminating NUL)
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t len;
+} fmt_out_t;
+
+static void out_begin(fmt_out_t *o, char *buf, size_t size) {
+    o->buf = buf;
+    o->size = size;
+    o->len = 0;
+    if (buf && size > 0) buf[0] = '\0';
+}
+
+static void out_char(fmt_out_t *o, char c) {
+    if (o->buf == nullptr || o->len + 1 >= o->size) return;
+    o->buf[o->len++] = c;
+    o->buf[o->len] = '\0';
+}
+
+static void out_str(fmt_out_t *o, const char *s) {
+    while (*s) out_char(o, *s++);
+}
+
+// Decimal digits, zero-padded to at least min_digits
+static void out_uint(fmt_out_t *o, uint32_t value, uint8_t min_digits) {
+    char tmp[10];
+    uint8_t n = 0;
+    do {
+        tmp[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (n < min_digits && n < sizeof(tmp)) tmp[n++] = '0';
+    while (n > 0) out_char(o, tmp[--n]);
+}
+
+static const uint32_t pow10_table[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+static void out_fixed(fmt_out_t *o, int32_t value, uint8_t decimals) {
+    if (decimals > 9) decimals = 9;
+    uint32_t magnitude = value < 0 ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+    if (value < 0) out_char(o, '-');
+    out_uint(o, magnitude / pow10_table[decimals], 1);
+    if (decimals > 0) {
+        out_char(o, '.');
+        out_uint(o, magnitude % pow10_table[decimals], decimals);
+    }
+}
+
+size_t ui_format_uint(char *buf, size_t size, uint32_t value) {
+    fmt_out_t o;
+    out_begin(&o, buf, size);
+    out_uint(&o, value, 1);
+    return o.len;
+}
+
+size_t ui_format_int(char *buf, size_t size, int32_t value) {
+    return ui_format_fixed(buf, size, value, 0);
+}
+
+size_t ui_format_fixed(char *buf, size_t size, int32_t value, uint8_t decimals) {
+    fmt_out_t o;
+    out_begin(&o, buf, size);
+    out_fixed(&o, value, decimals);
+    return o.len;
+}
+
+size_t ui_format_distance(char *buf, size_t size, int32_t meters, UIDistanceUnits units) {
+    fmt_out_t o;
+    out_begin(&o, buf, size);
+    if (meters <= 0) return 0;
+
+    if (units == UI_UNITS_IMPERIAL) {
+        // 1 m = 3.2808 ft; 1 mi = 1609.344 m
+        uint64_t feet = ((uint64_t)meters * 32808 + 5000) / 10000;
+        uint64_t feet_rounded = (feet + 5) / 10 * 10;
+        if (feet_rounded < 10) feet_rounded = 10;  // Never "0 ft" for a distance left
+        if (feet_rounded < 1000) {
+            out_uint(&o, (uint32_t)feet_rounded, 1);
+            out_str(&o, " ft");
+        } else {
+            uint32_t tenths_mi = (uint32_t)(((uint64_t)meters * 10000 + 804672) / 1609344);
+            out_fixed(&o, (int32_t)tenths_mi, 1);
+            out_str(&o, " mi");
+        }
+    } else {
+        if (meters < 1000) {
+            out_uint(&o, (uint32_t)meters, 1);
+            out_str(&o, " m");
+        } else {
+            out_fixed(&o, (int32_t)(((uint32_t)meters + 50) / 100), 1);
+            out_str(&o, " km");
+        }
+    }
+    return o.len;
+}
+
+size_t ui_format_mmss(char *buf, size_t size, uint32_t seconds) {
+    fmt_out_t o;
+    out_begin(&o, buf, size);
+    out_uint(&o, seconds / 60, 2);
+    out_char(&o, ':');
+    out_uint(&o, seconds % 60, 2);
+    return o.len;
+}
+
+size_t ui_format_eta(char *buf, size_t size, uint32_t seconds) {
+    fmt_out_t o;
+    out_begin(&o, buf, size);
+    uint32_t minutes = seconds / 60;
+    if (minutes < 1) {
+        out_str(&o, "< 1 min");
+    } else if (minutes < 60) {
+        out_uint(&o, minutes, 1);
+        out_str(&o, " min");
+    } else {
+        out_uint(&o, minutes / 60, 1);
+        out_char(&o, 'h');
+        if (minutes % 60 != 0) {
+            out_char(&o, ' ');
+            out_uint(&o, minutes % 60, 1);
+            out_char(&o, 'm');
+        }
+    }
+    return o.len;
+}
+
+void ui_format_benchmark(void) {
+    const int iterations = 2000;
+    char a[24];
+    char b[24];
+    volatile size_t sink = 0;
+
+    // Distances sweep the m/km switch and every km decimal
+    uint32_t start_us = micros();
+    for (int i = 0; i < iterations; i++) {
+        int32_t d = 1 + i * 7;
+        sink += ui_format_distance(a, sizeof(a), d, UI_UNITS_METRIC);
+    }
+    uint32_t fmt_us = micros() - start_us;
+
+    start_us = micros();
+    for (int i = 0; i < iterations; i++) {
+        int32_t d = 1 + i * 7;
+        if (d >= 1000) {
+            sink += snprintf(b, sizeof(b), "%.1f km", d / 1000.0f);
+        } else {
+            sink += snprintf(b, sizeof(b), "%d m", (int)d);
+        }
+    }
+    uint32_t printf_us = micros() - start_us;
+
+    // Output check (snprintf rounds half-to-even on binary floats, so
+    // exact .x5 km values may differ by one tenth)
+    int mismatches = 0;
+    for (int i = 0; i < iterations; i++) {
+        int32_t d = 1 + i * 7;
+        ui_format_distance(a, sizeof(a), d, UI_UNITS_METRIC);
+        if (d >= 1000) {
+            snprintf(b, sizeof(b), "%.1f km", d / 1000.0f);
+        } else {
+            snprintf(b, sizeof(b), "%d m", (int)d);
+        }
+        if (strcmp(a, b) != 0) mismatches++;
+    }
+
+    Serial.printf("[FORMAT] distance x%d: ui_format=%luus snprintf=%luus (%lu.%02lux) mismatches=%d\n",
+                  iterations, fmt_us, printf_us,
+                  fmt_us ? printf_us / fmt_us : 0, fmt_us ? (printf_us * 100 / fmt_us) % 100 : 0,
+                  mismatches);
+
+    start_us = micros();
+    for (int i = 0; i < iterations; i++) {
+        sink += ui_format_mmss(a, sizeof(a), i * 3);
+    }
+    fmt_us = micros() - start_us;
+
+    start_us = micros();
+    for (int i = 0; i < iterations; i++) {
+        int s = i * 3;
+        sink += snprintf(b, sizeof(b), "%02d:%02d", s / 60, s % 60);
+    }
+    printf_us = micros() - start_us;
+
+    Serial.printf("[FORMAT] mm:ss x%d: ui_format=%luus snprintf=%luus\n", iterations, fmt_us, printf_us);
+    (void)sink;
+}
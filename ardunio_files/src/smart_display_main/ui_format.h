@@ -0,0 +1,64 @@
+#ifndef UI_FORMAT_H
+#define UI_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Integer/fixed-point text formatting for labels
+// No float math, no printf and no heap. Every function writes into the
+// caller's buffer (always NUL-terminated, truncated to fit) and returns the
+// length written. Pair with lv_label_set_text_static on a per-label buffer.
+// ============================================================================
+
+/**
+ * Distance unit policy
+ */
+enum UIDistanceUnits {
+    UI_UNITS_METRIC = 0,         // "450 m", "1.2 km"
+    UI_UNITS_IMPERIAL            // "350 ft", "0.4 mi"
+};
+
+/**
+ * Format an unsigned integer ("1234")
+ */
+size_t ui_format_uint(char *buf, size_t size, uint32_t value);
+
+/**
+ * Format a signed integer ("-12")
+ */
+size_t ui_format_int(char *buf, size_t size, int32_t value);
+
+/**
+ * Format a fixed-point value
+ * @param value Value scaled by 10^decimals (e.g. 12 with 1 decimal -> "1.2")
+ * @param decimals Digits after the point (0-9)
+ */
+size_t ui_format_fixed(char *buf, size_t size, int32_t value, uint8_t decimals);
+
+/**
+ * Format a distance with its unit
+ * Metric: meters below 1 km, then km with one decimal.
+ * Imperial: feet (rounded to 10 ft, at least 10 ft) below 1000 ft, then miles
+ * with one decimal.
+ * @param meters Distance in meters (<= 0 gives an empty string)
+ */
+size_t ui_format_distance(char *buf, size_t size, int32_t meters, UIDistanceUnits units);
+
+/**
+ * Format a duration as mm:ss ("03:07"; minutes grow past 99 as needed)
+ */
+size_t ui_format_mmss(char *buf, size_t size, uint32_t seconds);
+
+/**
+ * Format a remaining time as an ETA, matching the phone's wording
+ * ("< 1 min", "12 min", "1h", "1h 15m"; whole minutes, rounded down)
+ */
+size_t ui_format_eta(char *buf, size_t size, uint32_t seconds);
+
+/**
+ * Compare ui_format against snprintf over serial (timing and output mismatches)
+ */
+void ui_format_benchmark(void);
+
+#endif // UI_FORMAT_H
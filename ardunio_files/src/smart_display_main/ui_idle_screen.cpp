@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include "ui_idle_screen.h"
 #include "ui_theme.h"
+#include "ui_anim.h"
 
 // UI element references
 static lv_obj_t *label_title = nullptr;
@@ -22,13 +23,9 @@ static lv_style_t style_status;
 static lv_style_t style_instruction;
 static lv_style_t style_ready_dot;
 
-// Animation for pulsing indicator
-static lv_anim_t pulse_anim;
-
-// Animation callback for pulse
-static void pulse_anim_cb(void *var, int32_t value) {
-    if (var == nullptr) return;
-    lv_obj_set_style_opa((lv_obj_t*)var, value, LV_PART_MAIN);
+// Animation callback for pulse (driven by ui_anim)
+static void pulse_anim_cb(lv_obj_t *obj, int32_t value) {
+    lv_obj_set_style_bg_opa(obj, (lv_opa_t)value, LV_PART_MAIN);
 }
 
 // Track if styles are initialized
@@ -122,7 +119,7 @@ void ui_idle_screen_update_ble_status(bool connected) {
         return;
     }
     if (label_status && status_bar) {
-        lv_label_set_text(label_status, "Connected");
+        lv_label_set_text_static(label_status, "Connected");
         lv_obj_set_style_bg_color(status_bar, lv_color_hex(0x1E824C), 0);
     }
     // Optional indicator dot
@@ -147,29 +144,24 @@ void ui_idle_screen_start_pulse() {
         lv_obj_set_style_bg_opa(indicator_ready, LV_OPA_50, 0);
     }
     if (!lv_obj_is_valid(indicator_ready)) return;
-    lv_anim_t a; lv_anim_init(&a);
-    lv_anim_set_var(&a, indicator_ready);
-    lv_anim_set_values(&a, LV_OPA_30, LV_OPA_100);
-    lv_anim_set_time(&a, 800);
-    lv_anim_set_playback_time(&a, 800);
-    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
-    lv_anim_set_exec_cb(&a, [](void* obj, int32_t v){ lv_obj_set_style_bg_opa((lv_obj_t*)obj, (lv_opa_t)v, 0); });
-    lv_anim_start(&a);
+    // Restarting replaces the running pulse instead of stacking a new one
+    ui_anim_start(indicator_ready, pulse_anim_cb, LV_OPA_30, LV_OPA_100,
+                  800, 800, LV_ANIM_REPEAT_INFINITE);
 }
 
 void ui_idle_screen_stop_animations() {
     if (indicator_ready) {
-        lv_anim_del(indicator_ready, nullptr);
+        ui_anim_stop(indicator_ready);
     }
 }
 
 void ui_idle_screen_set_no_nav_msg(bool show) {
     if (!label_no_nav) return;
     if (show) {
-        lv_label_set_text(label_no_nav, "Connect to Google Maps to start navigation.");
+        lv_label_set_text_static(label_no_nav, "Connect to Google Maps to start navigation.");
         lv_obj_set_style_text_color(label_no_nav, lv_color_hex(0x9EC1FF), 0);
     } else {
-        lv_label_set_text(label_no_nav, "");
+        lv_label_set_text_static(label_no_nav, "");
     }
 }
 
@@ -1,20 +1,23 @@
 #include <Arduino.h>
 #include "ui_incoming_call_screen.h"
 #include "ui_theme.h"
+#include "ui_anim.h"
 #include <string.h>
 #define COLOR_TEXT_PRIMARY 0xFFFF  // Ensure theme constants available
 
 // UI element references
 static lv_obj_t *label_header = nullptr;
-// REMOVED: arc_pulse (causing crashes) - static avatar only
+static lv_obj_t *arc_pulse = nullptr;   // Ringing ring around avatar (animated via ui_anim)
 static lv_obj_t *label_name = nullptr;
 static lv_obj_t *label_number = nullptr;
 static lv_obj_t *btn_dismiss = nullptr;
 static lv_obj_t *img_avatar = nullptr;  // Avatar circle with initial
 
-// Animation objects
-static lv_anim_t pulse_anim;
-static lv_anim_t vibrate_anim;
+// Last caller shown (re-applied when the screen is rebuilt)
+static char cached_name[48] = "";
+static char cached_number[32] = "";
+static char avatar_initial[2] = "";   // Labels show the cached texts in place (lv_label_set_text_static)
+static bool ringing = false;
 
 // Callbacks
 static decline_callback_t dismiss_cb = nullptr;  // Use decline callback as dismiss
@@ -37,25 +40,26 @@ static void btn_dismiss_event_cb(lv_event_t *e) {
     }
 }
 
-// Pulse animation callback - DISABLED for stability
-static void pulse_anim_cb(void *var, int32_t value) {
-    // DISABLED - causing crashes
-    return;
-    
-    if (!var) return;
-    lv_obj_t *arc = (lv_obj_t *)var;
-    if (!lv_obj_is_valid(arc)) return;
-    
-    lv_obj_set_style_arc_width(arc, value, LV_PART_MAIN);
-    
-    // Fade opacity from 255 to 100
-    uint8_t opacity = 255 - (value * 155 / 30);  // 30 is max width
-    lv_obj_set_style_arc_opa(arc, opacity, LV_PART_MAIN);
+// Screen deleted (evicted by ui_screens) - drop dangling references
+static void screen_delete_event_cb(lv_event_t *e) {
+    label_header = nullptr;
+    arc_pulse = nullptr;
+    label_name = nullptr;
+    label_number = nullptr;
+    btn_dismiss = nullptr;
+    img_avatar = nullptr;
 }
 
-static void pulse_anim_ready_cb(lv_anim_t *a) {
-    // DISABLED - causing crashes
-    return;
+// Pulse animation callback (runs on the UI task, object guaranteed alive by ui_anim)
+#define PULSE_WIDTH_MIN 2
+#define PULSE_WIDTH_MAX 14
+
+static void pulse_anim_cb(lv_obj_t *arc, int32_t value) {
+    lv_obj_set_style_arc_width(arc, value, LV_PART_INDICATOR);
+    
+    // Fade opacity from 255 to 100 as the ring widens
+    uint8_t opacity = 255 - ((value - PULSE_WIDTH_MIN) * 155 / (PULSE_WIDTH_MAX - PULSE_WIDTH_MIN));
+    lv_obj_set_style_arc_opa(arc, opacity, LV_PART_INDICATOR);
 }
 
 void ui_incoming_call_screen_create(lv_obj_t *parent) {
@@ -67,6 +71,7 @@ void ui_incoming_call_screen_create(lv_obj_t *parent) {
     // Set screen background to black
     lv_obj_set_style_bg_color(parent, lv_color_hex(0x000000), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(parent, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_add_event_cb(parent, screen_delete_event_cb, LV_EVENT_DELETE, nullptr);
     
     // Initialize styles only once (critical - re-initializing causes crash)
     if (!incoming_styles_initialized) {
@@ -110,7 +115,17 @@ void ui_incoming_call_screen_create(lv_obj_t *parent) {
     lv_label_set_text(label_header, "Incoming Call");
     lv_obj_align(label_header, LV_ALIGN_TOP_MID, 0, 10);
     
-    // REMOVED: Pulsing arc (causing crashes) - use simple static avatar instead
+    // Create pulsing ring behind avatar (bounded size keeps per-frame redraw small)
+    arc_pulse = lv_arc_create(parent);
+    lv_obj_set_size(arc_pulse, 112, 112);
+    lv_arc_set_bg_angles(arc_pulse, 0, 360);
+    lv_arc_set_angles(arc_pulse, 0, 360);
+    lv_obj_remove_style(arc_pulse, NULL, LV_PART_KNOB);
+    lv_obj_set_style_arc_opa(arc_pulse, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_arc_color(arc_pulse, lv_color_hex(0x07FF), LV_PART_INDICATOR);
+    lv_obj_set_style_arc_width(arc_pulse, PULSE_WIDTH_MIN, LV_PART_INDICATOR);
+    lv_obj_align(arc_pulse, LV_ALIGN_CENTER, 0, -40);
+    lv_obj_clear_flag(arc_pulse, LV_OBJ_FLAG_CLICKABLE);
     
     // Create simple avatar circle (80px, centered) - ULTRA SIMPLE
     img_avatar = lv_obj_create(parent);
@@ -163,55 +178,68 @@ void ui_incoming_call_screen_create(lv_obj_t *parent) {
     lv_label_set_text(label_instruction, "Tap to dismiss");
     lv_obj_align(label_instruction, LV_ALIGN_BOTTOM_MID, 0, -90);
     
-    // DISABLED: Pulse animation initialization (causing crashes)
-    // Animation will remain disabled until stability is confirmed
+    // Restore state set while the screen was not built
+    ui_incoming_call_screen_update(cached_name, cached_number);
+    if (ringing) {
+        ui_incoming_call_screen_start_ringing();
+    }
     
     Serial.println("[UI] Incoming call screen created");
 }
 
 void ui_incoming_call_screen_update(const char *name, const char *number) {
+    // Remember for a later rebuild (no-op when re-applying the cache)
+    if (name != cached_name) {
+        strlcpy(cached_name, name ? name : "", sizeof(cached_name));
+    }
+    if (number != cached_number) {
+        strlcpy(cached_number, number ? number : "", sizeof(cached_number));
+    }
+    
     if (label_name && lv_obj_is_valid(label_name)) {
         if (name && strlen(name) > 0) {
-            lv_label_set_text(label_name, name);
+            lv_label_set_text_static(label_name, cached_name);
             
             // Update avatar with first letter (safe check for name length)
             if (img_avatar && lv_obj_is_valid(img_avatar) && name && strlen(name) > 0) {
                 lv_obj_t *avatar_label = lv_obj_get_child(img_avatar, 0);
                 if (avatar_label && lv_obj_is_valid(avatar_label)) {
-                    char initial[2] = {name[0], '\0'};
-                    lv_label_set_text(avatar_label, initial);
+                    avatar_initial[0] = cached_name[0];
+                    lv_label_set_text_static(avatar_label, avatar_initial);
                 }
             }
         } else {
-            lv_label_set_text(label_name, "Unknown");
+            lv_label_set_text_static(label_name, "Unknown");
         }
     }
     
     if (label_number && lv_obj_is_valid(label_number)) {
         if (number && strlen(number) > 0 && strcmp(number, "Unknown") != 0) {
-            lv_label_set_text(label_number, number);
+            lv_label_set_text_static(label_number, cached_number);
         } else {
-            lv_label_set_text(label_number, "");
+            lv_label_set_text_static(label_number, "");
         }
     }
 }
 
 void ui_incoming_call_screen_start_ringing(void) {
-    // DISABLED - animation causing crashes, just show the arc
-    // REMOVED: arc_pulse animation (disabled for stability)
-    if (false) {  // Never execute - arc_pulse removed
-        Serial.println("[UI] Ringing indicator shown (animation disabled)");
-    } else {
-        Serial.println("[UI] Warning: arc_pulse invalid");
+    ringing = true;
+    if (arc_pulse == nullptr) {
+        // Screen not built yet - ringing starts when it is
+        return;
     }
+    // Safe from the BLE task - ui_anim defers the start to the UI task
+    ui_anim_start(arc_pulse, pulse_anim_cb, PULSE_WIDTH_MIN, PULSE_WIDTH_MAX,
+                  ANIM_PULSE_PERIOD / 2, ANIM_PULSE_PERIOD / 2, LV_ANIM_REPEAT_INFINITE);
+    Serial.println("[UI] Ringing animation started");
 }
 
 void ui_incoming_call_screen_stop_animations(void) {
-    // REMOVED: arc_pulse (no longer exists)
-    if (false) {  // Never execute - arc_pulse removed
-        Serial.println("[UI] Stopped ringing animation");
-    }
-    // Note: Screen-level animations are managed by ui_screens
+    ringing = false;
+    if (arc_pulse == nullptr) return;
+    ui_anim_stop(arc_pulse);
+    Serial.println("[UI] Stopped ringing animation");
+    // Note: Screen unload also cancels animations (ui_anim_bind_screen)
 }
 
 void ui_incoming_call_screen_set_callbacks(accept_callback_t accept_cb_fn, decline_callback_t decline_cb_fn) {
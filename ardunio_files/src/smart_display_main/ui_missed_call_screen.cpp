@@ -1,6 +1,7 @@
 #include <Arduino.h>
-#include <stdio.h>
 #include "ui_missed_call_screen.h"
+#include "ui_anim.h"
+#include "ui_format.h"
 #include <string.h>
 
 // UI element references
@@ -12,8 +13,17 @@ static lv_obj_t *badge_count = nullptr;  // Count badge (if multiple)
 static lv_obj_t *btn_dismiss = nullptr;
 static lv_obj_t *card = nullptr;  // Main notification card
 
-// Animation
-static lv_anim_t slide_anim;
+// Card positions
+#define CARD_Y_HIDDEN  -220
+#define CARD_Y_SHOWN   40
+
+// Last missed call shown (re-applied when the screen is rebuilt)
+static char cached_name[48] = "";
+static char cached_number[32] = "";
+static char cached_timestamp[16] = "";
+static int cached_count = 0;
+static char badge_text[8] = "";   // Badge label shows this in place
+static bool card_shown = false;
 
 // Callback
 static dismiss_callback_t dismiss_cb = nullptr;
@@ -30,6 +40,17 @@ static lv_style_t style_btn_ok;
 // Style initialization guard
 static bool missed_styles_initialized = false;
 
+// Screen deleted (evicted by ui_screens) - drop dangling references
+static void screen_delete_event_cb(lv_event_t *e) {
+    img_icon = nullptr;
+    label_name = nullptr;
+    label_number = nullptr;
+    label_timestamp = nullptr;
+    badge_count = nullptr;
+    btn_dismiss = nullptr;
+    card = nullptr;
+}
+
 // Button event callback
 static void btn_dismiss_event_cb(lv_event_t *e) {
     // Immediately hide the missed call screen first
@@ -56,11 +77,20 @@ static void screen_tap_event_cb(lv_event_t *e) {
 }
 
 // Slide animation callback
-static void slide_anim_cb(void *var, int32_t value) {
-    lv_obj_t *obj = (lv_obj_t *)var;
+static void slide_anim_cb(lv_obj_t *obj, int32_t value) {
     lv_obj_set_y(obj, value);
 }
 
+// Slide-out start (read on the UI task when the animation starts)
+static int32_t card_y_cb(lv_obj_t *obj) {
+    return lv_obj_get_y(obj);
+}
+
+// Badge blink callback (opacity only - badge is small, cheap to redraw)
+static void badge_blink_cb(lv_obj_t *obj, int32_t value) {
+    lv_obj_set_style_opa(obj, (lv_opa_t)value, LV_PART_MAIN);
+}
+
 void ui_missed_call_screen_create(lv_obj_t *parent) {
     if (parent == nullptr) {
         Serial.println("[UI] Error: parent is null in ui_missed_call_screen_create");
@@ -73,6 +103,7 @@ void ui_missed_call_screen_create(lv_obj_t *parent) {
     
     // Add tap event to screen (tap anywhere to dismiss)
     lv_obj_add_event_cb(parent, screen_tap_event_cb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_add_event_cb(parent, screen_delete_event_cb, LV_EVENT_DELETE, nullptr);
     
     // Initialize styles only once (critical - re-initializing causes crash)
     if (!missed_styles_initialized) {
@@ -127,7 +158,7 @@ void ui_missed_call_screen_create(lv_obj_t *parent) {
     card = lv_obj_create(parent);
     lv_obj_add_style(card, &style_card, 0);
     lv_obj_set_size(card, 150, 200);
-    lv_obj_align(card, LV_ALIGN_TOP_MID, 0, -220);  // Start off-screen
+    lv_obj_align(card, LV_ALIGN_TOP_MID, 0, CARD_Y_HIDDEN);  // Start off-screen
     lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
     
     // Create missed call icon (top center of card)
@@ -177,25 +208,41 @@ void ui_missed_call_screen_create(lv_obj_t *parent) {
     lv_obj_set_style_text_color(label_ok, lv_color_hex(0x000000), 0);
     lv_obj_center(label_ok);
     
+    // Restore state set while the screen was not built
+    if (cached_count > 0) {
+        ui_missed_call_screen_update(cached_name, cached_number, cached_count, cached_timestamp);
+    }
+    if (card_shown) {
+        ui_missed_call_screen_show();
+    }
+    
     Serial.println("[UI] Missed call screen created");
 }
 
 void ui_missed_call_screen_update(const char *name, const char *number, int count, const char *timestamp) {
+    // Remember for a later rebuild (no-op when re-applying the cache)
+    if (name != cached_name) {
+        strlcpy(cached_name, name ? name : "", sizeof(cached_name));
+        strlcpy(cached_number, number ? number : "", sizeof(cached_number));
+        strlcpy(cached_timestamp, timestamp ? timestamp : "", sizeof(cached_timestamp));
+    }
+    cached_count = count;
+    
     // Update name
     if (label_name && lv_obj_is_valid(label_name)) {
         if (name && strlen(name) > 0) {
-            lv_label_set_text(label_name, name);
+            lv_label_set_text_static(label_name, cached_name);
         } else {
-            lv_label_set_text(label_name, "Unknown Caller");
+            lv_label_set_text_static(label_name, "Unknown Caller");
         }
     }
     
     // Update number
     if (label_number && lv_obj_is_valid(label_number)) {
         if (number && strlen(number) > 0 && strcmp(number, "Unknown") != 0) {
-            lv_label_set_text(label_number, number);
+            lv_label_set_text_static(label_number, cached_number);
         } else {
-            lv_label_set_text(label_number, "");
+            lv_label_set_text_static(label_number, "");
         }
     }
     
@@ -205,11 +252,15 @@ void ui_missed_call_screen_update(const char *name, const char *number, int coun
             lv_obj_clear_flag(badge_count, LV_OBJ_FLAG_HIDDEN);
             lv_obj_t *label_badge = lv_obj_get_child(badge_count, 0);
             if (label_badge && lv_obj_is_valid(label_badge)) {
-                char count_str[8];
-                snprintf(count_str, sizeof(count_str), "%d", count);
-                lv_label_set_text(label_badge, count_str);
+                ui_format_uint(badge_text, sizeof(badge_text), (uint32_t)count);
+                lv_label_set_text_static(label_badge, badge_text);
             }
+            // Blink badge to draw attention to repeated calls
+            ui_anim_start(badge_count, badge_blink_cb, LV_OPA_COVER, LV_OPA_30,
+                          500, 500, LV_ANIM_REPEAT_INFINITE);
         } else {
+            ui_anim_stop(badge_count);
+            lv_obj_set_style_opa(badge_count, LV_OPA_COVER, LV_PART_MAIN);
             lv_obj_add_flag(badge_count, LV_OBJ_FLAG_HIDDEN);
         }
     }
@@ -217,43 +268,34 @@ void ui_missed_call_screen_update(const char *name, const char *number, int coun
     // Update timestamp
     if (label_timestamp && lv_obj_is_valid(label_timestamp)) {
         if (timestamp && strlen(timestamp) > 0) {
-            lv_label_set_text(label_timestamp, timestamp);
+            lv_label_set_text_static(label_timestamp, cached_timestamp);
         } else {
-            lv_label_set_text(label_timestamp, "");
+            lv_label_set_text_static(label_timestamp, "");
         }
     }
 }
 
 void ui_missed_call_screen_show(void) {
-    if (card && lv_obj_is_valid(card)) {
-        // Reset position (off-screen)
-        lv_obj_set_y(card, -220);
-        
-        // Slide in animation
-        lv_anim_init(&slide_anim);
-        lv_anim_set_var(&slide_anim, card);
-        lv_anim_set_values(&slide_anim, -220, 40);  // Slide from top to center
-        lv_anim_set_time(&slide_anim, 400);  // 400ms
-        lv_anim_set_exec_cb(&slide_anim, slide_anim_cb);
-        lv_anim_start(&slide_anim);
-        Serial.println("[UI] Started missed call slide-in animation");
-    } else {
-        Serial.println("[UI] Warning: card invalid, cannot show");
+    card_shown = true;
+    if (card == nullptr) {
+        // Screen not built yet - card slides in when it is
+        return;
     }
+    // May run on the BLE task: ui_anim checks the card and applies the
+    // start value (off-screen) on the UI task.
+    // Slide in animation (top to center, 400ms)
+    ui_anim_start(card, slide_anim_cb, CARD_Y_HIDDEN, CARD_Y_SHOWN, 400, 0, 1);
+    Serial.println("[UI] Started missed call slide-in animation");
 }
 
 void ui_missed_call_screen_hide(void) {
-    if (card && lv_obj_is_valid(card)) {
-        // Slide out animation
-        lv_anim_init(&slide_anim);
-        lv_anim_set_var(&slide_anim, card);
-        lv_anim_set_values(&slide_anim, lv_obj_get_y(card), -220);
-        lv_anim_set_time(&slide_anim, 300);
-        lv_anim_set_exec_cb(&slide_anim, slide_anim_cb);
-        lv_anim_start(&slide_anim);
+    card_shown = false;
+    if (card) {
+        // Slide out animation (300ms) from wherever the card is when it starts
+        ui_anim_start_from(card, card_y_cb, slide_anim_cb, CARD_Y_HIDDEN, 300, 0, 1);
         Serial.println("[UI] Started missed call slide-out animation");
     } else {
-        Serial.println("[UI] Warning: card invalid, cannot hide");
+        Serial.println("[UI] Warning: card not built, cannot hide");
     }
 }
 
@@ -1,18 +1,47 @@
 #include <Arduino.h>
 #include "ui_navigation_screen.h"
 #include "ui_theme.h"
+#include "alloc_guard.h"
+#include "ui_format.h"
+#include "nav_estimator.h"
+#include "sys_clock.h"
+#include "nav_lookahead.h"
 // Arrow generation removed for now
 #include <string.h>
 
+// One arrow: its line widgets inside a container, and the points they draw.
+// There are two - one shown, one hidden where the next maneuver is built
+// ahead of time, so switching maneuvers only swaps container visibility.
+typedef struct {
+    lv_obj_t *cont;
+    lv_obj_t *line_shaft;                      // Arrow shaft
+    lv_obj_t *line_head1;                      // Arrow head part 1
+    lv_obj_t *line_head2;                      // Arrow head part 2
+    lv_obj_t *line_poly;                       // Polyline for complex shapes (U-turn, roundabout)
+    lv_obj_t *flag_pole;                       // Destination flag
+    lv_obj_t *flag_triangle;
+    lv_style_t style_line;                     // Per group: the hidden one may have another color
+    uint16_t color;
+    lv_point_t pts_shaft[2];
+    lv_point_t pts_head1[2];
+    lv_point_t pts_head2[2];
+    lv_point_t pts_poly[24];
+    lv_point_t pts_flag_pole[2];
+    lv_point_t pts_flag_head[3];
+    char direction[32];                        // Direction the geometry was built for ("" = none)
+} arrow_group_t;
+
 // Forward declarations for internal helpers
-static void set_arrow_points_keep(bool to_right);
+static void set_arrow_points_keep(arrow_group_t *g, bool to_right);
+static void distance_timer_cb(lv_timer_t *timer);
+static void eta_timer_cb(lv_timer_t *timer);
+static void advance_to_next(NavSwitchKind kind);
 
 // UI element references
-static lv_obj_t *img_arrow = nullptr;         // Image widget for arrows
-static lv_obj_t *line_shaft = nullptr;        // Arrow shaft
-static lv_obj_t *line_head1 = nullptr;        // Arrow head part 1
-static lv_obj_t *line_head2 = nullptr;        // Arrow head part 2
-static lv_obj_t *line_poly = nullptr;         // Polyline for complex shapes (U-turn, roundabout)
+static arrow_group_t arrow_groups[2];
+static arrow_group_t *arrow_shown = &arrow_groups[0];
+static arrow_group_t *arrow_staged = &arrow_groups[1];
+static lv_obj_t *label_then = nullptr;         // "then" glyph for the maneuver after this one
 static lv_obj_t *label_distance = nullptr;    // Large distance display
 static lv_obj_t *label_maneuver = nullptr;     // Maneuver instruction text
 static lv_obj_t *label_eta_banner = nullptr;   // ETA display
@@ -22,71 +51,93 @@ static lv_obj_t *label_eta_banner = nullptr;   // ETA display
 #define ARROW_WIDTH  170
 #define ARROW_HEIGHT 140
 
+// Local ETA countdown rate (label only changes once a minute)
+#define ETA_TICK_MS 1000
+
 // Current state
 static char current_direction[32] = "";
 static int current_distance = 0;
 static bool critical_alert_active = false;
+static UIDistanceUnits distance_units = UI_UNITS_METRIC;
+static int shown_distance = 0;                 // Value currently rendered (ground truth or estimate)
+static lv_timer_t *distance_timer = nullptr;   // Local countdown between phone updates
+static uint32_t arrival_ms = 0;                // sys_clock_ms() at arrival; 0 = phone-provided ETA text
+static lv_timer_t *eta_timer = nullptr;        // Local ETA countdown
+
+// Upcoming maneuvers from the phone, nearest first; [0] is built in arrow_staged
+typedef struct {
+    char direction[32];
+    int gap_m;                                 // From the previous maneuver (0 = unknown)
+    char maneuver[64];
+} nav_next_t;
+static nav_next_t next_maneuvers[NAV_LOOKAHEAD_MAX];
+static uint8_t next_count = 0;
+
+// After a local switch, phone frames still describing the old maneuver are stale
+static char passed_direction[32] = "";
+static uint32_t passed_until_ms = 0;
 
 // Style initialization guard
 static bool nav_styles_initialized = false;
 
 // Styles (only initialize once)
 static lv_style_t style_arrow_canvas;
-static lv_style_t style_arrow_line;
 static lv_style_t style_distance_text;
 static lv_style_t style_maneuver_text;
 static lv_style_t style_eta_text;
+static lv_style_t style_flag_pole;
+static lv_style_t style_flag_triangle;
 
-// Reusable point arrays
-static lv_point_t pts_shaft[2];
-static lv_point_t pts_head1[2];
-static lv_point_t pts_head2[2];
-static lv_point_t pts_poly[24];
+// Label texts (labels point at these with lv_label_set_text_static - no copies)
+static char distance_text[16] = "";   // Written by ui_format_distance()
+static char maneuver_text[64] = "";
+static char then_text[32] = "";
+static char eta_text[32] = "";
 
 // Helpers
-static void set_arrow_points_left_right(bool to_right) {
+static void set_arrow_points_left_right(arrow_group_t *g, bool to_right) {
     const int origin_x = (172 - ARROW_WIDTH) / 2;
     const int origin_y = 60;
     int y_mid = origin_y + ARROW_HEIGHT / 2;
     int x_start = origin_x + 20;
     int x_end   = origin_x + ARROW_WIDTH - 20;
 
-    pts_shaft[0].x = to_right ? x_start : x_end - 10; pts_shaft[0].y = y_mid;
-    pts_shaft[1].x = to_right ? x_end - 10 : x_start; pts_shaft[1].y = y_mid;
+    g->pts_shaft[0].x = to_right ? x_start : x_end - 10; g->pts_shaft[0].y = y_mid;
+    g->pts_shaft[1].x = to_right ? x_end - 10 : x_start; g->pts_shaft[1].y = y_mid;
 
     if (to_right) {
-        pts_head1[0].x = x_end - 20; pts_head1[0].y = y_mid - 15; pts_head1[1].x = x_end - 2;  pts_head1[1].y = y_mid;
-        pts_head2[0].x = x_end - 20; pts_head2[0].y = y_mid + 15; pts_head2[1].x = x_end - 2;  pts_head2[1].y = y_mid;
+        g->pts_head1[0].x = x_end - 20; g->pts_head1[0].y = y_mid - 15; g->pts_head1[1].x = x_end - 2;  g->pts_head1[1].y = y_mid;
+        g->pts_head2[0].x = x_end - 20; g->pts_head2[0].y = y_mid + 15; g->pts_head2[1].x = x_end - 2;  g->pts_head2[1].y = y_mid;
     } else {
-        pts_head1[0].x = x_start + 20; pts_head1[0].y = y_mid - 15; pts_head1[1].x = x_start + 2;  pts_head1[1].y = y_mid;
-        pts_head2[0].x = x_start + 20; pts_head2[0].y = y_mid + 15; pts_head2[1].x = x_start + 2;  pts_head2[1].y = y_mid;
+        g->pts_head1[0].x = x_start + 20; g->pts_head1[0].y = y_mid - 15; g->pts_head1[1].x = x_start + 2;  g->pts_head1[1].y = y_mid;
+        g->pts_head2[0].x = x_start + 20; g->pts_head2[0].y = y_mid + 15; g->pts_head2[1].x = x_start + 2;  g->pts_head2[1].y = y_mid;
     }
 
-    lv_line_set_points(line_shaft, pts_shaft, 2);
-    lv_line_set_points(line_head1, pts_head1, 2);
-    lv_line_set_points(line_head2, pts_head2, 2);
+    lv_line_set_points(g->line_shaft, g->pts_shaft, 2);
+    lv_line_set_points(g->line_head1, g->pts_head1, 2);
+    lv_line_set_points(g->line_head2, g->pts_head2, 2);
 }
 
-static void set_arrow_points_straight(void) {
+static void set_arrow_points_straight(arrow_group_t *g) {
     const int origin_x = (172 - ARROW_WIDTH) / 2;
     const int origin_y = 60;
     int x_mid = origin_x + ARROW_WIDTH / 2;
     int y_top = origin_y + 10;
     int y_bot = origin_y + ARROW_HEIGHT - 20;
 
-    pts_shaft[0].x = x_mid; pts_shaft[0].y = y_bot;
-    pts_shaft[1].x = x_mid; pts_shaft[1].y = y_top + 15;
+    g->pts_shaft[0].x = x_mid; g->pts_shaft[0].y = y_bot;
+    g->pts_shaft[1].x = x_mid; g->pts_shaft[1].y = y_top + 15;
 
-    pts_head1[0].x = x_mid - 15; pts_head1[0].y = y_top + 15; pts_head1[1].x = x_mid;      pts_head1[1].y = y_top;
-    pts_head2[0].x = x_mid + 15; pts_head2[0].y = y_top + 15; pts_head2[1].x = x_mid;      pts_head2[1].y = y_top;
+    g->pts_head1[0].x = x_mid - 15; g->pts_head1[0].y = y_top + 15; g->pts_head1[1].x = x_mid;      g->pts_head1[1].y = y_top;
+    g->pts_head2[0].x = x_mid + 15; g->pts_head2[0].y = y_top + 15; g->pts_head2[1].x = x_mid;      g->pts_head2[1].y = y_top;
 
-    lv_line_set_points(line_shaft, pts_shaft, 2);
-    lv_line_set_points(line_head1, pts_head1, 2);
-    lv_line_set_points(line_head2, pts_head2, 2);
+    lv_line_set_points(g->line_shaft, g->pts_shaft, 2);
+    lv_line_set_points(g->line_head1, g->pts_head1, 2);
+    lv_line_set_points(g->line_head2, g->pts_head2, 2);
 }
 
 // Helper for U-turn (India/Europe: curve left, head at bottom left unless "right" specified)
-static void set_arrow_points_uturn(bool to_left) {
+static void set_arrow_points_uturn(arrow_group_t *g, bool to_left) {
     const int origin_x = (172 - ARROW_WIDTH) / 2;
     const int origin_y = 60;
     int x_mid = origin_x + ARROW_WIDTH / 2;
@@ -100,32 +151,32 @@ static void set_arrow_points_uturn(bool to_left) {
     int y_stem_top = y_bot - stem_len;
     int n = 0;
     // Go up
-    pts_poly[n++] = { (lv_coord_t)x_start, (lv_coord_t)y_start };
-    pts_poly[n++] = { (lv_coord_t)x_start, (lv_coord_t)y_stem_top };
+    g->pts_poly[n++] = { (lv_coord_t)x_start, (lv_coord_t)y_start };
+    g->pts_poly[n++] = { (lv_coord_t)x_start, (lv_coord_t)y_stem_top };
     // 180 degree arc over, 15 deg steps, 7 points
     for (int i=0; i<=7; ++i) {
         float t = (float)i/7.0f;
         float ang = to_left ? (3.14159f * (1.0f + t)) : (3.14159f * (2.0f - t));
         int xx = x_mid + (to_left ? -arc_r : arc_r) + (int)(arc_r * cosf(ang));
         int yy = y_stem_top + (int)(arc_r * sinf(ang));
-        pts_poly[n++] = { (lv_coord_t)xx, (lv_coord_t)yy };
+        g->pts_poly[n++] = { (lv_coord_t)xx, (lv_coord_t)yy };
     }
     // Down leg
     int x_end = x_mid + (to_left ? -2 * arc_r : 2 * arc_r);
     int y_end = y_bot - 15;
-    pts_poly[n++] = { (lv_coord_t)x_end, (lv_coord_t)y_end };
-    lv_line_set_points(line_poly, pts_poly, n);
+    g->pts_poly[n++] = { (lv_coord_t)x_end, (lv_coord_t)y_end };
+    lv_line_set_points(g->line_poly, g->pts_poly, n);
     // Arrowhead (bottom tip)
-    pts_shaft[0].x = x_end;              pts_shaft[0].y = y_end - 15;
-    pts_shaft[1].x = x_end;              pts_shaft[1].y = y_end;
-    pts_head1[0].x = x_end - 10;         pts_head1[0].y = y_end - 7; pts_head1[1].x = x_end; pts_head1[1].y = y_end;
-    pts_head2[0].x = x_end + 10;         pts_head2[0].y = y_end - 7; pts_head2[1].x = x_end; pts_head2[1].y = y_end;
-    lv_line_set_points(line_shaft, pts_shaft, 2);
-    lv_line_set_points(line_head1, pts_head1, 2);
-    lv_line_set_points(line_head2, pts_head2, 2);
+    g->pts_shaft[0].x = x_end;              g->pts_shaft[0].y = y_end - 15;
+    g->pts_shaft[1].x = x_end;              g->pts_shaft[1].y = y_end;
+    g->pts_head1[0].x = x_end - 10;         g->pts_head1[0].y = y_end - 7; g->pts_head1[1].x = x_end; g->pts_head1[1].y = y_end;
+    g->pts_head2[0].x = x_end + 10;         g->pts_head2[0].y = y_end - 7; g->pts_head2[1].x = x_end; g->pts_head2[1].y = y_end;
+    lv_line_set_points(g->line_shaft, g->pts_shaft, 2);
+    lv_line_set_points(g->line_head1, g->pts_head1, 2);
+    lv_line_set_points(g->line_head2, g->pts_head2, 2);
 }
 
-static void set_arrow_points_slight(bool to_right) {
+static void set_arrow_points_slight(arrow_group_t *g, bool to_right) {
     // Mild curve from bottom center, veers out left/right, arrowhead at end
     const int origin_x = (172 - ARROW_WIDTH) / 2;
     const int origin_y = 60;
@@ -136,28 +187,28 @@ static void set_arrow_points_slight(bool to_right) {
     int x_ctrl = x0 + (to_right ? 30 : -30);
     int y_ctrl = y0 - 40;
     // Gentle polyline as 3 segments
-    pts_poly[0] = { (lv_coord_t)x0, (lv_coord_t)y0 };
-    pts_poly[1] = { (lv_coord_t)x_ctrl, (lv_coord_t)y_ctrl };
-    pts_poly[2] = { (lv_coord_t)x1, (lv_coord_t)y1 };
-    lv_line_set_points(line_poly, pts_poly, 3);
+    g->pts_poly[0] = { (lv_coord_t)x0, (lv_coord_t)y0 };
+    g->pts_poly[1] = { (lv_coord_t)x_ctrl, (lv_coord_t)y_ctrl };
+    g->pts_poly[2] = { (lv_coord_t)x1, (lv_coord_t)y1 };
+    lv_line_set_points(g->line_poly, g->pts_poly, 3);
     // Arrowhead at tip
     float angle = atan2f((float)(y1 - y_ctrl), (float)(x1 - x_ctrl));
     int len = 17;
-    pts_shaft[0].x = x1 - (int)(len * cosf(angle));
-    pts_shaft[0].y = y1 - (int)(len * sinf(angle));
-    pts_shaft[1].x = x1; pts_shaft[1].y = y1;
-    pts_head1[0].x = x1 - (int)(8 * cosf(angle + 2.2f));
-    pts_head1[0].y = y1 - (int)(8 * sinf(angle + 2.2f));
-    pts_head1[1].x = x1; pts_head1[1].y = y1;
-    pts_head2[0].x = x1 - (int)(8 * cosf(angle - 2.2f));
-    pts_head2[0].y = y1 - (int)(8 * sinf(angle - 2.2f));
-    pts_head2[1].x = x1; pts_head2[1].y = y1;
-    lv_line_set_points(line_shaft, pts_shaft, 2);
-    lv_line_set_points(line_head1, pts_head1, 2);
-    lv_line_set_points(line_head2, pts_head2, 2);
-}
-
-static void set_arrow_points_sharp(bool to_right) {
+    g->pts_shaft[0].x = x1 - (int)(len * cosf(angle));
+    g->pts_shaft[0].y = y1 - (int)(len * sinf(angle));
+    g->pts_shaft[1].x = x1; g->pts_shaft[1].y = y1;
+    g->pts_head1[0].x = x1 - (int)(8 * cosf(angle + 2.2f));
+    g->pts_head1[0].y = y1 - (int)(8 * sinf(angle + 2.2f));
+    g->pts_head1[1].x = x1; g->pts_head1[1].y = y1;
+    g->pts_head2[0].x = x1 - (int)(8 * cosf(angle - 2.2f));
+    g->pts_head2[0].y = y1 - (int)(8 * sinf(angle - 2.2f));
+    g->pts_head2[1].x = x1; g->pts_head2[1].y = y1;
+    lv_line_set_points(g->line_shaft, g->pts_shaft, 2);
+    lv_line_set_points(g->line_head1, g->pts_head1, 2);
+    lv_line_set_points(g->line_head2, g->pts_head2, 2);
+}
+
+static void set_arrow_points_sharp(arrow_group_t *g, bool to_right) {
     // Short up, then sharp right/left at top
     const int origin_x = (172 - ARROW_WIDTH) / 2;
     const int origin_y = 60;
@@ -167,29 +218,29 @@ static void set_arrow_points_sharp(bool to_right) {
     int x2 = to_right ? x0 + 40 : x0 - 40;
     int y2 = y1 - 40;
     // Shaft: up then horizontal right/left
-    pts_poly[0] = { (lv_coord_t)x0, (lv_coord_t)y0 };
-    pts_poly[1] = { (lv_coord_t)x0, (lv_coord_t)y1 };
-    pts_poly[2] = { (lv_coord_t)x2, (lv_coord_t)y1 };
-    pts_poly[3] = { (lv_coord_t)x2, (lv_coord_t)y2 };
-    lv_line_set_points(line_poly, pts_poly, 4);
+    g->pts_poly[0] = { (lv_coord_t)x0, (lv_coord_t)y0 };
+    g->pts_poly[1] = { (lv_coord_t)x0, (lv_coord_t)y1 };
+    g->pts_poly[2] = { (lv_coord_t)x2, (lv_coord_t)y1 };
+    g->pts_poly[3] = { (lv_coord_t)x2, (lv_coord_t)y2 };
+    lv_line_set_points(g->line_poly, g->pts_poly, 4);
     // Arrowhead at end
     float angle = atan2f((float)(y2 - y1), (float)(x2 - x0));
     int x_tip = x2, y_tip = y2;
-    pts_shaft[0].x = x2 - (int)(12 * cosf(angle));
-    pts_shaft[0].y = y2 - (int)(12 * sinf(angle));
-    pts_shaft[1].x = x_tip; pts_shaft[1].y = y_tip;
-    pts_head1[0].x = x_tip - (int)(8 * cosf(angle + 2.2f));
-    pts_head1[0].y = y_tip - (int)(8 * sinf(angle + 2.2f));
-    pts_head1[1].x = x_tip; pts_head1[1].y = y_tip;
-    pts_head2[0].x = x_tip - (int)(8 * cosf(angle - 2.2f));
-    pts_head2[0].y = y_tip - (int)(8 * sinf(angle - 2.2f));
-    pts_head2[1].x = x_tip; pts_head2[1].y = y_tip;
-    lv_line_set_points(line_shaft, pts_shaft, 2);
-    lv_line_set_points(line_head1, pts_head1, 2);
-    lv_line_set_points(line_head2, pts_head2, 2);
-}
-
-static void set_arrow_points_roundabout(int exit_dir) {
+    g->pts_shaft[0].x = x2 - (int)(12 * cosf(angle));
+    g->pts_shaft[0].y = y2 - (int)(12 * sinf(angle));
+    g->pts_shaft[1].x = x_tip; g->pts_shaft[1].y = y_tip;
+    g->pts_head1[0].x = x_tip - (int)(8 * cosf(angle + 2.2f));
+    g->pts_head1[0].y = y_tip - (int)(8 * sinf(angle + 2.2f));
+    g->pts_head1[1].x = x_tip; g->pts_head1[1].y = y_tip;
+    g->pts_head2[0].x = x_tip - (int)(8 * cosf(angle - 2.2f));
+    g->pts_head2[0].y = y_tip - (int)(8 * sinf(angle - 2.2f));
+    g->pts_head2[1].x = x_tip; g->pts_head2[1].y = y_tip;
+    lv_line_set_points(g->line_shaft, g->pts_shaft, 2);
+    lv_line_set_points(g->line_head1, g->pts_head1, 2);
+    lv_line_set_points(g->line_head2, g->pts_head2, 2);
+}
+
+static void set_arrow_points_roundabout(arrow_group_t *g, int exit_dir) {
     const int origin_x = (172 - ARROW_WIDTH) / 2;
     const int origin_y = 60;
     int cx = origin_x + ARROW_WIDTH / 2;
@@ -201,91 +252,88 @@ static void set_arrow_points_roundabout(int exit_dir) {
         float ang = (float)i / 12.0f * 6.28318f;
         int x = cx + (int)(r * cosf(ang));
         int y = cy + (int)(r * sinf(ang));
-        pts_poly[n++] = { (lv_coord_t)x, (lv_coord_t)y };
+        g->pts_poly[n++] = { (lv_coord_t)x, (lv_coord_t)y };
     }
-    lv_line_set_points(line_poly, pts_poly, n);
+    lv_line_set_points(g->line_poly, g->pts_poly, n);
 
     if (exit_dir == 0) {
-        pts_shaft[0].x = cx; pts_shaft[0].y = cy - r;
-        pts_shaft[1].x = cx; pts_shaft[1].y = cy - r - 15;
-        pts_head1[0].x = cx - 8; pts_head1[0].y = cy - r - 5; pts_head1[1].x = cx; pts_head1[1].y = cy - r - 15;
-        pts_head2[0].x = cx + 8; pts_head2[0].y = cy - r - 5; pts_head2[1].x = cx; pts_head2[1].y = cy - r - 15;
+        g->pts_shaft[0].x = cx; g->pts_shaft[0].y = cy - r;
+        g->pts_shaft[1].x = cx; g->pts_shaft[1].y = cy - r - 15;
+        g->pts_head1[0].x = cx - 8; g->pts_head1[0].y = cy - r - 5; g->pts_head1[1].x = cx; g->pts_head1[1].y = cy - r - 15;
+        g->pts_head2[0].x = cx + 8; g->pts_head2[0].y = cy - r - 5; g->pts_head2[1].x = cx; g->pts_head2[1].y = cy - r - 15;
     } else if (exit_dir < 0) {
-        pts_shaft[0].x = cx - r; pts_shaft[0].y = cy;
-        pts_shaft[1].x = cx - r - 15; pts_shaft[1].y = cy;
-        pts_head1[0].x = cx - r - 5; pts_head1[0].y = cy - 8; pts_head1[1].x = cx - r - 15; pts_head1[1].y = cy;
-        pts_head2[0].x = cx - r - 5; pts_head2[0].y = cy + 8; pts_head2[1].x = cx - r - 15; pts_head2[1].y = cy;
+        g->pts_shaft[0].x = cx - r; g->pts_shaft[0].y = cy;
+        g->pts_shaft[1].x = cx - r - 15; g->pts_shaft[1].y = cy;
+        g->pts_head1[0].x = cx - r - 5; g->pts_head1[0].y = cy - 8; g->pts_head1[1].x = cx - r - 15; g->pts_head1[1].y = cy;
+        g->pts_head2[0].x = cx - r - 5; g->pts_head2[0].y = cy + 8; g->pts_head2[1].x = cx - r - 15; g->pts_head2[1].y = cy;
     } else {
-        pts_shaft[0].x = cx + r; pts_shaft[0].y = cy;
-        pts_shaft[1].x = cx + r + 15; pts_shaft[1].y = cy;
-        pts_head1[0].x = cx + r + 5; pts_head1[0].y = cy - 8; pts_head1[1].x = cx + r + 15; pts_head1[1].y = cy;
-        pts_head2[0].x = cx + r + 5; pts_head2[0].y = cy + 8; pts_head2[1].x = cx + r + 15; pts_head2[1].y = cy;
+        g->pts_shaft[0].x = cx + r; g->pts_shaft[0].y = cy;
+        g->pts_shaft[1].x = cx + r + 15; g->pts_shaft[1].y = cy;
+        g->pts_head1[0].x = cx + r + 5; g->pts_head1[0].y = cy - 8; g->pts_head1[1].x = cx + r + 15; g->pts_head1[1].y = cy;
+        g->pts_head2[0].x = cx + r + 5; g->pts_head2[0].y = cy + 8; g->pts_head2[1].x = cx + r + 15; g->pts_head2[1].y = cy;
     }
 
-    lv_line_set_points(line_shaft, pts_shaft, 2);
-    lv_line_set_points(line_head1, pts_head1, 2);
-    lv_line_set_points(line_head2, pts_head2, 2);
+    lv_line_set_points(g->line_shaft, g->pts_shaft, 2);
+    lv_line_set_points(g->line_head1, g->pts_head1, 2);
+    lv_line_set_points(g->line_head2, g->pts_head2, 2);
 }
 
 // Utility to hide all arrows
-static void hide_all_arrows() {
-    if (line_shaft)  lv_obj_add_flag(line_shaft, LV_OBJ_FLAG_HIDDEN);
-    if (line_head1)  lv_obj_add_flag(line_head1, LV_OBJ_FLAG_HIDDEN);
-    if (line_head2)  lv_obj_add_flag(line_head2, LV_OBJ_FLAG_HIDDEN);
-    if (line_poly)   lv_obj_add_flag(line_poly,  LV_OBJ_FLAG_HIDDEN);
+static void hide_all_arrows(arrow_group_t *g) {
+    if (g->line_shaft)  lv_obj_add_flag(g->line_shaft, LV_OBJ_FLAG_HIDDEN);
+    if (g->line_head1)  lv_obj_add_flag(g->line_head1, LV_OBJ_FLAG_HIDDEN);
+    if (g->line_head2)  lv_obj_add_flag(g->line_head2, LV_OBJ_FLAG_HIDDEN);
+    if (g->line_poly)   lv_obj_add_flag(g->line_poly,  LV_OBJ_FLAG_HIDDEN);
 }
 // Utility to make visible only those needed
-static void show_shaft_head() {
-    lv_obj_clear_flag(line_shaft, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_clear_flag(line_head1, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_clear_flag(line_head2, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_add_flag(line_poly, LV_OBJ_FLAG_HIDDEN);
+static void show_shaft_head(arrow_group_t *g) {
+    lv_obj_clear_flag(g->line_shaft, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(g->line_head1, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(g->line_head2, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(g->line_poly, LV_OBJ_FLAG_HIDDEN);
 }
-static void show_poly_with_heads() {
-    lv_obj_clear_flag(line_shaft, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_clear_flag(line_head1, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_clear_flag(line_head2, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_clear_flag(line_poly, LV_OBJ_FLAG_HIDDEN);
+static void show_poly_with_heads(arrow_group_t *g) {
+    lv_obj_clear_flag(g->line_shaft, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(g->line_head1, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(g->line_head2, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(g->line_poly, LV_OBJ_FLAG_HIDDEN);
 }
 
-static lv_obj_t *flag_pole = nullptr;
-static lv_obj_t *flag_triangle = nullptr;
-static lv_style_t style_flag_pole;
-static lv_style_t style_flag_triangle;
-
-// Point arrays for flag
-lv_point_t pts_flag_pole[2];
-lv_point_t pts_flag_head[3];
-
 // Helper for destination (flag)
-static void set_flag_symbol() {
+static void set_flag_symbol(arrow_group_t *g) {
     const int origin_x = (172 - ARROW_WIDTH) / 2;
     const int origin_y = 60;
     int x_left = origin_x + ARROW_WIDTH / 2 - 28;
     int y_bot = origin_y + ARROW_HEIGHT - 35;
     int y_top = y_bot - 66;
     // Flag pole
-    pts_flag_pole[0] = { (lv_coord_t)x_left, (lv_coord_t)y_bot };
-    pts_flag_pole[1] = { (lv_coord_t)x_left, (lv_coord_t)y_top };
-    lv_line_set_points(flag_pole, pts_flag_pole, 2);
+    g->pts_flag_pole[0] = { (lv_coord_t)x_left, (lv_coord_t)y_bot };
+    g->pts_flag_pole[1] = { (lv_coord_t)x_left, (lv_coord_t)y_top };
+    lv_line_set_points(g->flag_pole, g->pts_flag_pole, 2);
     // Flag triangle
-    pts_flag_head[0] = { (lv_coord_t)x_left, (lv_coord_t)y_top };
-    pts_flag_head[1] = { (lv_coord_t)x_left, (lv_coord_t)(y_top + 24) };
-    pts_flag_head[2] = { (lv_coord_t)(x_left+36), (lv_coord_t)(y_top + 12) };
-    lv_line_set_points(flag_triangle, pts_flag_head, 3);
-}
-
-// Update arrow image based on direction
-static void update_arrow_image(const char* direction, uint16_t color) {
-    if (!line_shaft || !line_head1 || !line_head2 || !line_poly) return;
-    lv_obj_set_style_line_color(line_shaft, lv_color_hex(color), LV_PART_MAIN);
-    lv_obj_set_style_line_color(line_head1, lv_color_hex(color), LV_PART_MAIN);
-    lv_obj_set_style_line_color(line_head2, lv_color_hex(color), LV_PART_MAIN);
-    lv_obj_set_style_line_color(line_poly,  lv_color_hex(color), LV_PART_MAIN);
+    g->pts_flag_head[0] = { (lv_coord_t)x_left, (lv_coord_t)y_top };
+    g->pts_flag_head[1] = { (lv_coord_t)x_left, (lv_coord_t)(y_top + 24) };
+    g->pts_flag_head[2] = { (lv_coord_t)(x_left+36), (lv_coord_t)(y_top + 12) };
+    lv_line_set_points(g->flag_triangle, g->pts_flag_head, 3);
+}
+
+// Recolor a group's arrow lines through their shared style
+// (the property already exists in the style, so it is updated in place)
+static void set_arrow_color(arrow_group_t *g, uint16_t color) {
+    if (color == g->color) return;
+    g->color = color;
+    lv_style_set_line_color(&g->style_line, lv_color_hex(color));
+    lv_obj_report_style_change(&g->style_line);
+}
+
+// Build a group's arrow for a direction
+static void update_arrow_image(arrow_group_t *g, const char* direction, uint16_t color) {
+    strlcpy(g->direction, direction ? direction : "", sizeof(g->direction));
+    if (!g->line_shaft || !g->line_head1 || !g->line_head2 || !g->line_poly) return;
     // Hide everything by default
-    hide_all_arrows();
-    if (flag_pole) lv_obj_add_flag(flag_pole, LV_OBJ_FLAG_HIDDEN);
-    if (flag_triangle) lv_obj_add_flag(flag_triangle, LV_OBJ_FLAG_HIDDEN);
+    hide_all_arrows(g);
+    if (g->flag_pole) lv_obj_add_flag(g->flag_pole, LV_OBJ_FLAG_HIDDEN);
+    if (g->flag_triangle) lv_obj_add_flag(g->flag_triangle, LV_OBJ_FLAG_HIDDEN);
 
     // If no direction provided or empty, leave all hidden (no default straight)
     if (direction == nullptr || *direction == '\0') {
@@ -324,69 +372,112 @@ static void update_arrow_image(const char* direction, uint16_t color) {
 
     // Routing
     if (is_uturn) {
-        set_arrow_points_uturn(false); // always right per spec
-        show_poly_with_heads();
+        set_arrow_points_uturn(g, false); // always right per spec
+        show_poly_with_heads(g);
         goto ARROW_COLOR;
     }
-    if (is_keep && is_right) { set_arrow_points_keep(true);  show_poly_with_heads(); goto ARROW_COLOR; }
-    if (is_keep && is_left)  { set_arrow_points_keep(false); show_poly_with_heads(); goto ARROW_COLOR; }
-    if (is_sharp && is_right) { set_arrow_points_sharp(true);  show_poly_with_heads(); goto ARROW_COLOR; }
-    if (is_sharp && is_left)  { set_arrow_points_sharp(false); show_poly_with_heads(); goto ARROW_COLOR; }
-    if ((is_slight || is_keep) && is_right) { set_arrow_points_slight(true);  show_poly_with_heads(); goto ARROW_COLOR; }
-    if ((is_slight || is_keep) && is_left)  { set_arrow_points_slight(false); show_poly_with_heads(); goto ARROW_COLOR; }
+    if (is_keep && is_right) { set_arrow_points_keep(g, true);  show_poly_with_heads(g); goto ARROW_COLOR; }
+    if (is_keep && is_left)  { set_arrow_points_keep(g, false); show_poly_with_heads(g); goto ARROW_COLOR; }
+    if (is_sharp && is_right) { set_arrow_points_sharp(g, true);  show_poly_with_heads(g); goto ARROW_COLOR; }
+    if (is_sharp && is_left)  { set_arrow_points_sharp(g, false); show_poly_with_heads(g); goto ARROW_COLOR; }
+    if ((is_slight || is_keep) && is_right) { set_arrow_points_slight(g, true);  show_poly_with_heads(g); goto ARROW_COLOR; }
+    if ((is_slight || is_keep) && is_left)  { set_arrow_points_slight(g, false); show_poly_with_heads(g); goto ARROW_COLOR; }
     if (is_round) {
         int exit_dir = 0;
         if (is_left) exit_dir = -1; else if (is_right) exit_dir = 1;
-        set_arrow_points_roundabout(exit_dir);
-        show_poly_with_heads();
+        set_arrow_points_roundabout(g, exit_dir);
+        show_poly_with_heads(g);
         goto ARROW_COLOR;
     }
-    if (is_right) { set_arrow_points_left_right(true);  show_shaft_head(); goto ARROW_COLOR; }
-    if (is_left)  { set_arrow_points_left_right(false); show_shaft_head(); goto ARROW_COLOR; }
+    if (is_right) { set_arrow_points_left_right(g, true);  show_shaft_head(g); goto ARROW_COLOR; }
+    if (is_left)  { set_arrow_points_left_right(g, false); show_shaft_head(g); goto ARROW_COLOR; }
     if (is_dest) {
-        // Lazily create flag objects if they were not created
-        if (!flag_pole) {
-            flag_pole = lv_line_create(lv_obj_get_parent(line_shaft));
-            lv_style_init(&style_flag_pole);
-            lv_style_set_line_width(&style_flag_pole, 6);
-            lv_style_set_line_color(&style_flag_pole, lv_color_hex(0xF800));
-            lv_obj_add_style(flag_pole, &style_flag_pole, 0);
-        }
-        if (!flag_triangle) {
-            flag_triangle = lv_line_create(lv_obj_get_parent(line_shaft));
-            lv_style_init(&style_flag_triangle);
-            lv_style_set_line_width(&style_flag_triangle, 6);
-            lv_style_set_line_color(&style_flag_triangle, lv_color_hex(0xF800));
-            lv_obj_add_style(flag_triangle, &style_flag_triangle, 0);
-        }
-        set_flag_symbol();
-        if (flag_pole) { lv_obj_clear_flag(flag_pole, LV_OBJ_FLAG_HIDDEN); lv_obj_set_style_line_color(flag_pole, lv_color_hex(0xF800), LV_PART_MAIN); }
-        if (flag_triangle) { lv_obj_clear_flag(flag_triangle, LV_OBJ_FLAG_HIDDEN); lv_obj_set_style_line_color(flag_triangle, lv_color_hex(0xF800), LV_PART_MAIN); }
+        // Flag objects are built (hidden) with the screen
+        if (!g->flag_pole || !g->flag_triangle) return;
+        set_flag_symbol(g);
+        lv_obj_clear_flag(g->flag_pole, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(g->flag_triangle, LV_OBJ_FLAG_HIDDEN);
         return;
     }
     if (is_straight) {
-        set_arrow_points_straight();
-        show_shaft_head();
+        set_arrow_points_straight(g);
+        show_shaft_head(g);
         goto ARROW_COLOR;
     }
     // Unknown: keep hidden
     return;
 ARROW_COLOR:
-    lv_obj_set_style_line_color(line_shaft, lv_color_hex(arrow_color), LV_PART_MAIN);
-    lv_obj_set_style_line_color(line_head1, lv_color_hex(arrow_color), LV_PART_MAIN);
-    lv_obj_set_style_line_color(line_head2, lv_color_hex(arrow_color), LV_PART_MAIN);
-    lv_obj_set_style_line_color(line_poly,  lv_color_hex(arrow_color), LV_PART_MAIN);
+    set_arrow_color(g, arrow_color);
+}
+
+// Show a direction's arrow: the staged group if it was built for it, else
+// build it there first; then swap the groups
+// @param build_us Set to the time spent building geometry
+// @return true if the arrow was already staged
+static bool show_arrow(const char *direction, uint32_t *build_us) {
+    bool staged = strcmp(arrow_staged->direction, direction) == 0;
+    *build_us = 0;
+    if (!staged) {
+        uint32_t start_us = micros();
+        update_arrow_image(arrow_staged, direction, COLOR_ARROW_STRAIGHT);
+        *build_us = micros() - start_us;
+    }
+    lv_obj_add_flag(arrow_shown->cont, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(arrow_staged->cont, LV_OBJ_FLAG_HIDDEN);
+    arrow_group_t *shown = arrow_staged;
+    arrow_staged = arrow_shown;
+    arrow_shown = shown;
+    return staged;
+}
+
+// Small symbol for the "then" glyph (built-in font symbols)
+static const char *then_glyph(const char *direction) {
+    if (strstr(direction, "destination")) return LV_SYMBOL_HOME;
+    if (strstr(direction, "uturn") || strstr(direction, "roundabout")) return LV_SYMBOL_LOOP;
+    if (strstr(direction, "left")) return LV_SYMBOL_LEFT;
+    if (strstr(direction, "right")) return LV_SYMBOL_RIGHT;
+    return LV_SYMBOL_UP;
+}
+
+// Build the next maneuver's arrow in the hidden group and show the "then" glyph
+static void stage_next(void) {
+    if (!label_then) return;
+    if (next_count == 0) {
+        then_text[0] = '\0';
+        lv_obj_add_flag(label_then, LV_OBJ_FLAG_HIDDEN);
+        return;
+    }
+    const nav_next_t *next = &next_maneuvers[0];
+    if (strcmp(arrow_staged->direction, next->direction) != 0) {
+        uint32_t start_us = micros();
+        update_arrow_image(arrow_staged, next->direction, COLOR_ARROW_STRAIGHT);
+        nav_lookahead_record_stage(micros() - start_us);
+    }
+
+    char text[sizeof(then_text)];
+    char gap[16] = "";
+    if (next->gap_m > 0) ui_format_distance(gap, sizeof(gap), next->gap_m, distance_units);
+    snprintf(text, sizeof(text), "then %s %s", then_glyph(next->direction), gap);
+    if (strcmp(text, then_text) != 0) {
+        memcpy(then_text, text, sizeof(then_text));
+        lv_label_set_text_static(label_then, then_text);
+    }
+    lv_obj_clear_flag(label_then, LV_OBJ_FLAG_HIDDEN);
 }
 
 void ui_navigation_hide_all_objects() {
-    if (line_shaft)  lv_obj_add_flag(line_shaft, LV_OBJ_FLAG_HIDDEN);
-    if (line_head1)  lv_obj_add_flag(line_head1, LV_OBJ_FLAG_HIDDEN);
-    if (line_head2)  lv_obj_add_flag(line_head2, LV_OBJ_FLAG_HIDDEN);
-    if (line_poly)   lv_obj_add_flag(line_poly,  LV_OBJ_FLAG_HIDDEN);
-    if (flag_pole)   lv_obj_add_flag(flag_pole, LV_OBJ_FLAG_HIDDEN);
-    if (flag_triangle) lv_obj_add_flag(flag_triangle, LV_OBJ_FLAG_HIDDEN);
-}
-static void set_arrow_points_keep(bool to_right) {
+    for (int i = 0; i < 2; i++) {
+        arrow_group_t *g = &arrow_groups[i];
+        if (g->line_shaft)  lv_obj_add_flag(g->line_shaft, LV_OBJ_FLAG_HIDDEN);
+        if (g->line_head1)  lv_obj_add_flag(g->line_head1, LV_OBJ_FLAG_HIDDEN);
+        if (g->line_head2)  lv_obj_add_flag(g->line_head2, LV_OBJ_FLAG_HIDDEN);
+        if (g->line_poly)   lv_obj_add_flag(g->line_poly,  LV_OBJ_FLAG_HIDDEN);
+        if (g->flag_pole)   lv_obj_add_flag(g->flag_pole, LV_OBJ_FLAG_HIDDEN);
+        if (g->flag_triangle) lv_obj_add_flag(g->flag_triangle, LV_OBJ_FLAG_HIDDEN);
+        g->direction[0] = '\0';  // Rebuilt on the next switch
+    }
+}
+static void set_arrow_points_keep(arrow_group_t *g, bool to_right) {
     const int origin_x = (172 - ARROW_WIDTH) / 2;
     const int origin_y = 60;
     int x_mid = origin_x + ARROW_WIDTH / 2;
@@ -395,23 +486,23 @@ static void set_arrow_points_keep(bool to_right) {
     int y_tick = y_top + 30;
     int tick_len = 24;
     // Upward shaft
-    pts_shaft[0].x = x_mid; pts_shaft[0].y = y_bot;
-    pts_shaft[1].x = x_mid; pts_shaft[1].y = y_top;
-    lv_line_set_points(line_shaft, pts_shaft, 2);
+    g->pts_shaft[0].x = x_mid; g->pts_shaft[0].y = y_bot;
+    g->pts_shaft[1].x = x_mid; g->pts_shaft[1].y = y_top;
+    lv_line_set_points(g->line_shaft, g->pts_shaft, 2);
     // Arrowhead at top
-    pts_head1[0].x = x_mid - 15; pts_head1[0].y = y_top + 15; pts_head1[1].x = x_mid; pts_head1[1].y = y_top;
-    pts_head2[0].x = x_mid + 15; pts_head2[0].y = y_top + 15; pts_head2[1].x = x_mid; pts_head2[1].y = y_top;
-    lv_line_set_points(line_head1, pts_head1, 2);
-    lv_line_set_points(line_head2, pts_head2, 2);
+    g->pts_head1[0].x = x_mid - 15; g->pts_head1[0].y = y_top + 15; g->pts_head1[1].x = x_mid; g->pts_head1[1].y = y_top;
+    g->pts_head2[0].x = x_mid + 15; g->pts_head2[0].y = y_top + 15; g->pts_head2[1].x = x_mid; g->pts_head2[1].y = y_top;
+    lv_line_set_points(g->line_head1, g->pts_head1, 2);
+    lv_line_set_points(g->line_head2, g->pts_head2, 2);
     // Tick on left/right
     if (to_right) {
-        pts_poly[0].x = x_mid; pts_poly[0].y = y_tick;
-        pts_poly[1].x = x_mid + tick_len; pts_poly[1].y = y_tick - 16;
+        g->pts_poly[0].x = x_mid; g->pts_poly[0].y = y_tick;
+        g->pts_poly[1].x = x_mid + tick_len; g->pts_poly[1].y = y_tick - 16;
     } else {
-        pts_poly[0].x = x_mid; pts_poly[0].y = y_tick;
-        pts_poly[1].x = x_mid - tick_len; pts_poly[1].y = y_tick - 16;
+        g->pts_poly[0].x = x_mid; g->pts_poly[0].y = y_tick;
+        g->pts_poly[1].x = x_mid - tick_len; g->pts_poly[1].y = y_tick - 16;
     }
-    lv_line_set_points(line_poly, pts_poly, 2);
+    lv_line_set_points(g->line_poly, g->pts_poly, 2);
 }
 
 void ui_navigation_screen_create(lv_obj_t *parent) {
@@ -428,10 +519,22 @@ void ui_navigation_screen_create(lv_obj_t *parent) {
         lv_style_set_border_width(&style_arrow_canvas, 0);
         lv_style_set_pad_all(&style_arrow_canvas, 0);
         
-        lv_style_init(&style_arrow_line);
-        lv_style_set_line_width(&style_arrow_line, 8);
-        lv_style_set_line_rounded(&style_arrow_line, true);
-        lv_style_set_line_color(&style_arrow_line, lv_color_hex(COLOR_ARROW_STRAIGHT));
+        for (int i = 0; i < 2; i++) {
+            lv_style_t *style = &arrow_groups[i].style_line;
+            lv_style_init(style);
+            lv_style_set_line_width(style, 8);
+            lv_style_set_line_rounded(style, true);
+            lv_style_set_line_color(style, lv_color_hex(COLOR_ARROW_STRAIGHT));
+            arrow_groups[i].color = COLOR_ARROW_STRAIGHT;
+        }
+        
+        lv_style_init(&style_flag_pole);
+        lv_style_set_line_width(&style_flag_pole, 6);
+        lv_style_set_line_color(&style_flag_pole, lv_color_hex(0xF800));
+        
+        lv_style_init(&style_flag_triangle);
+        lv_style_set_line_width(&style_flag_triangle, 6);
+        lv_style_set_line_color(&style_flag_triangle, lv_color_hex(0xF800));
         
         lv_style_init(&style_distance_text);
         lv_style_set_text_font(&style_distance_text, &lv_font_montserrat_28);
@@ -462,21 +565,58 @@ void ui_navigation_screen_create(lv_obj_t *parent) {
     lv_obj_set_style_bg_color(parent, lv_color_hex(0x000000), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(parent, LV_OPA_COVER, LV_PART_MAIN);
     
-    line_poly = lv_line_create(parent);
-    lv_obj_add_style(line_poly, &style_arrow_line, 0);
-    lv_obj_align(line_poly, LV_ALIGN_TOP_LEFT, 0, 0);
-
-    line_shaft = lv_line_create(parent);
-    lv_obj_add_style(line_shaft, &style_arrow_line, 0);
-    lv_obj_align(line_shaft, LV_ALIGN_TOP_LEFT, 0, 0);
-
-    line_head1 = lv_line_create(parent);
-    lv_obj_add_style(line_head1, &style_arrow_line, 0);
-    lv_obj_align(line_head1, LV_ALIGN_TOP_LEFT, 0, 0);
-
-    line_head2 = lv_line_create(parent);
-    lv_obj_add_style(line_head2, &style_arrow_line, 0);
-    lv_obj_align(line_head2, LV_ALIGN_TOP_LEFT, 0, 0);
+    // Two arrow groups over the arrow zone; the second starts hidden (staging)
+    for (int i = 0; i < 2; i++) {
+        arrow_group_t *g = &arrow_groups[i];
+        g->cont = lv_obj_create(parent);
+        lv_obj_add_style(g->cont, &style_arrow_canvas, 0);
+        lv_obj_set_size(g->cont, 172, 60 + ARROW_HEIGHT);
+        lv_obj_align(g->cont, LV_ALIGN_TOP_LEFT, 0, 0);
+        lv_obj_clear_flag(g->cont, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_clear_flag(g->cont, LV_OBJ_FLAG_CLICKABLE);
+
+        g->line_poly = lv_line_create(g->cont);
+        lv_obj_add_style(g->line_poly, &g->style_line, 0);
+        lv_obj_align(g->line_poly, LV_ALIGN_TOP_LEFT, 0, 0);
+
+        g->line_shaft = lv_line_create(g->cont);
+        lv_obj_add_style(g->line_shaft, &g->style_line, 0);
+        lv_obj_align(g->line_shaft, LV_ALIGN_TOP_LEFT, 0, 0);
+
+        g->line_head1 = lv_line_create(g->cont);
+        lv_obj_add_style(g->line_head1, &g->style_line, 0);
+        lv_obj_align(g->line_head1, LV_ALIGN_TOP_LEFT, 0, 0);
+
+        g->line_head2 = lv_line_create(g->cont);
+        lv_obj_add_style(g->line_head2, &g->style_line, 0);
+        lv_obj_align(g->line_head2, LV_ALIGN_TOP_LEFT, 0, 0);
+
+        // Destination flag (hidden until a destination direction arrives)
+        g->flag_pole = lv_line_create(g->cont);
+        lv_obj_add_style(g->flag_pole, &style_flag_pole, 0);
+        lv_obj_align(g->flag_pole, LV_ALIGN_TOP_LEFT, 0, 0);
+
+        g->flag_triangle = lv_line_create(g->cont);
+        lv_obj_add_style(g->flag_triangle, &style_flag_triangle, 0);
+        lv_obj_align(g->flag_triangle, LV_ALIGN_TOP_LEFT, 0, 0);
+    }
+    arrow_shown = &arrow_groups[0];
+    arrow_staged = &arrow_groups[1];
+    lv_obj_add_flag(arrow_staged->cont, LV_OBJ_FLAG_HIDDEN);
+
+    // "then" glyph for the maneuver after this one (hidden until the phone sends one)
+    label_then = lv_label_create(parent);
+    if (label_then) {
+        lv_label_set_text_static(label_then, then_text);
+        lv_obj_set_size(label_then, 170, 24);
+        lv_obj_set_style_text_color(label_then, lv_color_hex(COLOR_TEXT_SECONDARY), LV_PART_MAIN);
+        lv_obj_set_style_text_font(label_then, lv_font_default(), LV_PART_MAIN);
+        lv_obj_set_style_text_align(label_then, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(label_then, LV_OPA_TRANSP, LV_PART_MAIN);
+        lv_obj_align(label_then, LV_ALIGN_TOP_MID, 0, 4);
+        lv_obj_clear_flag(label_then, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_flag(label_then, LV_OBJ_FLAG_HIDDEN);
+    }
 
     // Do not default to straight; start with no direction and hidden arrows
     strncpy(current_direction, "", sizeof(current_direction) - 1);
@@ -490,7 +630,17 @@ void ui_navigation_screen_create(lv_obj_t *parent) {
     }
     
     lv_obj_add_style(label_distance, &style_distance_text, 0);
-    lv_label_set_text(label_distance, "");
+    lv_label_set_text_static(label_distance, distance_text);
+    
+    // Dead-reckoning timer (created once, paused until a moving distance arrives)
+    if (distance_timer == nullptr) {
+        distance_timer = lv_timer_create(distance_timer_cb, NAV_ESTIMATOR_TICK_MS, nullptr);
+        lv_timer_pause(distance_timer);
+    }
+    if (eta_timer == nullptr) {
+        eta_timer = lv_timer_create(eta_timer_cb, ETA_TICK_MS, nullptr);
+        lv_timer_pause(eta_timer);
+    }
     lv_obj_set_size(label_distance, 170, 50);
     lv_obj_set_style_text_color(label_distance, lv_color_hex(0xFFFF), LV_PART_MAIN);
     lv_obj_set_style_text_font(label_distance, lv_font_default(), LV_PART_MAIN);
@@ -505,7 +655,7 @@ void ui_navigation_screen_create(lv_obj_t *parent) {
     label_maneuver = lv_label_create(parent);
     if (label_maneuver) {
         lv_obj_add_style(label_maneuver, &style_maneuver_text, 0);
-        lv_label_set_text(label_maneuver, "");
+        lv_label_set_text_static(label_maneuver, maneuver_text);
         lv_obj_set_width(label_maneuver, 170);
         lv_obj_set_height(label_maneuver, 50);
         lv_obj_set_style_text_color(label_maneuver, lv_color_hex(COLOR_ACCENT_YELLOW), LV_PART_MAIN);
@@ -521,7 +671,7 @@ void ui_navigation_screen_create(lv_obj_t *parent) {
     label_eta_banner = lv_label_create(parent);
     if (label_eta_banner) {
         lv_obj_add_style(label_eta_banner, &style_eta_text, 0);
-        lv_label_set_text(label_eta_banner, "");
+        lv_label_set_text_static(label_eta_banner, eta_text);
         lv_obj_set_size(label_eta_banner, 170, 30);
         lv_obj_set_style_text_color(label_eta_banner, lv_color_hex(COLOR_ACCENT_YELLOW), LV_PART_MAIN);
         lv_obj_set_style_text_font(label_eta_banner, lv_font_default(), LV_PART_MAIN);
@@ -532,7 +682,7 @@ void ui_navigation_screen_create(lv_obj_t *parent) {
     }
     
     uint16_t arrow_color = COLOR_ARROW_STRAIGHT;
-    update_arrow_image("straight", arrow_color);
+    update_arrow_image(arrow_shown, "straight", arrow_color);
     
     Serial.println("[UI] Navigation screen created (LINE-BASED ARROWS, initially hidden)");
 }
@@ -555,52 +705,178 @@ void ui_navigation_screen_update_direction(const char* direction, bool animated)
         return;
     }
     
+    // The maneuver the phone announced before: already built, and no longer "next"
+    if (next_count > 0 && strcmp(next_maneuvers[0].direction, direction) == 0) {
+        next_count--;
+        memmove(&next_maneuvers[0], &next_maneuvers[1], next_count * sizeof(next_maneuvers[0]));
+    }
+    
     // Accept explicit straight/forward from app (do not suppress)
     // Update and render normally
     strncpy(current_direction, direction, sizeof(current_direction) - 1);
     current_direction[sizeof(current_direction) - 1] = '\0';
     
-    uint16_t arrow_color = COLOR_ARROW_STRAIGHT;
-    update_arrow_image(direction, arrow_color);
-    Serial.printf("[NAV] Updated direction to: %s\n", direction);
+    uint32_t start_us = micros();
+    uint32_t build_us = 0;
+    bool staged = show_arrow(direction, &build_us);
+    nav_lookahead_mark_switch(staged ? NAV_SWITCH_PHONE_STAGED : NAV_SWITCH_PHONE_UNSTAGED, start_us, build_us);
+    stage_next();
+    Serial.printf("[NAV] Updated direction to: %s%s\n", direction, staged ? " (staged)" : "");
 }
 
-void ui_navigation_screen_update_distance(int distance, bool animated) {
-    if (!label_distance) return;
-    
-    current_distance = distance;
+// Render a distance; returns true if the label text changed
+static bool render_distance(int distance) {
+    shown_distance = distance;
     
     if (distance <= 0) {
-        lv_label_set_text(label_distance, "");
+        distance_text[0] = '\0';
+        lv_label_set_text_static(label_distance, distance_text);
         ui_navigation_screen_show_critical_alert(false);
-        return;
+        return true;
     }
 
-    char distance_str[32];
-    if (distance >= 1000) {
-        snprintf(distance_str, sizeof(distance_str), "%.1f km", distance / 1000.0f);
-    } else {
-        snprintf(distance_str, sizeof(distance_str), "%d m", distance);
+    char text[sizeof(distance_text)];
+    ui_format_distance(text, sizeof(text), distance, distance_units);
+    bool changed = strcmp(text, distance_text) != 0;
+    if (changed) {
+        memcpy(distance_text, text, sizeof(distance_text));
+        lv_label_set_text_static(label_distance, distance_text);
     }
     
-    lv_label_set_text(label_distance, distance_str);
-    
     bool should_show_alert = (distance > 0 && distance < 100);
     if (should_show_alert != critical_alert_active) {
         ui_navigation_screen_show_critical_alert(should_show_alert);
     }
+    return changed;
+}
+
+// Count the distance down between phone updates (UI task, NAV_ESTIMATOR_TICK_MS)
+static void distance_timer_cb(lv_timer_t *timer) {
+    if (!label_distance) return;
+    uint32_t now = sys_clock_ms();
+    if (!nav_estimator_active(now)) return;  // Hold the last value
+    
+    int32_t estimate = nav_estimator_predict(now);
+    // At the turn: the next maneuver is already built, don't wait for the phone
+    if (estimate <= 0 && next_count > 0) {
+        advance_to_next(NAV_SWITCH_LOCAL);
+        return;
+    }
+    if (estimate == shown_distance) return;
+    if (render_distance(estimate)) {
+        nav_estimator_record_local_update();
+    }
+}
+
+// Render the remaining time to arrival (only touches the label when the text changes)
+static void render_eta_countdown(void) {
+    int32_t remaining_ms = (int32_t)(arrival_ms - sys_clock_ms());
+    char text[sizeof(eta_text)];
+    ui_format_eta(text, sizeof(text), remaining_ms > 0 ? (uint32_t)remaining_ms / 1000 : 0);
+    if (strcmp(text, eta_text) == 0) return;
+    memcpy(eta_text, text, sizeof(eta_text));
+    lv_label_set_text_static(label_eta_banner, eta_text);
+}
+
+static void eta_timer_cb(lv_timer_t *timer) {
+    if (!label_eta_banner || arrival_ms == 0) return;
+    render_eta_countdown();
+}
+
+void ui_navigation_screen_update_distance(int distance, bool animated) {
+    if (!label_distance) return;
+    
+    current_distance = distance;
+    
+    // Snap to ground truth; 'animated' keeps counting down from here
+    if (animated && distance > 0) {
+        nav_estimator_add_sample(distance, sys_clock_ms());
+        if (distance_timer) lv_timer_resume(distance_timer);
+    } else {
+        nav_estimator_reset();
+        if (distance_timer) lv_timer_pause(distance_timer);
+    }
+    render_distance(distance);
+}
+
+void ui_navigation_screen_set_units(UIDistanceUnits units) {
+    distance_units = units;
+    if (shown_distance > 0) {
+        render_distance(shown_distance);
+    }
+    stage_next();
+}
+
+// Switch to next_maneuvers[0] (the turn was reached locally)
+static void advance_to_next(NavSwitchKind kind) {
+    uint32_t start_us = micros();
+    nav_next_t next = next_maneuvers[0];
+    next_count--;
+    memmove(&next_maneuvers[0], &next_maneuvers[1], next_count * sizeof(next_maneuvers[0]));
+    
+    // Until the phone catches up, its frames still describe the maneuver just passed
+    strlcpy(passed_direction, current_direction, sizeof(passed_direction));
+    passed_until_ms = sys_clock_ms() + NAV_LOOKAHEAD_HOLD_MS;
+    
+    strlcpy(current_direction, next.direction, sizeof(current_direction));
+    uint32_t build_us = 0;
+    show_arrow(next.direction, &build_us);
+    current_distance = next.gap_m;
+    nav_estimator_rebase(next.gap_m, sys_clock_ms());
+    render_distance(next.gap_m);
+    if (next.maneuver[0] != '\0') ui_navigation_screen_update_maneuver(next.maneuver);
+    nav_lookahead_mark_switch(kind, start_us, build_us);
+    stage_next();
+    Serial.printf("[NAV] Reached the turn - switched to: %s\n", current_direction);
+}
+
+void ui_navigation_screen_set_next(const char *const *directions, const int *gaps_m,
+                                   const char *const *maneuvers, uint8_t count) {
+    if (count > NAV_LOOKAHEAD_MAX) count = NAV_LOOKAHEAD_MAX;
+    next_count = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (directions[i] == nullptr || directions[i][0] == '\0') break;
+        nav_next_t *next = &next_maneuvers[next_count++];
+        strlcpy(next->direction, directions[i], sizeof(next->direction));
+        next->gap_m = gaps_m[i] > 0 ? gaps_m[i] : 0;
+        strlcpy(next->maneuver, maneuvers[i] ? maneuvers[i] : "", sizeof(next->maneuver));
+    }
+    stage_next();
+}
+
+bool ui_navigation_screen_is_passed(const char *direction) {
+    if (passed_direction[0] == '\0' || direction == nullptr) return false;
+    // Over once the phone sends the new maneuver, or after the hold time
+    if (strcmp(direction, current_direction) == 0 || (int32_t)(sys_clock_ms() - passed_until_ms) >= 0) {
+        passed_direction[0] = '\0';
+        return false;
+    }
+    return strcmp(passed_direction, direction) == 0;
 }
 
 void ui_navigation_screen_update_maneuver(const char* maneuver) {
     if (!label_maneuver || !maneuver) return;
-    lv_label_set_text(label_maneuver, maneuver);
-    Serial.printf("[NAV] Updated maneuver: %s\n", maneuver);
+    if (strcmp(maneuver_text, maneuver) == 0) return;
+    strlcpy(maneuver_text, maneuver, sizeof(maneuver_text));
+    lv_label_set_text_static(label_maneuver, maneuver_text);
+    alloc_guard_printf("[NAV] Updated maneuver: %s\n", maneuver_text);
 }
 
 void ui_navigation_screen_update_eta(const char* eta) {
     if (!label_eta_banner || !eta) return;
-    lv_label_set_text(label_eta_banner, eta);
-    Serial.printf("[NAV] Updated ETA: %s\n", eta);
+    arrival_ms = 0;
+    if (eta_timer) lv_timer_pause(eta_timer);
+    if (strcmp(eta_text, eta) == 0) return;
+    strlcpy(eta_text, eta, sizeof(eta_text));
+    lv_label_set_text_static(label_eta_banner, eta_text);
+    alloc_guard_printf("[NAV] Updated ETA: %s\n", eta_text);
+}
+
+void ui_navigation_screen_set_arrival(uint32_t arrival) {
+    if (!label_eta_banner) return;
+    arrival_ms = arrival ? arrival : 1;  // 0 is reserved for "no countdown"
+    render_eta_countdown();
+    if (eta_timer) lv_timer_resume(eta_timer);
 }
 
 void ui_navigation_screen_show_critical_alert(bool show) {
@@ -617,9 +893,20 @@ void ui_navigation_screen_update_compass(int heading) {
 }
 
 void ui_navigation_screen_clear(void) {
-    if (label_distance) lv_label_set_text(label_distance, "");
-    if (label_maneuver) lv_label_set_text(label_maneuver, "");
-    if (label_eta_banner) lv_label_set_text(label_eta_banner, "");
+    distance_text[0] = '\0';
+    maneuver_text[0] = '\0';
+    next_count = 0;
+    passed_direction[0] = '\0';
+    stage_next();
+    eta_text[0] = '\0';
+    shown_distance = 0;
+    nav_estimator_reset();
+    if (distance_timer) lv_timer_pause(distance_timer);
+    arrival_ms = 0;
+    if (eta_timer) lv_timer_pause(eta_timer);
+    if (label_distance) lv_label_set_text_static(label_distance, distance_text);
+    if (label_maneuver) lv_label_set_text_static(label_maneuver, maneuver_text);
+    if (label_eta_banner) lv_label_set_text_static(label_eta_banner, eta_text);
 
     strncpy(current_direction, "", sizeof(current_direction) - 1);
     current_direction[sizeof(current_direction) - 1] = '\0';
@@ -2,6 +2,7 @@
 #define UI_NAVIGATION_SCREEN_H
 
 #include <lvgl.h>
+#include "ui_format.h"
 
 /**
  * Create navigation screen UI (LVGL version)
@@ -23,18 +24,48 @@ void ui_navigation_screen_update_direction(const char* direction, bool animated
  */
 void ui_navigation_screen_update_distance(int distance, bool animated = true);
 
+/**
+ * Set the distance unit policy (metric by default)
+ * Re-renders the current distance
+ */
+void ui_navigation_screen_set_units(UIDistanceUnits units);
+
 /**
  * Update maneuver instruction text
  * @param maneuver Maneuver text (auto-wraps)
  */
 void ui_navigation_screen_update_maneuver(const char* maneuver);
 
+/**
+ * Set the upcoming maneuvers (lookahead, nearest first; count 0 clears them)
+ * The first one's arrow is built hidden and a "then" glyph shows it; the
+ * arrow is swapped in when the distance countdown reaches zero or the phone
+ * sends that direction (see nav_lookahead.h).
+ * @param gaps_m Meters from the previous maneuver (0 = unknown)
+ * @param maneuvers Instruction texts (entries may be nullptr)
+ */
+void ui_navigation_screen_set_next(const char *const *directions, const int *gaps_m,
+                                   const char *const *maneuvers, uint8_t count);
+
+/**
+ * Check if a direction is the maneuver just passed locally (phone not caught up yet)
+ * Frames for it should not be drawn.
+ */
+bool ui_navigation_screen_is_passed(const char *direction);
+
 /**
  * Update ETA display
  * @param eta ETA string (e.g., "5 min", "Arriving in 2 min")
  */
 void ui_navigation_screen_update_eta(const char* eta);
 
+/**
+ * Count the ETA down locally until the given arrival time
+ * Replaced by the next ui_navigation_screen_update_eta() or set_arrival() call.
+ * @param arrival_ms Arrival time on the sys_clock_ms() clock
+ */
+void ui_navigation_screen_set_arrival(uint32_t arrival_ms);
+
 /**
  * Show critical navigation alert (for < 100m distance)
  * @param show True to show pulsing alert, false to hide
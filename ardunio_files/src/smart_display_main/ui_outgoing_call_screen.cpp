@@ -1,6 +1,6 @@
 #include <Arduino.h>
-#include <stdio.h>
 #include "ui_outgoing_call_screen.h"
+#include "ui_format.h"
 #include <string.h>
 
 // UI element references
@@ -11,6 +11,13 @@ static lv_obj_t *label_duration = nullptr;
 static lv_obj_t *btn_hangup = nullptr;
 static lv_obj_t *img_avatar = nullptr;
 
+// Last call state shown (re-applied when the screen is rebuilt)
+static char cached_name[48] = "";
+static char avatar_initial[2] = "";   // Labels show the cached texts in place (lv_label_set_text_static)
+static bool cached_connecting = true;
+static int cached_duration = 0;
+static char duration_text[12] = "";   // label_duration shows this in place
+
 // Callback
 static hangup_callback_t hangup_cb = nullptr;
 
@@ -30,6 +37,16 @@ static void btn_hangup_event_cb(lv_event_t *e) {
     }
 }
 
+// Screen deleted (evicted by ui_screens) - drop dangling references
+static void screen_delete_event_cb(lv_event_t *e) {
+    label_name = nullptr;
+    label_status = nullptr;
+    spinner = nullptr;
+    label_duration = nullptr;
+    btn_hangup = nullptr;
+    img_avatar = nullptr;
+}
+
 // Spinner animation callback (removed - spinner handles rotation automatically)
 // LVGL spinner widget rotates on its own, no manual animation needed
 
@@ -44,6 +61,7 @@ void ui_outgoing_call_screen_create(lv_obj_t *parent) {
     // Set screen background to black
     lv_obj_set_style_bg_color(parent, lv_color_hex(0x000000), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(parent, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_add_event_cb(parent, screen_delete_event_cb, LV_EVENT_DELETE, nullptr);
     
     // Initialize styles only once (critical - re-initializing causes crash)
     if (!outgoing_styles_initialized) {
@@ -134,32 +152,45 @@ void ui_outgoing_call_screen_create(lv_obj_t *parent) {
     lv_obj_set_style_text_font(label_hangup_icon, lv_font_default(), 0);
     lv_obj_center(label_hangup_icon);
     
+    // Restore state set while the screen was not built
+    if (cached_name[0] != '\0') {
+        ui_outgoing_call_screen_update(cached_name);
+    }
+    ui_outgoing_call_screen_set_connecting(cached_connecting);
+    ui_outgoing_call_screen_update_duration(cached_duration);
+    
     Serial.println("[UI] Outgoing call screen created");
 }
 
 void ui_outgoing_call_screen_update(const char *name) {
+    // Remember for a later rebuild (no-op when re-applying the cache)
+    if (name != cached_name) {
+        strlcpy(cached_name, name ? name : "", sizeof(cached_name));
+    }
+    
     if (label_name && lv_obj_is_valid(label_name)) {
         if (name && strlen(name) > 0) {
-            lv_label_set_text(label_name, name);
+            lv_label_set_text_static(label_name, cached_name);
             
             // Update avatar with first letter (safe check for name length)
             if (img_avatar && lv_obj_is_valid(img_avatar) && name && strlen(name) > 0) {
                 lv_obj_t *avatar_label = lv_obj_get_child(img_avatar, 0);
                 if (avatar_label && lv_obj_is_valid(avatar_label)) {
-                    char initial[2] = {name[0], '\0'};
-                    lv_label_set_text(avatar_label, initial);
+                    avatar_initial[0] = cached_name[0];
+                    lv_label_set_text_static(avatar_label, avatar_initial);
                 }
             }
         } else {
-            lv_label_set_text(label_name, "Unknown");
+            lv_label_set_text_static(label_name, "Unknown");
         }
     }
 }
 
 void ui_outgoing_call_screen_set_connecting(bool connecting) {
+    cached_connecting = connecting;
     if (label_status && lv_obj_is_valid(label_status)) {
         if (connecting) {
-            lv_label_set_text(label_status, "Calling");
+            lv_label_set_text_static(label_status, "Calling");
             // Show spinner
             if (spinner && lv_obj_is_valid(spinner)) {
                 lv_obj_clear_flag(spinner, LV_OBJ_FLAG_HIDDEN);
@@ -169,7 +200,7 @@ void ui_outgoing_call_screen_set_connecting(bool connecting) {
                 lv_obj_add_flag(label_duration, LV_OBJ_FLAG_HIDDEN);
             }
         } else {
-            lv_label_set_text(label_status, "Connected");
+            lv_label_set_text_static(label_status, "Connected");
             // Hide spinner
             if (spinner && lv_obj_is_valid(spinner)) {
                 lv_obj_add_flag(spinner, LV_OBJ_FLAG_HIDDEN);
@@ -183,12 +214,10 @@ void ui_outgoing_call_screen_set_connecting(bool connecting) {
 }
 
 void ui_outgoing_call_screen_update_duration(int duration_seconds) {
+    cached_duration = duration_seconds;
     if (label_duration && lv_obj_is_valid(label_duration)) {
-        int minutes = duration_seconds / 60;
-        int seconds = duration_seconds % 60;
-        char duration_str[16];
-        snprintf(duration_str, sizeof(duration_str), "%02d:%02d", minutes, seconds);
-        lv_label_set_text(label_duration, duration_str);
+        ui_format_mmss(duration_text, sizeof(duration_text), duration_seconds > 0 ? duration_seconds : 0);
+        lv_label_set_text_static(label_duration, duration_text);
     }
 }
 
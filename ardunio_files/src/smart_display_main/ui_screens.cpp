@@ -6,9 +6,12 @@
 #include "ui_incoming_call_screen.h"
 #include "ui_outgoing_call_screen.h"
 #include "ui_missed_call_screen.h"
-
-// Forward declarations - screen objects need to be accessible
-extern lv_obj_t *screen_incoming_call;
+#include "ui_anim.h"
+#include "ui_transition.h"
+#include "perf_hud.h"
+#include "render_profiler.h"
+#include "lv_mem_pool.h"
+#include "freertos/semphr.h"
 
 // Screen objects
 lv_obj_t *screen_welcome = nullptr;
@@ -21,65 +24,227 @@ lv_obj_t *screen_missed_call = nullptr;
 // Current active screen
 UIScreen current_screen = UI_SCREEN_NONE;
 
+// Pending screen switch (posted by ui_show_screen, committed by ui_screens_process_pending)
+static UIScreen pending_screen = UI_SCREEN_NONE;
+static uint32_t pending_anim_time = 0;
+static UITransition pending_transition = UI_TRANSITION_NONE;
+static uint32_t pending_request_us = 0;   // Time of the first request in this batch
+static portMUX_TYPE pending_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Frame lock: held by loop() for a whole frame and by the BLE task for a
+// whole batch, so a frame never renders half a batch (recursive: batches nest)
+static SemaphoreHandle_t frame_lock = nullptr;
+static uint32_t batch_depth = 0;   // Only touched with frame_lock held
+
+// Switch latency tracking (commit -> first flush)
+static uint32_t awaiting_flush_request_us = 0;
+static bool awaiting_flush = false;
+
+// Statistics
+static uint32_t stat_switch_requests = 0;
+static uint32_t stat_switch_commits = 0;
+static uint32_t stat_switch_collapsed = 0;   // Requests overwritten before commit
+static uint32_t stat_switch_redundant = 0;   // Requests for the screen already shown
+static uint32_t stat_latency_sum_us = 0;
+static uint32_t stat_latency_max_us = 0;
+static uint32_t stat_latency_samples = 0;
+static uint32_t stat_batches = 0;
+static uint32_t stat_batch_hold_us_max = 0;
+static uint32_t batch_start_us = 0;
+
+// Screen pool entry
+typedef struct {
+    lv_obj_t **obj;                      // Exported screen pointer (nullptr while not built)
+    void (*create)(lv_obj_t *parent);    // Module constructor
+    bool evictable;                      // May be destroyed under memory pressure
+    uint32_t last_used_ms;               // LRU timestamp (last commit)
+    uint32_t builds;                     // Times constructed
+    uint32_t last_build_us;              // Duration of the last construction
+} screen_entry_t;
+
+// Indexed by UIScreen. Welcome/idle/navigation are updated straight after a
+// switch request (before it is committed), so they are built during boot and pinned.
+// Call screens cache their state and are built on first show.
+static screen_entry_t screen_pool[] = {
+    {nullptr,               nullptr,                        false, 0, 0, 0},  // UI_SCREEN_NONE
+    {&screen_welcome,       ui_welcome_screen_create,       false, 0, 0, 0},
+    {&screen_idle,          ui_idle_screen_create,          false, 0, 0, 0},
+    {&screen_navigation,    ui_navigation_screen_create,    false, 0, 0, 0},
+    {&screen_incoming_call, ui_incoming_call_screen_create, true,  0, 0, 0},
+    {&screen_outgoing_call, ui_outgoing_call_screen_create, true,  0, 0, 0},
+    {&screen_missed_call,   ui_missed_call_screen_create,   true,  0, 0, 0},
+};
+
+// Memory statistics
+static uint32_t mem_used_after_init = 0;   // After the last boot prebuild
+static uint32_t stat_evictions = 0;
+static uint32_t stat_cold_switches = 0;
+static uint32_t stat_cold_latency_sum_us = 0;
+static uint32_t stat_cold_latency_max_us = 0;
+static bool awaiting_flush_cold = false;
+
+// Screen names, also used as LVGL heap tags (tag = UIScreen)
+static const char *const screen_names[] = {
+    "lvgl", "welcome", "idle", "navigation", "incoming", "outgoing", "missed"
+};
+
+static uint32_t lvgl_mem_used(void) {
+    lv_mem_pool_stats_t stats;
+    lv_mem_pool_get_stats(&stats);
+    return stats.live_bytes;
+}
+
+static lv_obj_t *screen_object(UIScreen screen) {
+    if (screen <= UI_SCREEN_NONE || screen > UI_SCREEN_MISSED_CALL) return nullptr;
+    return *screen_pool[screen].obj;
+}
+
+static void evict_screen(UIScreen screen) {
+    screen_entry_t *entry = &screen_pool[screen];
+    if (*entry->obj == nullptr) return;
+    
+    uint32_t used_before = lvgl_mem_used();
+    lv_obj_del(*entry->obj);  // Modules null their widget pointers on LV_EVENT_DELETE
+    *entry->obj = nullptr;
+    stat_evictions++;
+    Serial.printf("[UI] Evicted screen %d (freed %lu bytes)\n", screen, used_before - lvgl_mem_used());
+}
+
+// Destroy least recently used cold screens until the LVGL heap has headroom
+static void trim_pool(UIScreen keep) {
+    lv_mem_pool_stats_t stats;
+    lv_mem_pool_get_stats(&stats);
+    
+    while (stats.free_bytes < UI_SCREENS_MIN_FREE_BYTES) {
+        UIScreen victim = UI_SCREEN_NONE;
+        for (int i = UI_SCREEN_WELCOME; i <= UI_SCREEN_MISSED_CALL; i++) {
+            screen_entry_t *entry = &screen_pool[i];
+            if (!entry->evictable || *entry->obj == nullptr) continue;
+            if (i == keep || *entry->obj == lv_scr_act()) continue;
+            if (victim == UI_SCREEN_NONE || entry->last_used_ms < screen_pool[victim].last_used_ms) {
+                victim = (UIScreen)i;
+            }
+        }
+        if (victim == UI_SCREEN_NONE) break;  // Nothing left to evict
+        
+        evict_screen(victim);
+        lv_mem_pool_get_stats(&stats);
+    }
+}
+
+// Build a screen if it is not constructed yet
+static lv_obj_t *ensure_screen(UIScreen screen) {
+    if (screen <= UI_SCREEN_NONE || screen > UI_SCREEN_MISSED_CALL) return nullptr;
+    
+    screen_entry_t *entry = &screen_pool[screen];
+    if (*entry->obj != nullptr) return *entry->obj;
+    
+    trim_pool(screen);
+    
+    uint32_t start_us = micros();
+    uint8_t prev_tag = lv_mem_pool_set_tag(screen);  // Charge the widget tree to this screen
+    lv_obj_t *obj = lv_obj_create(nullptr);
+    if (obj == nullptr) {
+        lv_mem_pool_set_tag(prev_tag);
+        Serial.printf("[UI] ERROR: Failed to create screen %d\n", screen);
+        return nullptr;
+    }
+    *entry->obj = obj;
+    entry->create(obj);
+    lv_mem_pool_set_tag(prev_tag);
+    
+    // Cancel the screen's animations when it is unloaded
+    ui_anim_bind_screen(obj);
+    perf_hud_bind_screen(obj);  // Long press toggles the performance HUD
+    render_profiler_attach_screen(obj);
+    
+    entry->last_build_us = micros() - start_us;
+    entry->builds++;
+    Serial.printf("[UI] Built screen %d in %luus\n", screen, entry->last_build_us);
+    return obj;
+}
+
 void ui_screens_init(void) {
     Serial.println("[UI] Initializing screens...");
     
-    // Create all screen objects
-    screen_welcome = lv_obj_create(nullptr);
-    screen_idle = lv_obj_create(nullptr);
-    screen_navigation = lv_obj_create(nullptr);
-    screen_incoming_call = lv_obj_create(nullptr);
-    screen_outgoing_call = lv_obj_create(nullptr);
-    screen_missed_call = lv_obj_create(nullptr);
-    
-    // Verify all screens were created
-    if (!screen_welcome || !screen_idle || !screen_navigation || 
-        !screen_incoming_call || !screen_outgoing_call || !screen_missed_call) {
+    if (frame_lock == nullptr) frame_lock = xSemaphoreCreateRecursiveMutex();
+    
+    for (int i = UI_SCREEN_WELCOME; i <= UI_SCREEN_MISSED_CALL; i++) {
+        lv_mem_pool_set_tag_name(i, screen_names[i]);
+    }
+    
+    // Only the first visible screen is built here; the other pinned screens
+    // are prebuilt between frames during boot, call screens on first show
+    if (ensure_screen(UI_SCREEN_WELCOME) == nullptr) {
         Serial.println("[UI] ERROR: Failed to create screen objects!");
         return;
     }
     
-    Serial.println("[UI] Screen objects created, initializing UI elements...");
-    
-    // Initialize individual screens (setup their UI elements)
-    ui_welcome_screen_create(screen_welcome);
-    ui_idle_screen_create(screen_idle);
-    ui_navigation_screen_create(screen_navigation);
-    ui_incoming_call_screen_create(screen_incoming_call);
-    ui_outgoing_call_screen_create(screen_outgoing_call);
-    ui_missed_call_screen_create(screen_missed_call);
+    mem_used_after_init = lvgl_mem_used();
+    Serial.printf("[UI] Welcome screen initialized (LVGL heap used: %lu bytes)\n", mem_used_after_init);
+}
+
+bool ui_screens_prebuild(UIScreen screen) {
+    if (ensure_screen(screen) == nullptr) return false;
+    mem_used_after_init = lvgl_mem_used();
+    return true;
+}
+
+const char *ui_screens_name(lv_obj_t *screen) {
+    for (int i = UI_SCREEN_WELCOME; i <= UI_SCREEN_MISSED_CALL; i++) {
+        if (screen != nullptr && *screen_pool[i].obj == screen) return screen_names[i];
+    }
+    return "other";
+}
+
+void ui_screens_pin(UIScreen screen) {
+    if (screen <= UI_SCREEN_NONE || screen > UI_SCREEN_MISSED_CALL) return;
+    screen_pool[screen].evictable = false;
+}
+
+static void post_switch(UIScreen screen, uint32_t anim_time, UITransition transition) {
+    if (screen == UI_SCREEN_NONE || screen > UI_SCREEN_MISSED_CALL) {
+        Serial.printf("[UI] Error: Invalid screen ID %d\n", screen);
+        return;
+    }
     
-    Serial.println("[UI] All screens initialized successfully");
+    // Post the request - the switch is committed at the start of the next UI frame.
+    // Several requests within one frame collapse to the last one.
+    uint32_t now_us = micros();
+    portENTER_CRITICAL(&pending_mux);
+    if (pending_screen != UI_SCREEN_NONE) {
+        stat_switch_collapsed++;
+    } else {
+        pending_request_us = now_us;
+    }
+    pending_screen = screen;
+    pending_anim_time = anim_time;
+    pending_transition = anim_time > 0 ? transition : UI_TRANSITION_NONE;
+    stat_switch_requests++;
+    portEXIT_CRITICAL(&pending_mux);
 }
 
 void ui_show_screen(UIScreen screen, uint32_t anim_time) {
-    lv_obj_t *target_screen = nullptr;
-    
-    // Get target screen object
-    switch (screen) {
-        case UI_SCREEN_WELCOME:
-            target_screen = screen_welcome;
-            break;
-        case UI_SCREEN_IDLE:
-            target_screen = screen_idle;
-            break;
-        case UI_SCREEN_NAVIGATION:
-            target_screen = screen_navigation;
-            break;
-        case UI_SCREEN_INCOMING_CALL:
-            target_screen = screen_incoming_call;
-            break;
-        case UI_SCREEN_OUTGOING_CALL:
-            target_screen = screen_outgoing_call;
-            break;
-        case UI_SCREEN_MISSED_CALL:
-            target_screen = screen_missed_call;
-            break;
-        default:
-            Serial.printf("[UI] Error: Invalid screen ID %d\n", screen);
-            return;
-    }
+    post_switch(screen, anim_time, UI_TRANSITION_SLIDE);
+}
+
+void ui_screens_process_pending(void) {
+    UIScreen screen;
+    uint32_t request_us;
+    uint32_t anim_time;
+    UITransition transition;
+    portENTER_CRITICAL(&pending_mux);
+    screen = pending_screen;
+    request_us = pending_request_us;
+    anim_time = pending_anim_time;
+    transition = pending_transition;
+    pending_screen = UI_SCREEN_NONE;
+    portEXIT_CRITICAL(&pending_mux);
+    
+    if (screen == UI_SCREEN_NONE) return;
     
+    bool cold = (screen_object(screen) == nullptr);
+    lv_obj_t *target_screen = ensure_screen(screen);
     if (target_screen == nullptr) {
         Serial.printf("[UI] Error: Screen %d not initialized (null pointer)\n", screen);
         return;
@@ -91,27 +256,151 @@ void ui_show_screen(UIScreen screen, uint32_t anim_time) {
         return;
     }
     
-    // Process LVGL before screen change
-    lv_timer_handler();
+    // A new switch cuts the running transition short
+    ui_transition_finish();
+    screen_pool[screen].last_used_ms = millis();
     
-    Serial.printf("[UI] Loading screen %d (immediate, no animation)\n", screen);
+    // Already showing - nothing to render
+    lv_obj_t *from_screen = lv_scr_act();
+    if (from_screen == target_screen) {
+        stat_switch_redundant++;
+        current_screen = screen;
+        return;
+    }
     
-    // ULTRA SIMPLIFIED: Always use immediate load, no animations EVER
-    // This prevents all animation-related crashes
-    lv_scr_load(target_screen);
+    // Animate only a snapshot of the outgoing screen; fall back to an
+    // immediate load when no transition is requested or the snapshot fails
+    if (ui_transition_start(from_screen, target_screen, transition, anim_time)) {
+        Serial.printf("[UI] Loading screen %d (%s, %lums)\n", screen,
+                      transition == UI_TRANSITION_FADE ? "fade" : "slide", anim_time);
+    } else {
+        Serial.printf("[UI] Loading screen %d (immediate, no animation)\n", screen);
+        lv_scr_load(target_screen);
+    }
+    current_screen = screen;
+    stat_switch_commits++;
     
-    // Process LVGL after screen change (multiple times for stability)
-    for (int i = 0; i < 2; i++) {
-        lv_timer_handler();
+    awaiting_flush_request_us = request_us;
+    awaiting_flush = true;
+    awaiting_flush_cold = cold;
+}
+
+void ui_screens_lock(void) {
+    if (frame_lock) xSemaphoreTakeRecursive(frame_lock, portMAX_DELAY);
+}
+
+void ui_screens_unlock(void) {
+    if (frame_lock) xSemaphoreGiveRecursive(frame_lock);
+}
+
+void ui_screens_batch_begin(void) {
+    ui_screens_lock();
+    if (batch_depth++ == 0) {
+        batch_start_us = micros();
     }
+}
+
+void ui_screens_batch_end(void) {
+    if (batch_depth > 0 && --batch_depth == 0) {
+        uint32_t hold_us = micros() - batch_start_us;
+        stat_batches++;
+        if (hold_us > stat_batch_hold_us_max) stat_batch_hold_us_max = hold_us;
+    }
+    ui_screens_unlock();
+}
+
+void ui_screens_on_flush(void) {
+    if (!awaiting_flush) return;
+    awaiting_flush = false;
     
-    current_screen = screen;
+    uint32_t latency_us = micros() - awaiting_flush_request_us;
+    stat_latency_sum_us += latency_us;
+    stat_latency_samples++;
+    if (latency_us > stat_latency_max_us) {
+        stat_latency_max_us = latency_us;
+    }
+    
+    if (awaiting_flush_cold) {
+        stat_cold_switches++;
+        stat_cold_latency_sum_us += latency_us;
+        if (latency_us > stat_cold_latency_max_us) {
+            stat_cold_latency_max_us = latency_us;
+        }
+    }
+}
+
+void ui_screens_log_stats(void) {
+    uint32_t avg_us = stat_latency_samples ? stat_latency_sum_us / stat_latency_samples : 0;
+    Serial.printf("[UI] switches: requests=%lu commits=%lu collapsed=%lu redundant=%lu latency avg=%luus max=%luus\n",
+                  stat_switch_requests, stat_switch_commits, stat_switch_collapsed,
+                  stat_switch_redundant, avg_us, stat_latency_max_us);
+    
+    uint32_t cold_avg_us = stat_cold_switches ? stat_cold_latency_sum_us / stat_cold_switches : 0;
+    Serial.printf("[UI] cold shows=%lu latency avg=%luus max=%luus evictions=%lu\n",
+                  stat_cold_switches, cold_avg_us, stat_cold_latency_max_us, stat_evictions);
+    
+    if (stat_batches > 0) {
+        Serial.printf("[UI] batches=%lu longest hold=%luus\n",
+                      stat_batches, stat_batch_hold_us_max);
+    }
+}
+
+void ui_screens_log_memory(void) {
+    lv_mem_pool_stats_t stats;
+    lv_mem_pool_get_stats(&stats);
+    
+    char built[8];
+    uint8_t n = 0;
+    for (int i = UI_SCREEN_WELCOME; i <= UI_SCREEN_MISSED_CALL; i++) {
+        built[n++] = (*screen_pool[i].obj != nullptr) ? '0' + i : '-';
+    }
+    built[n] = '\0';
     
-    Serial.printf("[UI] Switched to screen %d successfully\n", screen);
+    Serial.printf("[MEM] LVGL pool: size=%lu live=%lu peak=%lu after_init=%lu free=%lu min_free=%lu biggest=%lu frag=%u%% screens=%s\n",
+                  stats.total_size, stats.live_bytes, stats.peak_bytes, mem_used_after_init,
+                  stats.free_bytes, stats.min_free, stats.largest_free, stats.frag_pct, built);
+    Serial.printf("[MEM] LVGL blocks: live=%lu allocs=%lu frees=%lu failed=%lu\n",
+                  stats.live_blocks, stats.alloc_count, stats.free_count, stats.failed_count);
+    
+    // Per allocation site (tag 0 = everything not charged to a screen build)
+    for (uint8_t tag = 0; tag < LV_MEM_POOL_MAX_TAGS; tag++) {
+        lv_mem_pool_tag_stats_t t;
+        if (!lv_mem_pool_get_tag_stats(tag, &t) || t.alloc_count == 0) continue;
+        Serial.printf("[MEM]   %-10s live=%lu peak=%lu allocs=%lu frees=%lu\n",
+                      t.name ? t.name : "?", t.live_bytes, t.peak_bytes, t.alloc_count, t.free_count);
+    }
+}
+
+void ui_screens_benchmark_cold_show(void) {
+    Serial.println("[BENCH] Cold screen construction:");
+    for (int i = UI_SCREEN_WELCOME; i <= UI_SCREEN_MISSED_CALL; i++) {
+        screen_entry_t *entry = &screen_pool[i];
+        if (!entry->evictable || *entry->obj == lv_scr_act()) continue;
+        
+        bool was_built = (*entry->obj != nullptr);
+        evict_screen((UIScreen)i);
+        
+        uint32_t used_before = lvgl_mem_used();
+        uint32_t start_us = micros();
+        lv_obj_t *obj = ensure_screen((UIScreen)i);
+        if (obj == nullptr) continue;
+        lv_obj_update_layout(obj);  // Include layout, as the first show would
+        uint32_t total_us = micros() - start_us;
+        
+        Serial.printf("[BENCH]   screen %d: build+layout=%luus heap=%lu bytes\n",
+                      i, total_us, lvgl_mem_used() - used_before);
+        
+        if (!was_built) {
+            evict_screen((UIScreen)i);
+        }
+    }
+    stat_evictions = 0;
 }
 
 UIScreen ui_get_current_screen(void) {
-    return current_screen;
+    // A posted switch is the screen callers should reason about
+    UIScreen pending = pending_screen;
+    return pending != UI_SCREEN_NONE ? pending : current_screen;
 }
 
 void ui_show_navigation(void) {
@@ -132,16 +421,18 @@ void ui_show_navigation(void) {
 }
 
 void ui_transition_fade(UIScreen from, UIScreen to, uint32_t time) {
-    lv_obj_t *from_screen = nullptr;
-    lv_obj_t *to_screen = nullptr;
-    
-    // Get screen objects (simplified - would need full switch for all screens)
-    // For now, just transition to target
-    ui_show_screen(to, time);
+    // 'from' is always the screen shown when the switch is committed
+    post_switch(to, time, UI_TRANSITION_FADE);
 }
 
 void ui_screens_cleanup(void) {
     // Cleanup if needed (LVGL handles most cleanup automatically)
+    ui_transition_finish();
+    for (int i = UI_SCREEN_WELCOME; i <= UI_SCREEN_MISSED_CALL; i++) {
+        if (screen_pool[i].evictable && *screen_pool[i].obj != lv_scr_act()) {
+            evict_screen((UIScreen)i);
+        }
+    }
     current_screen = UI_SCREEN_NONE;
 }
 
@@ -3,6 +3,9 @@
 
 #include <lvgl.h>
 
+// Evict cold screens when the LVGL pool has less free space than this
+#define UI_SCREENS_MIN_FREE_BYTES  (8 * 1024)
+
 /**
  * Screen identifiers
  */
@@ -18,6 +21,8 @@ enum UIScreen {
 
 /**
  * Screen objects (created by individual screen modules)
+ * Call screens are nullptr until first shown and may be destroyed again
+ * under memory pressure, unless prebuilt and pinned with ui_screens_pin().
  */
 extern lv_obj_t *screen_welcome;
 extern lv_obj_t *screen_idle;
@@ -32,20 +37,95 @@ extern lv_obj_t *screen_missed_call;
 extern UIScreen current_screen;
 
 /**
- * Initialize all UI screens
- * Creates all screen objects but doesn't show them
+ * Initialize UI screens
+ * Builds only the welcome screen (doesn't show it); idle and navigation are
+ * prebuilt during boot with ui_screens_prebuild(), call screens on first show
  */
 void ui_screens_init(void);
 
+/**
+ * Build a screen ahead of its first show (no-op if already built)
+ * Must be called from the UI task
+ * @return True if the screen exists afterwards
+ */
+bool ui_screens_prebuild(UIScreen screen);
+
+/**
+ * Exclude a screen from eviction (steady state: built once, never destroyed)
+ */
+void ui_screens_pin(UIScreen screen);
+
 /**
  * Show a specific screen
+ * Slides the outgoing screen out when anim_time > 0.
+ * Posts a switch request (safe from any task); it is committed by
+ * ui_screens_process_pending() at the start of the next UI frame.
+ * Requests within the same frame collapse to the last one.
  * @param screen Screen identifier to show
  * @param anim_time Animation duration in milliseconds (0 = no animation)
  */
 void ui_show_screen(UIScreen screen, uint32_t anim_time = 300);
 
+/**
+ * Commit the pending screen switch (if any)
+ * Call from loop() right before lv_timer_handler()
+ */
+void ui_screens_process_pending(void);
+
+/**
+ * Take the frame lock (recursive; created by ui_screens_init())
+ * loop() holds it from the switch commit through lv_timer_handler(), so
+ * a batch applied on the BLE task lands entirely between two frames.
+ */
+void ui_screens_lock(void);
+
+/**
+ * Release the frame lock
+ */
+void ui_screens_unlock(void);
+
+/**
+ * Apply a batch of messages as one UI commit (BLE task)
+ * Takes the frame lock, waiting for a frame in progress to finish.
+ * Nests; every begin needs a matching ui_screens_batch_end().
+ */
+void ui_screens_batch_begin(void);
+
+/**
+ * Release the lock taken by ui_screens_batch_begin()
+ */
+void ui_screens_batch_end(void);
+
+/**
+ * Display flush notification (measures switch-to-first-flush latency)
+ * Called from the display flush callback
+ */
+void ui_screens_on_flush(void);
+
+/**
+ * Print screen switch statistics over serial
+ */
+void ui_screens_log_stats(void);
+
+/**
+ * Print LVGL pool usage (live, peak, fragmentation, per-screen tags) and built screens
+ */
+void ui_screens_log_memory(void);
+
+/**
+ * Measure cold construction time and heap cost of each lazily built screen
+ * Leaves the pool as it was
+ */
+void ui_screens_benchmark_cold_show(void);
+
+/**
+ * Name of a screen object ("other" for objects that aren't pool screens)
+ */
+const char *ui_screens_name(lv_obj_t *screen);
+
 /**
  * Get current active screen
+ * Returns the pending screen if a switch has been requested but not committed
  */
 UIScreen ui_get_current_screen(void);
 
@@ -56,11 +136,15 @@ void ui_show_navigation(void);
 
 /**
  * Transition to screen with fade animation
+ * Posted like ui_show_screen(); fades through black when committed
+ * @param from Unused (the screen shown at commit time fades out)
+ * @param to Screen to show
+ * @param time Fade duration in milliseconds
  */
 void ui_transition_fade(UIScreen from, UIScreen to, uint32_t time);
 
 /**
- * Cleanup screens (free memory if needed)
+ * Cleanup screens (destroys cold call screens)
  */
 void ui_screens_cleanup(void);
 
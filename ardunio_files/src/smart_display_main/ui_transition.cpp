@@ -0,0 +1,196 @@
+#include <Arduino.h>
+#include "ui_transition.h"
+
+#ifdef ESP32
+#include "esp_heap_caps.h"
+#endif
+
+// Reusable snapshot buffer (allocated on first transition, kept afterwards)
+static uint8_t *snap_buf = nullptr;
+static uint32_t snap_buf_size = 0;
+static lv_img_dsc_t snap_dsc;
+
+// Running transition
+static lv_obj_t *overlay = nullptr;       // Root of the transition objects (child of incoming screen)
+static lv_obj_t *img_snapshot = nullptr;  // Snapshot image (slide: overlay itself)
+static lv_obj_t *to_screen = nullptr;
+static UITransition active_type = UI_TRANSITION_NONE;
+static uint32_t phase_time = 0;
+
+// Per-type frame cost statistics
+typedef struct {
+    uint32_t transitions;
+    uint32_t frames;
+    uint32_t frame_sum_us;
+    uint32_t frame_max_us;
+} transition_stats_t;
+
+static transition_stats_t stats_slide = {0, 0, 0, 0};
+static transition_stats_t stats_fade = {0, 0, 0, 0};
+
+static transition_stats_t *stats_for(UITransition type) {
+    return type == UI_TRANSITION_FADE ? &stats_fade : &stats_slide;
+}
+
+static bool ensure_snapshot_buffer(uint32_t needed) {
+    if (snap_buf && snap_buf_size >= needed) return true;
+
+    if (snap_buf) {
+        free(snap_buf);
+        snap_buf = nullptr;
+        snap_buf_size = 0;
+    }
+
+#ifdef ESP32
+    snap_buf = (uint8_t *)heap_caps_malloc(needed, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#else
+    snap_buf = (uint8_t *)malloc(needed);
+#endif
+    if (!snap_buf) {
+        Serial.printf("[TRANSITION] Warning: cannot allocate %lu byte snapshot buffer\n", needed);
+        return false;
+    }
+    snap_buf_size = needed;
+    Serial.printf("[TRANSITION] Snapshot buffer allocated: %lu bytes\n", needed);
+    return true;
+}
+
+static bool take_snapshot(lv_obj_t *obj) {
+    lv_obj_update_layout(obj);
+    if (!ensure_snapshot_buffer(lv_snapshot_buf_size_needed(obj, LV_IMG_CF_TRUE_COLOR))) return false;
+    return lv_snapshot_take_to_buf(obj, LV_IMG_CF_TRUE_COLOR, &snap_dsc, snap_buf, snap_buf_size) == LV_RES_OK;
+}
+
+static void slide_anim_cb(void *var, int32_t value) {
+    lv_obj_set_x((lv_obj_t *)var, value);
+}
+
+static void fade_anim_cb(void *var, int32_t value) {
+    lv_obj_set_style_img_opa((lv_obj_t *)var, (lv_opa_t)value, LV_PART_MAIN);
+}
+
+static void transition_done_cb(lv_anim_t *a) {
+    ui_transition_finish();
+}
+
+static void start_phase(lv_anim_exec_xcb_t exec_cb, int32_t from, int32_t to, lv_anim_ready_cb_t ready_cb) {
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, img_snapshot);
+    lv_anim_set_values(&a, from, to);
+    lv_anim_set_time(&a, phase_time);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_ready_cb(&a, ready_cb);
+    lv_anim_start(&a);
+}
+
+// Fade phase 2: the outgoing snapshot has faded to black - replace it with
+// a snapshot of the incoming screen and fade that in
+static void fade_out_done_cb(lv_anim_t *a) {
+    lv_obj_add_flag(overlay, LV_OBJ_FLAG_HIDDEN);
+    bool ok = take_snapshot(to_screen);
+    lv_obj_clear_flag(overlay, LV_OBJ_FLAG_HIDDEN);
+
+    if (!ok) {
+        ui_transition_finish();
+        return;
+    }
+
+    lv_img_cache_invalidate_src(&snap_dsc);
+    lv_img_set_src(img_snapshot, &snap_dsc);
+    start_phase(fade_anim_cb, LV_OPA_TRANSP, LV_OPA_COVER, transition_done_cb);
+}
+
+bool ui_transition_start(lv_obj_t *from, lv_obj_t *to, UITransition type, uint32_t time) {
+    ui_transition_finish();
+
+    if (from == nullptr || to == nullptr || from == to || type == UI_TRANSITION_NONE || time == 0) {
+        return false;
+    }
+
+    if (!take_snapshot(from)) {
+        Serial.println("[TRANSITION] Snapshot failed - loading immediately");
+        return false;
+    }
+
+    lv_scr_load(to);
+    to_screen = to;
+    active_type = type;
+
+    if (type == UI_TRANSITION_FADE) {
+        // Opaque black cover so the incoming widgets are never drawn under the fade
+        overlay = lv_obj_create(to);
+        lv_obj_remove_style_all(overlay);
+        lv_obj_set_size(overlay, LV_PCT(100), LV_PCT(100));
+        lv_obj_set_style_bg_color(overlay, lv_color_hex(0x000000), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(overlay, LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_clear_flag(overlay, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+
+        img_snapshot = lv_img_create(overlay);
+        phase_time = time / 2;
+    } else {
+        img_snapshot = lv_img_create(to);
+        overlay = img_snapshot;
+        phase_time = time;
+    }
+
+    lv_img_set_src(img_snapshot, &snap_dsc);
+    lv_obj_set_pos(img_snapshot, 0, 0);
+    lv_obj_clear_flag(img_snapshot, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_move_foreground(overlay);
+
+    if (type == UI_TRANSITION_FADE) {
+        start_phase(fade_anim_cb, LV_OPA_COVER, LV_OPA_TRANSP, fade_out_done_cb);
+    } else {
+        start_phase(slide_anim_cb, 0, -lv_obj_get_width(to), transition_done_cb);
+    }
+
+    stats_for(type)->transitions++;
+    return true;
+}
+
+uint32_t ui_transition_buffer_bytes(lv_coord_t width, lv_coord_t height) {
+    return lv_img_buf_get_img_size(width, height, LV_IMG_CF_TRUE_COLOR);
+}
+
+bool ui_transition_reserve(void) {
+    return ensure_snapshot_buffer(ui_transition_buffer_bytes(lv_disp_get_hor_res(nullptr),
+                                                             lv_disp_get_ver_res(nullptr)));
+}
+
+void ui_transition_finish(void) {
+    if (active_type == UI_TRANSITION_NONE) return;
+
+    lv_anim_del(img_snapshot, nullptr);
+    if (overlay && lv_obj_is_valid(overlay)) {
+        lv_obj_del(overlay);
+    }
+    overlay = nullptr;
+    img_snapshot = nullptr;
+    to_screen = nullptr;
+    active_type = UI_TRANSITION_NONE;
+}
+
+bool ui_transition_active(void) {
+    return active_type != UI_TRANSITION_NONE;
+}
+
+void ui_transition_record_frame(uint32_t us) {
+    if (active_type == UI_TRANSITION_NONE) return;
+
+    transition_stats_t *s = stats_for(active_type);
+    s->frames++;
+    s->frame_sum_us += us;
+    if (us > s->frame_max_us) {
+        s->frame_max_us = us;
+    }
+}
+
+void ui_transition_log_stats(void) {
+    const transition_stats_t *s = &stats_slide;
+    Serial.printf("[TRANSITION] slide: count=%lu frames=%lu avg=%luus max=%luus\n",
+                  s->transitions, s->frames, s->frames ? s->frame_sum_us / s->frames : 0, s->frame_max_us);
+    s = &stats_fade;
+    Serial.printf("[TRANSITION] fade: count=%lu frames=%lu avg=%luus max=%luus\n",
+                  s->transitions, s->frames, s->frames ? s->frame_sum_us / s->frames : 0, s->frame_max_us);
+}
@@ -0,0 +1,64 @@
+#ifndef UI_TRANSITION_H
+#define UI_TRANSITION_H
+
+#include <lvgl.h>
+
+/**
+ * Transition types
+ */
+enum UITransition {
+    UI_TRANSITION_NONE = 0,      // Immediate load
+    UI_TRANSITION_SLIDE,         // Outgoing screen slides out to the left
+    UI_TRANSITION_FADE           // Fade through black
+};
+
+/**
+ * Start a snapshot-backed transition
+ * Captures the outgoing screen into a reusable buffer, loads the incoming
+ * screen and animates only the snapshot (blit/blend) on top of it.
+ * Must be called from the UI task.
+ * @param from Outgoing screen (currently loaded)
+ * @param to Incoming screen
+ * @param type Transition type
+ * @param time Duration in milliseconds
+ * @return True if the transition started (and 'to' was loaded),
+ *         false if the caller should load 'to' immediately
+ */
+bool ui_transition_start(lv_obj_t *from, lv_obj_t *to, UITransition type, uint32_t time);
+
+/**
+ * Snapshot buffer size for a screen of this size (budgeted by lvgl_init)
+ */
+uint32_t ui_transition_buffer_bytes(lv_coord_t width, lv_coord_t height);
+
+/**
+ * Allocate the snapshot buffer ahead of the first transition
+ * Sized for the display (all screens are full-size). Call at boot right
+ * after the display driver, while its budgeted share of RAM is still free.
+ * @return True if the buffer is available
+ */
+bool ui_transition_reserve(void);
+
+/**
+ * Finish the running transition immediately (no-op if none)
+ */
+void ui_transition_finish(void);
+
+/**
+ * Check if a transition is running
+ */
+bool ui_transition_active(void);
+
+/**
+ * Record the duration of one lv_timer_handler() call
+ * Only counted while a transition is running
+ * @param us Frame duration in microseconds
+ */
+void ui_transition_record_frame(uint32_t us);
+
+/**
+ * Print per-type transition frame cost over serial
+ */
+void ui_transition_log_stats(void);
+
+#endif // UI_TRANSITION_H
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include "ui_welcome_screen.h"
+#include "ui_anim.h"
 
 // UI element references
 static lv_obj_t *label_title = nullptr;
@@ -15,6 +16,15 @@ static lv_style_t style_status;
 // Style initialization guard
 static bool welcome_styles_initialized = false;
 
+// Loading arc animation callback
+static void arc_loading_anim_cb(lv_obj_t *obj, int32_t value) {
+    lv_arc_set_value(obj, value);
+}
+
+static void start_loading_anim(void) {
+    ui_anim_start(arc_loading, arc_loading_anim_cb, 0, 360, 2000, 0, LV_ANIM_REPEAT_INFINITE);
+}
+
 void ui_welcome_screen_create(lv_obj_t *parent) {
     if (parent == nullptr) {
         Serial.println("[UI] Error: parent is null in ui_welcome_screen_create");
@@ -80,15 +90,7 @@ void ui_welcome_screen_create(lv_obj_t *parent) {
     lv_obj_align(arc_loading, LV_ALIGN_CENTER, 0, 20);
 
     // Animate arc rotation
-    lv_anim_t arc_anim; lv_anim_init(&arc_anim);
-    lv_anim_set_var(&arc_anim, arc_loading);
-    lv_anim_set_values(&arc_anim, 0, 360);
-    lv_anim_set_time(&arc_anim, 2000);
-    lv_anim_set_repeat_count(&arc_anim, LV_ANIM_REPEAT_INFINITE);
-    lv_anim_set_exec_cb(&arc_anim, [](void *var, int32_t value) {
-        lv_arc_set_value((lv_obj_t*)var, value);
-    });
-    lv_anim_start(&arc_anim);
+    start_loading_anim();
 
     // Status label
     label_status = lv_label_create(parent);
@@ -106,6 +108,7 @@ void ui_welcome_screen_update_ble_status(bool connected) {
         lv_label_set_text(label_status, "Connected");
         lv_obj_set_style_text_color(label_status, lv_color_hex(0x00FF00), 0);
         if (arc_loading && lv_obj_is_valid(arc_loading)) {
+            ui_anim_stop(arc_loading);
             lv_obj_add_flag(arc_loading, LV_OBJ_FLAG_HIDDEN);
         }
     } else {
@@ -113,6 +116,7 @@ void ui_welcome_screen_update_ble_status(bool connected) {
         lv_obj_set_style_text_color(label_status, lv_color_hex(0x00FFFF), 0);
         if (arc_loading && lv_obj_is_valid(arc_loading)) {
             lv_obj_clear_flag(arc_loading, LV_OBJ_FLAG_HIDDEN);
+            start_loading_anim();
         }
     }
 }
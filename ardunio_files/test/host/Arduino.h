@@ -0,0 +1,67 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Minimal Arduino/FreeRTOS surface for building firmware modules on the host
+// (single-threaded: critical sections are no-ops, time is set by the test)
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct HostSerial {
+    bool quiet = true;   // Module logs are noise in test output
+
+    int printf(const char *fmt, ...) {
+        if (quiet) return 0;
+        va_list args;
+        va_start(args, fmt);
+        int n = vprintf(fmt, args);
+        va_end(args);
+        return n;
+    }
+
+    void println(const char *s) {
+        if (!quiet) puts(s);
+    }
+
+    size_t write(const uint8_t *buf, size_t len) {
+        if (!quiet) fwrite(buf, 1, len, stdout);
+        return len;
+    }
+};
+
+extern HostSerial Serial;
+extern uint32_t host_now_ms;
+
+inline uint32_t millis() { return host_now_ms; }
+inline uint32_t micros() { return host_now_ms * 1000u; }
+
+// newlib has strlcpy; older glibc does not (and newer glibc declares its own)
+inline size_t host_strlcpy(char *dst, const char *src, size_t size) {
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#define strlcpy host_strlcpy
+
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+
+#define IRAM_ATTR
+
+typedef void *TaskHandle_t;
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+    static int host_task;   // Everything runs on one task
+    return &host_task;
+}
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,170 @@
+// Host test for the zero-allocation message path: links with the same
+// -Wl,--wrap heap flags as the firmware, runs navigation and call messages
+// through the host-buildable modules of the BLE write path inside an
+// alloc_guard scope and fails on any malloc, calloc, realloc or new.
+// Allocations made inside the C library itself (strdup, stdio buffers) are
+// not wrapped here or on the device; see alloc_guard.cpp.
+
+#include <Arduino.h>
+#include <stdlib.h>
+#include "alloc_guard.h"
+#include "ble_frame.h"
+#include "frame_dedup.h"
+#include "caller_directory.h"
+#include "nav_estimator.h"
+#include "sys_clock.h"
+#include "ui_format.h"
+#include "lv_mem_pool.h"
+
+HostSerial Serial;
+uint32_t host_now_ms = 1000;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        checks++;                                                          \
+        if (!(cond)) {                                                     \
+            failures++;                                                    \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                  \
+    } while (0)
+
+// No LVGL pool on the host
+extern "C" void lv_mem_pool_set_alloc_hook(lv_mem_pool_alloc_hook_t hook) {
+    (void)hook;
+}
+
+static uint16_t next_seq[BLE_STREAM_COUNT];
+
+static size_t make_frame(uint8_t *buf, uint8_t stream, uint8_t flags, const char *payload) {
+    size_t len = strlen(payload);
+    uint16_t seq = next_seq[stream]++;
+    buf[0] = BLE_FRAME_MAGIC;
+    buf[1] = (uint8_t)((flags << 4) | stream);
+    buf[2] = (uint8_t)(seq & 0xFF);
+    buf[3] = (uint8_t)(seq >> 8);
+    memcpy(buf + BLE_FRAME_HEADER_LEN, payload, len);
+    return BLE_FRAME_HEADER_LEN + len;
+}
+
+// The allocation-free part of handleWrite/handleMessage for one write
+static void handle_write(const uint8_t *data, size_t len, bool is_call) {
+    ble_frame_t frame;
+    if (!ble_frame_parse(data, len, &frame)) return;
+    if (ble_frame_check(&frame) != BLE_FRAME_ACCEPT) return;
+    const uint8_t *msg;
+    size_t msg_len;
+    if (!ble_frame_reassemble(&frame, millis(), &msg, &msg_len)) return;
+
+    uint32_t hash = frame_dedup_hash(msg, msg_len);
+    if (frame_dedup_match(hash, msg_len, sys_clock_ms()) != FRAME_KIND_NONE) return;
+    FrameDedupDecode decode(hash, msg_len);
+
+    char text[24];
+    if (is_call) {
+        decode.set_kind(FRAME_KIND_CALL);
+        char name[CALLER_DIRECTORY_NAME_LEN];
+        uint32_t number_hash = 0;
+        bool by_id = caller_directory_lookup(7, name, sizeof(name), &number_hash);
+        if (!by_id) number_hash = caller_directory_hash_number("+91 98765 43210");
+        caller_directory_record_call_frame(msg_len, by_id);
+        ui_format_mmss(text, sizeof(text), 187);
+        alloc_guard_printf("[CALL] State=%s, Name=%s, Hash=%08lx\n", "INCOMING", name, (unsigned long)number_hash);
+    } else {
+        decode.set_kind(FRAME_KIND_NAV);
+        int32_t dist = 450 - (int32_t)(next_seq[BLE_STREAM_NAV] % 40) * 10;
+        nav_estimator_add_sample(dist, sys_clock_ms());
+        ui_format_distance(text, sizeof(text), nav_estimator_predict(sys_clock_ms()), UI_UNITS_METRIC);
+        ui_format_eta(text, sizeof(text), 754);
+        alloc_guard_printf("[NAV] dist=%ld, text=%s\n", (long)dist, text);
+    }
+    uint8_t ack[BLE_FRAME_ACK_MAX_LEN];
+    if (ble_frame_ack_due(millis())) ble_frame_build_ack(ack, sizeof(ack));
+}
+
+static void send_nav(uint32_t step) {
+    char json[96];
+    snprintf(json, sizeof(json),
+             "{\"type\":\"NAVIGATION\",\"direction\":\"right\",\"distance\":%lu}", (unsigned long)step);
+    uint8_t buf[128];
+    size_t len = make_frame(buf, BLE_STREAM_NAV, 0, json);
+    handle_write(buf, len, false);
+}
+
+static void send_call_fragments(void) {
+    uint8_t buf[64];
+    static const char *const parts[3] = {
+        "{\"type\":\"phone_call\",", "\"call_state\":\"INCOMING\",", "\"contact\":7}"
+    };
+    static const uint8_t flags[3] = { BLE_FRAME_FLAG_START, BLE_FRAME_FLAG_CONT, BLE_FRAME_FLAG_END };
+    for (int i = 0; i < 3; i++) {
+        size_t len = make_frame(buf, BLE_STREAM_CALL, flags[i], parts[i]);
+        handle_write(buf, len, true);
+    }
+}
+
+// Boot: first use of every module happens before counting starts
+static void boot(void) {
+    alloc_guard_init();
+    caller_directory_clear();
+    caller_directory_put(7, caller_directory_hash_number("9876543210"), "Asha");
+    send_nav(0);
+    send_call_fragments();
+    alloc_guard_mark_boot_complete();
+}
+
+static void test_message_path(void) {
+    for (uint32_t step = 1; step <= 200; step++) {
+        host_now_ms += 100;
+        AllocGuardScope scope;
+        scope.set_kind("nav");
+        send_nav(step);
+    }
+    for (int i = 0; i < 20; i++) {
+        host_now_ms += FRAME_DEDUP_CALL_WINDOW_MS + 1;
+        AllocGuardScope scope;
+        scope.set_kind("call");
+        send_call_fragments();
+    }
+    CHECK(alloc_guard_violations() == 0);
+}
+
+// The guard itself: each allocator is seen, once, and only inside the scope
+static void test_guard_sees_allocators(void) {
+    void *volatile p;
+    uint32_t violations = alloc_guard_violations();
+
+    alloc_guard_scope_begin();
+    p = malloc(16);
+    free(p);
+    CHECK(alloc_guard_scope_end("malloc") == 1);
+
+    alloc_guard_scope_begin();
+    p = calloc(4, 4);
+    p = realloc(p, 64);             // What a growing String does
+    free(p);
+    CHECK(alloc_guard_scope_end("realloc") == 2);
+
+    alloc_guard_scope_begin();
+    int *volatile q = new int(3);
+    delete q;
+    CHECK(alloc_guard_scope_end("new") == 1);   // Not twice (new -> malloc)
+
+    p = malloc(16);                 // Outside a scope: counted in stats only
+    alloc_guard_scope_begin();
+    free(p);
+    CHECK(alloc_guard_scope_end("free") == 0);
+
+    CHECK(alloc_guard_violations() == violations + 3);
+}
+
+int main(void) {
+    boot();
+    test_message_path();
+    test_guard_sees_allocators();
+
+    printf("alloc_guard: %d checks, %d failed\n", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
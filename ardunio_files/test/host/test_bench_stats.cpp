@@ -0,0 +1,153 @@
+// Host test for bench_stats.cpp: nearest-rank percentiles on small, odd,
+// unsorted, duplicated and full-size (REPLAY_BENCH_SAMPLES) sample sets, and
+// the render benchmark's baseline lookup and regression check.
+
+#include <Arduino.h>
+#include "bench_stats.h"
+#include "replay_bench.h"
+
+HostSerial Serial;
+uint32_t host_now_ms = 1000;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        checks++;                                                          \
+        if (!(cond)) {                                                     \
+            failures++;                                                    \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                  \
+    } while (0)
+
+static uint32_t scratch[REPLAY_BENCH_SAMPLES];
+
+static bool percentiles_are(const uint32_t *samples, uint16_t count,
+                            uint32_t p50, uint32_t p95, uint32_t p99, uint32_t max) {
+    uint32_t out[4] = { 1, 1, 1, 1 };
+    bench_stats_percentiles(samples, count, scratch, out);
+    if (out[0] == p50 && out[1] == p95 && out[2] == p99 && out[3] == max) return true;
+    fprintf(stderr, "  n=%u: got %u/%u/%u/%u, expected %u/%u/%u/%u\n", count,
+            out[0], out[1], out[2], out[3], p50, p95, p99, max);
+    return false;
+}
+
+static void test_empty_and_single(void) {
+    uint32_t one[1] = { 42 };
+    CHECK(percentiles_are(one, 0, 0, 0, 0, 0));
+    CHECK(percentiles_are(one, 1, 42, 42, 42, 42));
+}
+
+static void test_small_sets(void) {
+    // Nearest rank: p50 of 2 is the lower sample, p95/p99 of anything under
+    // 20 samples is the max
+    uint32_t two[2] = { 9, 3 };
+    CHECK(percentiles_are(two, 2, 3, 9, 9, 9));
+    uint32_t five[5] = { 50, 10, 40, 20, 30 };
+    CHECK(percentiles_are(five, 5, 30, 50, 50, 50));
+    // The input is left as it was
+    CHECK(five[0] == 50 && five[4] == 30);
+}
+
+static void test_hundred(void) {
+    // 100..1 reversed: every percentile is its own rank
+    uint32_t s[100];
+    for (int i = 0; i < 100; i++) s[i] = 100 - i;
+    CHECK(percentiles_are(s, 100, 50, 95, 99, 100));
+    // Of 100 samples, one slow outlier only moves max; a second one moves p99
+    for (int i = 0; i < 100; i++) s[i] = 1000;
+    s[37] = 90000;
+    CHECK(percentiles_are(s, 100, 1000, 1000, 1000, 90000));
+    s[38] = 80000;
+    CHECK(percentiles_are(s, 100, 1000, 1000, 80000, 90000));
+}
+
+static void test_full_window(void) {
+    // A full sample window, shuffled (ranks 128, 244, 254 of 256)
+    uint32_t s[REPLAY_BENCH_SAMPLES];
+    for (uint32_t i = 0; i < REPLAY_BENCH_SAMPLES; i++) s[i] = (i * 97) % REPLAY_BENCH_SAMPLES + 1;
+    CHECK(percentiles_are(s, REPLAY_BENCH_SAMPLES, 128, 244, 254, 256));
+    // All equal
+    for (uint32_t i = 0; i < REPLAY_BENCH_SAMPLES; i++) s[i] = 7;
+    CHECK(percentiles_are(s, REPLAY_BENCH_SAMPLES, 7, 7, 7, 7));
+    // Extremes of the range
+    s[0] = UINT32_MAX;
+    s[1] = 0;
+    CHECK(percentiles_are(s, REPLAY_BENCH_SAMPLES, 7, 7, 7, UINT32_MAX));
+}
+
+static const render_bench_baseline_t baseline[] = {
+    { "nav_left", 20000, 30000, 12, 0 },
+    { "incoming", 50000, 80000, 40, 256 },
+    { nullptr, 0, 0, 0, 0 }
+};
+
+static void test_find_baseline(void) {
+    CHECK(bench_stats_find_baseline(baseline, "incoming") == &baseline[1]);
+    CHECK(bench_stats_find_baseline(baseline, "nav_left") == &baseline[0]);
+    CHECK(bench_stats_find_baseline(baseline, "nav_right") == nullptr);
+    // The shipped table is just the terminator
+    static const render_bench_baseline_t none[] = { { nullptr, 0, 0, 0, 0 } };
+    CHECK(bench_stats_find_baseline(none, "nav_left") == nullptr);
+}
+
+static void test_regression_check(void) {
+    const render_bench_baseline_t *base = &baseline[0];
+    render_bench_baseline_t r = *base;
+    CHECK(!bench_stats_regressed(&r, base, RENDER_BENCH_TIME_TOLERANCE));
+
+    // Render time: up to the tolerance is noise, past it is a regression
+    r.render_us = 22000;                                // +10%
+    CHECK(!bench_stats_regressed(&r, base, RENDER_BENCH_TIME_TOLERANCE));
+    r.render_us = 22001;
+    CHECK(bench_stats_regressed(&r, base, RENDER_BENCH_TIME_TOLERANCE));
+    CHECK(!bench_stats_regressed(&r, base, 20));
+    r.render_us = 5000;                                 // Faster is fine
+    CHECK(!bench_stats_regressed(&r, base, RENDER_BENCH_TIME_TOLERANCE));
+
+    // Area, flushes and heap have no tolerance; less is fine
+    r = *base;
+    r.inv_px = base->inv_px + 1;
+    CHECK(bench_stats_regressed(&r, base, RENDER_BENCH_TIME_TOLERANCE));
+    r = *base;
+    r.flushes = base->flushes + 1;
+    CHECK(bench_stats_regressed(&r, base, RENDER_BENCH_TIME_TOLERANCE));
+    r = *base;
+    r.heap = 1;
+    CHECK(bench_stats_regressed(&r, base, RENDER_BENCH_TIME_TOLERANCE));
+    r = *base;
+    r.inv_px = 100;
+    r.flushes = 1;
+    r.heap = -512;
+    CHECK(!bench_stats_regressed(&r, base, RENDER_BENCH_TIME_TOLERANCE));
+
+    // Large render times don't overflow the tolerance math
+    render_bench_baseline_t big_base = { "big", 4000000000u, 0, 0, 0 };
+    render_bench_baseline_t big = big_base;
+    big.render_us = 4100000000u;
+    CHECK(!bench_stats_regressed(&big, &big_base, RENDER_BENCH_TIME_TOLERANCE));
+}
+
+static void test_pct_change(void) {
+    CHECK(bench_stats_pct_change(22000, 20000) == 10);
+    CHECK(bench_stats_pct_change(19000, 20000) == -5);
+    CHECK(bench_stats_pct_change(20199, 20000) == 0);   // Toward zero
+    CHECK(bench_stats_pct_change(19801, 20000) == 0);
+    CHECK(bench_stats_pct_change(0, 20000) == -100);
+    CHECK(bench_stats_pct_change(0, 0) == 0);
+    CHECK(bench_stats_pct_change(7, 0) == 100);
+}
+
+int main(void) {
+    test_empty_and_single();
+    test_small_sets();
+    test_hundred();
+    test_full_window();
+    test_find_baseline();
+    test_regression_check();
+    test_pct_change();
+
+    printf("bench_stats: %d checks, %d failed\n", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+// Host test for ble_frame.cpp: sequence checks under reordering, loss,
+// duplication and wrap-around, fragment reassembly, batches, acks and the
+// state set aside during a replay.
+
+#include <Arduino.h>
+#include "ble_frame.h"
+
+HostSerial Serial;
+uint32_t host_now_ms = 1000;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        checks++;                                                          \
+        if (!(cond)) {                                                     \
+            failures++;                                                    \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                  \
+    } while (0)
+
+// Headered frame for a stream, written into buf
+static size_t make_frame(uint8_t *buf, uint8_t stream, uint16_t seq, uint8_t flags,
+                         const char *payload) {
+    size_t len = strlen(payload);
+    buf[0] = BLE_FRAME_MAGIC;
+    buf[1] = (uint8_t)((flags << 4) | stream);
+    buf[2] = (uint8_t)(seq & 0xFF);
+    buf[3] = (uint8_t)(seq >> 8);
+    memcpy(buf + BLE_FRAME_HEADER_LEN, payload, len);
+    return BLE_FRAME_HEADER_LEN + len;
+}
+
+static BleFrameVerdict send(uint8_t stream, uint16_t seq) {
+    uint8_t buf[64];
+    ble_frame_t frame;
+    size_t len = make_frame(buf, stream, seq, 0, "{}");
+    if (!ble_frame_parse(buf, len, &frame)) return (BleFrameVerdict)-1;
+    return ble_frame_check(&frame);
+}
+
+// Feed one fragment; returns true (and the message) when reassembly completes
+static bool feed(uint8_t stream, uint16_t seq, uint8_t flags, const char *payload,
+                 const uint8_t **out, size_t *out_len) {
+    uint8_t buf[64];
+    ble_frame_t frame;
+    size_t len = make_frame(buf, stream, seq, flags, payload);
+    ble_frame_parse(buf, len, &frame);
+    return ble_frame_reassemble(&frame, host_now_ms, out, out_len);
+}
+
+static void test_parse(void) {
+    ble_frame_t frame;
+    const char *json = "{\"type\":\"navigation\"}";
+    CHECK(ble_frame_parse((const uint8_t *)json, strlen(json), &frame));
+    CHECK(!frame.has_header);
+    CHECK(frame.stream == BLE_STREAM_LEGACY);
+    CHECK(frame.payload_len == strlen(json));
+    CHECK(ble_frame_check(&frame) == BLE_FRAME_ACCEPT);
+
+    uint8_t buf[64];
+    size_t len = make_frame(buf, BLE_STREAM_CALL, 0x1234, BLE_FRAME_FLAG_START, "ab");
+    CHECK(ble_frame_parse(buf, len, &frame));
+    CHECK(frame.has_header);
+    CHECK(frame.stream == BLE_STREAM_CALL);
+    CHECK(frame.seq == 0x1234);
+    CHECK(frame.flags == BLE_FRAME_FLAG_START);
+    CHECK(frame.payload_len == 2 && memcmp(frame.payload, "ab", 2) == 0);
+
+    // Stream 0 and out-of-range streams are malformed
+    buf[1] = 0x00;
+    CHECK(!ble_frame_parse(buf, len, &frame));
+    buf[1] = 0x0F;
+    CHECK(!ble_frame_parse(buf, len, &frame));
+}
+
+static void test_reorder_and_duplicates(void) {
+    ble_frame_reset();
+    CHECK(send(BLE_STREAM_NAV, 10) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_NAV, 10) == BLE_FRAME_DUPLICATE);
+    CHECK(send(BLE_STREAM_NAV, 12) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_NAV, 11) == BLE_FRAME_STALE);    // Overtaken by 12
+    CHECK(send(BLE_STREAM_NAV, 12) == BLE_FRAME_DUPLICATE);
+
+    // Streams are independent: a stale ENDED can't hide behind nav traffic
+    CHECK(send(BLE_STREAM_CALL, 3) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_CALL, 2) == BLE_FRAME_STALE);
+    CHECK(send(BLE_STREAM_NAV, 13) == BLE_FRAME_ACCEPT);
+}
+
+static void test_loss(void) {
+    ble_frame_reset();
+    CHECK(send(BLE_STREAM_NAV, 1) == BLE_FRAME_ACCEPT);
+    // 2..9 lost: newer frames are still accepted, the lost ones are stale if they turn up
+    CHECK(send(BLE_STREAM_NAV, 10) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_NAV, 5) == BLE_FRAME_STALE);
+}
+
+static void test_wrap_and_resync(void) {
+    ble_frame_reset();
+    CHECK(send(BLE_STREAM_NOTIFY, 0xFFFE) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_NOTIFY, 0xFFFF) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_NOTIFY, 0x0000) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_NOTIFY, 0x0001) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_NOTIFY, 0xFFFF) == BLE_FRAME_STALE);  // Before the wrap
+    CHECK(send(BLE_STREAM_NOTIFY, 0x0001) == BLE_FRAME_DUPLICATE);
+
+    // A jump back by more than the resync gap is a restarted sender
+    CHECK(send(BLE_STREAM_NAV, 5000) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_NAV, 0) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_NAV, 1) == BLE_FRAME_ACCEPT);
+
+    // After a reset (new connection) any sequence number is accepted
+    ble_frame_reset();
+    CHECK(send(BLE_STREAM_NAV, 1) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_CALL, 0x8000) == BLE_FRAME_ACCEPT);
+}
+
+static void test_reassembly(void) {
+    ble_frame_reset();
+    const uint8_t *msg = nullptr;
+    size_t msg_len = 0;
+
+    // In order, across a sequence wrap
+    CHECK(!feed(BLE_STREAM_NAV, 0xFFFF, BLE_FRAME_FLAG_START, "{\"a\":", &msg, &msg_len));
+    CHECK(!feed(BLE_STREAM_NAV, 0x0000, BLE_FRAME_FLAG_CONT, "12", &msg, &msg_len));
+    CHECK(feed(BLE_STREAM_NAV, 0x0001, BLE_FRAME_FLAG_END, "3}", &msg, &msg_len));
+    CHECK(msg_len == 9 && memcmp(msg, "{\"a\":123}", 9) == 0);
+
+    // A lost middle fragment discards the message
+    CHECK(!feed(BLE_STREAM_NAV, 10, BLE_FRAME_FLAG_START, "x", &msg, &msg_len));
+    CHECK(!feed(BLE_STREAM_NAV, 12, BLE_FRAME_FLAG_END, "z", &msg, &msg_len));
+
+    // A lost START: the continuation is ignored
+    CHECK(!feed(BLE_STREAM_CALL, 20, BLE_FRAME_FLAG_END, "z", &msg, &msg_len));
+
+    // Too slow
+    CHECK(!feed(BLE_STREAM_NAV, 30, BLE_FRAME_FLAG_START, "x", &msg, &msg_len));
+    host_now_ms += BLE_FRAME_REASSEMBLY_TIMEOUT + 1;
+    CHECK(!feed(BLE_STREAM_NAV, 31, BLE_FRAME_FLAG_END, "y", &msg, &msg_len));
+
+    // Unfragmented frames pass straight through
+    CHECK(feed(BLE_STREAM_NAV, 40, 0, "{}", &msg, &msg_len));
+    CHECK(msg_len == 2);
+}
+
+static void test_batch(void) {
+    ble_frame_reset();
+    // nav seq 7 "{}", call seq 9 "[1]"
+    const uint8_t batch[] = {
+        BLE_STREAM_NAV, 7, 0, 2, 0, '{', '}',
+        BLE_STREAM_CALL, 9, 0, 3, 0, '[', '1', ']',
+    };
+    const uint8_t *cursor = batch;
+    const uint8_t *end = batch + sizeof(batch);
+    ble_frame_t sub;
+
+    CHECK(ble_frame_next_sub(&cursor, end, &sub));
+    CHECK(sub.stream == BLE_STREAM_NAV && sub.seq == 7 && sub.payload_len == 2);
+    CHECK(ble_frame_check(&sub) == BLE_FRAME_ACCEPT);
+    CHECK(ble_frame_next_sub(&cursor, end, &sub));
+    CHECK(sub.stream == BLE_STREAM_CALL && sub.seq == 9 && sub.payload_len == 3);
+    CHECK(ble_frame_check(&sub) == BLE_FRAME_ACCEPT);
+    CHECK(!ble_frame_next_sub(&cursor, end, &sub));
+
+    // A length past the end is malformed
+    const uint8_t truncated[] = { BLE_STREAM_NAV, 1, 0, 9, 0, '{', '}' };
+    cursor = truncated;
+    CHECK(!ble_frame_next_sub(&cursor, truncated + sizeof(truncated), &sub));
+}
+
+static void test_acks(void) {
+    ble_frame_reset();
+    uint8_t ack[BLE_FRAME_ACK_MAX_LEN];
+    CHECK(!ble_frame_ack_due(host_now_ms));
+    CHECK(ble_frame_build_ack(ack, sizeof(ack)) == 0);
+
+    // Batched by count
+    send(BLE_STREAM_NAV, 1);
+    send(BLE_STREAM_NAV, 2);
+    send(BLE_STREAM_NAV, 2);   // Duplicate
+    CHECK(!ble_frame_ack_due(host_now_ms));
+    send(BLE_STREAM_CALL, 4);
+    CHECK(ble_frame_ack_due(host_now_ms));
+    CHECK(ble_frame_ack_backlog() == 4);
+
+    size_t len = ble_frame_build_ack(ack, sizeof(ack));
+    CHECK(len == 3 + 2 * 5);
+    CHECK(ack[0] == BLE_FRAME_MAGIC && ack[1] == BLE_FRAME_ACK_TYPE && ack[2] == 2);
+    // nav: last 2, 2 received, 1 dropped
+    CHECK(ack[3] == BLE_STREAM_NAV && ack[4] == 2 && ack[5] == 0 && ack[6] == 2 && ack[7] == 1);
+    // call: last 4, 1 received
+    CHECK(ack[8] == BLE_STREAM_CALL && ack[9] == 4 && ack[10] == 0 && ack[11] == 1 && ack[12] == 0);
+    CHECK(ble_frame_ack_backlog() == 0);
+
+    // Batched by time
+    send(BLE_STREAM_NAV, 3);
+    CHECK(!ble_frame_ack_due(host_now_ms));
+    host_now_ms += BLE_FRAME_ACK_MAX_DELAY;
+    CHECK(ble_frame_ack_due(host_now_ms));
+}
+
+static void test_replay_save_restore(void) {
+    ble_frame_reset();
+    uint8_t ack[BLE_FRAME_ACK_MAX_LEN];
+    CHECK(send(BLE_STREAM_NAV, 100) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_CALL, 7) == BLE_FRAME_ACCEPT);
+
+    // A replay runs its own sequence numbers from a reset state
+    ble_frame_save();
+    ble_frame_reset();
+    CHECK(send(BLE_STREAM_NAV, 3) == BLE_FRAME_ACCEPT);
+    CHECK(send(BLE_STREAM_NAV, 500) == BLE_FRAME_ACCEPT);
+    ble_frame_restore();
+
+    // The live connection carries on: its acks don't cover replayed frames
+    CHECK(ble_frame_ack_backlog() == 2);
+    CHECK(send(BLE_STREAM_NAV, 100) == BLE_FRAME_DUPLICATE);
+    CHECK(send(BLE_STREAM_NAV, 101) == BLE_FRAME_ACCEPT);
+    size_t len = ble_frame_build_ack(ack, sizeof(ack));
+    CHECK(len == 3 + 2 * 5);
+    CHECK(ack[3] == BLE_STREAM_NAV && ack[4] == 101 && ack[5] == 0);
+    CHECK(ack[8] == BLE_STREAM_CALL && ack[9] == 7);
+
+    // A reconnect during the replay resets the saved state, not the replay's
+    ble_frame_save();
+    ble_frame_reset();
+    CHECK(send(BLE_STREAM_NAV, 1) == BLE_FRAME_ACCEPT);
+    ble_frame_reset_live();
+    CHECK(send(BLE_STREAM_NAV, 1) == BLE_FRAME_DUPLICATE);
+    ble_frame_restore();
+    CHECK(ble_frame_ack_backlog() == 0);
+    CHECK(send(BLE_STREAM_NAV, 0) == BLE_FRAME_ACCEPT);   // The new connection's first frame
+
+    // Without a saved state a restore changes nothing, and a live reset is a plain reset
+    ble_frame_restore();
+    CHECK(send(BLE_STREAM_NAV, 0) == BLE_FRAME_DUPLICATE);
+    ble_frame_reset_live();
+    CHECK(send(BLE_STREAM_NAV, 0) == BLE_FRAME_ACCEPT);
+}
+
+int main(void) {
+    test_parse();
+    test_reorder_and_duplicates();
+    test_loss();
+    test_wrap_and_resync();
+    test_reassembly();
+    test_batch();
+    test_acks();
+    test_replay_save_restore();
+
+    printf("ble_frame: %d checks, %d failed\n", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
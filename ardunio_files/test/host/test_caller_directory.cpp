@@ -0,0 +1,136 @@
+// Host test for caller_directory.cpp: the trailing-digit number hash,
+// probing on colliding home slots, wrap-around at the end of the table,
+// the CALLER_DIRECTORY_MAX_ENTRIES limit and name truncation.
+
+#include <Arduino.h>
+#include "caller_directory.h"
+
+HostSerial Serial;
+uint32_t host_now_ms = 1000;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        checks++;                                                          \
+        if (!(cond)) {                                                     \
+            failures++;                                                    \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                  \
+    } while (0)
+
+// Home slots under the table's Fibonacci hash (64 slots):
+//   2 and 36 -> 15, 34 and 89 -> 0, 55, 144 and 199 -> 63
+static bool has(uint16_t id, const char *name, uint32_t hash) {
+    char buf[CALLER_DIRECTORY_NAME_LEN];
+    uint32_t h = 0;
+    if (!caller_directory_lookup(id, buf, sizeof(buf), &h)) return false;
+    return strcmp(buf, name) == 0 && h == hash;
+}
+
+static void test_hash(void) {
+    // Same value as CallerDirectoryTest.kt on the phone
+    uint32_t hash = caller_directory_hash_number("9876543210");
+    CHECK(hash == 0x52158234u);
+    // Only the last 10 digits count: country code and formatting are ignored
+    CHECK(caller_directory_hash_number("+91 98765-43210") == hash);
+    CHECK(caller_directory_hash_number("0091 (987) 654 3210") == hash);
+    CHECK(caller_directory_hash_number("9876543211") != hash);
+    // Fewer digits hash all of them
+    CHECK(caller_directory_hash_number("112") != 0);
+    CHECK(caller_directory_hash_number("112") == caller_directory_hash_number("1-1-2"));
+    CHECK(caller_directory_hash_number("") == 0);
+    CHECK(caller_directory_hash_number("Private") == 0);
+    CHECK(caller_directory_hash_number(nullptr) == 0);
+}
+
+static void test_put_lookup(void) {
+    caller_directory_clear();
+    char buf[CALLER_DIRECTORY_NAME_LEN];
+    CHECK(!caller_directory_put(0, 1, "Nobody"));
+    CHECK(!caller_directory_lookup(0, buf, sizeof(buf), nullptr));
+    CHECK(!caller_directory_lookup(7, buf, sizeof(buf), nullptr));
+
+    CHECK(caller_directory_put(7, 0x1234, "Asha"));
+    CHECK(has(7, "Asha", 0x1234));
+    CHECK(caller_directory_lookup(7, buf, sizeof(buf), nullptr));
+
+    // Replacing keeps one entry
+    CHECK(caller_directory_put(7, 0x5678, "Asha M"));
+    CHECK(has(7, "Asha M", 0x5678));
+
+    // Long names are cut to the buffer, and so is the lookup output
+    CHECK(caller_directory_put(8, 1, "A very long contact name that does not fit"));
+    CHECK(caller_directory_lookup(8, buf, sizeof(buf), nullptr));
+    CHECK(strlen(buf) == CALLER_DIRECTORY_NAME_LEN - 1);
+    char small[5];
+    CHECK(caller_directory_lookup(8, small, sizeof(small), nullptr));
+    CHECK(strcmp(small, "A ve") == 0);
+    CHECK(caller_directory_put(9, 2, nullptr));
+    CHECK(has(9, "", 2));
+
+    caller_directory_clear();
+    CHECK(!caller_directory_lookup(7, buf, sizeof(buf), nullptr));
+}
+
+static void test_probing(void) {
+    caller_directory_clear();
+    CHECK(caller_directory_put(2, 2, "Two"));
+    CHECK(caller_directory_put(36, 36, "Thirty-six"));    // Home slot taken by 2
+    CHECK(has(2, "Two", 2));
+    CHECK(has(36, "Thirty-six", 36));
+    // Replacing the probed entry finds it again instead of taking a new slot
+    CHECK(caller_directory_put(36, 360, "Thirty-six"));
+    CHECK(has(36, "Thirty-six", 360));
+}
+
+static void test_wrap_around(void) {
+    caller_directory_clear();
+    // 55 takes the last slot; 144 wraps to slot 0, which pushes 34 and 89 on
+    CHECK(caller_directory_put(55, 55, "Last"));
+    CHECK(caller_directory_put(144, 144, "Wrapped"));
+    CHECK(caller_directory_put(34, 34, "Zero"));
+    CHECK(caller_directory_put(89, 89, "Zero too"));
+    CHECK(has(55, "Last", 55));
+    CHECK(has(144, "Wrapped", 144));
+    CHECK(has(34, "Zero", 34));
+    CHECK(has(89, "Zero too", 89));
+    // A miss on the same chain walks through the wrap and stops at the first empty slot
+    char buf[CALLER_DIRECTORY_NAME_LEN];
+    CHECK(!caller_directory_lookup(199, buf, sizeof(buf), nullptr));
+}
+
+static void test_max_entries(void) {
+    caller_directory_clear();
+    int stored = 0;
+    for (uint16_t id = 1; id <= CALLER_DIRECTORY_MAX_ENTRIES + 10; id++) {
+        char name[8];
+        snprintf(name, sizeof(name), "C%u", id);
+        if (caller_directory_put(id, id, name)) stored++;
+    }
+    CHECK(stored == CALLER_DIRECTORY_MAX_ENTRIES);
+    CHECK(has(1, "C1", 1));
+    char buf[CALLER_DIRECTORY_NAME_LEN];
+    snprintf(buf, sizeof(buf), "C%u", CALLER_DIRECTORY_MAX_ENTRIES);
+    CHECK(has(CALLER_DIRECTORY_MAX_ENTRIES, buf, CALLER_DIRECTORY_MAX_ENTRIES));
+    CHECK(!caller_directory_lookup(CALLER_DIRECTORY_MAX_ENTRIES + 1, buf, sizeof(buf), nullptr));
+    // A full table still replaces existing entries
+    CHECK(caller_directory_put(1, 100, "C1 new"));
+    CHECK(has(1, "C1 new", 100));
+    // Clearing frees the room again
+    caller_directory_clear();
+    CHECK(caller_directory_put(CALLER_DIRECTORY_MAX_ENTRIES + 1, 1, "Late"));
+    CHECK(has(CALLER_DIRECTORY_MAX_ENTRIES + 1, "Late", 1));
+}
+
+int main(void) {
+    test_hash();
+    test_put_lookup();
+    test_probing();
+    test_wrap_around();
+    test_max_entries();
+
+    printf("caller_directory: %d checks, %d failed\n", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
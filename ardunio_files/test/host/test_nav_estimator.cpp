@@ -0,0 +1,192 @@
+// Host test for nav_estimator.cpp: countdown error over a recorded drive,
+// speed smoothing, the reset when the distance grows, the MIN_DT/MAX_DT
+// gates and the clamps on speed, extrapolation time and distance.
+
+#include <Arduino.h>
+#include "nav_estimator.h"
+
+HostSerial Serial;
+uint32_t host_now_ms = 1000;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        checks++;                                                          \
+        if (!(cond)) {                                                     \
+            failures++;                                                    \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                  \
+    } while (0)
+
+// Phone updates on the approach to a turn: distance in meters (rounded to
+// 10 m, as Maps reports it) and arrival time, at the app's irregular 2-3 s
+// cadence. The car slows from about 14 m/s to 8 m/s and waits at a light
+// around 30 s.
+typedef struct {
+    uint32_t ms;
+    int32_t distance_m;
+} trace_sample_t;
+
+static const trace_sample_t drive_trace[] = {
+    {     0, 820 }, {  2100, 790 }, {  4050, 760 }, {  6200, 730 },
+    {  8900, 690 }, { 11000, 660 }, { 13150, 630 }, { 16000, 590 },
+    { 18200, 560 }, { 21300, 520 }, { 24000, 490 }, { 26800, 470 },
+    { 29500, 460 }, { 31800, 460 }, { 34500, 450 }, { 37000, 430 },
+    { 39100, 410 }, { 42000, 380 }, { 44200, 360 }, { 47100, 340 },
+    { 49800, 310 }, { 52000, 290 }, { 54900, 270 }, { 57100, 250 },
+};
+
+// Worst error allowed at the moment a new sample arrives: Maps' 10 m
+// rounding on both ends plus the speed change the smoothing lags behind
+#define TRACE_MAX_ERROR_M   20
+#define TRACE_MAX_AVG_M     8
+
+static int32_t abs32(int32_t v) { return v < 0 ? -v : v; }
+
+static void test_trace_error_bound(void) {
+    nav_estimator_reset();
+    const size_t n = sizeof(drive_trace) / sizeof(drive_trace[0]);
+    int32_t max_err = 0;
+    int32_t sum_err = 0;
+    int scored = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        const trace_sample_t *s = &drive_trace[i];
+        if (i >= 2) {
+            // Counting down between samples never goes up
+            int32_t prev = nav_estimator_predict(drive_trace[i - 1].ms);
+            for (uint32_t t = drive_trace[i - 1].ms; t < s->ms; t += NAV_ESTIMATOR_TICK_MS) {
+                int32_t d = nav_estimator_predict(t);
+                CHECK(d <= prev);
+                prev = d;
+            }
+            int32_t err = abs32(nav_estimator_predict(s->ms) - s->distance_m);
+            if (err > max_err) max_err = err;
+            sum_err += err;
+            scored++;
+        }
+        nav_estimator_add_sample(s->distance_m, s->ms);
+    }
+    if (max_err > TRACE_MAX_ERROR_M || sum_err / scored > TRACE_MAX_AVG_M) {
+        fprintf(stderr, "  trace error: max=%ldm avg=%ldm\n", (long)max_err, (long)(sum_err / scored));
+    }
+    CHECK(max_err <= TRACE_MAX_ERROR_M);
+    CHECK(sum_err / scored <= TRACE_MAX_AVG_M);
+}
+
+static void test_no_speed_yet(void) {
+    nav_estimator_reset();
+    CHECK(nav_estimator_predict(0) == 0);
+    nav_estimator_add_sample(500, 1000);
+    // One sample: no speed, the distance holds
+    CHECK(nav_estimator_predict(5000) == 500);
+    CHECK(!nav_estimator_active(5000));
+    nav_estimator_add_sample(0, 6000);
+    CHECK(nav_estimator_predict(7000) == 0);
+}
+
+static void test_smoothing(void) {
+    nav_estimator_reset();
+    nav_estimator_add_sample(1000, 0);
+    nav_estimator_add_sample(900, 10000);      // 10 m/s
+    CHECK(nav_estimator_active(10000));
+    CHECK(nav_estimator_predict(11000) == 890);
+    nav_estimator_add_sample(700, 20000);      // 20 m/s measured -> (10 + 20) / 2
+    CHECK(nav_estimator_predict(22000) == 670);
+    nav_estimator_add_sample(670, 22000);      // 15 m/s measured -> stays 15
+    CHECK(nav_estimator_predict(24000) == 640);
+}
+
+static void test_reset_when_distance_grows(void) {
+    nav_estimator_reset();
+    nav_estimator_add_sample(1000, 0);
+    nav_estimator_add_sample(900, 10000);
+    CHECK(nav_estimator_active(10000));
+    // Next step or reroute: start over from the new distance without a speed
+    nav_estimator_add_sample(1500, 12000);
+    CHECK(!nav_estimator_active(12000));
+    CHECK(nav_estimator_predict(20000) == 1500);
+    // The first sample after the reset sets a fresh speed (5 m/s)
+    nav_estimator_add_sample(1450, 22000);
+    CHECK(nav_estimator_predict(24000) == 1440);
+}
+
+static void test_dt_gates(void) {
+    nav_estimator_reset();
+    nav_estimator_add_sample(1000, 0);
+    nav_estimator_add_sample(900, 10000);      // 10 m/s
+
+    // Below MIN_DT the speed is left alone but the sample still resyncs
+    nav_estimator_add_sample(880, 10000 + NAV_ESTIMATOR_MIN_DT_MS - 1);
+    CHECK(nav_estimator_predict(10000 + NAV_ESTIMATOR_MIN_DT_MS - 1 + 1000) == 870);
+
+    // A repeated distance within MIN_DT keeps the old time base
+    nav_estimator_reset();
+    nav_estimator_add_sample(1000, 0);
+    nav_estimator_add_sample(900, 10000);
+    nav_estimator_add_sample(900, 10100);
+    CHECK(nav_estimator_predict(11000) == 890);
+
+    // A gap past MAX_DT leaves no usable speed
+    nav_estimator_reset();
+    nav_estimator_add_sample(1000, 0);
+    nav_estimator_add_sample(900, 10000);
+    nav_estimator_add_sample(600, 10000 + NAV_ESTIMATOR_MAX_DT_MS + 1);
+    CHECK(!nav_estimator_active(10000 + NAV_ESTIMATOR_MAX_DT_MS + 1));
+    CHECK(nav_estimator_predict(10000 + NAV_ESTIMATOR_MAX_DT_MS + 5000) == 600);
+
+    // Exactly MAX_DT still measures (300 m in 30 s = 10 m/s)
+    nav_estimator_reset();
+    nav_estimator_add_sample(1000, 0);
+    nav_estimator_add_sample(700, NAV_ESTIMATOR_MAX_DT_MS);
+    CHECK(nav_estimator_predict(NAV_ESTIMATOR_MAX_DT_MS + 1000) == 690);
+}
+
+static void test_clamps(void) {
+    // Faster than MAX_SPEED is a glitch, not a speed
+    nav_estimator_reset();
+    nav_estimator_add_sample(1000, 0);
+    nav_estimator_add_sample(200, 10000);      // 80 m/s
+    CHECK(!nav_estimator_active(10000));
+    CHECK(nav_estimator_predict(12000) == 200);
+
+    // Extrapolation stops after MAX_EXTRAPOLATE
+    nav_estimator_reset();
+    nav_estimator_add_sample(1000, 0);
+    nav_estimator_add_sample(900, 10000);      // 10 m/s
+    uint32_t limit = 10000 + NAV_ESTIMATOR_MAX_EXTRAPOLATE;
+    CHECK(nav_estimator_active(limit));
+    CHECK(!nav_estimator_active(limit + 1));
+    CHECK(nav_estimator_predict(limit) == 900 - NAV_ESTIMATOR_MAX_EXTRAPOLATE / 100);
+    CHECK(nav_estimator_predict(limit + 60000) == nav_estimator_predict(limit));
+
+    // Never below zero
+    nav_estimator_reset();
+    nav_estimator_add_sample(100, 0);
+    nav_estimator_add_sample(50, 5000);        // 10 m/s, 5 s to go
+    CHECK(nav_estimator_predict(12000) == 0);
+
+    // Rebase keeps the speed and counts down from the new distance
+    nav_estimator_reset();
+    nav_estimator_add_sample(1000, 0);
+    nav_estimator_add_sample(900, 10000);
+    nav_estimator_rebase(400, 11000);
+    CHECK(nav_estimator_predict(13000) == 380);
+    nav_estimator_rebase(0, 14000);
+    CHECK(!nav_estimator_active(14000));
+    CHECK(nav_estimator_predict(15000) == 0);
+}
+
+int main(void) {
+    test_trace_error_bound();
+    test_no_speed_yet();
+    test_smoothing();
+    test_reset_when_distance_grows();
+    test_dt_gates();
+    test_clamps();
+
+    printf("nav_estimator: %d checks, %d failed\n", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
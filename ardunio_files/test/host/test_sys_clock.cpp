@@ -0,0 +1,171 @@
+// Host test for sys_clock.cpp: fast-forward jumps to the earliest deadline,
+// every deadline is reached in order and never early, across a millis()
+// wrap, and the clock never goes back.
+
+#include <Arduino.h>
+#include "sys_clock.h"
+
+HostSerial Serial;
+uint32_t host_now_ms = 1000;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        checks++;                                                          \
+        if (!(cond)) {                                                     \
+            failures++;                                                    \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                  \
+    } while (0)
+
+// A loop() waiter like the call timeout or the missed-call reminder: fires
+// once its time has come, then waits again period_ms later
+typedef struct {
+    uint32_t next_ms;
+    uint32_t period_ms;
+    uint32_t fired;
+} waiter_t;
+
+typedef struct {
+    uint8_t waiter;
+    uint32_t due_ms;
+    uint32_t at_ms;
+} firing_t;
+
+#define MAX_FIRINGS 64
+
+// Run loop passes (each pass_ms of real time) until max_firings waiters fire
+static uint32_t run_loop(waiter_t *w, uint8_t count, uint32_t pass_ms, firing_t *log, uint32_t max_firings) {
+    uint32_t n = 0;
+    for (uint32_t pass = 0; pass < 100000 && n < max_firings; pass++) {
+        host_now_ms += pass_ms;
+        for (uint8_t i = 0; i < count && n < max_firings; i++) {
+            uint32_t now = sys_clock_ms();
+            if ((int32_t)(now - w[i].next_ms) >= 0) {
+                log[n++] = { i, w[i].next_ms, now };
+                w[i].fired++;
+                w[i].next_ms += w[i].period_ms;
+            }
+            sys_clock_deadline(w[i].next_ms);
+        }
+        sys_clock_tick();
+    }
+    return n;
+}
+
+// Firings come in deadline order, none early, each within one pass of its time
+static void check_firings(const firing_t *log, uint32_t n, uint32_t pass_ms) {
+    for (uint32_t i = 0; i < n; i++) {
+        CHECK((int32_t)(log[i].at_ms - log[i].due_ms) >= 0);
+        CHECK(log[i].at_ms - log[i].due_ms <= pass_ms);
+        if (i > 0) CHECK((int32_t)(log[i].due_ms - log[i - 1].due_ms) >= 0);
+    }
+}
+
+static void test_fast_forward_order(void) {
+    sys_clock_set_fast_forward(true);
+    uint32_t start = sys_clock_ms();
+    uint32_t real_start = host_now_ms;
+    // Incoming-call timeout, reminder interval, reminder display time
+    waiter_t w[3] = {
+        { start + 30000, 3600000, 0 },
+        { start + 60000, 60000, 0 },
+        { start + 70000, 60000, 0 },
+    };
+    firing_t log[MAX_FIRINGS];
+    uint32_t n = run_loop(w, 3, 2, log, 21);
+    CHECK(n == 21);
+    check_firings(log, n, 2);
+    // An hour of reminders: 1 timeout, then reminder/display pairs
+    CHECK(w[0].fired == 1);
+    CHECK(w[1].fired == 10 && w[2].fired == 10);
+    CHECK(log[0].waiter == 0 && log[1].waiter == 1 && log[2].waiter == 2);
+    // ...in a fraction of a second of real time
+    CHECK(host_now_ms - real_start < 1000);
+    CHECK(sys_clock_ms() - start >= 600000);
+    sys_clock_set_fast_forward(false);
+}
+
+static void test_exact_with_no_loop_time(void) {
+    // With no real time passing between passes every deadline is hit exactly
+    sys_clock_set_fast_forward(true);
+    uint32_t start = sys_clock_ms();
+    waiter_t w[2] = {
+        { start + 1500, 1000, 0 },
+        { start + 1000, 700, 0 },
+    };
+    firing_t log[MAX_FIRINGS];
+    uint32_t n = run_loop(w, 2, 0, log, 8);
+    CHECK(n == 8);
+    for (uint32_t i = 0; i < n; i++) CHECK(log[i].at_ms == log[i].due_ms);
+    // 1000, 1500, 1700, 2400, 2500, 3100, 3500, 3800
+    CHECK(log[0].waiter == 1 && log[1].waiter == 0 && log[2].waiter == 1);
+    CHECK(log[7].due_ms == start + 3800);
+    sys_clock_set_fast_forward(false);
+}
+
+static void test_no_jump_when_off_or_due(void) {
+    sys_clock_set_fast_forward(false);
+    uint32_t before = sys_clock_ms();
+    sys_clock_deadline(before + 50000);
+    sys_clock_tick();
+    CHECK(sys_clock_ms() == before);
+
+    // A deadline already due is handled by the next pass, not a jump back
+    sys_clock_set_fast_forward(true);
+    sys_clock_deadline(before - 10);
+    sys_clock_deadline(before + 50000);
+    sys_clock_tick();
+    CHECK(sys_clock_ms() == before);
+
+    // Deadlines are forgotten at each tick: nothing noted, nothing to jump to
+    sys_clock_tick();
+    CHECK(sys_clock_ms() == before);
+
+    // The earliest of several wins, whatever order they are noted in
+    sys_clock_deadline(before + 9000);
+    sys_clock_deadline(before + 3000);
+    sys_clock_deadline(before + 6000);
+    sys_clock_tick();
+    CHECK(sys_clock_ms() == before + 3000);
+    sys_clock_set_fast_forward(false);
+}
+
+static void test_millis_wrap(void) {
+    // Real time close to the 32-bit wrap; deadlines past it still order right
+    host_now_ms = 0xFFFFF000u;
+    sys_clock_set_fast_forward(true);
+    uint32_t start = sys_clock_ms();
+    waiter_t w[2] = {
+        { start + 0x2000, 0x3000, 0 },
+        { start + 0x1000, 0x3000, 0 },
+    };
+    firing_t log[MAX_FIRINGS];
+    uint32_t n = run_loop(w, 2, 1, log, 6);
+    CHECK(n == 6);
+    check_firings(log, n, 1);
+    CHECK(log[0].waiter == 1 && log[1].waiter == 0);
+    sys_clock_set_fast_forward(false);
+}
+
+static void test_advance(void) {
+    host_now_ms = 5000;
+    uint32_t before = sys_clock_ms();
+    sys_clock_advance(600000);
+    CHECK(sys_clock_ms() == before + 600000);
+    host_now_ms += 10;
+    CHECK(sys_clock_ms() == before + 600010);
+}
+
+int main(void) {
+    test_fast_forward_order();
+    test_exact_with_no_loop_time();
+    test_no_jump_when_off_or_due();
+    test_millis_wrap();
+    test_advance();
+
+    printf("sys_clock: %d checks, %d failed\n", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
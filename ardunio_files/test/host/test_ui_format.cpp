@@ -0,0 +1,123 @@
+// Host test for ui_format.cpp: integer and fixed-point output, truncation,
+// distance rounding and the m/km and ft/mi switch points.
+
+#include <Arduino.h>
+#include <limits.h>
+#include "ui_format.h"
+
+HostSerial Serial;
+uint32_t host_now_ms = 1000;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        checks++;                                                          \
+        if (!(cond)) {                                                     \
+            failures++;                                                    \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                  \
+    } while (0)
+
+// Distance text equals expected, and the returned length matches it
+static void check_distance(int line, int32_t meters, UIDistanceUnits units, const char *expected) {
+    char buf[24];
+    size_t len = ui_format_distance(buf, sizeof(buf), meters, units);
+    checks++;
+    if (strcmp(buf, expected) != 0 || len != strlen(expected)) {
+        failures++;
+        fprintf(stderr, "%s:%d: %ld m gave \"%s\" (%zu), expected \"%s\"\n",
+                __FILE__, line, (long)meters, buf, len, expected);
+    }
+}
+
+#define CHECK_METRIC(meters, expected) check_distance(__LINE__, meters, UI_UNITS_METRIC, expected)
+#define CHECK_IMPERIAL(meters, expected) check_distance(__LINE__, meters, UI_UNITS_IMPERIAL, expected)
+
+static void test_integers(void) {
+    char buf[16];
+    CHECK(ui_format_uint(buf, sizeof(buf), 0) == 1 && strcmp(buf, "0") == 0);
+    CHECK(ui_format_uint(buf, sizeof(buf), UINT32_MAX) == 10 && strcmp(buf, "4294967295") == 0);
+    CHECK(ui_format_int(buf, sizeof(buf), -12) == 3 && strcmp(buf, "-12") == 0);
+    CHECK(ui_format_int(buf, sizeof(buf), INT32_MIN) == 11 && strcmp(buf, "-2147483648") == 0);
+    CHECK(ui_format_int(buf, sizeof(buf), INT32_MAX) == 10 && strcmp(buf, "2147483647") == 0);
+}
+
+static void test_fixed(void) {
+    char buf[16];
+    CHECK(ui_format_fixed(buf, sizeof(buf), 12, 1) == 3 && strcmp(buf, "1.2") == 0);
+    CHECK(ui_format_fixed(buf, sizeof(buf), 5, 2) == 4 && strcmp(buf, "0.05") == 0);
+    CHECK(ui_format_fixed(buf, sizeof(buf), -12, 1) == 4 && strcmp(buf, "-1.2") == 0);
+    CHECK(ui_format_fixed(buf, sizeof(buf), -5, 1) == 4 && strcmp(buf, "-0.5") == 0);
+    CHECK(ui_format_fixed(buf, sizeof(buf), INT32_MIN, 3) == 12 && strcmp(buf, "-2147483.648") == 0);
+    CHECK(ui_format_fixed(buf, sizeof(buf), 7, 0) == 1 && strcmp(buf, "7") == 0);
+}
+
+static void test_truncation(void) {
+    char buf[4];
+    CHECK(ui_format_uint(buf, sizeof(buf), 12345) == 3 && strcmp(buf, "123") == 0);
+    CHECK(ui_format_distance(buf, sizeof(buf), 450, UI_UNITS_METRIC) == 3 && strcmp(buf, "450") == 0);
+    CHECK(ui_format_uint(buf, 1, 9) == 0 && buf[0] == '\0');
+    CHECK(ui_format_uint(nullptr, 0, 9) == 0);
+}
+
+static void test_distance_metric(void) {
+    CHECK_METRIC(0, "");
+    CHECK_METRIC(-5, "");
+    CHECK_METRIC(INT32_MIN, "");
+    CHECK_METRIC(1, "1 m");
+    CHECK_METRIC(999, "999 m");
+    CHECK_METRIC(1000, "1.0 km");
+    CHECK_METRIC(1049, "1.0 km");
+    CHECK_METRIC(1050, "1.1 km");
+    CHECK_METRIC(12345, "12.3 km");
+    CHECK_METRIC(INT32_MAX, "2147483.6 km");
+}
+
+static void test_distance_imperial(void) {
+    CHECK_IMPERIAL(0, "");
+    CHECK_IMPERIAL(INT32_MIN, "");
+    // A distance still to go never reads "0 ft"
+    CHECK_IMPERIAL(1, "10 ft");
+    CHECK_IMPERIAL(2, "10 ft");
+    CHECK_IMPERIAL(5, "20 ft");   // 16.4 ft
+    CHECK_IMPERIAL(100, "330 ft"); // 328.1 ft
+    // 303 m = 994 ft stays in feet; 304 m = 997 ft rounds to 1000 ft and switches
+    CHECK_IMPERIAL(303, "990 ft");
+    CHECK_IMPERIAL(304, "0.2 mi");
+    CHECK_IMPERIAL(1609, "1.0 mi");
+    CHECK_IMPERIAL(2333, "1.4 mi"); // 1.4497 mi
+    CHECK_IMPERIAL(2334, "1.5 mi"); // 1.4503 mi
+    // Feet past 32 bits must not wrap back below the switch point
+    CHECK_IMPERIAL(INT32_MAX, "1334384.5 mi");
+}
+
+static void test_times(void) {
+    char buf[16];
+    CHECK(ui_format_mmss(buf, sizeof(buf), 0) == 5 && strcmp(buf, "00:00") == 0);
+    CHECK(ui_format_mmss(buf, sizeof(buf), 187) == 5 && strcmp(buf, "03:07") == 0);
+    CHECK(ui_format_mmss(buf, sizeof(buf), 6000) == 6 && strcmp(buf, "100:00") == 0);
+    ui_format_eta(buf, sizeof(buf), 59);
+    CHECK(strcmp(buf, "< 1 min") == 0);
+    ui_format_eta(buf, sizeof(buf), 60);
+    CHECK(strcmp(buf, "1 min") == 0);
+    ui_format_eta(buf, sizeof(buf), 3599);
+    CHECK(strcmp(buf, "59 min") == 0);
+    ui_format_eta(buf, sizeof(buf), 3600);
+    CHECK(strcmp(buf, "1h") == 0);
+    ui_format_eta(buf, sizeof(buf), 4500);
+    CHECK(strcmp(buf, "1h 15m") == 0);
+}
+
+int main(void) {
+    test_integers();
+    test_fixed();
+    test_truncation();
+    test_distance_metric();
+    test_distance_imperial();
+    test_times();
+
+    printf("ui_format: %d checks, %d failed\n", checks, failures);
+    return failures == 0 ? 0 : 1;
+}